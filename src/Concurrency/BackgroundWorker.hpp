@@ -0,0 +1,121 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file
+ *  @brief a single std::thread running one task at a time behind the caller
+ */
+#ifndef QMCPLUSPLUS_BACKGROUNDWORKER_HPP
+#define QMCPLUSPLUS_BACKGROUNDWORKER_HPP
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace qmcplusplus
+{
+/** Runs tasks on a dedicated thread, at most one in flight.
+ *
+ *  This is meant for double buffered I/O: the caller fills one buffer while the
+ *  task submitted last drains the other. submit waits for the previous task, so
+ *  the caller only needs to wait before reusing the buffer owned by the task.
+ *  An exception thrown by a task is rethrown by the next wait or submit.
+ */
+class BackgroundWorker
+{
+public:
+  BackgroundWorker() : thread_([this] { run(); }) {}
+
+  BackgroundWorker(const BackgroundWorker&) = delete;
+  BackgroundWorker& operator=(const BackgroundWorker&) = delete;
+
+  ~BackgroundWorker()
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      idle_.wait(lock, [this] { return !task_; });
+      stop_ = true;
+    }
+    pending_.notify_one();
+    thread_.join();
+  }
+
+  /// wait for the previous task and hand over the next one
+  void submit(std::function<void()> task)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return !task_; });
+    rethrow(lock);
+    task_ = std::move(task);
+    lock.unlock();
+    pending_.notify_one();
+  }
+
+  /// wait until the submitted task is done
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return !task_; });
+    rethrow(lock);
+  }
+
+private:
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+      pending_.wait(lock, [this] { return stop_ || task_; });
+      if (!task_)
+        return;
+      lock.unlock();
+      try
+      {
+        task_();
+      }
+      catch (...)
+      {
+        lock.lock();
+        error_ = std::current_exception();
+        lock.unlock();
+      }
+      lock.lock();
+      task_ = nullptr;
+      idle_.notify_all();
+    }
+  }
+
+  void rethrow(std::unique_lock<std::mutex>& lock)
+  {
+    if (error_)
+    {
+      std::exception_ptr error = error_;
+      error_                   = nullptr;
+      lock.unlock();
+      std::rethrow_exception(error);
+    }
+  }
+
+  std::mutex mutex_;
+  /// signals a new task or stop to the worker
+  std::condition_variable pending_;
+  /// signals the completion of a task to the caller
+  std::condition_variable idle_;
+  std::function<void()> task_;
+  std::exception_ptr error_;
+  bool stop_ = false;
+  // the last member so that everything the thread touches exists before it starts
+  std::thread thread_;
+};
+} // namespace qmcplusplus
+#endif
@@ -0,0 +1,53 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "Concurrency/BackgroundWorker.hpp"
+
+namespace qmcplusplus
+{
+TEST_CASE("BackgroundWorker", "[concurrency]")
+{
+  std::vector<int> written;
+  const auto caller = std::this_thread::get_id();
+  std::thread::id worker_id;
+  {
+    BackgroundWorker worker;
+    // double buffered: the staged value is only refilled after the previous task is done
+    int staged = 0;
+    for (int block = 0; block < 4; ++block)
+    {
+      worker.wait();
+      staged = block;
+      worker.submit([&written, &staged, &worker_id] {
+        worker_id = std::this_thread::get_id();
+        written.push_back(staged);
+      });
+    }
+    worker.wait();
+    CHECK(worker_id != caller);
+    CHECK(written == std::vector<int>{0, 1, 2, 3});
+
+    worker.submit([] { throw std::runtime_error("write failed"); });
+    CHECK_THROWS_AS(worker.wait(), std::runtime_error);
+    // the error is only reported once
+    worker.wait();
+
+    worker.submit([&written] { written.push_back(4); });
+  }
+  // destruction completes the outstanding task
+  CHECK(written.size() == 5);
+}
+} // namespace qmcplusplus
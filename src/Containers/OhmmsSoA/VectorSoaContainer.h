@@ -70,7 +70,11 @@ struct VectorSoaContainer
 
   ///move constructor
   VectorSoaContainer(VectorSoaContainer&& in) noexcept
-      : nLocal(in.nLocal), nGhosts(in.nGhosts), nAllocated(in.nAllocated), myData(std::move(in.myData))
+      : nLocal(in.nLocal),
+        nGhosts(in.nGhosts),
+        nAllocated(in.nAllocated),
+        myData(std::move(in.myData)),
+        mAllocator(std::move(in.mAllocator))
   {
     in.myData     = nullptr;
     in.nAllocated = 0;
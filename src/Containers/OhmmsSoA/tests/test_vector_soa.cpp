@@ -14,7 +14,9 @@
 #include "catch.hpp"
 
 #include "OhmmsSoA/VectorSoaContainer.h"
+#include "MemoryAccounting.h"
 
+#include <memory>
 #include <stdio.h>
 #include <string>
 
@@ -98,6 +100,25 @@ TEST_CASE("VectorSoaContainer move constructor", "[OhmmsSoA]")
   CHECK(rsoa_move[1][2] == Approx(1.68658058));
 }
 
+TEST_CASE("VectorSoaContainer move constructor memory accounting", "[OhmmsSoA]")
+{
+  const int64_t spline_walker = getMemoryAccountedCurrent(MemoryTag::SPLINE, MemoryScope::WALKER);
+  const int64_t untagged      = getMemoryAccountedCurrent(MemoryTag::UNTAGGED, MemoryScope::SHARED);
+  std::unique_ptr<VectorSoaContainer<double, 3>> created;
+  {
+    ScopedMemoryScope walker_memory(MemoryScope::WALKER);
+    ScopedMemoryTag spline_memory(MemoryTag::SPLINE);
+    created = std::make_unique<VectorSoaContainer<double, 3>>(4);
+  }
+  CHECK(getMemoryAccountedCurrent(MemoryTag::SPLINE, MemoryScope::WALKER) > spline_walker);
+  {
+    // the allocator moves along with the memory, which is released under the key it was allocated with
+    VectorSoaContainer<double, 3> moved(std::move(*created));
+  }
+  CHECK(getMemoryAccountedCurrent(MemoryTag::SPLINE, MemoryScope::WALKER) == spline_walker);
+  CHECK(getMemoryAccountedCurrent(MemoryTag::UNTAGGED, MemoryScope::SHARED) == untagged);
+}
+
 TEST_CASE("VectorSoaContainer assignment", "[OhmmsSoA]")
 {
   Vector<TinyVector<double, 3>> R(4);
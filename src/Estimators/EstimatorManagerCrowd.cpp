@@ -10,11 +10,13 @@
 //////////////////////////////////////////////////////////////////////////////////////
 
 #include "EstimatorManagerCrowd.h"
+#include "MemoryAccounting.h"
 
 namespace qmcplusplus
 {
 EstimatorManagerCrowd::EstimatorManagerCrowd(EstimatorManagerNew& em)
 {
+  ScopedMemoryTag estimator_memory(MemoryTag::ESTIMATOR);
   main_estimator_ = UPtr<ScalarEstimatorBase>(em.main_estimator_->clone());
   for (const auto& est : em.scalar_ests_)
     scalar_estimators_.emplace_back(est->clone());
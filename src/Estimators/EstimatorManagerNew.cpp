@@ -28,6 +28,7 @@
 #include "Message/CommUtilities.h"
 #include "Estimators/LocalEnergyEstimator.h"
 #include "Estimators/LocalEnergyOnlyEstimator.h"
+#include "Concurrency/BackgroundWorker.hpp"
 #include "Estimators/RMCLocalEnergyEstimator.h"
 #include "QMCDrivers/SimpleFixedNodeBranch.h"
 #include "QMCDrivers/WalkerProperties.h"
@@ -36,6 +37,7 @@
 #include "OhmmsData/AttributeSet.h"
 #include "Estimators/CSEnergyEstimator.h"
 #include "type_traits/variant_help.hpp"
+#include "MemoryAccounting.h"
 
 //leave it for serialization debug
 //#define DEBUG_ESTIMATOR_ARCHIVE
@@ -97,6 +99,7 @@ EstimatorManagerNew::EstimatorManagerNew(Communicate* c,
                                          const TrialWaveFunction& twf)
     : RecordCount(0), my_comm_(c), max4ascii(8), FieldWidth(20)
 {
+  ScopedMemoryTag estimator_memory(MemoryTag::ESTIMATOR);
   for (auto& est_input : emi.get_estimator_inputs())
     if (!(createEstimator<SpinDensityInput>(est_input, pset.getLattice(), pset.getSpeciesSet()) ||
           createEstimator<MomentumDistributionInput>(est_input, pset.getTotalNum(), pset.getTwist(),
@@ -231,15 +234,96 @@ void EstimatorManagerNew::startDriverRun()
     main_estimator_->registerObservables(h5desc, *h_file);
     for (int i = 0; i < scalar_ests_.size(); i++)
       scalar_ests_[i]->registerObservables(h5desc, *h_file);
+    // the distributed reduction writes the operator estimators to the node files instead
+    if (operator_reduction_ != OperatorReduction::DISTRIBUTED)
+      for (auto& uope : operator_ests_)
+        uope->registerOperatorEstimator(*h_file);
+    performance_h5desc_.clear();
+    performance_counters_.assign(performance_names_.size(), 0.0);
+    if (!performance_names_.empty())
+    {
+      performance_h5desc_.emplace_back(hdf_path{"driver_performance"});
+      performance_h5desc_.back().set_dimensions({static_cast<int>(performance_names_.size())}, 0);
+      performance_h5desc_.back().addProperty(performance_names_, "names", *h_file);
+    }
+  }
+
+  if (operator_reduction_ != OperatorReduction::FLAT)
+    makeReductionComms();
+  if (operator_reduction_ == OperatorReduction::DISTRIBUTED && isOperatorWriter() && !operator_ests_.empty())
+  {
+    std::array<char, 32> node_suffix;
+    if (std::snprintf(node_suffix.data(), node_suffix.size(), ".node%03d.stat.h5", leader_comm_->rank()) < 0)
+      throw std::runtime_error("Error generating filename");
+    node_h_file_ = std::make_unique<hdf_archive>();
+    node_h_file_->create(my_comm_->getName() + node_suffix.data());
     for (auto& uope : operator_ests_)
-      uope->registerOperatorEstimator(*h_file);
+      uope->registerOperatorEstimator(*node_h_file_);
+    // the node partial sums are normalized by the node weights, which are needed to combine the nodes
+    node_h5desc_.clear();
+    node_h5desc_.emplace_back(hdf_path{"walkers_weight"});
+    node_h5desc_.back().set_dimensions({static_cast<int>(operator_ests_.size())}, 0);
+  }
+
+  if (async_write_ && (h_file || node_h_file_))
+  {
+#ifdef H5_HAVE_THREADSAFE
+    block_writer_ = std::make_unique<BackgroundWorker>();
+    // HDF5 error printing is a per thread setting, suppress it on the writer thread as well
+    block_writer_->submit([] { H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr); });
+#else
+    app_warning() << "EstimatorManagerNew async writes require a thread-safe HDF5 library. "
+                  << "Block output is written synchronously." << std::endl;
+#endif
   }
 }
 
-void EstimatorManagerNew::stopDriverRun() { h_file.reset(); }
+void EstimatorManagerNew::stopDriverRun()
+{
+  flushWrites();
+  block_writer_.reset();
+  h_file.reset();
+  node_h_file_.reset();
+}
+
+void EstimatorManagerNew::flushWrites()
+{
+  if (!async_write_)
+    return;
+  // only the ranks writing files own a writer, the others must learn about its failure
+  // here instead of waiting for the failed rank in the next collective
+  std::string message;
+  int failed = 0;
+  if (block_writer_)
+    try
+    {
+      block_writer_->wait();
+    }
+    catch (const std::exception& e)
+    {
+      message = e.what();
+      failed  = 1;
+    }
+    catch (...)
+    {
+      message = "unknown error";
+      failed  = 1;
+    }
+  my_comm_->allreduce(failed);
+  if (failed)
+    throw UniformCommunicateError(std::string(error_tag_) + "writing the block output failed" +
+                                  (message.empty() ? " on another rank" : ": " + message));
+}
 
 void EstimatorManagerNew::startBlock(int steps) { block_timer_.restart(); }
 
+void EstimatorManagerNew::setBlockPerformance(const std::vector<RealType>& counters)
+{
+  if (counters.size() != performance_counters_.size())
+    throw std::runtime_error(std::string(error_tag_) + "block performance counters do not match the counter names");
+  performance_counters_ = counters;
+}
+
 void EstimatorManagerNew::stopBlock(unsigned long accept, unsigned long reject, RealType block_weight)
 {
   /* Need a redesign of how accept, reject and block_weight are handled from driver to this manager.
@@ -250,11 +334,30 @@ void EstimatorManagerNew::stopBlock(unsigned long accept, unsigned long reject,
   PropertyCache[weightInd] = block_weight;
   makeBlockAverages(accept, reject);
   reduceOperatorEstimators();
-  writeOperatorEstimators();
-  zeroOperatorEstimators();
-  // intentionally put after all the estimator I/O
-  PropertyCache[cpuInd] = block_timer_.elapsed();
-  writeScalarH5();
+  // the staged data of the previous block belongs to the writer until it is done
+  flushWrites();
+  if (block_writer_)
+  {
+    for (auto& op_est : operator_ests_)
+      op_est->stageWrite();
+    staged_operator_weights_ = operator_weights_;
+    zeroOperatorEstimators();
+    PropertyCache[cpuInd] = block_timer_.elapsed();
+    stageScalars();
+    block_writer_->submit([this] {
+      writeOperatorEstimators();
+      writeScalarH5();
+    });
+  }
+  else
+  {
+    writeOperatorEstimators();
+    zeroOperatorEstimators();
+    // intentionally put after all the estimator I/O
+    PropertyCache[cpuInd] = block_timer_.elapsed();
+    stageScalars();
+    writeScalarH5();
+  }
   RecordCount++;
 }
 
@@ -346,6 +449,14 @@ void EstimatorManagerNew::makeBlockAverages(unsigned long accepts, unsigned long
   varAccumulator(AverageCache[1]);
 }
 
+void EstimatorManagerNew::stageScalars()
+{
+  staged_averages_.assign(AverageCache.begin(), AverageCache.end());
+  staged_properties_.assign(PropertyCache.begin(), PropertyCache.end());
+  staged_performance_counters_ = performance_counters_;
+  staged_record_count_ = RecordCount;
+}
+
 void EstimatorManagerNew::writeScalarH5()
 {
   //Do not assume h_file is valid
@@ -353,75 +464,106 @@ void EstimatorManagerNew::writeScalarH5()
   {
     for (int o = 0; o < h5desc.size(); ++o)
       // cheating here, remove SquaredAverageCache from API
-      h5desc[o].write(AverageCache.data(), *h_file);
+      h5desc[o].write(staged_averages_.data(), *h_file);
+    for (auto& h5d : performance_h5desc_)
+      h5d.write(staged_performance_counters_.data(), *h_file);
     h_file->flush();
   }
 
   if (Archive)
   {
-    *Archive << std::setw(10) << RecordCount;
+    *Archive << std::setw(10) << staged_record_count_;
     int maxobjs = std::min(BlockAverages.size(), max4ascii);
     for (int j = 0; j < maxobjs; j++)
-      *Archive << std::setw(FieldWidth) << AverageCache[j];
-    for (int j = 0; j < PropertyCache.size(); j++)
-      *Archive << std::setw(FieldWidth) << PropertyCache[j];
+      *Archive << std::setw(FieldWidth) << staged_averages_[j];
+    for (int j = 0; j < staged_properties_.size(); j++)
+      *Archive << std::setw(FieldWidth) << staged_properties_[j];
     *Archive << std::endl;
   }
 }
 
+void EstimatorManagerNew::makeReductionComms()
+{
+  if (node_comm_)
+    return;
+  // rank 0 of my_comm_ is also rank 0 of its node and of the node leaders
+  node_comm_.reset(new Communicate(my_comm_->NodeComm()));
+#ifdef HAVE_MPI
+  leader_comm_ = std::make_unique<Communicate>(my_comm_->comm.split(node_comm_->rank() == 0 ? 0 : 1, my_comm_->rank()));
+#else
+  leader_comm_ = std::make_unique<Communicate>();
+#endif
+}
+
+bool EstimatorManagerNew::isOperatorWriter() const
+{
+  if (operator_reduction_ == OperatorReduction::DISTRIBUTED)
+    return node_comm_ && node_comm_->rank() == 0;
+  return my_comm_->rank() == 0;
+}
+
 void EstimatorManagerNew::reduceOperatorEstimators()
 {
-  if (operator_ests_.size() > 0)
+  if (operator_ests_.empty())
+    return;
+  // 1 larger per estimator because we put the weight in to avoid dependence of the Scalar estimators being reduced first.
+  size_t buffer_size = 0;
+  for (auto& op_est : operator_ests_)
+    buffer_size += op_est->get_data().size() + 1;
+  operator_buffer_.resize(buffer_size);
+  auto cur = operator_buffer_.begin();
+  for (auto& op_est : operator_ests_)
   {
-    std::vector<size_t> operator_data_sizes(operator_ests_.size());
-    RefVector<OperatorEstBase> ref_op_ests = convertUPtrToRefVector(operator_ests_);
-    for (int iop = 0; iop < operator_data_sizes.size(); ++iop)
-    {
-      operator_data_sizes[iop] = operator_ests_[iop]->get_data().size();
-    }
-    // 1 larger because we put the weight in to avoid dependence of the Scalar estimators being reduced firt.
-    size_t nops = *(std::max_element(operator_data_sizes.begin(), operator_data_sizes.end())) + 1;
-    std::vector<RealType> operator_send_buffer;
-    std::vector<RealType> operator_recv_buffer;
-    operator_send_buffer.reserve(nops);
-    operator_recv_buffer.reserve(nops);
-    for (int iop = 0; iop < operator_ests_.size(); ++iop)
-    {
-      auto& estimator      = *operator_ests_[iop];
-      auto& data           = estimator.get_data();
-      size_t adjusted_size = data.size() + 1;
-      operator_send_buffer.resize(adjusted_size, 0.0);
-      operator_recv_buffer.resize(adjusted_size, 0.0);
-      std::copy_n(data.begin(), data.size(), operator_send_buffer.begin());
-      operator_send_buffer[data.size()] = estimator.get_walkers_weight();
-      // This is necessary to use mpi3's C++ style reduce
+    auto& data = op_est->get_data();
+    cur        = std::copy(data.begin(), data.end(), cur);
+    *cur++     = op_est->get_walkers_weight();
+  }
+
+  if (operator_reduction_ != OperatorReduction::FLAT)
+    makeReductionComms();
+  // This is necessary to use mpi3's C++ style reduce
 #ifdef HAVE_MPI
-      my_comm_->comm.reduce_n(operator_send_buffer.begin(), adjusted_size, operator_recv_buffer.begin(), std::plus<>{},
-                              0);
-#else
-      operator_recv_buffer = operator_send_buffer;
+  if (operator_reduction_ == OperatorReduction::FLAT)
+    my_comm_->comm.reduce_in_place_n(operator_buffer_.begin(), operator_buffer_.size(), std::plus<>{});
+  else
+  {
+    // a plain reduction over the node communicator, only the node leaders communicate over the network
+    node_comm_->comm.reduce_in_place_n(operator_buffer_.begin(), operator_buffer_.size(), std::plus<>{});
+    if (operator_reduction_ == OperatorReduction::HIERARCHICAL && node_comm_->rank() == 0)
+      leader_comm_->comm.reduce_in_place_n(operator_buffer_.begin(), operator_buffer_.size(), std::plus<>{});
+  }
 #endif
-      if (my_comm_->rank() == 0)
-      {
-        std::copy_n(operator_recv_buffer.begin(), data.size(), data.begin());
-        size_t reduced_walker_weights = operator_recv_buffer[data.size()];
-        RealType invTotWgt            = 1.0 / static_cast<QMCT::RealType>(reduced_walker_weights);
-        operator_ests_[iop]->normalize(invTotWgt);
-      }
+
+  if (isOperatorWriter())
+  {
+    operator_weights_.resize(operator_ests_.size());
+    auto cur = operator_buffer_.cbegin();
+    for (int iop = 0; iop < operator_ests_.size(); ++iop)
+    {
+      auto& data = operator_ests_[iop]->get_data();
+      std::copy_n(cur, data.size(), data.begin());
+      cur += data.size();
+      operator_weights_[iop] = *cur++;
+      // walker weights are not integers in DMC
+      RealType invTotWgt = 1.0 / static_cast<RealType>(operator_weights_[iop]);
+      operator_ests_[iop]->normalize(invTotWgt);
     }
   }
 }
 
 void EstimatorManagerNew::writeOperatorEstimators()
 {
-  if (my_comm_->rank() == 0)
+  hdf_archive* file = operator_reduction_ == OperatorReduction::DISTRIBUTED ? node_h_file_.get() : h_file.get();
+  if (file)
   {
-    if (h_file)
-    {
-      for (auto& op_est : operator_ests_)
-        op_est->write(*h_file);
-      h_file->flush();
-    }
+    for (auto& op_est : operator_ests_)
+      if (block_writer_)
+        op_est->writeStaged(*file);
+      else
+        op_est->write(*file);
+    for (auto& h5d : node_h5desc_)
+      h5d.write(block_writer_ ? staged_operator_weights_.data() : operator_weights_.data(), *file);
+    file->flush();
   }
 }
 
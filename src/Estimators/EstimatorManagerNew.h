@@ -30,6 +30,7 @@ namespace qmcplusplus
 {
 class QMCHamiltonian;
 class hdf_archive;
+class BackgroundWorker;
 
 namespace testing
 {
@@ -53,6 +54,14 @@ public:
   using FPRBuffer = std::vector<FullPrecRealType>;
   using MCPWalker = Walker<QMCTraits, PtclOnLatticeTraits>;
 
+  /// how the operator estimator data is reduced over the ranks at the end of a block
+  enum class OperatorReduction
+  {
+    FLAT,         ///< reduce over all the ranks to rank 0
+    HIERARCHICAL, ///< reduce within each node, then over the node leaders to rank 0
+    DISTRIBUTED   ///< reduce within each node only, each node leader writes the partial sums of its node
+  };
+
   ///default constructor
   EstimatorManagerNew(const QMCHamiltonian& ham, Communicate* comm);
   ///copy constructor, deleted
@@ -112,6 +121,32 @@ public:
    */
   void stopBlock(unsigned long accept, unsigned long reject, RealType block_weight);
 
+  /** write block output on a background thread, takes effect at the next startDriverRun
+   *
+   *  The reduced block data is staged and written while the next block runs.
+   *  Falls back to synchronous writes if HDF5 is not thread-safe.
+   */
+  void setAsyncWrite(bool async_write) { async_write_ = async_write; }
+
+  /** wait until the output of the previous block is written, e.g. before a checkpoint
+   *
+   *  Collective over the ranks when writing asynchronously: a failed write on any rank
+   *  throws UniformCommunicateError on all of them.
+   */
+  void flushWrites();
+
+  /// select the rank reduction of the operator estimators, takes effect at the next startDriverRun
+  void setOperatorReduction(OperatorReduction reduction) { operator_reduction_ = reduction; }
+
+  /// name the driver performance counters written to driver_performance in stat.h5, takes effect at the next startDriverRun
+  void setPerformanceCounterNames(const std::vector<std::string>& names) { performance_names_ = names; }
+
+  /** set the driver performance counters of the current block, written by the next stopBlock
+   *
+   *  Only meaningful on rank 0 and in the order of setPerformanceCounterNames.
+   */
+  void setBlockPerformance(const std::vector<RealType>& counters);
+
   /** At end of block collect the main scalar estimators for the entire rank
    *
    *  One per crowd over multiple walkers
@@ -189,6 +224,9 @@ private:
   /// write scalars to scalar.dat and h5
   void writeScalarH5();
 
+  /// copy the block averages for writeScalarH5
+  void stageScalars();
+
   /** do the rank wise reduction of the OperatorEstimators
    *
    *  Why do this here?
@@ -199,13 +237,20 @@ private:
    *     the requirement that get_data_ref() returns a reference to
    *     std::vector<RealType>
    *
-   *  Implementation makes the assumption that sending each OperatorEstimator
-   *  separately is the correct memory use vs. mpi message balance.
+   *  All the estimators and their walker weights are packed into one buffer
+   *  so that a block costs a single reduction per communicator level.
+   *  See OperatorReduction for the communication patterns.
    */
   void reduceOperatorEstimators();
+  /// create the node and node leader communicators used by the non flat reductions
+  void makeReductionComms();
+  /// true if this rank holds reduced operator estimator data to write
+  bool isOperatorWriter() const;
   /** Write OperatorEstimator data to *.stat.h5
    *
    *  Note that OperatorEstimator owns its own observable_helpers
+   *  With async writes the data staged by OperatorEstBase::stageWrite is written.
+   *  With the distributed reduction every node leader writes to its own *.node<n>.stat.h5
    */
   void writeOperatorEstimators();
   /** OperatorEstimators need to be zeroed out after the block is finished.
@@ -222,6 +267,8 @@ private:
   int acceptRatioInd;
   ///hdf5 handler
   std::unique_ptr<hdf_archive> h_file;
+  ///hdf5 handler of the node partial sums for OperatorReduction::DISTRIBUTED
+  std::unique_ptr<hdf_archive> node_h_file_;
   ///file handler to write data
   std::unique_ptr<std::ofstream> Archive;
   ///file handler to write data for debugging
@@ -273,6 +320,36 @@ private:
 
   static constexpr std::string_view error_tag_{"EstimatorManagerNew "};
 
+  OperatorReduction operator_reduction_ = OperatorReduction::FLAT;
+  /// ranks sharing memory with this rank, only set up for the non flat reductions
+  std::unique_ptr<Communicate> node_comm_;
+  /// rank 0 of every node_comm_, only meaningful on the node leaders
+  std::unique_ptr<Communicate> leader_comm_;
+  /// operator estimator data followed by its walker weight for every estimator
+  std::vector<RealType> operator_buffer_;
+  /// reduced walker weight of every operator estimator, written with the node partial sums
+  std::vector<RealType> operator_weights_;
+  std::vector<RealType> staged_operator_weights_;
+  /// hdf5 descriptor of operator_weights_ in node_h_file_
+  std::vector<ObservableHelper> node_h5desc_;
+
+  /// names and current values of the driver performance counters
+  std::vector<std::string> performance_names_;
+  std::vector<RealType> performance_counters_;
+  std::vector<RealType> staged_performance_counters_;
+  /// hdf5 descriptor of performance_counters_ in h_file
+  std::vector<ObservableHelper> performance_h5desc_;
+
+  /// block averages, properties and record index being written
+  std::vector<RealType> staged_averages_;
+  std::vector<RealType> staged_properties_;
+  int staged_record_count_ = 0;
+  bool async_write_        = false;
+  /** writes block output while the next block runs, only on the rank writing files
+   *  declared last so its outstanding task finishes before the members it writes are destroyed
+   */
+  std::unique_ptr<BackgroundWorker> block_writer_;
+
   friend class EstimatorManagerCrowd;
   friend class qmcplusplus::testing::EstimatorManagerNewTest;
   friend class qmcplusplus::testing::EstimatorManagerNewTestAccess;
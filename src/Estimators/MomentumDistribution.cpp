@@ -11,7 +11,9 @@
 
 #include "MomentumDistribution.h"
 #include "CPU/e2iphi.h"
+#include "CPU/BLAS.hpp"
 #include "TrialWaveFunction.h"
+#include "QMCHamiltonians/NLPPJob.h"
 
 #include <iostream>
 #include <numeric>
@@ -30,8 +32,6 @@ MomentumDistribution::MomentumDistribution(MomentumDistributionInput&& mdi,
       Lattice(lattice),
       norm_nofK(1.0 / RealType(mdi.get_samples()))
 {
-  psi_ratios.resize(np);
-
   my_name_ = input_.get_name();
 
   //dims of a grid for generating k points (obtained below)
@@ -159,12 +159,11 @@ MomentumDistribution::MomentumDistribution(MomentumDistributionInput&& mdi,
   nofK.resize(kPoints.size());
   kdotp.resize(kPoints.size());
   auto samples = input_.get_samples();
-  vPos.resize(samples);
   phases.resize(kPoints.size());
-  phases_vPos.resize(samples);
-  for (int im = 0; im < samples; im++)
-    phases_vPos[im].resize(kPoints.size());
-  psi_ratios_all.resize(samples, psi_ratios.size());
+  phases_vPos.resize(samples, 2 * kPoints.size());
+  ratio_phases_c.resize(np, 2 * kPoints.size());
+  if constexpr (IsComplex_t<ValueType>::value)
+    ratio_phases_s.resize(np, 2 * kPoints.size());
 
   // allocate data storage
   size_t data_size = nofK.size();
@@ -238,39 +237,118 @@ void MomentumDistribution::accumulate(const RefVector<MCPWalker>& walkers,
                                       const RefVector<QMCHamiltonian>& hams,
                                       RandomBase<FullPrecRealType>& rng)
 {
-  for (int iw = 0; iw < walkers.size(); ++iw)
-  {
-    MCPWalker& walker      = walkers[iw];
-    ParticleSet& pset      = psets[iw];
-    TrialWaveFunction& psi = wfns[iw];
-    RealType weight        = walker.Weight;
+  const int nw = walkers.size();
+  if (nw == 0)
+    return;
+  constexpr bool is_complex = IsComplex_t<ValueType>::value;
 
-    const int np = pset.getTotalNum();
-    const int nk = kPoints.size();
+  const int np      = psets[0].get().getTotalNum();
+  const int nk      = kPoints.size();
+  const int samples = input_.get_samples();
 
-    // accumulate weight
-    //  (required by all estimators, otherwise inf results)
-    walkers_weight_ += weight;
+  if (mw_vPos.size() != nw)
+  {
+    mw_vPos.resize(nw, std::vector<PosType>(samples));
+    mw_deltaV.resize(nw, std::vector<PosType>(samples));
+    mw_psi_ratios.resize(nw, std::vector<ValueType>(samples));
+    mw_ratios_c.resize(nw, Matrix<RealType>(np, samples));
+    if constexpr (is_complex)
+      mw_ratios_s.resize(nw, Matrix<RealType>(np, samples));
+  }
 
-    auto samples = input_.get_samples();
-    // compute phase factors
+  // sample positions, drawn walker by walker
+  for (int iw = 0; iw < nw; ++iw)
     for (int s = 0; s < samples; ++s)
     {
       PosType newpos;
       for (int i = 0; i < OHMMS_DIM; ++i)
         newpos[i] = rng();
       //make it cartesian
-      vPos[s] = Lattice.toCart(newpos);
-      pset.makeVirtualMoves(vPos[s]);
-      psi.evaluateRatiosAlltoOne(pset, psi_ratios);
-      for (int i = 0; i < np; ++i)
-        psi_ratios_all[s][i] = psi_ratios[i];
+      mw_vPos[iw][s] = Lattice.toCart(newpos);
+    }
+
+  // ratios of moving each electron to all the samples, all the walkers at once
+  {
+    auto& vps = walker_vps_.vps;
+    while (vps.size() < nw)
+      vps.push_back(std::make_unique<VirtualParticleSet>(psets[0], samples));
+    if (!walker_vps_.vp_res)
+    {
+      walker_vps_.vp_res = std::make_unique<ResourceCollection>("MomentumDistribution VPs");
+      vps[0]->createResource(*walker_vps_.vp_res);
+    }
+
+    RefVectorWithLeader<ParticleSet> p_list(psets[0]);
+    RefVectorWithLeader<TrialWaveFunction> wf_list(wfns[0]);
+    for (int iw = 0; iw < nw; ++iw)
+    {
+      p_list.push_back(psets[iw]);
+      wf_list.push_back(wfns[iw]);
+    }
+    RefVectorWithLeader<VirtualParticleSet> vp_list(*vps[0]);
+    RefVectorWithLeader<const VirtualParticleSet> const_vp_list(*vps[0]);
+    RefVector<const std::vector<PosType>> deltaV_list;
+    RefVector<std::vector<ValueType>> ratios_list;
+    for (int iw = 0; iw < nw; ++iw)
+    {
+      vp_list.push_back(*vps[iw]);
+      const_vp_list.push_back(*vps[iw]);
+      deltaV_list.push_back(mw_deltaV[iw]);
+      ratios_list.push_back(mw_psi_ratios[iw]);
+    }
 
+    ResourceCollectionTeamLock<VirtualParticleSet> vp_res_lock(*walker_vps_.vp_res, vp_list);
+
+    for (int i = 0; i < np; ++i)
+    {
+      std::vector<NLPPJob<RealType>> jobs;
+      jobs.reserve(nw);
+      for (int iw = 0; iw < nw; ++iw)
+      {
+        const PosType& r_i = psets[iw].get().R[i];
+        for (int s = 0; s < samples; ++s)
+          mw_deltaV[iw][s] = mw_vPos[iw][s] - r_i;
+        jobs.emplace_back(-1, i, 0, PosType());
+      }
+      VirtualParticleSet::mw_makeMoves(vp_list, p_list, deltaV_list, makeRefVector<const NLPPJob<RealType>>(jobs),
+                                       false);
+      TrialWaveFunction::mw_evaluateRatios(wf_list, const_vp_list, ratios_list);
+      for (int iw = 0; iw < nw; ++iw)
+        for (int s = 0; s < samples; ++s)
+        {
+          const ComplexType one_ratio(mw_psi_ratios[iw][s]);
+          mw_ratios_c[iw][i][s] = one_ratio.real();
+          if constexpr (is_complex)
+            mw_ratios_s[iw][i][s] = one_ratio.imag();
+        }
+    }
+  }
+
+  for (int iw = 0; iw < nw; ++iw)
+  {
+    MCPWalker& walker = walkers[iw];
+    ParticleSet& pset = psets[iw];
+    RealType weight   = walker.Weight;
+
+    // accumulate weight
+    //  (required by all estimators, otherwise inf results)
+    walkers_weight_ += weight;
+
+    // compute phase factors
+    for (int s = 0; s < samples; ++s)
+    {
       for (int ik = 0; ik < nk; ++ik)
-        kdotp[ik] = -dot(kPoints[ik], vPos[s]);
-      eval_e2iphi(nk, kdotp.data(), phases_vPos[s].data(0), phases_vPos[s].data(1));
+        kdotp[ik] = -dot(kPoints[ik], mw_vPos[iw][s]);
+      eval_e2iphi(nk, kdotp.data(), phases_vPos[s], phases_vPos[s] + nk);
     }
 
+    // sum over samples of ratio x e^{-ik.vPos}, row major particles x [cos | sin]
+    BLAS::gemm('N', 'N', 2 * nk, np, samples, RealType(1), phases_vPos.data(), 2 * nk, mw_ratios_c[iw].data(),
+               samples, RealType(0), ratio_phases_c.data(), 2 * nk);
+    if constexpr (is_complex)
+      BLAS::gemm('N', 'N', 2 * nk, np, samples, RealType(1), phases_vPos.data(), 2 * nk, mw_ratios_s[iw].data(),
+                 samples, RealType(0), ratio_phases_s.data(), 2 * nk);
+
     // update n(k)
     std::fill_n(nofK.begin(), nk, RealType(0));
     for (int i = 0; i < np; ++i)
@@ -278,20 +356,19 @@ void MomentumDistribution::accumulate(const RefVector<MCPWalker>& walkers,
       for (int ik = 0; ik < nk; ++ik)
         kdotp[ik] = dot(kPoints[ik], pset.R[i]);
       eval_e2iphi(nk, kdotp.data(), phases.data(0), phases.data(1));
-      for (int s = 0; s < samples; ++s)
+      const RealType* restrict phases_c = phases.data(0);
+      const RealType* restrict phases_s = phases.data(1);
+      const RealType* restrict rp_cc    = ratio_phases_c[i];
+      const RealType* restrict rp_cs    = ratio_phases_c[i] + nk;
+      RealType* restrict nofK_here      = nofK.data();
+      for (int ik = 0; ik < nk; ++ik)
+        nofK_here[ik] += phases_c[ik] * rp_cc[ik] - phases_s[ik] * rp_cs[ik];
+      if constexpr (is_complex)
       {
-        const ComplexType one_ratio(psi_ratios_all[s][i]);
-        const RealType ratio_c                 = one_ratio.real();
-        const RealType ratio_s                 = one_ratio.imag();
-        const RealType* restrict phases_c      = phases.data(0);
-        const RealType* restrict phases_s      = phases.data(1);
-        const RealType* restrict phases_vPos_c = phases_vPos[s].data(0);
-        const RealType* restrict phases_vPos_s = phases_vPos[s].data(1);
-        RealType* restrict nofK_here           = nofK.data();
-#pragma omp simd aligned(nofK_here, phases_c, phases_s, phases_vPos_c, phases_vPos_s : QMC_SIMD_ALIGNMENT)
+        const RealType* restrict rp_sc = ratio_phases_s[i];
+        const RealType* restrict rp_ss = ratio_phases_s[i] + nk;
         for (int ik = 0; ik < nk; ++ik)
-          nofK_here[ik] += (phases_c[ik] * phases_vPos_c[ik] - phases_s[ik] * phases_vPos_s[ik]) * ratio_c -
-              (phases_s[ik] * phases_vPos_c[ik] + phases_c[ik] * phases_vPos_s[ik]) * ratio_s;
+          nofK_here[ik] -= phases_s[ik] * rp_sc[ik] + phases_c[ik] * rp_ss[ik];
       }
     }
 
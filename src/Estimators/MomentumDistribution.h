@@ -17,6 +17,8 @@
 #include "Configuration.h"
 #include "OperatorEstBase.h"
 #include "Containers/OhmmsPETE/TinyVector.h"
+#include "Particle/VirtualParticleSet.h"
+#include <ResourceCollection.h>
 
 #include "MomentumDistributionInput.h"
 
@@ -55,21 +57,44 @@ public:
 
   /** @ingroup MomentumDistribution mutable data members
    */
-  ///sample positions
-  std::vector<PosType> vPos;
-  ///wavefunction ratios
-  std::vector<ValueType> psi_ratios;
-  ///wavefunction ratios all samples
-  Matrix<ValueType> psi_ratios_all;
+  ///sample positions of each walker
+  std::vector<std::vector<PosType>> mw_vPos;
+  ///displacements from the moved electron to the sample positions of each walker
+  std::vector<std::vector<PosType>> mw_deltaV;
+  ///wavefunction ratios of each walker for the samples of one electron
+  std::vector<std::vector<ValueType>> mw_psi_ratios;
+  ///real part of the wavefunction ratios of each walker, particles x samples
+  std::vector<Matrix<RealType>> mw_ratios_c;
+  ///imaginary part of the wavefunction ratios of each walker, only used by complex builds
+  std::vector<Matrix<RealType>> mw_ratios_s;
   ///nofK internal
   Vector<RealType> kdotp;
   ///phases
   VectorSoaContainer<RealType, 2> phases;
-  ///phases of vPos
-  std::vector<VectorSoaContainer<RealType, 2>> phases_vPos;
+  ///phases of vPos, samples x [cos(-k.vPos) | sin(-k.vPos)]
+  Matrix<RealType> phases_vPos;
+  ///real ratios times phases of vPos, particles x [cos | sin]
+  Matrix<RealType> ratio_phases_c;
+  ///imaginary ratios times phases of vPos, particles x [cos | sin]
+  Matrix<RealType> ratio_phases_s;
   ///nofK
   aligned_vector<RealType> nofK;
 
+  /** virtual particle sets of the walkers and their shared resource
+   *
+   *  Created by the first accumulate and reused by the later ones.
+   *  A spawned crowd clone starts without them.
+   */
+  struct WalkerVPs
+  {
+    std::vector<std::unique_ptr<VirtualParticleSet>> vps;
+    std::unique_ptr<ResourceCollection> vp_res;
+
+    WalkerVPs() = default;
+    WalkerVPs(const WalkerVPs&) {}
+  };
+  WalkerVPs walker_vps_;
+
 public:
   /** Constructor for MomentumDistributionInput 
    */
@@ -94,6 +119,11 @@ public:
   std::unique_ptr<OperatorEstBase> spawnCrowdClone() const override;
 
   /** accumulate 1 or more walkers of MomentumDistribution samples
+   *
+   *  The displaced electron positions of all the walkers are handled by VirtualParticleSets
+   *  and their ratios computed with TrialWaveFunction::mw_evaluateRatios, so the caller
+   *  must have acquired the crowd resources of the trial wavefunctions.
+   *  The sum of phase factors over samples is done as a GEMM per walker.
    */
   void accumulate(const RefVector<MCPWalker>& walkers,
                   const RefVector<ParticleSet>& psets,
@@ -133,7 +133,7 @@ OneBodyDensityMatrices::OneBodyDensityMatrices(OneBodyDensityMatricesInput&& obd
   samples_weights_.resize(samples_);
   psi_ratios_.resize(nparticles);
 
-  if (input_.get_evaluator() == Evaluator::MATRIX)
+  if (input_.get_evaluator() == Evaluator::MATRIX || input_.get_evaluator() == Evaluator::BATCHED)
   {
     Phi_MB_.resize(samples_, basis_size_);
     Phi_NB_.reserve(nspecies);
@@ -148,6 +148,13 @@ OneBodyDensityMatrices::OneBodyDensityMatrices(OneBodyDensityMatricesInput&& obd
       Phi_Psi_NB_.emplace_back(specs_size, basis_size_);
       N_BB_.emplace_back(basis_size_, basis_size_);
     }
+    if (input_.get_evaluator() == Evaluator::BATCHED)
+    {
+      // sized by the number of walkers at the first accumulate
+      Psi_WNM_.resize(nspecies);
+      Phi_WNB_.resize(nspecies);
+      Phi_Psi_WNB_.resize(nspecies);
+    }
   }
 
   if (sampling_ == Sampling::METROPOLIS)
@@ -540,6 +547,13 @@ void OneBodyDensityMatrices::implAccumulate(const RefVector<MCPWalker>& walkers,
                                             const RefVector<TrialWaveFunction>& wfns,
                                             RandomBase<FullPrecReal>& rng)
 {
+  if (input_.get_evaluator() == Evaluator::BATCHED)
+  {
+    for (int iw = 0; iw < walkers.size(); ++iw)
+      walkers_weight_ += walkers[iw].get().Weight;
+    evaluateMatrixBatched(walkers, psets, wfns, rng);
+    return;
+  }
   for (int iw = 0; iw < walkers.size(); ++iw)
   {
     walkers_weight_ += walkers[iw].get().Weight;
@@ -579,24 +593,80 @@ void OneBodyDensityMatrices::evaluateMatrix(ParticleSet& pset_target,
     }
   }
   // accumulate data for this walker
+  accumulateNBB();
+}
+
+void OneBodyDensityMatrices::evaluateMatrixBatched(const RefVector<MCPWalker>& walkers,
+                                                   const RefVector<ParticleSet>& psets,
+                                                   const RefVector<TrialWaveFunction>& wfns,
+                                                   RandomBase<FullPrecReal>& rng)
+{
+  const int num_walkers = walkers.size();
+  if (num_walkers == 0)
+    return;
+  ParticleSet& pset_leader = psets[0];
+  //perform warmup sampling the first time
+  warmupSampling(pset_leader, rng);
+  // one set of sample positions for the crowd, walker weights are applied below
+  generateSamples(1.0, pset_leader, rng);
+  generateSampleBasis(Phi_MB_, pset_leader, wfns[0]); // basis : samples x basis_size
+
+  for (int s = 0; s < species_.size(); ++s)
+    if (Psi_WNM_[s].rows() != num_walkers * species_sizes_[s])
+    {
+      Psi_WNM_[s].resize(num_walkers * species_sizes_[s], samples_);
+      Phi_WNB_[s].resize(num_walkers * species_sizes_[s], basis_size_);
+      Phi_Psi_WNB_[s].resize(num_walkers * species_sizes_[s], basis_size_);
+    }
+
+  for (int iw = 0; iw < num_walkers; ++iw)
   {
-    ScopedTimer local_timer(timers_.accumulate_timer);
-    const int basis_size_sq = basis_size_ * basis_size_;
-    int ij                  = 0;
+    const Real weight = walkers[iw].get().Weight * metric_;
+    generateSampleRatios(psets[iw], wfns[iw], Psi_NM_); // conj(Psi ratio) : particles x samples
+    generateParticleBasis(psets[iw], Phi_NB_);          // conj(basis)     : particles x basis_size
     for (int s = 0; s < species_.size(); ++s)
     {
-      //int ij=nindex; // for testing
-      const Matrix<Value>& NDM = N_BB_[s];
-      for (int n = 0; n < basis_size_sq; ++n)
+      const int row_offset = iw * species_sizes_[s];
+      for (int n = 0; n < species_sizes_[s]; ++n)
       {
-        Value val = NDM(n);
-        data_[ij] += real(val);
-        ij++;
+        Value* restrict psi_wnm    = Psi_WNM_[s][row_offset + n];
+        const Value* restrict psi_nm = Psi_NM_[s][n];
+        for (int m = 0; m < samples_; ++m)
+          psi_wnm[m] = weight * samples_weights_[m] * psi_nm[m];
+        std::copy_n(Phi_NB_[s][n], basis_size_, Phi_WNB_[s][row_offset + n]);
+      }
+    }
+  }
+
+  {
+    ScopedTimer local_timer(timers_.matrix_products_timer);
+    for (int s = 0; s < species_.size(); ++s)
+    {
+      product(Psi_WNM_[s], Phi_MB_, Phi_Psi_WNB_[s]);      // ratio*basis : (walkers x particles) x basis_size
+      product_AtB(Phi_WNB_[s], Phi_Psi_WNB_[s], N_BB_[s]); // sum over walkers of conj(basis)^T*ratio*basis
+    }
+  }
+  accumulateNBB();
+}
+
+void OneBodyDensityMatrices::accumulateNBB()
+{
+  ScopedTimer local_timer(timers_.accumulate_timer);
+  const int basis_size_sq = basis_size_ * basis_size_;
+  int ij                  = 0;
+  for (int s = 0; s < species_.size(); ++s)
+  {
+    //int ij=nindex; // for testing
+    const Matrix<Value>& NDM = N_BB_[s];
+    for (int n = 0; n < basis_size_sq; ++n)
+    {
+      Value val = NDM(n);
+      data_[ij] += real(val);
+      ij++;
 #if defined(QMC_COMPLEX)
-        data_[ij] += imag(val);
-        ij++;
+      data_[ij] += imag(val);
+      ij++;
 #endif
-      }
     }
   }
 }
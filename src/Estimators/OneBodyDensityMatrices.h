@@ -122,6 +122,12 @@ private:
    *  size: samples * basis_size
    */
   Matrix<Value> Phi_MB_;
+  /** Psi_NM_, Phi_NB_ and Phi_Psi_NB_ of all the walkers of the crowd stacked by row
+   *  only used by Evaluator::BATCHED
+   *  size: (walkers * particles) * samples or (walkers * particles) * basis_size
+   *  vector is over species
+   */
+  std::vector<Matrix<Value>> Psi_WNM_, Phi_WNB_, Phi_Psi_WNB_;
   /** @} */
 
   /** @ingroup DensityIntegration only used for density integration
@@ -212,6 +218,17 @@ private:
                       TrialWaveFunction& psi_target,
                       const MCPWalker& walker,
                       RandomBase<FullPrecReal>& rng);
+  /** evaluateMatrix for all the walkers of a crowd at once
+   *  One sample set and its basis values are generated per call and shared by all the walkers.
+   *  The weighted ratios and particle basis values of the walkers are stacked so each species
+   *  needs a single product and product_AtB, the latter summing over the walkers.
+   */
+  void evaluateMatrixBatched(const RefVector<MCPWalker>& walkers,
+                             const RefVector<ParticleSet>& psets,
+                             const RefVector<TrialWaveFunction>& wfns,
+                             RandomBase<FullPrecReal>& rng);
+  /// add N_BB_ of all species to data_
+  void accumulateNBB();
   //  sample generation
   /** Dispatch method to difference methods of generating samples.
    *  dispatch determined by Integrator.
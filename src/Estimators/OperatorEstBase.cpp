@@ -39,7 +39,17 @@ void OperatorEstBase::normalize(QMCT::RealType invTotWgt)
     elem *= invTotWgt;
 }
 
-void OperatorEstBase::write(hdf_archive& file)
+void OperatorEstBase::write(hdf_archive& file) { writeData(data_, file); }
+
+void OperatorEstBase::stageWrite()
+{
+  staged_data_.swap(data_);
+  data_.resize(staged_data_.size());
+}
+
+void OperatorEstBase::writeStaged(hdf_archive& file) { writeData(staged_data_, file); }
+
+void OperatorEstBase::writeData(const Data& data, hdf_archive& file)
 {
   if (h5desc_.empty())
     return;
@@ -47,16 +57,16 @@ void OperatorEstBase::write(hdf_archive& file)
     // collectables in mixed precision were accumulated in float but always written
     // to hdf5 in double.
 #ifdef MIXED_PRECISION
-  std::vector<QMCT::FullPrecRealType> expanded_data(data_.size(), 0.0);
-  std::copy_n(data_.begin(), data_.size(), expanded_data.begin());
-  assert(!data_.empty());
-  // auto total = std::accumulate(data_->begin(), data_->end(), 0.0);
-  // std::cout << "data size: " << data_->size() << " : " << total << '\n';
+  std::vector<QMCT::FullPrecRealType> expanded_data(data.size(), 0.0);
+  std::copy_n(data.begin(), data.size(), expanded_data.begin());
+  assert(!data.empty());
+  // auto total = std::accumulate(data->begin(), data->end(), 0.0);
+  // std::cout << "data size: " << data->size() << " : " << total << '\n';
   for (auto& h5d : h5desc_)
     h5d.write(expanded_data.data(), file);
 #else
   for (auto& h5d : h5desc_)
-    h5d.write(data_.data(), file);
+    h5d.write(data.data(), file);
 #endif
   file.pop();
 }
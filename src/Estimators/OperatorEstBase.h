@@ -110,6 +110,15 @@ public:
    */
   void write(hdf_archive& file);
 
+  /** Move the block data into the write buffer, data_ keeps its size and must be zeroed before reuse.
+   *
+   *  This lets writeStaged run on another thread while data_ accumulates the next block.
+   */
+  void stageWrite();
+
+  /// write the data moved aside by stageWrite
+  void writeStaged(hdf_archive& file);
+
   /** zero data appropriately for the DataLocality
    */
   void zero();
@@ -156,9 +165,14 @@ protected:
   std::vector<ObservableHelper> h5desc_;
 
   Data data_;
+  /// block data being written, see stageWrite
+  Data staged_data_;
 
   bool requires_listener_ = false;
 
+private:
+  void writeData(const Data& data, hdf_archive& file);
+
   friend testing::OEBAccessor;
 };
 } // namespace qmcplusplus
@@ -22,8 +22,17 @@ PerParticleHamiltonianLogger::PerParticleHamiltonianLogger(PerParticleHamiltonia
   requires_listener_ = true;
   my_name_           = "PerParticleHamiltonianLogger";
 
-  std::string filename("rank_" + std::to_string(rank_) + "_" + input_.get_name() + ".dat");
-  rank_fstream_.open(filename, std::ios::out);
+  if (input_.get_format() == PerParticleHamiltonianLoggerInput::Format::HDF5)
+  {
+    std::string filename("rank_" + std::to_string(rank_) + "_" + input_.get_name() + ".h5");
+    if (!rank_hdf_.create(filename))
+      throw std::runtime_error("PerParticleHamiltonianLogger failed to create " + filename);
+  }
+  else
+  {
+    std::string filename("rank_" + std::to_string(rank_) + "_" + input_.get_name() + ".dat");
+    rank_fstream_.open(filename, std::ios::out);
+  }
 }
 
 PerParticleHamiltonianLogger::PerParticleHamiltonianLogger(const PerParticleHamiltonianLogger& pphl, DataLocality dl)
@@ -56,6 +65,68 @@ void PerParticleHamiltonianLogger::write(CrowdLogValues& cl_values, const std::v
   }
 }
 
+long PerParticleHamiltonianLogger::getComponentIndex(const std::string& component)
+{
+  auto it = std::find(component_names_.begin(), component_names_.end(), component);
+  if (it != component_names_.end())
+    return std::distance(component_names_.begin(), it);
+  component_names_.push_back(component);
+  return component_names_.size() - 1;
+}
+
+void PerParticleHamiltonianLogger::writeRecords(CrowdLogRecords& cl_records)
+{
+  for (auto& [component, records] : cl_records)
+  {
+    const std::size_t num_records = records.size();
+    if (num_records == 0)
+      continue;
+    const long component_index = getComponentIndex(component);
+    std::vector<long> index(num_records * 3);
+    for (std::size_t ir = 0; ir < num_records; ++ir)
+    {
+      index[ir * 3]     = records.index[ir * 2];
+      index[ir * 3 + 1] = records.index[ir * 2 + 1];
+      index[ir * 3 + 2] = component_index;
+    }
+
+    rank_hdf_.push(component);
+    const hsize_t index_dims[]  = {num_records, 3};
+    const hsize_t values_dims[] = {num_records, records.num_values};
+    // both datasets grow together so they share the count of written records
+    hsize_t& num_written = num_written_[component];
+    hsize_t values_written = num_written;
+    h5d_append(rank_hdf_.top(), "values", values_written, 2, values_dims, records.values.data(), num_records);
+    h5d_append(rank_hdf_.top(), "index", num_written, 2, index_dims, index.data(), num_records);
+    rank_hdf_.pop();
+
+    // keep the capacity, the buffers are reused by the next block
+    records.index.clear();
+    records.values.clear();
+  }
+}
+
+void PerParticleHamiltonianLogger::bufferRecords(const std::vector<long>& walker_ids)
+{
+  for (auto& [component, values] : values_)
+  {
+    ComponentRecords& records = records_[component];
+    const std::size_t nw      = std::min(values.size(), walker_ids.size());
+    for (std::size_t iw = 0; iw < nw; ++iw)
+    {
+      if (records.num_values == 0)
+        records.num_values = values[iw].size();
+      else if (records.num_values != values[iw].size())
+        throw std::runtime_error("PerParticleHamiltonianLogger component " + component +
+                                 " reported a varying number of values");
+      records.index.push_back(walker_ids[iw]);
+      records.index.push_back(step_);
+      records.values.insert(records.values.end(), values[iw].begin(), values[iw].end());
+    }
+    records.records_per_step = nw;
+  }
+}
+
 void PerParticleHamiltonianLogger::accumulate(const RefVector<MCPWalker>& walkers,
                                               const RefVector<ParticleSet>& psets,
                                               const RefVector<TrialWaveFunction>& wfns,
@@ -69,7 +140,11 @@ void PerParticleHamiltonianLogger::accumulate(const RefVector<MCPWalker>& walker
   walker_ids_.clear();
   for (MCPWalker& walker : walkers)
     walker_ids_.push_back(walker.ID);
-  rank_estimator_->write(values_, walker_ids_);
+  if (input_.get_format() == PerParticleHamiltonianLoggerInput::Format::HDF5)
+    bufferRecords(walker_ids_);
+  else
+    rank_estimator_->write(values_, walker_ids_);
+  ++step_;
 
   // \todo some per crowd reduction.
   //       clear log values
@@ -97,7 +172,12 @@ ListenerVector<QMCTraits::RealType>::ReportingFunction PerParticleHamiltonianLog
 
 void PerParticleHamiltonianLogger::collect(const RefVector<OperatorEstBase>& type_erased_operator_estimators)
 {
-  int crowd_count = 0;
+  if (input_.get_format() != PerParticleHamiltonianLoggerInput::Format::HDF5)
+    return;
+  // crowds buffer their records without synchronization during the block, they are written here in crowd order
+  for (OperatorEstBase& crowd_oeb : type_erased_operator_estimators)
+    writeRecords(dynamic_cast<PerParticleHamiltonianLogger&>(crowd_oeb).records_);
+  rank_hdf_.flush();
 }
 
 void PerParticleHamiltonianLogger::registerListeners(QMCHamiltonian& ham_leader)
@@ -109,7 +189,17 @@ void PerParticleHamiltonianLogger::registerListeners(QMCHamiltonian& ham_leader)
 void PerParticleHamiltonianLogger::startBlock(int steps)
 {
   ++block_;
-  rank_fstream_ << "starting block:  " << block_ << " steps: " << steps << "\n";
+  if (input_.get_format() == PerParticleHamiltonianLoggerInput::Format::HDF5)
+  {
+    // preallocate for a block like the last step so that accumulate does not reallocate
+    for (auto& [component, records] : records_)
+    {
+      records.index.reserve(steps * records.records_per_step * 2);
+      records.values.reserve(steps * records.records_per_step * records.num_values);
+    }
+  }
+  else
+    rank_fstream_ << "starting block:  " << block_ << " steps: " << steps << "\n";
 }
 
 } // namespace qmcplusplus
@@ -21,6 +21,7 @@
 #include <StdRandom.h>
 #include "OhmmsPETE/OhmmsVector.h"
 #include "QMCHamiltonians/Listener.hpp"
+#include "hdf/hdf_archive.h"
 
 namespace qmcplusplus
 {
@@ -31,6 +32,21 @@ public:
   using Real = QMCTraits::RealType;
   using CrowdLogValues = std::unordered_map<std::string, std::vector<Vector<Real>>>;
 
+  /** binary records of one component buffered by a crowd until the end of the block.
+   *  Each record is a (walker id, step) pair in index and a row of values.
+   */
+  struct ComponentRecords
+  {
+    std::vector<long> index;
+    std::vector<Real> values;
+    /// values per record, the number of particles reported by the component
+    std::size_t num_values = 0;
+    /// records added by the last step, used to preallocate the buffers of a block
+    std::size_t records_per_step = 0;
+    std::size_t size() const { return num_values > 0 ? values.size() / num_values : 0; }
+  };
+  using CrowdLogRecords = std::unordered_map<std::string, ComponentRecords>;
+
   
   PerParticleHamiltonianLogger(PerParticleHamiltonianLoggerInput&& input, int rank);
   PerParticleHamiltonianLogger(const PerParticleHamiltonianLogger& other, DataLocality data_locality);
@@ -55,8 +71,18 @@ public:
 
   void write(CrowdLogValues& values, const std::vector<long>& walkers_ids);
 
+  /** append the records buffered by a crowd to the per-rank HDF5 file and clear them
+   *  only called on the rank estimator by collect, so it needs no lock.
+   */
+  void writeRecords(CrowdLogRecords& records);
+
   int get_block() { return block_; }
 private:
+  /// append the current values of the crowd walkers to the binary records
+  void bufferRecords(const std::vector<long>& walker_ids);
+  /// component index of a component name, assigned in order of appearance
+  long getComponentIndex(const std::string& component);
+
   bool crowd_clone = false;
   PerParticleHamiltonianLogger  * const rank_estimator_;
   PerParticleHamiltonianLoggerInput input_;
@@ -67,6 +93,15 @@ private:
   std::fstream rank_fstream_;
   std::mutex write_lock;
   int block_ = 0;
+  /// steps accumulated by this crowd
+  long step_ = 0;
+  CrowdLogRecords records_;
+  /// per-rank output of the hdf5 format
+  hdf_archive rank_hdf_;
+  /// component names in order of their component index
+  std::vector<std::string> component_names_;
+  /// number of records already written per component
+  std::unordered_map<std::string, hsize_t> num_written_;
 };
   
 }
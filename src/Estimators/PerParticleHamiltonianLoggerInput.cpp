@@ -19,5 +19,12 @@ namespace qmcplusplus {
     auto setIfInInput = LAMBDA_setIfInInput;
     setIfInInput(to_stdout_, "to_stdout");
     setIfInInput(name_, "name");
+    setIfInInput(format_, "format");
+  }
+
+  std::any PerParticleHamiltonianLoggerInput::PerParticleHamiltonianLoggerInputSection::assignAnyEnum(
+      const std::string& name) const
+  {
+    return lookupAnyEnum(name, get<std::string>(name), lookup_input_enum_value);
   }
 }
@@ -25,17 +25,33 @@ public:
   using Consumer = PerParticleHamiltonianLogger;
   using Real     = QMCTraits::RealType;
 
+  /// text writes every value through a shared stream, hdf5 buffers binary records per crowd
+  enum class Format
+  {
+    TEXT,
+    HDF5
+  };
+
+  /** mapping for enumerated options of PerParticleHamiltonianLogger
+   *  This plus the virtual assignAnyEnum method are needed by InputSection to
+   *  validate and assign enum values from input.
+   */
+  inline static const std::unordered_map<std::string, std::any>
+      lookup_input_enum_value{{"format-text", Format::TEXT}, {"format-hdf5", Format::HDF5}};
+
   class PerParticleHamiltonianLoggerInputSection : public InputSection
   {
   public:
     PerParticleHamiltonianLoggerInputSection()
     {
       section_name = "PerParticleHamiltonianLogger";
-      attributes   = {"to_stdout", "validate_per_particle_sum", "type", "name"};
+      attributes   = {"to_stdout", "validate_per_particle_sum", "type", "name", "format"};
       bools        = {"to_stdout", "validate_per_particle_sum"};
       strings      = {"type", "name"};
+      enums        = {"format"};
     }
     PerParticleHamiltonianLoggerInputSection(const PerParticleHamiltonianLoggerInputSection& other) = default;
+    std::any assignAnyEnum(const std::string& name) const override;
   };
   PerParticleHamiltonianLoggerInput(const PerParticleHamiltonianLoggerInput& other) = default;
   PerParticleHamiltonianLoggerInput(xmlNodePtr cur);
@@ -46,11 +62,13 @@ public:
   
   const std::string& get_name() const { return name_; }
   bool get_to_stdout() const { return to_stdout_; }
+  Format get_format() const { return format_; }
 
 private:
   PerParticleHamiltonianLoggerInputSection input_section_;
   std::string name_               = "per_particle_log";
   bool to_stdout_                 = false;
+  Format format_                  = Format::TEXT;
 };
 } // namespace qmcplusplus
 #endif
@@ -0,0 +1,280 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "WalkerTraceManager.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include "Concurrency/BackgroundWorker.hpp"
+#include "OhmmsData/AttributeSet.h"
+#include "Message/Communicate.h"
+#include "Message/UniformCommunicateError.h"
+#include "QMCDrivers/WalkerProperties.h"
+#include "QMCHamiltonians/QMCHamiltonian.h"
+
+namespace qmcplusplus
+{
+using WP = WalkerProperties::Indexes;
+
+WalkerTraceCollector::WalkerTraceCollector(WalkerTraceManager& manager) : manager_(manager)
+{
+  ids_.resize(WalkerTraceManager::id_names.size(), manager_.get_buffer_rows());
+  quantities_.resize(manager_.get_quantities().size(), manager_.get_buffer_rows());
+  staged_ids_.resize(WalkerTraceManager::id_names.size(), manager_.get_buffer_rows());
+  staged_quantities_.resize(manager_.get_quantities().size(), manager_.get_buffer_rows());
+}
+
+void WalkerTraceCollector::collect(const RefVector<MCPWalker>& walkers)
+{
+  const long step = step_++;
+  if (step % manager_.get_step_period() != 0)
+    return;
+  // keep the rows of a step together unless the crowd alone exceeds buffer_rows
+  if (num_rows() + walkers.size() > manager_.get_buffer_rows())
+    manager_.flush(*this);
+
+  const auto& quantities = manager_.get_quantities();
+  for (const MCPWalker& walker : walkers)
+  {
+    if (num_rows() == manager_.get_buffer_rows())
+      manager_.flush(*this);
+    ids_[0].push_back(walker.ID);
+    ids_[1].push_back(walker.ParentID);
+    ids_[2].push_back(step);
+    for (int iq = 0; iq < quantities.size(); ++iq)
+    {
+      const auto& quantity = quantities[iq];
+      Real value;
+      switch (quantity.source)
+      {
+      case WalkerTraceManager::Source::WEIGHT:
+        value = walker.Weight;
+        break;
+      case WalkerTraceManager::Source::MULTIPLICITY:
+        value = walker.Multiplicity;
+        break;
+      case WalkerTraceManager::Source::AGE:
+        value = walker.Age;
+        break;
+      default:
+        value = walker.getPropertyBase()[quantity.property_index];
+      }
+      quantities_[iq].push_back(value);
+    }
+  }
+}
+
+void WalkerTraceCollector::clear()
+{
+  ids_.clear();
+  quantities_.clear();
+}
+
+void WalkerTraceCollector::stageBuffers()
+{
+  ids_.swap(staged_ids_);
+  quantities_.swap(staged_quantities_);
+  clear();
+}
+
+WalkerTraceManager::WalkerTraceManager(Communicate* comm) : comm_(comm) {}
+
+WalkerTraceManager::~WalkerTraceManager() = default;
+
+void WalkerTraceManager::put(xmlNodePtr cur, bool allow_traces, const std::string& file_root)
+{
+  file_root_ = file_root;
+  active_    = cur != nullptr && allow_traces;
+  if (!active_)
+    return;
+
+  std::string writing = "yes";
+  OhmmsAttributeSet attrib;
+  attrib.add(writing, "write");
+  attrib.add(step_period_, "step_period");
+  attrib.add(buffer_rows_, "buffer_rows");
+  attrib.put(cur);
+  active_ = writing == "yes";
+  if (step_period_ < 1)
+    throw UniformCommunicateError("WalkerTraceManager::put step_period must be positive");
+  if (buffer_rows_ < 1)
+    throw UniformCommunicateError("WalkerTraceManager::put buffer_rows must be positive");
+
+  // array_traces are requested for the legacy drivers only and are skipped here
+  requested_.clear();
+  xmlNodePtr element = cur->children;
+  while (element != nullptr)
+  {
+    std::string name((const char*)element->name);
+    if (name == "scalar_traces")
+    {
+      std::string defaults = "no";
+      OhmmsAttributeSet eattrib;
+      eattrib.add(defaults, "defaults");
+      eattrib.put(element);
+      if (defaults != "yes")
+      {
+        std::vector<std::string> scalar_list;
+        putContent(scalar_list, element);
+        requested_.insert(requested_.end(), scalar_list.begin(), scalar_list.end());
+      }
+    }
+    element = element->next;
+  }
+}
+
+void WalkerTraceManager::startRun(const QMCHamiltonian& ham)
+{
+  std::vector<std::string> observable_names;
+  for (int i = 0; i < ham.sizeOfObservables(); ++i)
+    observable_names.push_back(ham.getObservableName(i));
+  startRun(observable_names, ham.startIndex());
+}
+
+void WalkerTraceManager::startRun(const std::vector<std::string>& observable_names, int observable_start)
+{
+  if (!active_)
+    return;
+
+  std::vector<Quantity> available{{"Weight", Source::WEIGHT},
+                                  {"Multiplicity", Source::MULTIPLICITY},
+                                  {"Age", Source::AGE},
+                                  {"LocalEnergy", Source::PROPERTY, WP::LOCALENERGY},
+                                  {"LocalPotential", Source::PROPERTY, WP::LOCALPOTENTIAL}};
+  for (int i = 0; i < observable_names.size(); ++i)
+    available.push_back({observable_names[i], Source::PROPERTY, observable_start + i});
+
+  quantities_.clear();
+  if (requested_.empty())
+    quantities_ = available;
+  else
+    for (const auto& name : requested_)
+    {
+      auto it = std::find_if(available.begin(), available.end(), [&name](auto& q) { return q.name == name; });
+      if (it == available.end())
+      {
+        std::string names;
+        for (const auto& q : available)
+          names += " " + q.name;
+        throw UniformCommunicateError("WalkerTraceManager::startRun " + name +
+                                      " is not a traceable quantity\n  valid options are:" + names);
+      }
+      if (std::none_of(quantities_.begin(), quantities_.end(), [&name](auto& q) { return q.name == name; }))
+        quantities_.push_back(*it);
+    }
+
+  file_name_ = file_root_;
+  if (comm_->size() > 1)
+  {
+    std::array<char, 32> ptoken;
+    const int length = std::snprintf(ptoken.data(), ptoken.size(), ".p%03d", comm_->rank());
+    if (length < 0)
+      throw std::runtime_error("Error generating filename");
+    file_name_.append(ptoken.data(), length);
+  }
+  file_name_ += ".wtraces.h5";
+  hdf_file_ = std::make_unique<hdf_archive>();
+  if (!hdf_file_->create(file_name_))
+    throw std::runtime_error("WalkerTraceManager::startRun failed to create " + file_name_);
+  rows_written_ = 0;
+#ifdef H5_HAVE_THREADSAFE
+  writer_ = std::make_unique<BackgroundWorker>();
+  // HDF5 error printing is a per thread setting, suppress it on the writer thread as well
+  writer_->submit([] { H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr); });
+#endif
+
+  app_log() << "  WalkerTraceManager writing " << quantities_.size() << " quantities every " << step_period_
+            << " steps to " << file_name_ << std::endl;
+}
+
+void WalkerTraceManager::stopRun()
+{
+  flushWrites();
+  writer_.reset();
+  if (hdf_file_)
+    hdf_file_->close();
+  hdf_file_.reset();
+}
+
+std::unique_ptr<WalkerTraceCollector> WalkerTraceManager::makeCollector()
+{
+  return std::make_unique<WalkerTraceCollector>(*this);
+}
+
+void WalkerTraceManager::writeBuffers(const RefVector<WalkerTraceCollector>& collectors)
+{
+  if (writer_)
+  {
+    // the staged buffers belong to the writer until its last task is done
+    writer_->wait();
+    for (WalkerTraceCollector& collector : collectors)
+      collector.stageBuffers();
+    writer_->submit([this, collectors] {
+      for (WalkerTraceCollector& collector : collectors)
+        write(collector.get_staged_ids(), collector.get_staged_quantities());
+      if (hdf_file_)
+        hdf_file_->flush();
+    });
+    return;
+  }
+  std::lock_guard<std::mutex> lock(write_lock_);
+  for (WalkerTraceCollector& collector : collectors)
+    write(collector.get_ids(), collector.get_quantities());
+  if (hdf_file_)
+    hdf_file_->flush();
+}
+
+void WalkerTraceManager::flush(WalkerTraceCollector& collector)
+{
+  if (writer_)
+  {
+    // tasks run one at a time in submission order, so the previous write of this collector is done as well
+    writer_->wait();
+    collector.stageBuffers();
+    writer_->submit([this, &collector] { write(collector.get_staged_ids(), collector.get_staged_quantities()); });
+    return;
+  }
+  std::lock_guard<std::mutex> lock(write_lock_);
+  write(collector.get_ids(), collector.get_quantities());
+}
+
+void WalkerTraceManager::flushWrites()
+{
+  if (writer_)
+    writer_->wait();
+}
+
+void WalkerTraceManager::write(WalkerTraceColumns<long>& ids, WalkerTraceColumns<Real>& values)
+{
+  const hsize_t num_rows = ids.num_rows();
+  if (num_rows == 0)
+    return;
+  if (hdf_file_)
+  {
+    const hsize_t dims[] = {num_rows};
+    // every column grows by the same number of rows
+    for (int i = 0; i < ids.num_columns(); ++i)
+    {
+      hsize_t current = rows_written_;
+      h5d_append(hdf_file_->top(), id_names[i], current, 1, dims, ids[i].data(), buffer_rows_);
+    }
+    for (int i = 0; i < values.num_columns(); ++i)
+    {
+      hsize_t current = rows_written_;
+      h5d_append(hdf_file_->top(), quantities_[i].name, current, 1, dims, values[i].data(), buffer_rows_);
+    }
+    rows_written_ += num_rows;
+  }
+  ids.clear();
+  values.clear();
+}
+} // namespace qmcplusplus
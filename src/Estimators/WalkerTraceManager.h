@@ -0,0 +1,191 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#ifndef QMCPLUSPLUS_WALKERTRACEMANAGER_H
+#define QMCPLUSPLUS_WALKERTRACEMANAGER_H
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Configuration.h"
+#include "Particle/Walker.h"
+#include "hdf/hdf_archive.h"
+#include "type_traits/template_types.hpp"
+
+namespace qmcplusplus
+{
+class BackgroundWorker;
+class QMCHamiltonian;
+class WalkerTraceManager;
+
+/** Columnar buffer of per walker, per step scalar traces
+ *  Every quantity owns a contiguous column so selected quantities are appended
+ *  and written independently of each other.
+ */
+template<typename T>
+class WalkerTraceColumns
+{
+public:
+  void resize(std::size_t num_columns, std::size_t max_rows)
+  {
+    columns_.resize(num_columns);
+    for (auto& column : columns_)
+      column.reserve(max_rows);
+  }
+  void clear()
+  {
+    for (auto& column : columns_)
+      column.clear();
+  }
+  void swap(WalkerTraceColumns& other) { columns_.swap(other.columns_); }
+  std::size_t num_columns() const { return columns_.size(); }
+  std::size_t num_rows() const { return columns_.empty() ? 0 : columns_[0].size(); }
+  std::vector<T>& operator[](std::size_t i) { return columns_[i]; }
+  const std::vector<T>& operator[](std::size_t i) const { return columns_[i]; }
+
+private:
+  std::vector<std::vector<T>> columns_;
+};
+
+/** Per crowd collection of walker traces
+ *
+ *  A collector only touches its own preallocated buffers during the steps of a block.
+ *  When its buffers reach the row limit of the manager they are flushed before any reallocation happens.
+ *  Each buffer has a staged twin which the manager writes while the collector fills the other one.
+ */
+class WalkerTraceCollector
+{
+public:
+  using MCPWalker = Walker<QMCTraits, PtclOnLatticeTraits>;
+  using Real      = QMCTraits::FullPrecRealType;
+
+  WalkerTraceCollector(WalkerTraceManager& manager);
+
+  /// append a row per walker for this step if the step is traced
+  void collect(const RefVector<MCPWalker>& walkers);
+
+  std::size_t num_rows() const { return ids_.num_rows(); }
+  WalkerTraceColumns<long>& get_ids() { return ids_; }
+  WalkerTraceColumns<Real>& get_quantities() { return quantities_; }
+  WalkerTraceColumns<long>& get_staged_ids() { return staged_ids_; }
+  WalkerTraceColumns<Real>& get_staged_quantities() { return staged_quantities_; }
+  void clear();
+  /// swap the filled buffers with the staged ones, the staged buffers must have been written
+  void stageBuffers();
+
+private:
+  WalkerTraceManager& manager_;
+  /// walker id, parent id and step of each row
+  WalkerTraceColumns<long> ids_;
+  /// selected quantities of each row
+  WalkerTraceColumns<Real> quantities_;
+  /// rows handed to the manager for writing
+  WalkerTraceColumns<long> staged_ids_;
+  WalkerTraceColumns<Real> staged_quantities_;
+  /// steps seen by this collector in the current run
+  long step_ = 0;
+};
+
+/** Streams per walker, per step scalar quantities of the batched drivers into HDF5
+ *
+ *  It reads the same <traces> element as the legacy TraceManager: quantities are selected
+ *  by name with <scalar_traces>, all of them are traced by default. Particle arrays are not supported.
+ *  The extra attributes step_period and buffer_rows select how often walkers are traced and
+ *  bound the memory of each crowd.
+ *
+ *  Each rank writes <project>.pXXX.wtraces.h5, or <project>.wtraces.h5 in a single rank run,
+ *  holding one extendible dataset per traced column.
+ *  With a thread-safe HDF5 library the writes run on a background thread.
+ */
+class WalkerTraceManager
+{
+public:
+  using MCPWalker = WalkerTraceCollector::MCPWalker;
+  using Real      = WalkerTraceCollector::Real;
+
+  /// where the value of a quantity lives in a walker
+  enum class Source
+  {
+    WEIGHT,
+    MULTIPLICITY,
+    AGE,
+    PROPERTY
+  };
+  struct Quantity
+  {
+    std::string name;
+    Source source;
+    int property_index = 0;
+  };
+
+  WalkerTraceManager(Communicate* comm);
+  ~WalkerTraceManager();
+
+  /** parse <traces>
+   * @param cur traces element, may be nullptr when no traces are requested
+   * @param allow_traces whether the driver allows tracing
+   * @param file_root file name root of the output
+   */
+  void put(xmlNodePtr cur, bool allow_traces, const std::string& file_root);
+
+  bool is_active() const { return active_; }
+
+  /** resolve the requested quantities and open the output file
+   * @param observable_names names of the Hamiltonian observables stored in the walker properties
+   * @param observable_start index of the first observable in the walker properties
+   */
+  void startRun(const std::vector<std::string>& observable_names, int observable_start);
+  /// startRun with the observables of a Hamiltonian
+  void startRun(const QMCHamiltonian& ham);
+  void stopRun();
+
+  std::unique_ptr<WalkerTraceCollector> makeCollector();
+
+  /// write and clear the buffers of all the collectors, called at the end of a block
+  void writeBuffers(const RefVector<WalkerTraceCollector>& collectors);
+  /// write and clear the buffers of a collector that reached buffer_rows. Thread-safe.
+  void flush(WalkerTraceCollector& collector);
+  /// wait for the pending writes
+  void flushWrites();
+
+  const std::vector<Quantity>& get_quantities() const { return quantities_; }
+  int get_step_period() const { return step_period_; }
+  std::size_t get_buffer_rows() const { return buffer_rows_; }
+  const std::string& get_file_name() const { return file_name_; }
+
+  /// names of the id columns
+  inline static const std::vector<std::string> id_names{"walker_id", "parent_id", "step"};
+
+private:
+  /// append the rows of the given columns to the file and clear them
+  void write(WalkerTraceColumns<long>& ids, WalkerTraceColumns<Real>& values);
+
+  Communicate* comm_;
+  bool active_ = false;
+  int step_period_ = 1;
+  std::size_t buffer_rows_ = 1024;
+  std::string file_root_;
+  std::string file_name_;
+  /// names requested in <scalar_traces>, all quantities if empty
+  std::vector<std::string> requested_;
+  std::vector<Quantity> quantities_;
+  std::unique_ptr<hdf_archive> hdf_file_;
+  /// rows written per column, the same for every column
+  hsize_t rows_written_ = 0;
+  /// serializes HDF5 writes of collectors flushing during a block
+  std::mutex write_lock_;
+  /// writes the staged buffers of the collectors, only with a thread-safe HDF5 library
+  std::unique_ptr<BackgroundWorker> writer_;
+};
+} // namespace qmcplusplus
+#endif
@@ -117,7 +117,7 @@ void EstimatorManagerNewTest::fakeScalarSamplesAndCollect()
   em.collectScalarEstimators(scalar_estimators_);
 }
 
-void EstimatorManagerNewTest::fakeSomeOperatorEstimatorSamples(int rank)
+void EstimatorManagerNewTest::fakeSomeOperatorEstimatorSamples(int rank, QMCT::RealType walkers_weight)
 {
   em.operator_ests_.emplace_back(new FakeOperatorEstimator(comm_->size(), DataLocality::crowd));
   FakeOperatorEstimator& foe        = dynamic_cast<FakeOperatorEstimator&>(*(em.operator_ests_.back()));
@@ -127,7 +127,7 @@ void EstimatorManagerNewTest::fakeSomeOperatorEstimatorSamples(int rank)
     if (id > rank)
       data[id] += rank + 1;
   }
-  foe.set_walker_weights(1);
+  foe.set_walker_weights(walkers_weight);
 }
 
 std::vector<QMCTraits::RealType> EstimatorManagerNewTest::generateGoodOperatorData(int num_ranks)
@@ -38,7 +38,7 @@ public:
   /** Quickly add scalar samples using FakeEstimator mock estimator. */
   void fakeScalarSamplesAndCollect();
   /** Quickly add scalar samples using FakeOperatorEstimator mock estimator. */
-  void fakeSomeOperatorEstimatorSamples(int rank);
+  void fakeSomeOperatorEstimatorSamples(int rank, QMCT::RealType walkers_weight = 1);
   /** call private EMB method and collect EMBTs estimators_ as main_estimators*/
   void collectMainEstimators();
   /** call private EMB method and colelct EMBTs estimators_ */
@@ -56,7 +56,9 @@ public:
   bool testMakeBlockAverages();
   void testReduceOperatorEstimators();
 
-  std::vector<QMCT::RealType>& get_operator_data() { return em.operator_ests_[0]->get_data(); }
+  std::vector<QMCT::RealType>& get_operator_data(int iop = 0) { return em.operator_ests_[iop]->get_data(); }
+  /// reduced walker weight of each operator estimator, set on the ranks writing the operator estimators
+  const std::vector<QMCT::FullPrecRealType>& get_operator_weights() const { return em.operator_weights_; }
   
   EstimatorManagerNew em;
 private:
@@ -69,6 +71,8 @@ class EstimatorManagerNewTestAccess {
 public:
   EstimatorManagerNewTestAccess(EstimatorManagerNew& emn) : emn_(emn) {}
   const ScalarEstimatorBase& getMainEstimator() { return *(emn_.main_estimator_.get()); }
+  /// the block writer, only on the ranks writing files with async writes
+  BackgroundWorker* getBlockWriter() { return emn_.block_writer_.get(); }
 private:
   EstimatorManagerNew& emn_;
 };
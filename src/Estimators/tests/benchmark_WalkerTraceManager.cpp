@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** \file
+ *  Micro benchmark of the per step cost of WalkerTraceCollector::collect
+ *  as a function of the number of traced quantities.
+ */
+
+#include "catch.hpp"
+
+#include "WalkerTraceManager.h"
+
+#include <filesystem>
+
+#include "Message/Communicate.h"
+#include "OhmmsData/Libxml2Doc.h"
+#include "QMCDrivers/WalkerProperties.h"
+
+namespace qmcplusplus
+{
+TEST_CASE("WalkerTraceManager collect benchmark", "[estimators][benchmark]")
+{
+  using MCPWalker = WalkerTraceManager::MCPWalker;
+  using WP        = WalkerProperties::Indexes;
+
+  const int num_walkers     = 64;
+  const int num_observables = 16;
+
+  std::vector<std::string> observable_names;
+  for (int i = 0; i < num_observables; ++i)
+    observable_names.push_back("obs" + std::to_string(i));
+  std::vector<MCPWalker> walkers(num_walkers, MCPWalker(2));
+  auto walker_refs = makeRefVector<MCPWalker>(walkers);
+
+  for (const int num_traced : {1, 4, 16})
+  {
+    std::string xml = R"(<traces buffer_rows="65536"><scalar_traces>)";
+    for (int i = 0; i < num_traced; ++i)
+      xml += " " + observable_names[i];
+    xml += "</scalar_traces></traces>";
+    Libxml2Document doc;
+    REQUIRE(doc.parseFromString(xml));
+
+    WalkerTraceManager wtm(OHMMS::Controller);
+    wtm.put(doc.getRoot(), true, "wtraces_benchmark");
+    wtm.startRun(observable_names, WP::NUMPROPERTIES);
+    auto collector = wtm.makeCollector();
+
+    // the buffer flushes to disk every 1024 steps, which is included in the timing
+    BENCHMARK(std::to_string(num_traced) + " quantities x " + std::to_string(num_walkers) + " walkers collect")
+    {
+      collector->collect(walker_refs);
+    };
+    wtm.writeBuffers({*collector});
+    wtm.stopRun();
+    std::filesystem::remove(wtm.get_file_name());
+  }
+}
+} // namespace qmcplusplus
@@ -24,7 +24,12 @@
 #include "QMCHamiltonians/tests/MinimalHamiltonianPool.h"
 #include "QMCWaveFunctions/tests/MinimalWaveFunctionPool.h"
 #include "Utilities/ProjectData.h"
+#include "Concurrency/BackgroundWorker.hpp"
+#include "Message/UniformCommunicateError.h"
+#include "hdf/hdf_archive.h"
 #include <stdio.h>
+#include <filesystem>
+#include <fstream>
 #include <sstream>
 
 namespace qmcplusplus
@@ -134,6 +139,201 @@ TEST_CASE("EstimatorManagerNew::collectScalarEstimators", "[estimators]")
   CHECK(embt.em.get_AverageCache()[3] == Approx(correct_value));
 }
 
+TEST_CASE("EstimatorManagerNew::reduceOperatorEstimators packed", "[estimators]")
+{
+  using OperatorReduction = EstimatorManagerNew::OperatorReduction;
+  const auto reduction =
+      GENERATE(OperatorReduction::FLAT, OperatorReduction::HIERARCHICAL, OperatorReduction::DISTRIBUTED);
+  Communicate* c = OHMMS::Controller;
+  QMCHamiltonian ham;
+  testing::EstimatorManagerNewTest embt(ham, c, 1);
+  embt.em.setOperatorReduction(reduction);
+
+  // two estimators share the packed buffer, the second one with a different and fractional weight
+  embt.fakeSomeOperatorEstimatorSamples(c->rank());
+  embt.fakeSomeOperatorEstimatorSamples(c->rank(), 2.5);
+  const std::vector<QMCTraits::RealType> good_data = embt.generateGoodOperatorData(c->size());
+
+  embt.testReduceOperatorEstimators();
+
+  if (c->rank() == 0)
+  {
+    REQUIRE(embt.get_operator_weights().size() == 2);
+    CHECK(embt.get_operator_weights()[0] == Approx(c->size()));
+    CHECK(embt.get_operator_weights()[1] == Approx(2.5 * c->size()));
+    auto& first_data  = embt.get_operator_data(0);
+    auto& second_data = embt.get_operator_data(1);
+    for (size_t i = 0; i < good_data.size(); ++i)
+    {
+      CHECK(first_data[i] == Approx(good_data[i] / c->size()));
+      CHECK(second_data[i] == Approx(good_data[i] / (2.5 * c->size())));
+    }
+  }
+}
+
+TEST_CASE("EstimatorManagerNew distributed node file", "[estimators]")
+{
+  Communicate* c              = OHMMS::Controller;
+  const std::string comm_name = c->getName();
+  c->setName("distributed_write");
+  {
+    QMCHamiltonian ham;
+    testing::EstimatorManagerNewTest embt(ham, c, 1);
+    embt.em.setOperatorReduction(EstimatorManagerNew::OperatorReduction::DISTRIBUTED);
+    embt.fakeSomeOperatorEstimatorSamples(c->rank(), 2);
+    embt.em.startDriverRun();
+    embt.em.startBlock(1);
+    embt.em.stopBlock(10, 5, 2.0);
+    embt.em.stopDriverRun();
+  }
+  c->setName(comm_name);
+
+  // the node leader writes the node weight of every operator estimator next to its data
+  hdf_archive hin;
+  REQUIRE(hin.open("distributed_write.node000.stat.h5", H5F_ACC_RDONLY));
+  std::vector<double> walkers_weight;
+  hin.push("walkers_weight", false);
+  hin.readSlabReshaped(walkers_weight, std::array<int, 2>{1, 1}, "value");
+  hin.close();
+  CHECK(walkers_weight[0] == Approx(2.0));
+
+  for (const std::string suffix : {".scalar.dat", ".stat.h5", ".node000.stat.h5"})
+    std::filesystem::remove("distributed_write" + suffix);
+}
+
+TEST_CASE("EstimatorManagerNew async block writes", "[estimators]")
+{
+  Communicate* c              = OHMMS::Controller;
+  const std::string comm_name = c->getName();
+  QMCHamiltonian ham;
+
+  // three blocks with LocalEnergy, LocalEnergy_sq and LocalPotential, returns the scalar.dat rows without BlockCPU
+  auto runBlocks = [&](const std::string& name, bool async_write) {
+    c->setName(name);
+    {
+      EstimatorManagerNew em(ham, c);
+      em.setAsyncWrite(async_write);
+      em.startDriverRun();
+      for (int block = 0; block < 3; ++block)
+      {
+        em.startBlock(1);
+        auto& averages = em.get_AverageCache();
+        averages[0]    = -2.0 * (block + 1);
+        averages[1]    = 4.0 * (block + 1);
+        averages[2]    = -3.0;
+        em.stopBlock(10, 5, 2.0);
+        // the next block may change the caches while the writer works
+        averages = 0.0;
+      }
+      em.stopDriverRun();
+    }
+    std::vector<std::vector<std::string>> rows;
+    std::ifstream scalar_dat(name + ".scalar.dat");
+    std::string line;
+    std::getline(scalar_dat, line);
+    while (std::getline(scalar_dat, line))
+    {
+      std::istringstream row(line);
+      std::vector<std::string> columns;
+      std::string column;
+      while (row >> column)
+        columns.push_back(column);
+      REQUIRE(columns.size() == 7);
+      columns.erase(columns.begin() + 5);
+      rows.push_back(columns);
+    }
+    return rows;
+  };
+
+  auto sync_rows  = runBlocks("sync_write", false);
+  auto async_rows = runBlocks("async_write", true);
+  c->setName(comm_name);
+
+  REQUIRE(sync_rows.size() == 3);
+  CHECK(async_rows == sync_rows);
+
+  hdf_archive hin;
+  REQUIRE(hin.open("async_write.stat.h5", H5F_ACC_RDONLY));
+  std::vector<double> local_energy;
+  hin.push("LocalEnergy", false);
+  hin.readSlabReshaped(local_energy, std::array<int, 2>{3, 1}, "value");
+  hin.close();
+  CHECK(local_energy[0] == Approx(-1.0));
+  CHECK(local_energy[1] == Approx(-2.0));
+  CHECK(local_energy[2] == Approx(-3.0));
+
+  for (const std::string name : {"sync_write", "async_write"})
+  {
+    std::filesystem::remove(name + ".scalar.dat");
+    std::filesystem::remove(name + ".stat.h5");
+  }
+}
+
+#ifdef H5_HAVE_THREADSAFE
+TEST_CASE("EstimatorManagerNew async write error", "[estimators]")
+{
+  Communicate* c              = OHMMS::Controller;
+  const std::string comm_name = c->getName();
+  c->setName("async_write_error");
+  QMCHamiltonian ham;
+  {
+    EstimatorManagerNew em(ham, c);
+    em.setAsyncWrite(true);
+    em.startDriverRun();
+    // a write failing on the ranks owning a writer is reported on every rank
+    testing::EstimatorManagerNewTestAccess access(em);
+    if (BackgroundWorker* writer = access.getBlockWriter())
+      writer->submit([] { throw std::runtime_error("disk full"); });
+    CHECK_THROWS_AS(em.flushWrites(), UniformCommunicateError);
+    em.stopDriverRun();
+  }
+  c->setName(comm_name);
+  std::filesystem::remove("async_write_error.scalar.dat");
+  std::filesystem::remove("async_write_error.stat.h5");
+}
+#endif
+
+TEST_CASE("EstimatorManagerNew driver performance counters", "[estimators]")
+{
+  Communicate* c              = OHMMS::Controller;
+  const std::string comm_name = c->getName();
+  c->setName("performance_write");
+  {
+    QMCHamiltonian ham;
+    EstimatorManagerNew em(ham, c);
+    em.setPerformanceCounterNames({"block_seconds", "moves_per_second"});
+    em.startDriverRun();
+    if (c->rank() == 0)
+      CHECK_THROWS(em.setBlockPerformance({1.0}));
+    for (int block = 0; block < 2; ++block)
+    {
+      em.startBlock(1);
+      if (c->rank() == 0)
+        em.setBlockPerformance({0.5 * (block + 1), 100.0 * (block + 1)});
+      em.stopBlock(10, 5, 2.0);
+    }
+    em.stopDriverRun();
+  }
+  c->setName(comm_name);
+
+  hdf_archive hin;
+  REQUIRE(hin.open("performance_write.stat.h5", H5F_ACC_RDONLY));
+  std::vector<double> performance;
+  std::vector<std::string> names;
+  hin.push("driver_performance", false);
+  hin.readSlabReshaped(performance, std::array<int, 2>{2, 2}, "value");
+  hin.read(names, "names");
+  hin.close();
+  CHECK(names == std::vector<std::string>{"block_seconds", "moves_per_second"});
+  CHECK(performance[0] == Approx(0.5));
+  CHECK(performance[1] == Approx(100.0));
+  CHECK(performance[2] == Approx(1.0));
+  CHECK(performance[3] == Approx(200.0));
+
+  for (const std::string suffix : {".scalar.dat", ".stat.h5"})
+    std::filesystem::remove("performance_write" + suffix);
+}
+
 TEST_CASE("EstimatorManagerNew adhoc addVector operator", "[estimators]")
 {
   int num_scalars = 3;
@@ -25,6 +25,7 @@
 #include "Utilities/StdRandom.h"
 #include "Utilities/StlPrettyPrint.hpp"
 #include "Utilities/ProjectData.h"
+#include <ResourceCollection.h>
 
 #include <stdio.h>
 #include <sstream>
@@ -183,6 +184,16 @@ TEST_CASE("MomentumDistribution::accumulate", "[estimators]")
   //   Setup RNG
   FakeRandom<OHMMS_PRECISION_FULL> rng;
 
+  //   accumulate uses the multi walker APIs of the wavefunction, acquire the crowd resources as drivers do
+  ResourceCollection pset_res("test_pset_res");
+  ResourceCollection wfn_res("test_wfn_res");
+  psets[0].createResource(pset_res);
+  wfns[0]->createResource(wfn_res);
+  RefVectorWithLeader<ParticleSet> p_list(psets[0], ref_psets);
+  RefVectorWithLeader<TrialWaveFunction> wf_list(*wfns[0], ref_wfns);
+  ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, p_list);
+  ResourceCollectionTeamLock<TrialWaveFunction> mw_wfn_lock(wfn_res, wf_list);
+
   //   Perform accumulate
   md.accumulate(ref_walkers, ref_psets, ref_wfns, ref_hams, rng);
 
@@ -213,6 +224,17 @@ TEST_CASE("MomentumDistribution::accumulate", "[estimators]")
 #endif
   }
 
+  //   A second accumulate reuses the virtual particle sets and adds the same samples again
+  md.accumulate(ref_walkers, ref_psets, ref_wfns, ref_hams, rng);
+  for (size_t id = 0; id < ref_data.size(); ++id)
+  {
+#ifdef MIXED_PRECISION
+    CHECK(data[id] == Approx(2 * ref_data[id]).epsilon(2.e-05));
+#else
+    CHECK(data[id] == Approx(2 * ref_data[id]).epsilon(1.192092896e-05));
+#endif
+  }
+
   outputManager.resume();
 }
 
@@ -185,6 +185,33 @@ public:
       checkData(data.data(), returned_data.data(), data.size());
   }
 
+  /** batched accumulate over a crowd against evaluateMatrix of each walker with the same samples.
+   *  The rng is reset before each walker so only integrators drawing their samples
+   *  without history, i.e. not density, are valid here.
+   */
+  void testAccumulateBatched(OneBodyDensityMatrices& obdm_batched,
+                             OneBodyDensityMatrices& obdm_matrix,
+                             RefVector<MCPWalker>& walkers,
+                             RefVector<ParticleSet>& psets,
+                             RefVector<TrialWaveFunction>& twfcs)
+  {
+    REQUIRE(obdm_batched.input_.get_evaluator() == Evaluators::BATCHED);
+    REQUIRE(obdm_matrix.input_.get_evaluator() == Evaluators::MATRIX);
+    StdRandom<T> rng;
+    rng.init(101);
+    obdm_batched.implAccumulate(walkers, psets, twfcs, rng);
+    for (int iw = 0; iw < walkers.size(); ++iw)
+    {
+      rng.init(101);
+      obdm_matrix.walkers_weight_ += walkers[iw].get().Weight;
+      obdm_matrix.evaluateMatrix(psets[iw], twfcs[iw], walkers[iw], rng);
+    }
+    CHECK(obdm_batched.walkers_weight_ == Approx(obdm_matrix.walkers_weight_));
+    checkData(obdm_matrix.data_.data(), obdm_batched.data_.data(), obdm_matrix.data_.size());
+  }
+
+  static void setEvaluator(OBDMI& obdmi, Evaluators evaluator) { obdmi.evaluator_ = evaluator; }
+
   /** no change test for evaluateMatrix.
    */
   void testEvaluateMatrix(OneBodyDensityMatrices& obdm,
@@ -500,6 +527,95 @@ TEST_CASE("OneBodyDensityMatrices::accumulate", "[estimators]")
     obdmt.dumpData(obdm);
 }
 
+TEST_CASE("OneBodyDensityMatrices::accumulate batched", "[estimators]")
+{
+  using namespace testing;
+  using namespace onebodydensitymatrices;
+  using MCPWalker = OperatorEstBase::MCPWalker;
+  using OBDMTests = OneBodyDensityMatricesTests<QMCTraits::FullPrecRealType>;
+
+  ProjectData test_project("test", ProjectData::DriverVersion::BATCH);
+  Communicate* comm = OHMMS::Controller;
+
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(valid_one_body_density_matrices_input_sections[valid_obdm_input_scale]);
+  if (!okay)
+    throw std::runtime_error("cannot parse OneBodyDensitMatricesInput section");
+  xmlNodePtr node = doc.getRoot();
+  OneBodyDensityMatricesInput obdmi(node);
+  OneBodyDensityMatricesInput obdmi_batched(obdmi);
+  OBDMTests::setEvaluator(obdmi_batched, OBDMI::Evaluator::BATCHED);
+
+  auto particle_pool = MinimalParticlePool::make_diamondC_1x1x1(comm);
+  auto wavefunction_pool =
+      MinimalWaveFunctionPool::make_diamondC_1x1x1(test_project.getRuntimeOptions(), comm, particle_pool);
+  auto& spomap      = wavefunction_pool.getWaveFunction("wavefunction")->getSPOMap();
+  auto& pset_target = *(particle_pool.getParticleSet("e"));
+  auto& pset_source = *(particle_pool.getParticleSet("ion"));
+  auto& species_set = pset_target.getSpeciesSet();
+  OneBodyDensityMatrices obdm_matrix(std::move(obdmi), pset_target.getLattice(), species_set, spomap, pset_target);
+  OneBodyDensityMatrices obdm_batched(std::move(obdmi_batched), pset_target.getLattice(), species_set, spomap,
+                                      pset_target);
+
+  const int nwalkers = 3;
+  std::vector<MCPWalker> walkers;
+  for (int iw = 0; iw < nwalkers; ++iw)
+    walkers.emplace_back(8);
+
+  std::vector<ParticleSet::ParticlePos> deterministic_rs = {{
+                                                                {-0.6759092808, 0.835668385, 1.985307097},
+                                                                {0.09710352868, -0.76751858, -1.89306891},
+                                                                {-0.5605484247, -0.9578875303, 1.476860642},
+                                                                {2.585144997, 1.862680197, 3.282609463},
+                                                                {-0.1961335093, 1.111888766, -0.578481257},
+                                                                {1.794641614, 1.6000278, -0.9474347234},
+                                                                {2.157717228, 0.9254754186, 2.263158321},
+                                                                {1.883366346, 2.136350632, 3.188981533},
+                                                            },
+                                                            {
+                                                                {-0.2079261839, -0.2796236873, 0.5512072444},
+                                                                {-0.2823159397, 0.7537326217, 0.01526880637},
+                                                                {3.533515453, 2.433290243, 0.9281452894},
+                                                                {2.051767349, 2.312927485, 0.7089259624},
+                                                                {-1.043096781, 0.8190526962, -0.1958218962},
+                                                                {0.9210210443, 0.7726522088, 0.3962054551},
+                                                                {2.043324947, 0.3482068777, 3.39059639},
+                                                                {0.9103830457, 2.167978764, 2.341906071},
+                                                            },
+                                                            {
+                                                                {-0.466550231, 0.09173964709, -0.3779250085},
+                                                                {-0.4211375415, -2.017466068, -1.691870451},
+                                                                {2.090800285, 1.88529861, 2.152359247},
+                                                                {2.973145723, 1.718174577, 3.822324753},
+                                                                {-0.8552014828, -0.3484517336, -0.2870049179},
+                                                                {0.2349359095, -0.5025780797, 0.2305756211},
+                                                                {-0.03547382355, 2.279159069, 3.057915211},
+                                                                {2.535993099, 1.637133598, 3.689830303},
+                                                            }};
+  std::vector<ParticleSet> psets = generateRandomParticleSets(pset_target, pset_source, deterministic_rs, nwalkers);
+
+  auto& trial_wavefunction = *(wavefunction_pool.getPrimary());
+  std::vector<UPtr<TrialWaveFunction>> twfcs(nwalkers);
+  for (int iw = 0; iw < nwalkers; ++iw)
+  {
+    twfcs[iw] = trial_wavefunction.makeClone(psets[iw]);
+    psets[iw].update(true);
+    psets[iw].donePbyP();
+    twfcs[iw]->evaluateLog(psets[iw]);
+    psets[iw].saveWalker(walkers[iw]);
+  }
+  // unequal weights so the walker weighting of the stacked ratios is covered
+  walkers[1].Weight = 0.5;
+  walkers[2].Weight = 2.0;
+
+  auto ref_walkers(makeRefVector<MCPWalker>(walkers));
+  auto ref_psets(makeRefVector<ParticleSet>(psets));
+  auto ref_twfcs(convertUPtrToRefVector(twfcs));
+
+  OBDMTests obdmt;
+  obdmt.testAccumulateBatched(obdm_batched, obdm_matrix, ref_walkers, ref_psets, ref_twfcs);
+}
+
 TEST_CASE("OneBodyDensityMatrices::evaluateMatrix", "[estimators]")
 {
   using namespace testing;
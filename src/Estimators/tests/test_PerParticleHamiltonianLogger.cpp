@@ -139,4 +139,100 @@ TEST_CASE("PerParticleHamiltonianLogger_sum", "[estimators]")
   CHECK(std::filesystem::exists("rank_0_per_particle_log.dat"));
 }
 
+TEST_CASE("PerParticleHamiltonianLogger_hdf5", "[estimators]")
+{
+  std::string_view xml{R"XML(
+<PerParticleHamiltonianLogger format="hdf5" name="pp_binary"/>
+)XML"};
+
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(xml);
+  REQUIRE(okay);
+  xmlNodePtr node = doc.getRoot();
+  PerParticleHamiltonianLoggerInput pphli(node);
+  CHECK(pphli.get_format() == PerParticleHamiltonianLoggerInput::Format::HDF5);
+
+  const std::string filename("rank_0_pp_binary.h5");
+  if (std::filesystem::exists(filename))
+    std::filesystem::remove(filename);
+
+  const int ncrowds  = 2;
+  const int nwalkers = 3;
+  const int nsteps   = 2;
+  {
+    PerParticleHamiltonianLogger rank_logger(std::move(pphli), 0);
+
+    UPtrVector<OperatorEstBase> crowd_loggers;
+    for (int ic = 0; ic < ncrowds; ++ic)
+      crowd_loggers.emplace_back(rank_logger.spawnCrowdClone());
+
+    std::vector<OperatorEstBase::MCPWalker> walkers;
+    for (int iw = 0; iw < nwalkers; ++iw)
+      walkers.emplace_back(2);
+    std::vector<ParticleSet> psets;
+    std::vector<TrialWaveFunction> wfns;
+    std::vector<QMCHamiltonian> hams;
+    auto ref_walkers = makeRefVector<OperatorEstBase::MCPWalker>(walkers);
+    auto ref_psets   = makeRefVector<ParticleSet>(psets);
+    auto ref_wfns    = makeRefVector<TrialWaveFunction>(wfns);
+    auto ref_hams    = makeRefVector<QMCHamiltonian>(hams);
+
+    std::vector<MultiWalkerTalker> multi_walker_talkers{{"Talker1", nwalkers}, {"Talker2", nwalkers}};
+    for (auto& crowd_oeb : crowd_loggers)
+      for (auto& mwt : multi_walker_talkers)
+      {
+        auto& crowd_logger = dynamic_cast<PerParticleHamiltonianLogger&>(*crowd_oeb);
+        ListenerVector<Real> listener("whatever", crowd_logger.getLogger());
+        mwt.registerVector(listener);
+      }
+
+    FakeRandom<OHMMS_PRECISION_FULL> rng;
+    for (auto& crowd_oeb : crowd_loggers)
+      crowd_oeb->startBlock(nsteps);
+    for (int step = 0; step < nsteps; ++step)
+    {
+      for (auto& mwt : multi_walker_talkers)
+        mwt.reportVector();
+      for (int ic = 0; ic < ncrowds; ++ic)
+      {
+        for (int iw = 0; iw < nwalkers; ++iw)
+          walkers[iw].ID = ic * nwalkers + iw;
+        crowd_loggers[ic]->accumulate(ref_walkers, ref_psets, ref_wfns, ref_hams, rng);
+      }
+    }
+
+    RefVector<OperatorEstBase> crowd_loggers_refs = convertUPtrToRefVector(crowd_loggers);
+    rank_logger.collect(crowd_loggers_refs);
+  }
+
+  REQUIRE(std::filesystem::exists(filename));
+  hdf_archive hin;
+  REQUIRE(hin.open(filename, H5F_ACC_RDONLY));
+  const int nrecords = ncrowds * nsteps * nwalkers;
+  std::vector<long> index;
+  std::vector<Real> values;
+  std::vector<long> component_index;
+  for (const std::string talker : {"Talker1", "Talker2"})
+  {
+    hin.push(talker, false);
+    hin.readSlabReshaped(index, std::array<int, 2>{nrecords, 3}, "index");
+    hin.readSlabReshaped(values, std::array<int, 2>{nrecords, 4}, "values");
+    hin.pop();
+    // crowds are written in order, each with its records in step then walker order
+    for (int ic = 0; ic < ncrowds; ++ic)
+      for (int step = 0; step < nsteps; ++step)
+        for (int iw = 0; iw < nwalkers; ++iw)
+        {
+          const int ir = (ic * nsteps + step) * nwalkers + iw;
+          CHECK(index[ir * 3] == ic * nwalkers + iw);
+          CHECK(index[ir * 3 + 1] == step);
+          CHECK(values[ir * 4] == Approx(iw * nwalkers));
+          CHECK(values[ir * 4 + 3] == Approx(iw * nwalkers + 3));
+        }
+    component_index.push_back(index[2]);
+  }
+  // each component has its own index
+  CHECK(component_index[0] != component_index[1]);
+}
+
 } // namespace qmcplusplus
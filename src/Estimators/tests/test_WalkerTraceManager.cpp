@@ -0,0 +1,184 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "WalkerTraceManager.h"
+
+#include <filesystem>
+
+#include "Message/Communicate.h"
+#include "Message/UniformCommunicateError.h"
+#include "OhmmsData/Libxml2Doc.h"
+#include "QMCDrivers/WalkerProperties.h"
+
+namespace qmcplusplus
+{
+using MCPWalker = WalkerTraceManager::MCPWalker;
+using WP        = WalkerProperties::Indexes;
+
+namespace
+{
+/// walkers with distinguishable ids, weights and energies
+std::vector<MCPWalker> makeWalkers(int num_walkers)
+{
+  std::vector<MCPWalker> walkers(num_walkers, MCPWalker(2));
+  for (int iw = 0; iw < num_walkers; ++iw)
+  {
+    walkers[iw].ID                                   = iw + 1;
+    walkers[iw].ParentID                             = 100 + iw;
+    walkers[iw].Weight                               = 0.5 * iw;
+    walkers[iw].getPropertyBase()[WP::LOCALENERGY]   = -1.0 * iw;
+    walkers[iw].getPropertyBase()[WP::NUMPROPERTIES] = 10.0 * iw;
+  }
+  return walkers;
+}
+} // namespace
+
+TEST_CASE("WalkerTraceManager::put", "[estimators]")
+{
+  Communicate* comm = OHMMS::Controller;
+  WalkerTraceManager wtm(comm);
+  wtm.put(nullptr, true, "wtraces_put");
+  CHECK(!wtm.is_active());
+
+  const char* xml = R"(<traces step_period="2" buffer_rows="16">
+  <scalar_traces> LocalEnergy Kinetic Weight </scalar_traces>
+</traces>)";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(xml));
+  wtm.put(doc.getRoot(), false, "wtraces_put");
+  CHECK(!wtm.is_active());
+
+  wtm.put(doc.getRoot(), true, "wtraces_put");
+  CHECK(wtm.is_active());
+  CHECK(wtm.get_step_period() == 2);
+  CHECK(wtm.get_buffer_rows() == 16);
+
+  CHECK_THROWS_AS(wtm.startRun({"LocalECP"}, WP::NUMPROPERTIES), UniformCommunicateError);
+  wtm.startRun({"Kinetic"}, WP::NUMPROPERTIES);
+  const auto& quantities = wtm.get_quantities();
+  REQUIRE(quantities.size() == 3);
+  CHECK(quantities[0].name == "LocalEnergy");
+  CHECK(quantities[1].name == "Kinetic");
+  CHECK(quantities[1].property_index == WP::NUMPROPERTIES);
+  CHECK(quantities[2].name == "Weight");
+  wtm.stopRun();
+  std::filesystem::remove(wtm.get_file_name());
+}
+
+TEST_CASE("WalkerTraceManager::write", "[estimators]")
+{
+  Communicate* comm = OHMMS::Controller;
+  const char* xml   = R"(<traces step_period="2" buffer_rows="4">
+  <scalar_traces> Weight LocalEnergy Kinetic </scalar_traces>
+</traces>)";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(xml));
+
+  WalkerTraceManager wtm(comm);
+  wtm.put(doc.getRoot(), true, "wtraces_write");
+  wtm.startRun({"Kinetic"}, WP::NUMPROPERTIES);
+  const std::string filename = wtm.get_file_name();
+
+  // two crowds of three walkers, the second crowd has to flush during the block
+  std::vector<std::unique_ptr<WalkerTraceCollector>> collectors;
+  collectors.push_back(wtm.makeCollector());
+  collectors.push_back(wtm.makeCollector());
+  auto walkers = makeWalkers(6);
+  auto refs    = makeRefVector<MCPWalker>(walkers);
+  RefVector<MCPWalker> crowd0(refs.begin(), refs.begin() + 3);
+  RefVector<MCPWalker> crowd1(refs.begin() + 3, refs.end());
+
+  // only the steps 0 and 2 are traced
+  for (int step = 0; step < 3; ++step)
+  {
+    collectors[0]->collect(crowd0);
+    collectors[1]->collect(crowd1);
+  }
+  CHECK(collectors[0]->num_rows() == 3);
+  CHECK(collectors[1]->num_rows() == 3);
+  wtm.writeBuffers({*collectors[0], *collectors[1]});
+  CHECK(collectors[0]->num_rows() == 0);
+  wtm.stopRun();
+
+  // crowd0 step 0 and crowd1 step 0 were flushed at step 2
+  const int nrows = 12;
+  hdf_archive hin;
+  REQUIRE(hin.open(filename, H5F_ACC_RDONLY));
+  std::vector<long> walker_id, step;
+  std::vector<WalkerTraceManager::Real> weight, energy, kinetic;
+  hin.readSlabReshaped(walker_id, std::array<int, 1>{nrows}, "walker_id");
+  hin.readSlabReshaped(step, std::array<int, 1>{nrows}, "step");
+  hin.readSlabReshaped(weight, std::array<int, 1>{nrows}, "Weight");
+  hin.readSlabReshaped(energy, std::array<int, 1>{nrows}, "LocalEnergy");
+  hin.readSlabReshaped(kinetic, std::array<int, 1>{nrows}, "Kinetic");
+  hin.close();
+
+  const std::vector<long> walker_id_ref{1, 2, 3, 4, 5, 6, 1, 2, 3, 4, 5, 6};
+  const std::vector<long> step_ref{0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 2, 2};
+  CHECK(walker_id == walker_id_ref);
+  CHECK(step == step_ref);
+  for (int ir = 0; ir < nrows; ++ir)
+  {
+    const int iw = walker_id[ir] - 1;
+    CHECK(weight[ir] == Approx(0.5 * iw));
+    CHECK(energy[ir] == Approx(-1.0 * iw));
+    CHECK(kinetic[ir] == Approx(10.0 * iw));
+  }
+  std::filesystem::remove(filename);
+}
+
+TEST_CASE("WalkerTraceManager::write crowd larger than buffer_rows", "[estimators]")
+{
+  Communicate* comm = OHMMS::Controller;
+  const char* xml   = R"(<traces buffer_rows="4">
+  <scalar_traces> Weight </scalar_traces>
+</traces>)";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(xml));
+
+  WalkerTraceManager wtm(comm);
+  wtm.put(doc.getRoot(), true, "wtraces_chunks");
+  wtm.startRun(std::vector<std::string>{}, WP::NUMPROPERTIES);
+  const std::string filename = wtm.get_file_name();
+
+  auto collector = wtm.makeCollector();
+  auto walkers   = makeWalkers(6);
+  auto crowd     = makeRefVector<MCPWalker>(walkers);
+  // the buffers are flushed in chunks and never grow beyond their reserve
+  const auto capacity = collector->get_ids()[0].capacity();
+  for (int step = 0; step < 2; ++step)
+  {
+    collector->collect(crowd);
+    CHECK(collector->num_rows() <= wtm.get_buffer_rows());
+    CHECK(collector->get_ids()[0].capacity() == capacity);
+    CHECK(collector->get_quantities()[0].capacity() == capacity);
+  }
+  wtm.writeBuffers({*collector});
+  wtm.stopRun();
+
+  const int nrows = 12;
+  hdf_archive hin;
+  REQUIRE(hin.open(filename, H5F_ACC_RDONLY));
+  std::vector<long> walker_id, step;
+  hin.readSlabReshaped(walker_id, std::array<int, 1>{nrows}, "walker_id");
+  hin.readSlabReshaped(step, std::array<int, 1>{nrows}, "step");
+  hin.close();
+
+  const std::vector<long> walker_id_ref{1, 2, 3, 4, 5, 6, 1, 2, 3, 4, 5, 6};
+  const std::vector<long> step_ref{0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1};
+  CHECK(walker_id == walker_id_ref);
+  CHECK(step == step_ref);
+  std::filesystem::remove(filename);
+}
+
+} // namespace qmcplusplus
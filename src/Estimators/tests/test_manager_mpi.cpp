@@ -11,6 +11,7 @@
 
 #include "catch.hpp"
 #include "Message/Communicate.h"
+#include "Message/CommOperators.h"
 
 #include "Platforms/Host/OutputManager.h"
 #include "QMCHamiltonians/QMCHamiltonian.h"
@@ -88,10 +89,13 @@ TEST_CASE("EstimatorManagerNew::makeBlockAverages()", "[estimators]")
 
 TEST_CASE("EstimatorManagerNew::reduceOperatorestimators()", "[estimators]")
 {
-  Communicate* c = OHMMS::Controller;
-  int num_ranks  = c->size();
+  using OperatorReduction = EstimatorManagerNew::OperatorReduction;
+  const auto reduction    = GENERATE(OperatorReduction::FLAT, OperatorReduction::HIERARCHICAL);
+  Communicate* c          = OHMMS::Controller;
+  int num_ranks           = c->size();
   QMCHamiltonian ham;
   testing::EstimatorManagerNewTest embt(ham, c, num_ranks);
+  embt.em.setOperatorReduction(reduction);
 
   embt.fakeSomeOperatorEstimatorSamples(c->rank());
   std::vector<QMCTraits::RealType> good_data = embt.generateGoodOperatorData(num_ranks);
@@ -117,4 +121,61 @@ TEST_CASE("EstimatorManagerNew::reduceOperatorestimators()", "[estimators]")
   }
 }
 
+TEST_CASE("EstimatorManagerNew::reduceOperatorestimators() hierarchical matches flat", "[estimators]")
+{
+  using OperatorReduction = EstimatorManagerNew::OperatorReduction;
+  Communicate* c          = OHMMS::Controller;
+  int num_ranks           = c->size();
+  QMCHamiltonian ham;
+  testing::EstimatorManagerNewTest embt_flat(ham, c, num_ranks);
+  testing::EstimatorManagerNewTest embt_hier(ham, c, num_ranks);
+  embt_flat.em.setOperatorReduction(OperatorReduction::FLAT);
+  embt_hier.em.setOperatorReduction(OperatorReduction::HIERARCHICAL);
+
+  // fractional walker weights which differ between the ranks
+  const QMCTraits::RealType weight = 0.75 + 0.5 * c->rank();
+  embt_flat.fakeSomeOperatorEstimatorSamples(c->rank(), weight);
+  embt_hier.fakeSomeOperatorEstimatorSamples(c->rank(), weight);
+  embt_flat.testReduceOperatorEstimators();
+  embt_hier.testReduceOperatorEstimators();
+
+  if (c->rank() == 0)
+  {
+    const QMCTraits::RealType total_weight = 0.75 * num_ranks + 0.25 * num_ranks * (num_ranks - 1);
+    CHECK(embt_flat.get_operator_weights()[0] == Approx(total_weight));
+    CHECK(embt_hier.get_operator_weights()[0] == Approx(total_weight));
+    auto& flat_data = embt_flat.get_operator_data();
+    auto& hier_data = embt_hier.get_operator_data();
+    REQUIRE(flat_data.size() == hier_data.size());
+    for (size_t i = 0; i < flat_data.size(); ++i)
+      CHECK(hier_data[i] == Approx(flat_data[i]));
+  }
+}
+
+TEST_CASE("EstimatorManagerNew::reduceOperatorestimators() distributed", "[estimators]")
+{
+  Communicate* c = OHMMS::Controller;
+  int num_ranks  = c->size();
+  QMCHamiltonian ham;
+  testing::EstimatorManagerNewTest embt(ham, c, num_ranks);
+  embt.em.setOperatorReduction(EstimatorManagerNew::OperatorReduction::DISTRIBUTED);
+
+  embt.fakeSomeOperatorEstimatorSamples(c->rank());
+  std::vector<QMCTraits::RealType> good_data = embt.generateGoodOperatorData(num_ranks);
+
+  embt.testReduceOperatorEstimators();
+
+  // every node leader holds its node average, weighted by the node weights they add up to the global sum
+  Communicate node_comm{c->NodeComm()};
+  auto& test_data = embt.get_operator_data();
+  std::vector<QMCTraits::RealType> weighted_data(test_data.size(), 0.0);
+  if (node_comm.rank() == 0)
+    for (size_t i = 0; i < test_data.size(); ++i)
+      weighted_data[i] = test_data[i] * embt.get_operator_weights()[0];
+  c->allreduce(weighted_data);
+
+  for (size_t i = 0; i < weighted_data.size(); ++i)
+    CHECK(weighted_data[i] == Approx(good_data[i]));
+}
+
 } // namespace qmcplusplus
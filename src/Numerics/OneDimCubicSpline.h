@@ -222,6 +222,40 @@ public:
     return eval.cubicInterpolate(m_Y[Loc], m_Y[Loc + 1], m_Y2[Loc], m_Y2[Loc + 1]);
   }
 
+  /** evaluate the function at n points, same as calling splint(r[i]) for each point
+   *@param n the number of points
+   *@param r the radial distances
+   *@param v return the values of the function
+   *
+   * On a linear grid the locate is arithmetic and the loop over points vectorizes,
+   * the spline coefficients are gathered. Other grids fall back to splint.
+   */
+  inline void evaluateV(const int n, const point_type* restrict r, value_type* restrict v) const
+  {
+    if (m_grid->getGridTag() != LINEAR_1DGRID)
+    {
+      for (int i = 0; i < n; ++i)
+        v[i] = splint(r[i]);
+      return;
+    }
+
+    const point_type* restrict x  = m_grid->data();
+    const value_type* restrict y  = m_Y.data();
+    const value_type* restrict y2 = m_Y2.data();
+    const double dLinv            = m_grid->DeltaInv;
+    const int last_loc            = m_Y.size() - 2;
+#pragma omp simd
+    for (int i = 0; i < n; ++i)
+    {
+      const point_type ri = r[i];
+      int Loc             = static_cast<int>((static_cast<double>(ri) - x[0]) * dLinv);
+      Loc                 = Loc < 0 ? 0 : (Loc > last_loc ? last_loc : Loc);
+      CubicSplineEvaluator<value_type> eval(ri - x[Loc], x[Loc + 1] - x[Loc]);
+      const value_type val = eval.cubicInterpolate(y[Loc], y[Loc + 1], y2[Loc], y2[Loc + 1]);
+      v[i]                 = ri < r_min ? y[0] + first_deriv * (ri - r_min) : (ri >= r_max ? ConstValue : val);
+    }
+  }
+
   /** Interpolation to evaluate the function and itsderivatives.
    *@param r the radial distance
    *@param du return the derivative
@@ -174,4 +174,30 @@ TEST_CASE("one_dim_cubic_spline_1", "[numerics]")
   CHECK(check_yvals_d2u[5].d2u == Approx(10.25));
 }
 
+TEST_CASE("one_dim_cubic_spline_evaluateV", "[numerics]")
+{
+  std::vector<double> yvals = {1.0, 2.0, 1.5, 0.7, 0.2};
+  // points below, inside and beyond the grid
+  std::vector<double> xvals = {-0.3, 0.0, 0.1, 0.5, 0.75, 1.3, 1.99, 2.0, 3.0};
+  std::vector<double> vals(xvals.size());
+
+  auto check = [&](OneDimCubicSpline<double>& cubic_spline) {
+    cubic_spline.spline(0, 1.0, yvals.size() - 1, 0.0);
+    cubic_spline.evaluateV(xvals.size(), xvals.data(), vals.data());
+    for (int i = 0; i < xvals.size(); i++)
+      CHECK(vals[i] == Approx(cubic_spline.splint(xvals[i])));
+  };
+
+  auto linear_grid = std::make_unique<LinearGrid<double>>();
+  linear_grid->set(0.0, 2.0, yvals.size());
+  OneDimCubicSpline<double> linear_spline(std::move(linear_grid), yvals);
+  check(linear_spline);
+
+  // not a linear grid, evaluateV falls back to splint
+  auto log_grid = std::make_unique<LogGrid<double>>();
+  log_grid->set(0.01, 2.0, yvals.size());
+  OneDimCubicSpline<double> log_spline(std::move(log_grid), yvals);
+  check(log_spline);
+}
+
 } // namespace qmcplusplus
@@ -186,6 +186,14 @@ void KContainer::BuildKLists(const ParticleLayout& lattice, const PosType& twist
     TempActualMax[2] = mmax[2];
   }
 
+  for (int idim = 0; idim < DIM; idim++)
+  {
+    PosType unit;
+    unit[idim]           = 1.0;
+    kpts_base_cart[idim] = lattice.k_cart(unit);
+  }
+  kpts_twist_cart = useSphere ? lattice.k_cart(twist) : PosType();
+
   //Update a record of the number of k vectors
   numk = kpts_tmp.size();
   std::map<int64_t, std::vector<int>*> kpts_sorted;
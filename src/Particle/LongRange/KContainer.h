@@ -59,6 +59,12 @@ public:
   std::vector<int> minusk;
   /** kpts which belong to the ith-shell [kshell[i], kshell[i+1]) */
   std::vector<int> kshell;
+  /** Cartesian vectors of the unit translations of the reciprocal cell and the twist
+   *
+   * kpts_cart[ik] = kpts_twist_cart + sum_d kpts[ik][d] * kpts_base_cart[d]
+   */
+  TinyVector<PosType, DIM> kpts_base_cart;
+  PosType kpts_twist_cart;
 
   /** k points sorted by the |k|  excluding |k|=0
    *
@@ -15,7 +15,6 @@
 
 #include "StructFact.h"
 #include "CPU/math.hpp"
-#include "CPU/e2iphi.h"
 #include "CPU/SIMD/vmath.hpp"
 #include "CPU/BLAS.hpp"
 #include "Utilities/qmc_common.h"
@@ -57,7 +56,62 @@ void StructFact::resize(int nkpts, int num_species, int num_ptcls)
 void StructFact::updateAllPart(const ParticleSet& P)
 {
   ScopedTimer local(update_all_timer_);
-  computeRhok(P);
+  if (!isIncrementallyCurrent(P))
+    computeRhok(P);
+}
+
+bool StructFact::isIncrementallyCurrent(const ParticleSet& P) const
+{
+  const size_t num_ptcls = P.getTotalNum();
+  if (!StorePerParticle || sk_positions_.size() != num_ptcls ||
+      num_incremental_updates_ >= incremental_recompute_sweeps * static_cast<int>(num_ptcls))
+    return false;
+  for (int i = 0; i < num_ptcls; i++)
+    if (sk_positions_[i] != P.R[i])
+      return false;
+  return true;
+}
+
+void StructFact::acceptMove(const ParticleSet& P, int iat, const PosType& rnew)
+{
+  // the stored eikr of iat must correspond to its old position
+  if (!StorePerParticle || sk_positions_.size() != P.getTotalNum() || sk_positions_[iat] != P.R[iat])
+    return;
+
+  const size_t nk = k_lists_.numk;
+  eikr_r_temp_.resize(nk);
+  eikr_i_temp_.resize(nk);
+  computeEikr(rnew, eikr_r_temp_.data(), eikr_i_temp_.data());
+
+  auto* restrict eikr_r_ptr     = eikr_r[iat];
+  auto* restrict eikr_i_ptr     = eikr_i[iat];
+  auto* restrict eikr_r_new_ptr = eikr_r_temp_.data();
+  auto* restrict eikr_i_new_ptr = eikr_i_temp_.data();
+  auto* restrict rhok_r_ptr     = rhok_r[P.getGroupID(iat)];
+  auto* restrict rhok_i_ptr     = rhok_i[P.getGroupID(iat)];
+#pragma omp simd
+  for (int ki = 0; ki < nk; ki++)
+  {
+    rhok_r_ptr[ki] += eikr_r_new_ptr[ki] - eikr_r_ptr[ki];
+    rhok_i_ptr[ki] += eikr_i_new_ptr[ki] - eikr_i_ptr[ki];
+    eikr_r_ptr[ki] = eikr_r_new_ptr[ki];
+    eikr_i_ptr[ki] = eikr_i_new_ptr[ki];
+  }
+  sk_positions_[iat] = rnew;
+  num_incremental_updates_++;
+}
+
+void StructFact::mw_acceptMove(const RefVectorWithLeader<StructFact>& sk_list,
+                               const RefVectorWithLeader<ParticleSet>& p_list,
+                               int iat,
+                               const std::vector<bool>& isAccepted)
+{
+  if (!sk_list.getLeader().StorePerParticle)
+    return;
+  ScopedTimer local(sk_list.getLeader().update_all_timer_);
+  for (int iw = 0; iw < sk_list.size(); iw++)
+    if (isAccepted[iw])
+      sk_list[iw].acceptMove(p_list[iw], iat, p_list[iw].activeR(iat));
 }
 
 void StructFact::mw_updateAllPart(const RefVectorWithLeader<StructFact>& sk_list,
@@ -69,7 +123,10 @@ void StructFact::mw_updateAllPart(const RefVectorWithLeader<StructFact>& sk_list
   ScopedTimer local(sk_leader.update_all_timer_);
   if (p_leader.getCoordinates().getKind() != DynamicCoordinateKind::DC_POS_OFFLOAD || sk_leader.StorePerParticle)
     for (int iw = 0; iw < sk_list.size(); iw++)
-      sk_list[iw].computeRhok(p_list[iw]);
+    {
+      if (!sk_list[iw].isIncrementallyCurrent(p_list[iw]))
+        sk_list[iw].computeRhok(p_list[iw]);
+    }
   else
   {
     const size_t nw          = p_list.size();
@@ -144,63 +201,95 @@ void StructFact::computeRhok(const ParticleSet& P)
 
   rhok_r = 0.0;
   rhok_i = 0.0;
+  if (!StorePerParticle)
+  {
+    eikr_r_temp_.resize(nk);
+    eikr_i_temp_.resize(nk);
+  }
+  // positions are only tracked for incremental updates, which need eikr per particle
   if (StorePerParticle)
+    sk_positions_.assign(P.R.begin(), P.R.end());
+  else
+    sk_positions_.clear();
+  num_incremental_updates_ = 0;
+
+  for (int i = 0; i < num_ptcls; ++i)
   {
-    // save per particle and species value
-    for (int i = 0; i < num_ptcls; ++i)
-    {
-      const auto& pos           = P.R[i];
-      auto* restrict eikr_r_ptr = eikr_r[i];
-      auto* restrict eikr_i_ptr = eikr_i[i];
-      auto* restrict rhok_r_ptr = rhok_r[P.getGroupID(i)];
-      auto* restrict rhok_i_ptr = rhok_i[P.getGroupID(i)];
+    // save per particle value if requested, otherwise only per species value
+    auto* restrict eikr_r_ptr = StorePerParticle ? eikr_r[i] : eikr_r_temp_.data();
+    auto* restrict eikr_i_ptr = StorePerParticle ? eikr_i[i] : eikr_i_temp_.data();
+    auto* restrict rhok_r_ptr = rhok_r[P.getGroupID(i)];
+    auto* restrict rhok_i_ptr = rhok_i[P.getGroupID(i)];
+    computeEikr(P.R[i], eikr_r_ptr, eikr_i_ptr);
 #pragma omp simd
-      for (int ki = 0; ki < nk; ki++)
-      {
-        qmcplusplus::sincos(dot(k_lists_.kpts_cart[ki], pos), &eikr_i_ptr[ki], &eikr_r_ptr[ki]);
-        rhok_r_ptr[ki] += eikr_r_ptr[ki];
-        rhok_i_ptr[ki] += eikr_i_ptr[ki];
-      }
+    for (int ki = 0; ki < nk; ki++)
+    {
+      rhok_r_ptr[ki] += eikr_r_ptr[ki];
+      rhok_i_ptr[ki] += eikr_i_ptr[ki];
     }
   }
-  else
+}
+
+void StructFact::computeEikr(const PosType& pos, RealType* restrict eikr_r_ptr, RealType* restrict eikr_i_ptr)
+{
+  using ComplexType  = std::complex<FullPrecRealType>;
+  const auto& mmax   = k_lists_.mmax;
+  const size_t nk    = k_lists_.numk;
+  const auto& kpts   = k_lists_.kpts;
+  size_t table_size  = 0;
+  TinyVector<size_t, DIM> zero_offset;
+  for (int idim = 0; idim < DIM; idim++)
   {
-    // save per species value
-    for (int i = 0; i < num_ptcls; ++i)
+    zero_offset[idim] = table_size + mmax[idim];
+    table_size += 2 * mmax[idim] + 1;
+  }
+  phase_table_.resize(table_size);
+
+  for (int idim = 0; idim < DIM; idim++)
+  {
+    const FullPrecRealType phase = dot(k_lists_.kpts_base_cart[idim], pos);
+    FullPrecRealType s, c;
+    qmcplusplus::sincos(phase, &s, &c);
+    const ComplexType base(c, s);
+    ComplexType* restrict table = phase_table_.data() + zero_offset[idim];
+    table[0]                    = ComplexType(1.0, 0.0);
+    for (int n = 1; n <= mmax[idim]; n++)
     {
-      const auto& pos           = P.R[i];
-      auto* restrict rhok_r_ptr = rhok_r[P.getGroupID(i)];
-      auto* restrict rhok_i_ptr = rhok_i[P.getGroupID(i)];
-#if defined(__INTEL_COMPILER) || defined(__INTEL_LLVM_COMPILER)
-#pragma omp simd
-      for (int ki = 0; ki < nk; ki++)
+      if (n % eikr_reseed_interval == 0)
       {
-        RealType s, c;
-        qmcplusplus::sincos(dot(k_lists_.kpts_cart[ki], pos), &s, &c);
-        rhok_r_ptr[ki] += c;
-        rhok_i_ptr[ki] += s;
+        qmcplusplus::sincos(n * phase, &s, &c);
+        table[n] = ComplexType(c, s);
       }
-#else
-      // make the compute over nk by blocks
-      constexpr size_t kblock_size = 512;
-      const size_t num_kblocks     = (nk + kblock_size) / kblock_size;
-      RealType phiV[kblock_size], eikr_r_temp[kblock_size], eikr_i_temp[kblock_size];
+      else
+        table[n] = table[n - 1] * base;
+      table[-n] = std::conj(table[n]);
+    }
+  }
 
-      for (int ib = 0; ib < num_kblocks; ib++)
-      {
-        const size_t offset          = ib * kblock_size;
-        const size_t this_block_size = std::min(kblock_size, nk - offset);
-        for (int ki = 0; ki < this_block_size; ki++)
-          phiV[ki] = dot(k_lists_.kpts_cart[ki + offset], pos);
-        eval_e2iphi(this_block_size, phiV, eikr_r_temp, eikr_i_temp);
-        for (int ki = 0; ki < this_block_size; ki++)
-        {
-          rhok_r_ptr[ki + offset] += eikr_r_temp[ki];
-          rhok_i_ptr[ki + offset] += eikr_i_temp[ki];
-        }
-      }
-#endif
+  // the twist phase is folded into the first dimension
+  {
+    FullPrecRealType s, c;
+    qmcplusplus::sincos(static_cast<FullPrecRealType>(dot(k_lists_.kpts_twist_cart, pos)), &s, &c);
+    const ComplexType twist(c, s);
+    for (int n = -mmax[0]; n <= mmax[0]; n++)
+      phase_table_[zero_offset[0] + n] *= twist;
+  }
+
+  // complex products written out to stay away from the inf/nan handling of std::complex multiplication
+  for (int ki = 0; ki < nk; ki++)
+  {
+    const ComplexType& first = phase_table_[zero_offset[0] + kpts[ki][0]];
+    FullPrecRealType re      = first.real();
+    FullPrecRealType im      = first.imag();
+    for (int idim = 1; idim < DIM; idim++)
+    {
+      const ComplexType& factor = phase_table_[zero_offset[idim] + kpts[ki][idim]];
+      const FullPrecRealType tmp = re * factor.real() - im * factor.imag();
+      im                         = re * factor.imag() + im * factor.real();
+      re                         = tmp;
     }
+    eikr_r_ptr[ki] = re;
+    eikr_i_ptr[ki] = im;
   }
 }
 
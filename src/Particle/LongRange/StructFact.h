@@ -21,6 +21,7 @@
 #include <NewTimer.h>
 #include <OMPTarget/OffloadAlignedAllocators.hpp>
 #include <type_traits/template_types.hpp>
+#include <complex>
 
 namespace qmcplusplus
 {
@@ -74,6 +75,22 @@ public:
                                const RefVectorWithLeader<ParticleSet>& p_list,
                                SKMultiWalkerMem& mw_mem);
 
+  /** update rhok and eikr after an accepted single particle move
+   * @param P particle set, P.R[iat] still holds the old position
+   * @param iat the moved particle
+   * @param rnew the new position
+   *
+   * Only effective when StorePerParticle is on and the stored data corresponds to the positions in P.
+   * Otherwise the next updateAllPart recomputes everything.
+   */
+  void acceptMove(const ParticleSet& P, int iat, const PosType& rnew);
+
+  /// batched version of acceptMove, only walkers with isAccepted set are updated
+  static void mw_acceptMove(const RefVectorWithLeader<StructFact>& sk_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list,
+                            int iat,
+                            const std::vector<bool>& isAccepted);
+
   /** @brief switch on the storage per particle
    * if StorePerParticle was false, this function allocates memory and precompute data
    * if StorePerParticle was true, this function is no-op
@@ -86,9 +103,27 @@ public:
   /// accessor of k_lists_
   const KContainer& getKLists() const { return k_lists_; }
 
+  /// number of incremental updates since the last full recompute
+  int getNumIncrementalUpdates() const { return num_incremental_updates_; }
+
+  /** full recompute is forced after this many sweeps worth of incremental updates
+   * to remove the round-off accumulated in rhok
+   */
+  static constexpr int incremental_recompute_sweeps = 16;
+
 private:
   /// Compute all rhok elements from the start
   void computeRhok(const ParticleSet& P);
+  /// true if rhok and eikr are up-to-date with P.R through incremental updates and no recompute is due
+  bool isIncrementallyCurrent(const ParticleSet& P) const;
+  /** compute e^{i k.r} of one particle for all the k-vectors
+   *
+   * Every k-vector is an integer combination of the reciprocal lattice vectors plus the twist,
+   * e^{i k.r} = e^{i t.r} prod_d (e^{i b_d.r})^{n_d}. The powers of the base phases are tabulated by recurrence
+   * so that each k-vector only costs complex multiplications instead of a sincos.
+   * To bound the accumulated round-off, the table is reseeded with a direct sincos every eikr_reseed_interval powers.
+   */
+  void computeEikr(const PosType& pos, RealType* restrict eikr_r_ptr, RealType* restrict eikr_i_ptr);
   /** resize the internal data
    * @param nkpts
    * @param num_species number of species
@@ -105,6 +140,18 @@ private:
   bool StorePerParticle;
   /// timer for updateAllPart
   NewTimer& update_all_timer_;
+  /// powers of the base phases e^{i n b_d.r} for n in [-mmax[d], mmax[d]], stored dimension by dimension
+  std::vector<std::complex<FullPrecRealType>> phase_table_;
+  /// e^{i k.r} of a single particle when not stored per particle
+  std::vector<RealType> eikr_r_temp_, eikr_i_temp_;
+  /// particle positions rhok and eikr correspond to. Only tracked when StorePerParticle is on
+  std::vector<PosType> sk_positions_;
+  /// number of incremental updates since the last computeRhok
+  int num_incremental_updates_ = 0;
+
+public:
+  /// number of recurrence steps between two direct sincos evaluations in computeEikr
+  static constexpr int eikr_reseed_interval = 16;
 };
 
 ///multi walker shared memory buffer
@@ -16,6 +16,8 @@
 #include "Configuration.h"
 #include "ParticleSet.h"
 #include "LongRange/StructFact.h"
+#include "LongRange/KContainer.h"
+#include <ResourceCollection.h>
 
 namespace qmcplusplus
 {
@@ -70,4 +72,144 @@ TEST_CASE("StructFact", "[lrhandler]")
   }
 }
 
+TEST_CASE("StructFact eikr recurrence", "[lrhandler]")
+{
+  using RealType = QMCTraits::RealType;
+  using PosType  = QMCTraits::PosType;
+
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> Lattice;
+  Lattice.BoxBConds = true;
+  Lattice.R         = {4.0, 0.3, 0.0, 0.5, 3.5, 0.2, -0.4, 0.1, 5.0};
+  Lattice.reset();
+
+  const SimulationCell simulation_cell(Lattice);
+  ParticleSet ref(simulation_cell);
+  SpeciesSet& tspecies = ref.getSpeciesSet();
+  tspecies.addSpecies("u");
+  tspecies.addSpecies("d");
+  ref.create({2, 1});
+  ref.R[0] = {0.0, 1.0, 2.0};
+  ref.R[1] = {-7.3, 12.2, 3.0};
+  ref.R[2] = {25.1, -4.0, 17.4};
+
+  // large enough cutoff to go through several reseeds of the phase table
+  KContainer klists;
+  klists.updateKLists(Lattice, 30.0, OHMMS_DIM, PosType{0.25, -0.1, 0.4});
+  REQUIRE(klists.mmax[OHMMS_DIM] > StructFact::eikr_reseed_interval);
+
+  StructFact sk(Lattice, klists);
+  sk.turnOnStorePerParticle(ref);
+
+  // compare against direct sincos of every k-vector
+  double eikr_error = 0, rhok_error = 0;
+  std::vector<std::complex<double>> rhok(ref.groups() * klists.numk);
+  for (int i = 0; i < ref.getTotalNum(); i++)
+    for (int ik = 0; ik < klists.numk; ik++)
+    {
+      const double phase = dot(klists.kpts_cart[ik], ref.R[i]);
+      const std::complex<double> eikr(std::cos(phase), std::sin(phase));
+      eikr_error = std::max(eikr_error, std::abs(std::complex<double>(sk.eikr_r[i][ik], sk.eikr_i[i][ik]) - eikr));
+      rhok[ref.getGroupID(i) * klists.numk + ik] += eikr;
+    }
+  for (int is = 0; is < ref.groups(); is++)
+    for (int ik = 0; ik < klists.numk; ik++)
+      rhok_error = std::max(rhok_error,
+                            std::abs(std::complex<double>(sk.rhok_r[is][ik], sk.rhok_i[is][ik]) -
+                                     rhok[is * klists.numk + ik]));
+
+  const double eps = std::is_same<RealType, float>::value ? 2e-4 : 1e-10;
+  CHECK(eikr_error < eps);
+  CHECK(rhok_error < 2 * eps);
+}
+
+/// largest deviation of the rhok of P from a full recompute
+double rhokDeviation(const ParticleSet& P)
+{
+  const StructFact& sk = P.getSK();
+  StructFact sk_ref(P.getLRBox(), sk.getKLists());
+  sk_ref.updateAllPart(P);
+  double error = 0;
+  for (int is = 0; is < P.groups(); is++)
+    for (int ik = 0; ik < sk.getKLists().numk; ik++)
+    {
+      error = std::max(error, std::abs(static_cast<double>(sk.rhok_r[is][ik] - sk_ref.rhok_r[is][ik])));
+      error = std::max(error, std::abs(static_cast<double>(sk.rhok_i[is][ik] - sk_ref.rhok_i[is][ik])));
+    }
+  return error;
+}
+
+TEST_CASE("StructFact incremental update", "[lrhandler]")
+{
+  using PosType = QMCTraits::PosType;
+
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> Lattice;
+  Lattice.BoxBConds = true;
+  Lattice.R.diagonal(5.0);
+  Lattice.reset();
+
+  const SimulationCell simulation_cell(Lattice);
+  ParticleSet elec(simulation_cell);
+  SpeciesSet& tspecies = elec.getSpeciesSet();
+  tspecies.addSpecies("u");
+  tspecies.addSpecies("d");
+  elec.create({2, 1});
+  elec.R[0] = {0.0, 1.0, 2.0};
+  elec.R[1] = {1.0, 0.2, 3.0};
+  elec.R[2] = {0.3, 4.0, 1.4};
+  elec.createSK();
+  elec.turnOnPerParticleSK();
+  elec.update();
+
+  const StructFact& sk = elec.getSK();
+  REQUIRE(sk.isStorePerParticle());
+  CHECK(sk.getNumIncrementalUpdates() == 0);
+
+  const PosType disp{0.1, -0.3, 0.25};
+  elec.makeMove(1, disp);
+  elec.accept_rejectMove(1, true, false);
+  CHECK(sk.getNumIncrementalUpdates() == 1);
+  elec.makeMove(2, disp);
+  elec.accept_rejectMove(2, false, false);
+  CHECK(sk.getNumIncrementalUpdates() == 1);
+  // rhok is current, no recompute
+  elec.donePbyP();
+  CHECK(sk.getNumIncrementalUpdates() == 1);
+  CHECK(rhokDeviation(elec) < 1e-5);
+
+  // positions changed behind the back of StructFact
+  elec.R[2] = {2.3, 1.0, 0.4};
+  elec.update();
+  CHECK(sk.getNumIncrementalUpdates() == 0);
+  CHECK(rhokDeviation(elec) < 1e-5);
+
+  // periodic recompute
+  const int num_moves = StructFact::incremental_recompute_sweeps * elec.getTotalNum();
+  for (int i = 0; i < num_moves; i++)
+  {
+    elec.makeMove(i % 3, disp);
+    elec.accept_rejectMove(i % 3, true, true);
+  }
+  CHECK(sk.getNumIncrementalUpdates() == num_moves);
+  elec.donePbyP();
+  CHECK(sk.getNumIncrementalUpdates() == 0);
+  CHECK(rhokDeviation(elec) < 1e-5);
+
+  // batched
+  ParticleSet elec_clone(elec);
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec_clone});
+  ResourceCollection pset_res("test_pset_res");
+  elec.createResource(pset_res);
+  ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, p_list);
+
+  std::vector<PosType> mw_disp{disp, disp};
+  ParticleSet::mw_makeMove(p_list, 0, mw_disp);
+  ParticleSet::mw_accept_rejectMove(p_list, 0, {true, false}, true);
+  CHECK(elec.getSK().getNumIncrementalUpdates() == 1);
+  CHECK(elec_clone.getSK().getNumIncrementalUpdates() == 0);
+  ParticleSet::mw_donePbyP(p_list);
+  CHECK(elec.getSK().getNumIncrementalUpdates() == 1);
+  CHECK(rhokDeviation(elec) < 1e-5);
+  CHECK(rhokDeviation(elec_clone) < 1e-5);
+}
+
 } // namespace qmcplusplus
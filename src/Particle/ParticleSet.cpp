@@ -28,6 +28,7 @@
 #include "Utilities/RandomGenerator.h"
 #include "ParticleBase/RandomSeqGeneratorGlobal.h"
 #include "ResourceCollection.h"
+#include "MemoryAccounting.h"
 
 namespace qmcplusplus
 {
@@ -314,6 +315,7 @@ int ParticleSet::addTable(const ParticleSet& psrc, DTModes modes)
   if (tit == myDistTableMap.end())
   {
     std::ostringstream description;
+    ScopedMemoryTag distance_table_memory(MemoryTag::DISTANCE_TABLE);
     tid = DistTables.size();
     if (myName == psrc.getName())
       DistTables.push_back(createDistanceTable(*this, description));
@@ -648,6 +650,8 @@ void ParticleSet::acceptMove(Index_t iat)
   coordinates_->setOneParticlePos(active_pos_, iat);
   for (int i = 0; i < DistTables.size(); i++)
     DistTables[i]->update(iat);
+  if (structure_factor_)
+    structure_factor_->acceptMove(*this, iat, active_pos_);
 
   R[iat]       = active_pos_;
   spins[iat]   = active_spin_val_;
@@ -662,6 +666,8 @@ void ParticleSet::acceptMoveForwardMode(Index_t iat)
   coordinates_->setOneParticlePos(active_pos_, iat);
   for (int i = 0; i < DistTables.size(); i++)
     DistTables[i]->updatePartial(iat, true);
+  if (structure_factor_)
+    structure_factor_->acceptMove(*this, iat, active_pos_);
 
   R[iat]       = active_pos_;
   spins[iat]   = active_spin_val_;
@@ -735,6 +741,9 @@ void ParticleSet::mw_accept_rejectMove(const RefVectorWithLeader<ParticleSet>& p
       dts[i]->mw_updatePartial(dt_list, iat, isAccepted);
     }
 
+    if (p_leader.structure_factor_)
+      StructFact::mw_acceptMove(extractSKRefList(p_list), p_list, iat, isAccepted);
+
     for (int iw = 0; iw < p_list.size(); iw++)
     {
       assert(iat == p_list[iw].active_ptcl_);
@@ -944,8 +953,11 @@ int ParticleSet::addPropertyHistory(int leng)
 void ParticleSet::createResource(ResourceCollection& collection) const
 {
   coordinates_->createResource(collection);
-  for (int i = 0; i < DistTables.size(); i++)
-    DistTables[i]->createResource(collection);
+  {
+    ScopedMemoryTag distance_table_memory(MemoryTag::DISTANCE_TABLE);
+    for (int i = 0; i < DistTables.size(); i++)
+      DistTables[i]->createResource(collection);
+  }
   if (structure_factor_)
     collection.addResource(std::make_unique<SKMultiWalkerMem>());
 }
@@ -17,7 +17,8 @@
 #include <cstdlib>
 #include <string>
 #include <stdexcept>
-#include <string>
+#include <type_traits>
+#include "MemoryAccounting.h"
 
 namespace qmcplusplus
 {
@@ -31,11 +32,24 @@ struct Mallocator
 
   static constexpr size_t alignment = ALIGN;
 
-  Mallocator() = default;
+  /** The memory accounting key is captured at construction, not at allocation, so the memory of a container is
+   *  accounted to the subsystem that created it and allocate/deallocate always use the same key.
+   *  Containers carry their allocator along with their memory on move and swap.
+   */
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap            = std::true_type;
+  using is_always_equal                        = std::true_type;
+
+  Mallocator() : memory_key_(getMemoryAccountingKey()) {}
   template<class U>
-  Mallocator(const Mallocator<U, ALIGN>&)
+  Mallocator(const Mallocator<U, ALIGN>& other) : memory_key_(other.getMemoryKey())
   {}
 
+  /// a copied container is accounted to the scope that copies it
+  Mallocator select_on_container_copy_construction() const { return Mallocator(); }
+
+  MemoryAccountingKey getMemoryKey() const { return memory_key_; }
+
   template<class U>
   struct rebind
   {
@@ -47,10 +61,7 @@ struct Mallocator
     if (n == 0)
       throw std::runtime_error("Mallocator::allocate does not accept size 0 allocations.");
     void* pt(nullptr);
-    std::size_t asize = n * sizeof(T);
-    std::size_t amod  = asize % ALIGN;
-    if (amod != 0)
-      asize += ALIGN - amod;
+    const std::size_t asize = alignedBytes(n);
 
 #if __STDC_VERSION__ >= 201112L || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 16)
     // as per C11 standard asize must be an integral multiple of ALIGN
@@ -68,6 +79,7 @@ struct Mallocator
     if (pt == nullptr)
       throw std::runtime_error("Allocation failed in Mallocator, requested size in bytes = " +
                                std::to_string(n * sizeof(T)));
+    recordMemoryAllocation(memory_key_, asize);
     return static_cast<T*>(pt);
   }
 
@@ -75,8 +87,22 @@ struct Mallocator
   {
     if (n == 0)
       throw std::runtime_error("Mallocator::deallocate does not accept size 0 allocations.");
+    recordMemoryDeallocation(memory_key_, alignedBytes(n));
     free(p);
   }
+
+private:
+  MemoryAccountingKey memory_key_;
+
+  /// allocation size in bytes rounded up to a multiple of ALIGN
+  static std::size_t alignedBytes(std::size_t n)
+  {
+    std::size_t asize = n * sizeof(T);
+    std::size_t amod  = asize % ALIGN;
+    if (amod != 0)
+      asize += ALIGN - amod;
+    return asize;
+  }
 };
 
 template<class T1, size_t ALIGN1, class T2, size_t ALIGN2>
@@ -46,6 +46,7 @@ string getDateAndTime(const char* format)
 }
 
 #ifdef __linux__
+#include <sched.h>
 #include <sys/sysinfo.h>
 #include <sys/resource.h>
 #endif
@@ -73,3 +74,35 @@ size_t memusage()
   return 0;
 #endif
 }
+
+const std::vector<int>& getProcessCPUs()
+{
+  static const std::vector<int> process_cpus = [] {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+      for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+        if (CPU_ISSET(cpu, &mask))
+          cpus.push_back(cpu);
+#endif
+    return cpus;
+  }();
+  return process_cpus;
+}
+
+bool bindThreadToCPU(int cpu) { return bindThreadToCPUs({cpu}); }
+
+bool bindThreadToCPUs(const std::vector<int>& cpus)
+{
+#ifdef __linux__
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int cpu : cpus)
+    CPU_SET(cpu, &mask);
+  return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+  return false;
+#endif
+}
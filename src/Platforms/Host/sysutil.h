@@ -19,6 +19,7 @@
  * Function declarations to get system information.
  */
 #include <string>
+#include <vector>
 
 //!< return the host name
 std::string getHostName();
@@ -34,4 +35,19 @@ size_t freemem();
 
 size_t memusage();
 
+/** return the CPUs the process may run on, captured at the first call
+ *  Call it before any thread is bound. Empty if the platform does not support thread binding.
+ */
+const std::vector<int>& getProcessCPUs();
+
+/** bind the calling thread to a single CPU
+ *  @return false if the binding failed or is not supported
+ */
+bool bindThreadToCPU(int cpu);
+
+/** bind the calling thread to a set of CPUs
+ *  @return false if the binding failed or is not supported
+ */
+bool bindThreadToCPUs(const std::vector<int>& cpus);
+
 #endif
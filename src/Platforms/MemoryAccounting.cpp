@@ -0,0 +1,77 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "MemoryAccounting.h"
+#include <array>
+#include <iomanip>
+
+namespace qmcplusplus
+{
+MemoryAccountingCounter memory_accounting_counters[num_memory_tags * num_memory_scopes];
+thread_local MemoryTag current_memory_tag     = MemoryTag::UNTAGGED;
+thread_local MemoryScope current_memory_scope = MemoryScope::SHARED;
+
+int64_t getMemoryAccountedCurrent(MemoryTag tag, MemoryScope scope)
+{
+  return memory_accounting_counters[makeMemoryAccountingKey(tag, scope)].current;
+}
+
+size_t getMemoryAccountedPeak(MemoryTag tag, MemoryScope scope)
+{
+  return memory_accounting_counters[makeMemoryAccountingKey(tag, scope)].peak;
+}
+
+void resetMemoryAccountedPeaks()
+{
+  for (auto& counter : memory_accounting_counters)
+    counter.peak = counter.current.load();
+}
+
+void printMemoryAccounting(std::ostream& log, size_t num_walkers)
+{
+  static const std::array<const char*, num_memory_tags> tag_names{"untagged", "splines", "determinants",
+                                                                  "distance tables", "estimators"};
+  constexpr double MiB = 1 << 20;
+
+  const auto flags     = log.flags();
+  const auto precision = log.precision();
+  log << "Host memory by subsystem and owner, current / peak MiB" << std::endl;
+  log << std::left << std::setw(18) << "  subsystem" << std::right << std::setw(20) << "shared" << std::setw(20)
+      << "crowds" << std::setw(20) << "walkers" << std::endl;
+  int64_t walker_bytes = 0;
+  bool negative        = false;
+  log << std::fixed << std::setprecision(1);
+  for (size_t itag = 0; itag < num_memory_tags; ++itag)
+  {
+    const auto tag = static_cast<MemoryTag>(itag);
+    log << "  " << std::left << std::setw(16) << tag_names[itag] << std::right;
+    for (size_t iscope = 0; iscope < num_memory_scopes; ++iscope)
+    {
+      const auto scope      = static_cast<MemoryScope>(iscope);
+      const int64_t current = getMemoryAccountedCurrent(tag, scope);
+      negative              = negative || current < 0;
+      log << std::setw(10) << current / MiB << " /" << std::setw(8) << getMemoryAccountedPeak(tag, scope) / MiB;
+    }
+    log << std::endl;
+    walker_bytes += getMemoryAccountedCurrent(tag, MemoryScope::WALKER);
+  }
+  if (num_walkers > 0)
+    log << "Projected host memory per additional walker : " << std::setw(10) << walker_bytes / MiB / num_walkers
+        << " MiB" << std::endl;
+  if (negative)
+    log << "Warning: negative memory balances, some memory was released under another subsystem or owner "
+        << "than it was allocated with." << std::endl;
+  log.flags(flags);
+  log.precision(precision);
+}
+
+} // namespace qmcplusplus
@@ -0,0 +1,134 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file
+ *  Accounting of host memory allocated through Mallocator by subsystem and ownership scope.
+ *
+ *  An allocator captures the tag and the scope active on the constructing thread when it is constructed,
+ *  so memory is accounted to the code that created the container rather than to the code that resized it.
+ *  Tags and scopes are set with ScopedMemoryTag and ScopedMemoryScope at the few places where walkers,
+ *  crowds and the large objects of a subsystem are created.
+ */
+#ifndef QMCPLUSPLUS_MEMORYACCOUNTING_H
+#define QMCPLUSPLUS_MEMORYACCOUNTING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+namespace qmcplusplus
+{
+/// subsystem owning the memory
+enum class MemoryTag : uint8_t
+{
+  UNTAGGED = 0,
+  SPLINE,
+  DETERMINANT,
+  DISTANCE_TABLE,
+  ESTIMATOR,
+  NUM_TAGS
+};
+
+/// how many copies of the memory exist, shared by the rank, one per crowd or one per walker
+enum class MemoryScope : uint8_t
+{
+  SHARED = 0,
+  CROWD,
+  WALKER,
+  NUM_SCOPES
+};
+
+/// compact tag and scope of an allocator
+using MemoryAccountingKey = uint8_t;
+
+struct MemoryAccountingCounter
+{
+  std::atomic<int64_t> current{0};
+  std::atomic<int64_t> peak{0};
+};
+
+constexpr size_t num_memory_tags   = static_cast<size_t>(MemoryTag::NUM_TAGS);
+constexpr size_t num_memory_scopes = static_cast<size_t>(MemoryScope::NUM_SCOPES);
+
+extern MemoryAccountingCounter memory_accounting_counters[num_memory_tags * num_memory_scopes];
+extern thread_local MemoryTag current_memory_tag;
+extern thread_local MemoryScope current_memory_scope;
+
+inline MemoryAccountingKey makeMemoryAccountingKey(MemoryTag tag, MemoryScope scope)
+{
+  return static_cast<MemoryAccountingKey>(static_cast<size_t>(tag) * num_memory_scopes + static_cast<size_t>(scope));
+}
+
+/// key of the tag and the scope active on the calling thread
+inline MemoryAccountingKey getMemoryAccountingKey()
+{
+  return makeMemoryAccountingKey(current_memory_tag, current_memory_scope);
+}
+
+inline void recordMemoryAllocation(MemoryAccountingKey key, size_t bytes)
+{
+  auto& counter     = memory_accounting_counters[key];
+  const int64_t now = counter.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+  int64_t peak      = counter.peak.load(std::memory_order_relaxed);
+  while (now > peak && !counter.peak.compare_exchange_weak(peak, now, std::memory_order_relaxed))
+    ;
+}
+
+inline void recordMemoryDeallocation(MemoryAccountingKey key, size_t bytes)
+{
+  memory_accounting_counters[key].current.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+/** bytes currently allocated with the given tag and scope
+ *  A negative value means memory was released under another tag or scope than it was allocated with.
+ */
+int64_t getMemoryAccountedCurrent(MemoryTag tag, MemoryScope scope);
+/// highest value of getMemoryAccountedCurrent since the start or the last resetMemoryAccountedPeaks
+size_t getMemoryAccountedPeak(MemoryTag tag, MemoryScope scope);
+/// set the peaks to the current values
+void resetMemoryAccountedPeaks();
+
+/** print current and peak bytes per tag and scope.
+ *  @param num_walkers if not zero, the WALKER scope memory is divided by it to project the cost of an additional walker.
+ *  Negative balances are printed as they are and flagged with a warning.
+ */
+void printMemoryAccounting(std::ostream& log, size_t num_walkers = 0);
+
+/// set the memory tag of the calling thread for the lifetime of the object
+class ScopedMemoryTag
+{
+public:
+  explicit ScopedMemoryTag(MemoryTag tag) : previous_(current_memory_tag) { current_memory_tag = tag; }
+  ~ScopedMemoryTag() { current_memory_tag = previous_; }
+  ScopedMemoryTag(const ScopedMemoryTag&)            = delete;
+  ScopedMemoryTag& operator=(const ScopedMemoryTag&) = delete;
+
+private:
+  const MemoryTag previous_;
+};
+
+/// set the memory scope of the calling thread for the lifetime of the object
+class ScopedMemoryScope
+{
+public:
+  explicit ScopedMemoryScope(MemoryScope scope) : previous_(current_memory_scope) { current_memory_scope = scope; }
+  ~ScopedMemoryScope() { current_memory_scope = previous_; }
+  ScopedMemoryScope(const ScopedMemoryScope&)            = delete;
+  ScopedMemoryScope& operator=(const ScopedMemoryScope&) = delete;
+
+private:
+  const MemoryScope previous_;
+};
+
+} // namespace qmcplusplus
+#endif
@@ -11,6 +11,7 @@
 
 
 #include "MemoryUsage.h"
+#include "MemoryAccounting.h"
 #include <cstring>
 #include <string>
 #include <iomanip>
@@ -27,7 +28,7 @@
 
 namespace qmcplusplus
 {
-void print_mem(const std::string& title, std::ostream& log)
+void print_mem(const std::string& title, std::ostream& log, size_t num_walkers)
 {
   std::string line_separator;
   for (int i = 0; i < title.size() + 30; i++)
@@ -54,6 +55,7 @@ void print_mem(const std::string& title, std::ostream& log)
   log << "Free memory on the default device          : " << std::setw(7) << (getSYCLdeviceFreeMem() >> 20) << " MiB"
       << std::endl;
 #endif
+  printMemoryAccounting(log, num_walkers);
   log << line_separator << std::endl;
 }
 
@@ -13,13 +13,17 @@
 #ifndef QMCPLUSPLUS_MEMORYUSAGE_H
 #define QMCPLUSPLUS_MEMORYUSAGE_H
 
+#include <cstddef>
 #include <iostream>
 #include <string>
 
 namespace qmcplusplus
 {
 
-void print_mem(const std::string& title, std::ostream& log);
+/** print the process memory usage and the host memory accounted per subsystem
+ *  @param num_walkers walkers allocated on this rank, if not zero the memory per additional walker is also printed
+ */
+void print_mem(const std::string& title, std::ostream& log, size_t num_walkers = 0);
 
 }
 #endif
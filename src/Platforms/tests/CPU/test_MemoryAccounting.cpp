@@ -0,0 +1,126 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "catch.hpp"
+
+#include <sstream>
+#include <thread>
+#include "config.h"
+#include "CPU/SIMD/aligned_allocator.hpp"
+#include "MemoryAccounting.h"
+
+namespace qmcplusplus
+{
+TEST_CASE("MemoryAccounting tag and scope", "[platforms]")
+{
+  const int64_t spline_walker = getMemoryAccountedCurrent(MemoryTag::SPLINE, MemoryScope::WALKER);
+  const int64_t spline_shared = getMemoryAccountedCurrent(MemoryTag::SPLINE, MemoryScope::SHARED);
+  {
+    aligned_vector<double> untagged(16);
+    ScopedMemoryScope walker_memory(MemoryScope::WALKER);
+    {
+      ScopedMemoryTag spline_memory(MemoryTag::SPLINE);
+      aligned_vector<double> tagged(1000);
+      CHECK(getMemoryAccountedCurrent(MemoryTag::SPLINE, MemoryScope::WALKER) ==
+            spline_walker + getAlignedSize<double>(1000) * sizeof(double));
+      CHECK(getMemoryAccountedCurrent(MemoryTag::SPLINE, MemoryScope::SHARED) == spline_shared);
+    }
+    CHECK(getMemoryAccountedCurrent(MemoryTag::SPLINE, MemoryScope::WALKER) == spline_walker);
+    CHECK(getMemoryAccountedPeak(MemoryTag::SPLINE, MemoryScope::WALKER) >=
+          spline_walker + getAlignedSize<double>(1000) * sizeof(double));
+  }
+
+  // the previous tag and scope are restored
+  CHECK(getMemoryAccountingKey() == makeMemoryAccountingKey(MemoryTag::UNTAGGED, MemoryScope::SHARED));
+
+  // tags are per thread
+  MemoryAccountingKey other_key;
+  ScopedMemoryTag determinant_memory(MemoryTag::DETERMINANT);
+  std::thread other([&other_key] { other_key = getMemoryAccountingKey(); });
+  other.join();
+  CHECK(other_key == makeMemoryAccountingKey(MemoryTag::UNTAGGED, MemoryScope::SHARED));
+  CHECK(getMemoryAccountingKey() == makeMemoryAccountingKey(MemoryTag::DETERMINANT, MemoryScope::SHARED));
+}
+
+TEST_CASE("MemoryAccounting key follows the container", "[platforms]")
+{
+  const int64_t determinants = getMemoryAccountedCurrent(MemoryTag::DETERMINANT, MemoryScope::CROWD);
+  const int64_t bytes        = getAlignedSize<float>(311) * sizeof(float);
+
+  aligned_vector<float> created_in_scope;
+  {
+    ScopedMemoryScope crowd_memory(MemoryScope::CROWD);
+    ScopedMemoryTag determinant_memory(MemoryTag::DETERMINANT);
+    aligned_vector<float> tagged;
+    created_in_scope.swap(tagged);
+  }
+  // resized outside the scope but accounted to the scope the container was created in
+  created_in_scope.resize(311);
+  CHECK(getMemoryAccountedCurrent(MemoryTag::DETERMINANT, MemoryScope::CROWD) == determinants + bytes);
+
+  // a copy belongs to the scope that copies
+  aligned_vector<float> copied(created_in_scope);
+  CHECK(getMemoryAccountedCurrent(MemoryTag::DETERMINANT, MemoryScope::CROWD) == determinants + bytes);
+
+  // move assignment carries the memory and its key
+  aligned_vector<float> moved;
+  moved = std::move(created_in_scope);
+  created_in_scope.shrink_to_fit();
+  CHECK(getMemoryAccountedCurrent(MemoryTag::DETERMINANT, MemoryScope::CROWD) == determinants + bytes);
+  moved.clear();
+  moved.shrink_to_fit();
+  CHECK(getMemoryAccountedCurrent(MemoryTag::DETERMINANT, MemoryScope::CROWD) == determinants);
+}
+
+TEST_CASE("MemoryAccounting report", "[platforms]")
+{
+  ScopedMemoryScope walker_memory(MemoryScope::WALKER);
+  ScopedMemoryTag distance_table_memory(MemoryTag::DISTANCE_TABLE);
+  aligned_vector<char> walker_a(1 << 20);
+  aligned_vector<char> walker_b(1 << 20);
+
+  int64_t walker_bytes = 0;
+  for (size_t itag = 0; itag < num_memory_tags; ++itag)
+    walker_bytes += getMemoryAccountedCurrent(static_cast<MemoryTag>(itag), MemoryScope::WALKER);
+  REQUIRE(walker_bytes >= 2 << 20);
+
+  std::ostringstream report;
+  printMemoryAccounting(report, 2);
+  CHECK(report.str().find("distance tables") != std::string::npos);
+  CHECK(report.str().find("Warning") == std::string::npos);
+
+  // the projection is the walker memory of all the subsystems divided by the number of walkers
+  const std::string projected_label = "Projected host memory per additional walker :";
+  const auto label_pos              = report.str().find(projected_label);
+  REQUIRE(label_pos != std::string::npos);
+  std::istringstream projected_line(report.str().substr(label_pos + projected_label.size()));
+  double projected_mib = 0;
+  std::string unit;
+  projected_line >> projected_mib >> unit;
+  CHECK(unit == "MiB");
+  CHECK(projected_mib == Approx(walker_bytes / double(1 << 20) / 2).margin(0.05));
+  CHECK(projected_mib >= 1.0);
+}
+
+TEST_CASE("MemoryAccounting report negative balance", "[platforms]")
+{
+  // memory released under another key than it was allocated with
+  const MemoryAccountingKey estimator_key = makeMemoryAccountingKey(MemoryTag::ESTIMATOR, MemoryScope::CROWD);
+  recordMemoryDeallocation(estimator_key, 64);
+  CHECK(getMemoryAccountedCurrent(MemoryTag::ESTIMATOR, MemoryScope::CROWD) < 0);
+  std::ostringstream report;
+  printMemoryAccounting(report);
+  CHECK(report.str().find("Warning: negative memory balances") != std::string::npos);
+  recordMemoryAllocation(estimator_key, 64);
+}
+
+} // namespace qmcplusplus
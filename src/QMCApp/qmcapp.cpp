@@ -53,7 +53,9 @@ int main(int argc, char** argv)
   {
     //qmc_common  and MPI is initialized
     qmcplusplus::qmc_common.initialize(argc, argv);
-    int clones = 1;
+    int clones                   = 1;
+    std::size_t trace_max_events = 0;
+    int trace_sample_period      = 1;
     std::vector<std::string> fgroup1, fgroup2;
     int i = 1;
     while (i < argc)
@@ -82,6 +84,18 @@ int main(int argc, char** argv)
             getGlobalTimerManager().set_timer_threshold(timer_level);
           }
         }
+        // --timer-trace[=max_events_per_thread] records a timeline of the timers
+        if (c.find("-timer-trace") < c.size())
+        {
+          int pos = c.find("=");
+          if (c.find("-timer-trace-sample") < c.size())
+          {
+            if (pos != std::string::npos)
+              trace_sample_period = std::stoi(c.substr(pos + 1));
+          }
+          else
+            trace_max_events = pos != std::string::npos ? std::stoul(c.substr(pos + 1)) : 1 << 20;
+        }
         if (c.find("-verbosity") < c.size())
         {
           int pos = c.find("=");
@@ -140,6 +154,8 @@ int main(int argc, char** argv)
       }
       ++i;
     }
+    if (trace_max_events > 0)
+      getGlobalTimerManager().enable_trace(trace_max_events, trace_sample_period);
     int in_files = fgroup1.size();
     std::vector<std::string> inputs(in_files * clones + fgroup2.size());
     copy(fgroup2.begin(), fgroup2.end(), inputs.begin());
@@ -228,6 +244,15 @@ int main(int argc, char** argv)
       timingDoc.dump(qmc->getTitle() + ".info.xml");
     }
     getGlobalTimerManager().print(qmcComm);
+    if (getGlobalTimerManager().is_tracing())
+    {
+      std::array<char, 256> fn;
+      if (std::snprintf(fn.data(), fn.size(), "%s.p%03d.trace.json", qmc->getTitle().c_str(),
+                        OHMMS::Controller->rank()) < 0)
+        throw std::runtime_error("Error generating filename");
+      std::ofstream trace_out(fn.data());
+      getGlobalTimerManager().write_trace(OHMMS::Controller, trace_out);
+    }
 
     qmc.reset();
   }
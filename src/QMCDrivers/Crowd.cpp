@@ -74,12 +74,20 @@ void Crowd::setRNGForHamiltonian(RandomBase<FullPrecRealType>& rng)
     ham.setRandomGenerator(&rng);
 }
 
+void Crowd::collectNonlocalQuadraturePoints()
+{
+  for (QMCHamiltonian& ham : walker_hamiltonians_)
+    n_nonlocal_quadrature_points_ += ham.takeNonLocalQuadraturePointCount();
+}
+
 void Crowd::startBlock(int num_steps)
 {
   n_accept_ = 0;
   n_reject_ = 0;
   // VMCBatched does no nonlocal moves
-  n_nonlocal_accept_ = 0;
+  n_nonlocal_accept_            = 0;
+  n_nonlocal_quadrature_points_ = 0;
+  resource_seconds_             = 0.0;
   estimator_manager_crowd_.startBlock(num_steps);
 }
 
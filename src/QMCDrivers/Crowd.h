@@ -16,6 +16,7 @@
 #include "MultiWalkerDispatchers.h"
 #include "DriverWalkerTypes.h"
 #include "Estimators/EstimatorManagerCrowd.h"
+#include "Estimators/WalkerTraceManager.h"
 
 namespace qmcplusplus
 {
@@ -81,8 +82,16 @@ public:
     if (this->size() == 0)
       return;
     estimator_manager_crowd_.accumulate(mcp_walkers_, walker_elecs_, walker_twfs_, walker_hamiltonians_, rng);
+    if (walker_trace_collector_)
+      walker_trace_collector_->collect(mcp_walkers_);
   }
 
+  void setWalkerTraceCollector(std::unique_ptr<WalkerTraceCollector> collector)
+  {
+    walker_trace_collector_ = std::move(collector);
+  }
+  WalkerTraceCollector* get_walker_trace_collector() { return walker_trace_collector_.get(); }
+
   void setRNGForHamiltonian(RandomBase<FullPrecRealType>& rng);
 
   auto beginWalkers() { return mcp_walkers_.begin(); }
@@ -110,6 +119,13 @@ public:
   unsigned long get_accept() { return n_accept_; }
   unsigned long get_reject() { return n_reject_; }
 
+  /// add the NLPP quadrature points evaluated by the walker hamiltonians since the last call
+  void collectNonlocalQuadraturePoints();
+  unsigned long get_nonlocal_quadrature_points() const { return n_nonlocal_quadrature_points_; }
+  /// add the seconds spent acquiring the multi walker resources
+  void addResourceTime(double seconds) { resource_seconds_ += seconds; }
+  double get_resource_time() const { return resource_seconds_; }
+
   const MultiWalkerDispatchers& dispatchers_;
 
 private:
@@ -129,15 +145,19 @@ private:
   DriverWalkerResourceCollection driverwalker_resource_collection_;
   /// per crowd estimator manager
   EstimatorManagerCrowd estimator_manager_crowd_;
+  /// per crowd walker traces, only set when traces are requested
+  std::unique_ptr<WalkerTraceCollector> walker_trace_collector_;
 
   /** @name Step State
    * 
    *  Should be per walker? 
    *  @{
    */
-  unsigned long n_reject_          = 0;
-  unsigned long n_accept_          = 0;
-  unsigned long n_nonlocal_accept_ = 0;
+  unsigned long n_reject_                     = 0;
+  unsigned long n_accept_                     = 0;
+  unsigned long n_nonlocal_accept_            = 0;
+  unsigned long n_nonlocal_quadrature_points_ = 0;
+  double resource_seconds_                    = 0.0;
   /** @} */
 };
 
@@ -86,9 +86,11 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
                                                                 crowd.get_walker_hamiltonians());
 
   timers.resource_timer.start();
+  Timer resource_acquire;
   ResourceCollectionTeamLock<ParticleSet> pset_res_lock(crowd.getSharedResource().pset_res, walker_elecs);
   ResourceCollectionTeamLock<TrialWaveFunction> twfs_res_lock(crowd.getSharedResource().twf_res, walker_twfs);
   ResourceCollectionTeamLock<QMCHamiltonian> hams_res_lock(crowd.getSharedResource().ham_res, walker_hamiltonians);
+  crowd.addResourceTime(resource_acquire.elapsed());
   timers.resource_timer.stop();
 
   {
@@ -252,6 +254,7 @@ void DMCBatched::advanceWalkers(const StateForThread& sft,
 
     std::vector<QMCHamiltonian::FullPrecRealType> new_energies(
         ham_dispatcher.flex_evaluateWithToperator(walker_hamiltonians, walker_twfs, walker_elecs));
+    crowd.collectNonlocalQuadraturePoints();
 
     auto resetSigNLocalEnergy = [](MCPWalker& walker, TrialWaveFunction& twf, auto local_energy, auto rr_acc,
                                    auto rr_prop) {
@@ -459,6 +462,7 @@ bool DMCBatched::run()
     {
       ScopeGuard<LoopTimer<>> dmc_local_timer(dmc_loop);
       estimator_manager_->startBlock(qmcdriver_input_.get_max_steps());
+      block_timer_.restart();
 
       dmc_state.recalculate_properties_period = (qmc_driver_mode_[QMC_UPDATE_MODE])
           ? qmcdriver_input_.get_recalculate_properties_period()
@@ -493,7 +497,8 @@ bool DMCBatched::run()
 
         population_.redistributeWalkers(crowds_);
       }
-      print_mem("DMCBatched after a block", app_debug_stream());
+      print_mem("DMCBatched after a block", qmcdriver_input_.get_memory_report() ? app_log() : app_debug_stream(),
+                population_.get_walkers().size() + population_.get_dead_walkers().size());
       if (qmcdriver_input_.get_measure_imbalance())
         measureImbalance("Block " + std::to_string(block));
       endBlock();
@@ -17,6 +17,7 @@
 #include "Message/CommOperators.h"
 #include "QMCWaveFunctions/TrialWaveFunction.h"
 #include "QMCHamiltonians/QMCHamiltonian.h"
+#include "MemoryAccounting.h"
 
 namespace qmcplusplus
 {
@@ -44,7 +45,10 @@ MCPopulation::MCPopulation(int num_ranks,
 
 MCPopulation::~MCPopulation() = default;
 
-void MCPopulation::createWalkers(IndexType num_walkers, const WalkerConfigurations& walker_configs, RealType reserve)
+void MCPopulation::createWalkers(IndexType num_walkers,
+                                 const WalkerConfigurations& walker_configs,
+                                 RealType reserve,
+                                 int num_crowds)
 {
   IndexType num_walkers_plus_reserve = static_cast<IndexType>(num_walkers * reserve);
 
@@ -64,10 +68,8 @@ void MCPopulation::createWalkers(IndexType num_walkers, const WalkerConfiguratio
 
   outputManager.pause();
 
-  //this part is time consuming, it must be threaded and calls should be thread-safe.
-#pragma omp parallel for
-  for (size_t iw = 0; iw < num_walkers_plus_reserve; iw++)
-  {
+  auto createWalker = [this, &walker_configs](size_t iw) {
+    ScopedMemoryScope walker_memory(MemoryScope::WALKER);
     walkers_[iw]             = std::make_unique<MCPWalker>(elec_particle_set_->getTotalNum());
     walkers_[iw]->Properties = elec_particle_set_->Properties;
 
@@ -89,6 +91,32 @@ void MCPopulation::createWalkers(IndexType num_walkers, const WalkerConfiguratio
         hamiltonian_->makeClone(*walker_elec_particle_sets_[iw], *walker_trial_wavefunctions_[iw]);
   };
 
+  //this part is time consuming, it must be threaded and calls should be thread-safe.
+  if (num_crowds > 0)
+  {
+    // same partition as redistributeWalkers, the reserve walkers are spread over the crowds the same way.
+    // ParallelExecutor schedules the same number of tasks onto the same threads as the crowds are run.
+    const IndexType num_reserve  = num_walkers_plus_reserve - num_walkers;
+    const auto living_per_crowd  = fairDivide(num_walkers, static_cast<IndexType>(num_crowds));
+    const auto reserve_per_crowd = fairDivide(num_reserve, static_cast<IndexType>(num_crowds));
+    ParallelExecutor<> crowd_task;
+    crowd_task(num_crowds, [&](int crowd_id) {
+      const IndexType living_first  = std::accumulate(living_per_crowd.begin(), living_per_crowd.begin() + crowd_id, 0);
+      const IndexType reserve_first = num_walkers +
+          std::accumulate(reserve_per_crowd.begin(), reserve_per_crowd.begin() + crowd_id, 0);
+      for (IndexType iw = living_first; iw < living_first + living_per_crowd[crowd_id]; iw++)
+        createWalker(iw);
+      for (IndexType iw = reserve_first; iw < reserve_first + reserve_per_crowd[crowd_id]; iw++)
+        createWalker(iw);
+    });
+  }
+  else
+  {
+#pragma omp parallel for
+    for (size_t iw = 0; iw < num_walkers_plus_reserve; iw++)
+      createWalker(iw);
+  }
+
   outputManager.resume();
 
   int num_walkers_created = 0;
@@ -161,6 +189,7 @@ WalkerElementsRef MCPopulation::spawnWalker()
   {
     app_warning() << "Spawning walker number " << walkers_.size() + 1
                   << " outside of reserves, this ideally should never happened." << std::endl;
+    ScopedMemoryScope walker_memory(MemoryScope::WALKER);
     walkers_.push_back(std::make_unique<MCPWalker>(*(walkers_.back())));
 
     // There is no value in doing this here because its going to be wiped out
@@ -118,8 +118,13 @@ public:
    *
    *  \param[in] num_walkers number of living walkers in initial population
    *  \param[in] reserve multiple above that to reserve >=1.0
+   *  \param[in] num_crowds if positive, the walkers redistributeWalkers hands to each of num_crowds crowds are
+   *             created by the ParallelExecutor task of that crowd, so they are first touched by the thread running it
    */
-  void createWalkers(IndexType num_walkers, const WalkerConfigurations& walker_configs, RealType reserve = 1.0);
+  void createWalkers(IndexType num_walkers,
+                     const WalkerConfigurations& walker_configs,
+                     RealType reserve = 1.0,
+                     int num_crowds   = 0);
 
   /** distributes walkers and their "cloned" elements to the elements of a vector
    *  of unique_ptr to "walker_consumers". 
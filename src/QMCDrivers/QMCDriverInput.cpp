@@ -39,6 +39,10 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   std::string serialize_walkers;
   std::string debug_checks_str;
   std::string measure_imbalance_str;
+  std::string async_estimator_io_str;
+  std::string memory_report_str;
+  std::string crowd_first_touch_str;
+  std::string pin_threads_str;
   int Period4CheckPoint{0};
 
   ParameterSet parameter_set;
@@ -73,6 +77,11 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   parameter_set.add(debug_checks_str, "debug_checks",
                     {"no", "all", "checkGL_after_load", "checkGL_after_moves", "checkGL_after_tmove"});
   parameter_set.add(measure_imbalance_str, "measure_imbalance", {"no", "yes"});
+  parameter_set.add(async_estimator_io_str, "async_estimator_io", {"no", "yes"});
+  parameter_set.add(estimator_reduction_, "estimator_reduction", {"flat", "hierarchical", "distributed"});
+  parameter_set.add(memory_report_str, "memory_report", {"no", "yes"});
+  parameter_set.add(crowd_first_touch_str, "crowd_first_touch", {"no", "yes"});
+  parameter_set.add(pin_threads_str, "pin_threads", {"no", "yes"});
 
   OhmmsAttributeSet aAttrib;
   // first stage in from QMCDriverFactory
@@ -157,6 +166,11 @@ void QMCDriverInput::readXML(xmlNodePtr cur)
   if (measure_imbalance_str == "yes")
     measure_imbalance_ = true;
 
+  async_estimator_io_ = async_estimator_io_str == "yes";
+  memory_report_      = memory_report_str == "yes";
+  crowd_first_touch_  = crowd_first_touch_str == "yes";
+  pin_threads_        = pin_threads_str == "yes";
+
   if (check_point_period_.period < 1)
     check_point_period_.period = max_blocks_;
 
@@ -47,6 +47,16 @@ protected:
   DriverDebugChecks debug_checks_ = DriverDebugChecks::ALL_OFF;
   /// measure load imbalance (add a barrier) before data aggregation (obvious synchronization)
   bool measure_imbalance_ = false;
+  /// write estimator block output on a background thread
+  bool async_estimator_io_ = false;
+  /// rank reduction of the operator estimators: flat, hierarchical or distributed
+  std::string estimator_reduction_ = "flat";
+  /// print the memory accounted per subsystem after each block
+  bool memory_report_ = false;
+  /// create the crowds and their walkers in the threads running them
+  bool crowd_first_touch_ = false;
+  /// bind every thread to one of the CPUs of the rank
+  bool pin_threads_ = false;
 
   /** @ingroup Input Parameters for QMCDriver base class
    *  @{
@@ -137,6 +147,11 @@ public:
   bool get_scoped_profiling() const { return scoped_profiling_; }
   bool areWalkersSerialized() const { return crowd_serialize_walkers_; }
   bool get_measure_imbalance() const { return measure_imbalance_; }
+  bool get_async_estimator_io() const { return async_estimator_io_; }
+  const std::string& get_estimator_reduction() const { return estimator_reduction_; }
+  bool get_memory_report() const { return memory_report_; }
+  bool get_crowd_first_touch() const { return crowd_first_touch_; }
+  bool get_pin_threads() const { return pin_threads_; }
 
   const std::string get_drift_modifier() const { return drift_modifier_; }
   RealType get_drift_modifier_unr_a() const { return drift_modifier_unr_a_; }
@@ -25,14 +25,18 @@
 #include "Message/CommOperators.h"
 #include "RandomNumberControl.h"
 #include "Estimators/EstimatorManagerNew.h"
+#include "Estimators/WalkerTraceManager.h"
 #include "hdf/HDFVersion.h"
 #include "Utilities/qmc_common.h"
 #include "Concurrency/Info.hpp"
+#include "Concurrency/OpenMP.h"
 #include "QMCDrivers/GreenFunctionModifiers/DriftModifierBuilder.h"
 #include "Utilities/StlPrettyPrint.hpp"
 #include "Utilities/Timer.h"
 #include "Message/UniformCommunicateError.h"
 #include "EstimatorInputDelegates.h"
+#include "MemoryAccounting.h"
+#include "Host/sysutil.h"
 
 
 namespace qmcplusplus
@@ -81,6 +85,14 @@ QMCDriverNew::QMCDriverNew(const ProjectData& project_data,
                                                                       qmcdriver_input_.get_estimator_manager_input()),
                                             population_.get_golden_hamiltonian(), population.get_golden_electrons(),
                                             population.get_golden_twf());
+  estimator_manager_->setAsyncWrite(qmcdriver_input_.get_async_estimator_io());
+  if (qmcdriver_input_.get_estimator_reduction() == "hierarchical")
+    estimator_manager_->setOperatorReduction(EstimatorManagerNew::OperatorReduction::HIERARCHICAL);
+  else if (qmcdriver_input_.get_estimator_reduction() == "distributed")
+    estimator_manager_->setOperatorReduction(EstimatorManagerNew::OperatorReduction::DISTRIBUTED);
+  estimator_manager_->setPerformanceCounterNames({"block_seconds", "moves_per_second", "ratios_per_second",
+                                                  "nlpp_quadrature_points_per_second", "resource_fraction",
+                                                  "slowest_rank_moves_per_second"});
 
   drift_modifier_.reset(
       createDriftModifier(qmcdriver_input_.get_drift_modifier(), qmcdriver_input_.get_drift_modifier_unr_a()));
@@ -164,16 +176,40 @@ void QMCDriverNew::initializeQMC(const AdjustedWalkerCounts& awc)
     app_debug() << "Multi walker shared resources creation completed" << std::endl;
   }
 
-  makeLocalWalkers(awc.walkers_per_rank[myComm->rank()], awc.reserve_walkers);
+  if (qmcdriver_input_.get_pin_threads())
+    pinThreads();
 
-  crowds_.resize(awc.walkers_per_crowd.size());
+  // With first touch the walkers, crowds and their resources are allocated by the thread that runs them and
+  // their memory lands on its NUMA domain. Walkers move between crowds after DMC branching.
+  const bool first_touch = qmcdriver_input_.get_crowd_first_touch();
+  const int num_crowds   = awc.walkers_per_crowd.size();
+  makeLocalWalkers(awc.walkers_per_rank[myComm->rank()], awc.reserve_walkers, first_touch ? num_crowds : 0);
+
+  crowds_.resize(num_crowds);
 
   // at this point we can finally construct the Crowd objects.
-  for (int i = 0; i < crowds_.size(); ++i)
-  {
-    crowds_[i] =
+  auto makeCrowd = [this](int crowd_id) {
+    ScopedMemoryScope crowd_memory(MemoryScope::CROWD);
+    crowds_[crowd_id] =
         std::make_unique<Crowd>(*estimator_manager_, golden_resource_, population_.get_golden_electrons(),
                                 population_.get_golden_twf(), population_.get_golden_hamiltonian(), dispatchers_);
+  };
+  if (first_touch)
+  {
+    ParallelExecutor<> crowd_task;
+    crowd_task(num_crowds, makeCrowd);
+  }
+  else
+    for (int i = 0; i < num_crowds; ++i)
+      makeCrowd(i);
+
+  walker_traces_ = std::make_unique<WalkerTraceManager>(myComm);
+  walker_traces_->put(traces_xml_, allow_traces_, get_root_name());
+  if (walker_traces_->is_active())
+  {
+    walker_traces_->startRun(population_.get_golden_hamiltonian());
+    for (auto& crowd : crowds_)
+      crowd->setWalkerTraceCollector(walker_traces_->makeCollector());
   }
 
   //now give walkers references to their walkers
@@ -233,6 +269,8 @@ void QMCDriverNew::recordBlock(int block)
   if (qmcdriver_input_.get_dump_config() && block % qmcdriver_input_.get_check_point_period().period == 0)
   {
     ScopedTimer local_timer(timers_.checkpoint_timer);
+    // a checkpoint must not get ahead of the estimator output
+    estimator_manager_->flushWrites();
     population_.saveWalkerConfigurations(walker_configs_ref_);
     setWalkerOffsets(walker_configs_ref_, myComm);
     wOut->dump(walker_configs_ref_, block);
@@ -257,15 +295,18 @@ bool QMCDriverNew::finalize(int block, bool dumpwalkers)
   if (DumpConfig)
     RandomNumberControl::write(getRngRefs(), get_root_name(), myComm);
 
+  if (walker_traces_)
+    walker_traces_->stopRun();
+
   return true;
 }
 
-void QMCDriverNew::makeLocalWalkers(IndexType nwalkers, RealType reserve)
+void QMCDriverNew::makeLocalWalkers(IndexType nwalkers, RealType reserve, int num_crowds)
 {
   ScopedTimer local_timer(timers_.create_walkers_timer);
   // ensure nwalkers local walkers in population_
   if (population_.get_walkers().size() == 0)
-    population_.createWalkers(nwalkers, walker_configs_ref_, reserve);
+    population_.createWalkers(nwalkers, walker_configs_ref_, reserve, num_crowds);
   else if (population_.get_walkers().size() < nwalkers)
   {
     throw std::runtime_error("Unexpected walker count resulting in dangerous spawning");
@@ -463,6 +504,8 @@ void QMCDriverNew::endBlock()
   // Collect all the ScalarEstimatorsFrom EMCrowds
   unsigned long block_accept = 0;
   unsigned long block_reject = 0;
+  unsigned long block_nlpp_points = 0;
+  double block_resource_time      = 0.0;
 
   std::vector<RefVector<OperatorEstBase>> crowd_operator_estimators;
   // Seems uneeded see EstimatorManagerNew scalar_ests_ documentation.
@@ -476,6 +519,8 @@ void QMCDriverNew::endBlock()
     total_block_weight += crowd->get_estimator_manager_crowd().get_block_weight();
     block_accept += crowd->get_accept();
     block_reject += crowd->get_reject();
+    block_nlpp_points += crowd->get_nonlocal_quadrature_points();
+    block_resource_time += crowd->get_resource_time();
 
     // This seems altogether easier and more sane.
     crowd_operator_estimators.emplace_back(crowd->get_estimator_manager_crowd().get_operator_estimators());
@@ -494,7 +539,16 @@ void QMCDriverNew::endBlock()
   /// get the average cpu_block time per crowd
   /// cpu_block_time /= crowds_.size();
 
+  reportBlockPerformance(block_accept + block_reject, block_nlpp_points, block_resource_time);
   estimator_manager_->stopBlock(block_accept, block_reject, total_block_weight);
+
+  if (walker_traces_ && walker_traces_->is_active())
+  {
+    RefVector<WalkerTraceCollector> collectors;
+    for (const UPtr<Crowd>& crowd : crowds_)
+      collectors.push_back(*crowd->get_walker_trace_collector());
+    walker_traces_->writeBuffers(collectors);
+  }
 }
 
 void QMCDriverNew::checkLogAndGL(Crowd& crowd, const std::string_view location)
@@ -567,6 +621,30 @@ void QMCDriverNew::checkLogAndGL(Crowd& crowd, const std::string_view location)
     throw std::runtime_error(std::string("checkLogAndGL failed at ") + std::string(location) + std::string("\n"));
 }
 
+void QMCDriverNew::pinThreads() const
+{
+  const auto& cpus = getProcessCPUs();
+  if (cpus.empty())
+  {
+    app_warning() << "Thread pinning is not supported on this platform." << std::endl;
+    return;
+  }
+  // The main thread keeps all the CPUs of the rank since threads it starts, like the background writers of
+  // the estimators and walker traces, inherit its affinity and must not compete with the crowd on its CPU.
+  int failed_count = 0;
+#pragma omp parallel reduction(+ : failed_count)
+  {
+    const int thread_id = omp_get_thread_num();
+    if (!(thread_id == 0 ? bindThreadToCPUs(cpus) : bindThreadToCPU(cpus[thread_id % cpus.size()])))
+      ++failed_count;
+  }
+  if (failed_count > 0)
+    app_warning() << "Failed to pin " << failed_count << " threads." << std::endl;
+  else
+    app_log() << "  Pinned " << omp_get_max_threads() - 1 << " worker threads to the " << cpus.size()
+              << " CPUs of rank " << myComm->rank() << ", the main thread may run on any of them" << std::endl;
+}
+
 void QMCDriverNew::measureImbalance(const std::string& tag) const
 {
   ScopedTimer local_timer(timers_.imbalance_timer);
@@ -591,6 +669,53 @@ void QMCDriverNew::measureImbalance(const std::string& tag) const
   }
 }
 
+void QMCDriverNew::reportBlockPerformance(unsigned long moves, unsigned long nlpp_points, double resource_time)
+{
+  enum
+  {
+    MOVES,
+    NLPP_POINTS,
+    RESOURCE_TIME,
+    CROWD_TIME,
+    BLOCK_TIME,
+    NUM_COUNTERS
+  };
+  const double block_time = block_timer_.elapsed();
+  std::vector<double> my_counters{static_cast<double>(moves), static_cast<double>(nlpp_points), resource_time,
+                                  block_time * crowds_.size(), block_time};
+  std::vector<double> all_counters(NUM_COUNTERS * myComm->size(), 0.0);
+  myComm->gather(my_counters, all_counters, 0);
+  if (myComm->rank())
+    return;
+
+  auto rate = [](double count, double seconds) { return seconds > 0.0 ? count / seconds : 0.0; };
+  std::vector<double> totals(NUM_COUNTERS, 0.0);
+  double block_seconds                 = 0.0;
+  double slowest_rank_moves_per_second = std::numeric_limits<double>::max();
+  for (int ip = 0; ip < myComm->size(); ip++)
+  {
+    const double* rank_counters = all_counters.data() + ip * NUM_COUNTERS;
+    for (int ic = 0; ic < NUM_COUNTERS; ic++)
+      totals[ic] += rank_counters[ic];
+    block_seconds = std::max(block_seconds, rank_counters[BLOCK_TIME]);
+    slowest_rank_moves_per_second =
+        std::min(slowest_rank_moves_per_second, rate(rank_counters[MOVES], rank_counters[BLOCK_TIME]));
+  }
+
+  // every proposed move costs one ratio, every quadrature point another
+  const std::vector<FullPrecRealType> performance{block_seconds,
+                                                  rate(totals[MOVES], block_seconds),
+                                                  rate(totals[MOVES] + totals[NLPP_POINTS], block_seconds),
+                                                  rate(totals[NLPP_POINTS], block_seconds),
+                                                  rate(totals[RESOURCE_TIME], totals[CROWD_TIME]),
+                                                  slowest_rank_moves_per_second};
+  estimator_manager_->setBlockPerformance(performance);
+  app_log() << "  Block performance: seconds = " << performance[0] << ", moves/s = " << performance[1]
+            << ", ratios/s = " << performance[2] << ", NLPP points/s = " << performance[3]
+            << ", resource fraction = " << performance[4] << ", slowest rank moves/s = " << performance[5]
+            << std::endl;
+}
+
 void QMCDriverNew::setWalkerOffsets(WalkerConfigurations& walker_configs, Communicate* comm)
 {
   std::vector<int> nw(comm->size(), 0);
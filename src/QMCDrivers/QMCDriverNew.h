@@ -32,6 +32,7 @@
 #include "Particle/HDFWalkerIO.h"
 #include "Pools/PooledData.h"
 #include "Utilities/TimerManager.h"
+#include "Utilities/Timer.h"
 #include "Utilities/ScopedProfiler.h"
 #include "QMCDrivers/MCPopulation.h"
 #include "QMCDrivers/QMCDriverInterface.h"
@@ -52,6 +53,7 @@ namespace qmcplusplus
 //forward declarations: Do not include headers if not needed
 class TraceManager;
 class EstimatorManagerNew;
+class WalkerTraceManager;
 class TrialWaveFunction;
 class QMCHamiltonian;
 
@@ -119,10 +121,18 @@ protected:
    */
   void initializeQMC(const AdjustedWalkerCounts& awc);
 
+  /// bind every OpenMP worker thread to one of the CPUs of this rank, round robin, the main thread keeps all of them
+  void pinThreads() const;
   /// inject additional barrier and measure load imbalance.
   void measureImbalance(const std::string& tag) const;
   /// end of a block operations. Aggregates statistics across all MPI ranks and write to disk.
   void endBlock();
+  /** aggregate the block throughput counters of this rank across all ranks, log them and stage them for stat.h5
+   *  @param moves         proposed single particle moves on this rank
+   *  @param nlpp_points   NLPP quadrature points evaluated on this rank
+   *  @param resource_time seconds spent by the crowds of this rank acquiring the shared resources
+   */
+  void reportBlockPerformance(unsigned long moves, unsigned long nlpp_points, double resource_time);
 
 public:
   /// Constructor.
@@ -148,9 +158,9 @@ public:
 
   /** Adjust populations local walkers to this number
   * @param nwalkers number of walkers to add
-  *
+  * @param num_crowds if positive, new walkers are created by the threads running the crowds
   */
-  void makeLocalWalkers(int nwalkers, RealType reserve);
+  void makeLocalWalkers(int nwalkers, RealType reserve, int num_crowds = 0);
 
   DriftModifierBase& get_drift_modifier() const { return *drift_modifier_; }
 
@@ -238,8 +248,8 @@ public:
    */
   inline void setUpdateMode(bool pbyp) override { qmc_driver_mode_[QMC_UPDATE_MODE] = pbyp; }
 
-  void putTraces(xmlNodePtr txml) override {}
-  void requestTraces(bool allow_traces) override {}
+  void putTraces(xmlNodePtr txml) override { traces_xml_ = txml; }
+  void requestTraces(bool allow_traces) override { allow_traces_ = allow_traces; }
 
   // scales a MCCoords by sqrtTau. Chooses appropriate taus by CT
   template<typename RT, CoordsType CT>
@@ -420,6 +430,13 @@ protected:
   ///record engine for walkers
   std::unique_ptr<HDFWalkerOutput> wOut;
 
+  ///traces xml
+  xmlNodePtr traces_xml_ = nullptr;
+  ///whether the run type allows per walker traces
+  bool allow_traces_ = false;
+  ///per walker, per step traces written by the crowds
+  std::unique_ptr<WalkerTraceManager> walker_traces_;
+
   /** Per crowd move contexts, this is where the DistanceTables etc. reside
    */
   UPtrVector<ContextForSteps> step_contexts_;
@@ -446,6 +463,9 @@ protected:
 
   DriverTimers timers_;
 
+  ///wall clock of the current block, restarted by the drivers after EstimatorManagerNew::startBlock
+  Timer block_timer_;
+
   ///time the driver lifetime
   ScopedTimer driver_scope_timer_;
   ///profile the driver lifetime
@@ -68,8 +68,10 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
   // I don't see an  easy way to measure the release without putting the weight of tons of timer_manager calls in
   // ResourceCollectionTeamLock's constructor.
   timers.resource_timer.start();
+  Timer resource_acquire;
   ResourceCollectionTeamLock<ParticleSet> pset_res_lock(crowd.getSharedResource().pset_res, walker_elecs);
   ResourceCollectionTeamLock<TrialWaveFunction> twfs_res_lock(crowd.getSharedResource().twf_res, walker_twfs);
+  crowd.addResourceTime(resource_acquire.elapsed());
   timers.resource_timer.stop();
   if (sft.qmcdrv_input.get_debug_checks() & DriverDebugChecks::CHECKGL_AFTER_LOAD)
     checkLogAndGL(crowd, "checkGL_after_load");
@@ -186,6 +188,7 @@ void VMCBatched::advanceWalkers(const StateForThread& sft,
     ResourceCollectionTeamLock<QMCHamiltonian> hams_res_lock(crowd.getSharedResource().ham_res, walker_hamiltonians);
     std::vector<QMCHamiltonian::FullPrecRealType> local_energies(
         ham_dispatcher.flex_evaluate(walker_hamiltonians, walker_twfs, walker_elecs));
+    crowd.collectNonlocalQuadraturePoints();
 
     auto resetSigNLocalEnergy = [](MCPWalker& walker, TrialWaveFunction& twf, auto& local_energy) {
       walker.resetProperty(twf.getLogPsi(), twf.getPhase(), local_energy);
@@ -364,6 +367,7 @@ bool VMCBatched::run()
           : false;
 
       estimator_manager_->startBlock(qmcdriver_input_.get_max_steps());
+      block_timer_.restart();
 
       for (auto& crowd : crowds_)
         crowd->startBlock(qmcdriver_input_.get_max_steps());
@@ -382,7 +386,8 @@ bool VMCBatched::run()
           }
         }
       }
-      print_mem("VMCBatched after a block", app_debug_stream());
+      print_mem("VMCBatched after a block", qmcdriver_input_.get_memory_report() ? app_log() : app_debug_stream(),
+                population_.get_walkers().size() + population_.get_dead_walkers().size());
       if (qmcdriver_input_.get_measure_imbalance())
         measureImbalance("Block " + std::to_string(block));
       endBlock();
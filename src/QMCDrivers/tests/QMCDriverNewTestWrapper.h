@@ -176,6 +176,8 @@ public:
   };
 
   void testMeasureImbalance() { measureImbalance("Test"); }
+
+  void testPinThreads() { pinThreads(); }
 };
 
 template<class CONCURRENCY>
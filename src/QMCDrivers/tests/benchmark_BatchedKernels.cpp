@@ -0,0 +1,620 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** @file
+ * Benchmark of the batched kernels on the hot path of VMCBatched and DMCBatched.
+ *
+ * A periodic carbon-like system of configurable size is built from XML through the same pools as a QMCPACK run,
+ * the orbitals are LCAO from an inline Gaussian basis set.
+ * Walkers are cloned into crowds which acquire their resources and run particle-by-particle sweeps concurrently,
+ * calling the multi-walker APIs of the particle set, the orbitals, the determinants, the two-body Jastrow
+ * and the non-local pseudopotential. Latency and throughput of every kernel are reported as text and,
+ * when requested, as a JSON document for tracking across versions.
+ *
+ * By default the crowds are created by the main thread. With -f each crowd is created by the thread that runs it,
+ * as QMCDriverNew does with crowd_first_touch, and -b binds the threads to the CPUs of the process.
+ * Comparing the two placements on a multi-socket node shows the cost of remote memory accesses.
+ */
+
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <getopt.h>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include "config.h"
+#include "qmcpack_version.h"
+#include "DeviceManager.h"
+#include "Host/OutputManager.h"
+#include "hdf/hdf_error_suppression.h"
+#include "Message/Communicate.h"
+#include "OhmmsData/Libxml2Doc.h"
+#include "Particle/ParticleSetPool.h"
+#include "ParticleBase/RandomSeqGenerator.h"
+#include "QMCWaveFunctions/WaveFunctionPool.h"
+#include "QMCWaveFunctions/Fermion/SlaterDet.h"
+#include "QMCHamiltonians/HamiltonianPool.h"
+#include "QMCDrivers/DriverWalkerTypes.h"
+#include "Concurrency/ParallelExecutor.hpp"
+#include "Concurrency/OpenMP.h"
+#include "Host/sysutil.h"
+#include "Utilities/ProjectData.h"
+#include "Utilities/RandomGenerator.h"
+#include "Utilities/Timer.h"
+#include "ResourceCollection.h"
+
+namespace qmcplusplus
+{
+/// the timed kernels in the order they are reported
+enum BenchmarkKernel
+{
+  PARTICLE_MOVE = 0,
+  SPO_VGL,
+  DET_RATIO_GRAD,
+  DET_ACCEPT_REJECT,
+  DET_COMPLETE_UPDATES,
+  J2_RATIO_GRAD,
+  NLPP_EVALUATE,
+  NUM_KERNELS
+};
+
+const std::array<const char*, NUM_KERNELS> kernel_names{"ParticleSet::mw_makeMove",
+                                                        "SPOSet::mw_evaluateVGL",
+                                                        "SlaterDet::mw_ratioGrad",
+                                                        "SlaterDet::mw_accept_rejectMove",
+                                                        "SlaterDet::mw_completeUpdates",
+                                                        "TwoBodyJastrow::mw_ratioGrad",
+                                                        "NonLocalECPotential::mw_evaluate"};
+
+struct BenchmarkOptions
+{
+  int num_electrons     = 64;
+  int walkers_per_crowd = 8;
+  int num_crowds        = 1;
+  int num_steps         = 5;
+  int seed              = 11;
+  bool first_touch      = false;
+  bool bind_threads     = false;
+  std::string pseudo_file{"C.BFD.xml"};
+  std::string json_file;
+};
+
+struct KernelTiming
+{
+  double seconds            = 0.0;
+  size_t calls              = 0;
+  size_t walker_evaluations = 0;
+};
+
+/// the walkers of a crowd, the resources they share and the time spent in each kernel
+struct BenchmarkCrowd
+{
+  using RealType = QMCTraits::RealType;
+
+  UPtrVector<ParticleSet> elecs;
+  UPtrVector<TrialWaveFunction> twfs;
+  UPtrVector<QMCHamiltonian> hams;
+  /// per walker generators for the quadrature rotations of the pseudopotential
+  UPtrVector<RandomGenerator> ham_rngs;
+  DriverWalkerResourceCollection resources;
+  RandomGenerator rng;
+  std::array<KernelTiming, NUM_KERNELS> timings;
+
+  BenchmarkCrowd(const DriverWalkerResourceCollection& golden_resource,
+                 const ParticleSet& golden_elec,
+                 const TrialWaveFunction& golden_twf,
+                 const QMCHamiltonian& golden_ham,
+                 int num_walkers,
+                 int seed)
+      : resources(golden_resource), rng(seed)
+  {
+    for (int iw = 0; iw < num_walkers; ++iw)
+    {
+      elecs.push_back(std::make_unique<ParticleSet>(golden_elec));
+      // decorrelate the walkers of a crowd
+      for (int iat = 0; iat < elecs.back()->getTotalNum(); ++iat)
+        for (int idim = 0; idim < OHMMS_DIM; ++idim)
+          elecs.back()->R[iat][idim] += RealType(0.2) * (rng() - RealType(0.5));
+      twfs.push_back(golden_twf.makeClone(*elecs.back()));
+      hams.push_back(golden_ham.makeClone(*elecs.back(), *twfs.back()));
+      ham_rngs.push_back(std::make_unique<RandomGenerator>(seed + 1 + iw));
+      hams.back()->setRandomGenerator(ham_rngs.back().get());
+    }
+  }
+
+  /** run warm-up and timed steps, one step is a sweep over all the electrons followed by the pseudopotential
+   *  @param record_from the first step whose kernel times are recorded
+   */
+  void run(int num_steps, int record_from)
+  {
+    using PsiValue = WaveFunctionComponent::PsiValue;
+    using GradType = WaveFunctionComponent::GradType;
+
+    const RefVectorWithLeader<ParticleSet> p_list(*elecs[0], convertUPtrToRefVector(elecs));
+    const RefVectorWithLeader<TrialWaveFunction> twf_list(*twfs[0], convertUPtrToRefVector(twfs));
+    const RefVectorWithLeader<QMCHamiltonian> ham_list(*hams[0], convertUPtrToRefVector(hams));
+    ResourceCollectionTeamLock<ParticleSet> pset_res_lock(resources.pset_res, p_list);
+    ResourceCollectionTeamLock<TrialWaveFunction> twfs_res_lock(resources.twf_res, twf_list);
+    ResourceCollectionTeamLock<QMCHamiltonian> hams_res_lock(resources.ham_res, ham_list);
+
+    ParticleSet::mw_update(p_list);
+    TrialWaveFunction::mw_evaluateLog(twf_list, p_list);
+
+    const int num_walkers = p_list.size();
+    auto& p_leader        = p_list.getLeader();
+    auto det_list         = extractComponentList(twf_list, "SlaterDet");
+    auto j2_list          = extractComponentList(twf_list, "TwoBodyJastrow");
+    RefVectorWithLeader<OperatorBase> nlpp_list(*hams[0]->getHamiltonian("NonLocalECP"));
+    for (auto& ham : hams)
+      nlpp_list.push_back(*ham->getHamiltonian("NonLocalECP"));
+
+    // the orbitals of the determinant of each spin group
+    std::vector<RefVectorWithLeader<SPOSet>> spo_lists;
+    for (int ig = 0; ig < p_leader.groups(); ++ig)
+    {
+      spo_lists.emplace_back(*det_list.getCastedLeader<SlaterDet>().getPhi(ig));
+      for (int iw = 0; iw < num_walkers; ++iw)
+        spo_lists.back().push_back(*det_list.getCastedElement<SlaterDet>(iw).getPhi(ig));
+    }
+    const int norb = spo_lists[0].getLeader().getOrbitalSetSize();
+    std::vector<SPOSet::ValueVector> psi(num_walkers, SPOSet::ValueVector(norb));
+    std::vector<SPOSet::GradVector> dpsi(num_walkers, SPOSet::GradVector(norb));
+    std::vector<SPOSet::ValueVector> d2psi(num_walkers, SPOSet::ValueVector(norb));
+    const RefVector<SPOSet::ValueVector> psi_list(psi.begin(), psi.end());
+    const RefVector<SPOSet::GradVector> dpsi_list(dpsi.begin(), dpsi.end());
+    const RefVector<SPOSet::ValueVector> d2psi_list(d2psi.begin(), d2psi.end());
+
+    std::vector<ParticleSet::SingleParticlePos> displs(num_walkers);
+    std::vector<PsiValue> det_ratios(num_walkers), j2_ratios(num_walkers);
+    std::vector<GradType> det_grads(num_walkers), j2_grads(num_walkers);
+    std::vector<bool> is_accepted(num_walkers);
+    const RealType sqrt_tau = std::sqrt(RealType(0.3));
+
+    for (int step = 0; step < num_steps; ++step)
+    {
+      const bool record = step >= record_from;
+      auto timed        = [&](BenchmarkKernel kernel, auto&& call) {
+        Timer timer;
+        call();
+        if (!record)
+          return;
+        auto& timing = timings[kernel];
+        timing.seconds += timer.elapsed();
+        ++timing.calls;
+        timing.walker_evaluations += num_walkers;
+      };
+
+      for (int ig = 0; ig < p_leader.groups(); ++ig)
+      {
+        TrialWaveFunction::mw_prepareGroup(twf_list, p_list, ig);
+        for (int iat = p_leader.first(ig); iat < p_leader.last(ig); ++iat)
+        {
+          makeGaussRandomWithEngine(displs, rng);
+          for (auto& displ : displs)
+            displ *= sqrt_tau;
+
+          timed(PARTICLE_MOVE, [&] { ParticleSet::mw_makeMove(p_list, iat, displs); });
+          timed(SPO_VGL, [&] {
+            spo_lists[ig].getLeader().mw_evaluateVGL(spo_lists[ig], p_list, iat, psi_list, dpsi_list, d2psi_list);
+          });
+          timed(DET_RATIO_GRAD,
+                [&] { det_list.getLeader().mw_ratioGrad(det_list, p_list, iat, det_ratios, det_grads); });
+          timed(J2_RATIO_GRAD, [&] { j2_list.getLeader().mw_ratioGrad(j2_list, p_list, iat, j2_ratios, j2_grads); });
+
+          for (int iw = 0; iw < num_walkers; ++iw)
+            is_accepted[iw] = rng() < std::norm(det_ratios[iw] * j2_ratios[iw]);
+
+          timed(DET_ACCEPT_REJECT,
+                [&] { det_list.getLeader().mw_accept_rejectMove(det_list, p_list, iat, is_accepted, true); });
+          j2_list.getLeader().mw_accept_rejectMove(j2_list, p_list, iat, is_accepted, true);
+          ParticleSet::mw_accept_rejectMove<CoordsType::POS>(p_list, iat, is_accepted);
+        }
+      }
+      timed(DET_COMPLETE_UPDATES, [&] { det_list.getLeader().mw_completeUpdates(det_list); });
+      j2_list.getLeader().mw_completeUpdates(j2_list);
+      ParticleSet::mw_donePbyP(p_list);
+
+      timed(NLPP_EVALUATE, [&] { nlpp_list.getLeader().mw_evaluate(nlpp_list, twf_list, p_list); });
+    }
+  }
+
+private:
+  static RefVectorWithLeader<WaveFunctionComponent> extractComponentList(
+      const RefVectorWithLeader<TrialWaveFunction>& twf_list,
+      const std::string& class_name)
+  {
+    auto& components = twf_list.getLeader().getOrbitals();
+    for (int id = 0; id < components.size(); ++id)
+      if (components[id]->getClassName() == class_name)
+      {
+        RefVectorWithLeader<WaveFunctionComponent> wfc_list(*components[id]);
+        for (TrialWaveFunction& twf : twf_list)
+          wfc_list.push_back(*twf.getOrbitals()[id]);
+        return wfc_list;
+      }
+    throw std::runtime_error("benchmark_batched_kernels: the wavefunction has no " + class_name);
+  }
+};
+
+/** ions on a simple cubic grid in a cubic cell with the electron density of diamond.
+ *  The orbitals are dense combinations of the cc-pVDZ basis of the BFD carbon pseudopotential,
+ *  so the batched evaluation includes the basis functions of all the centers and the coefficient product.
+ */
+struct BenchmarkSystem
+{
+  int num_orbitals;
+  int num_electrons;
+  int num_ions;
+  double cell_length;
+
+  BenchmarkSystem(int requested_electrons)
+  {
+    num_orbitals  = std::max(1, (requested_electrons + 1) / 2);
+    num_electrons = 2 * num_orbitals;
+    num_ions      = std::max(1, num_electrons / 4);
+    // 9.57 bohr^3 per valence electron as in diamond
+    cell_length = std::cbrt(9.57 * num_electrons);
+  }
+
+  std::string particlesXML() const
+  {
+    const int grid       = std::ceil(std::cbrt(num_ions) - 1e-6);
+    const double spacing = cell_length / grid;
+
+    std::ostringstream xml;
+    xml << std::setprecision(12);
+    xml << "<tmp><simulationcell><parameter name='lattice' units='bohr'>" << cell_length << " 0 0 0 " << cell_length
+        << " 0 0 0 " << cell_length << "</parameter>"
+        << "<parameter name='bconds'>p p p</parameter>"
+        << "<parameter name='LR_dim_cutoff'>15</parameter></simulationcell>";
+    xml << "<particleset name='ion' size='" << num_ions << "'><group name='C'>"
+        << "<parameter name='charge'>4</parameter><parameter name='valence'>4</parameter>"
+        << "<parameter name='atomicnumber'>6</parameter></group>"
+        << "<attrib name='position' datatype='posArray' condition='0'>";
+    for (int ion = 0; ion < num_ions; ++ion)
+      xml << (ion / (grid * grid)) * spacing << " " << ((ion / grid) % grid) * spacing << " " << (ion % grid) * spacing
+          << " ";
+    xml << "</attrib><attrib name='ionid' datatype='stringArray'>";
+    for (int ion = 0; ion < num_ions; ++ion)
+      xml << "C ";
+    xml << "</attrib></particleset>";
+    xml << "<particleset name='e' random='yes' randomsrc='ion'>"
+        << "<group name='u' size='" << num_orbitals << "'><parameter name='charge'>-1</parameter></group>"
+        << "<group name='d' size='" << num_orbitals << "'><parameter name='charge'>-1</parameter></group>"
+        << "</particleset></tmp>";
+    return xml.str();
+  }
+
+  std::string wavefunctionXML() const
+  {
+    const double rcut = 0.99 * cell_length / 2;
+    std::ostringstream xml;
+    xml << std::setprecision(12);
+    xml << "<wavefunction name='psi0' target='e'>"
+        << "<sposet_collection type='MolecularOrbital' source='ion' cuspCorrection='no'>"
+        << "<basisset name='LCAOBSet' keyword='GTO' transform='yes'>"
+        << "<atomicBasisSet name='Gaussian' angular='cartesian' type='Gaussian' elementType='C' normalized='no'>"
+        << "<grid type='log' ri='1.e-6' rf='1.e2' npts='1001'/>";
+    // contracted shells of the basis, the angular momentum and the exponent and contraction pairs
+    const std::vector<std::pair<int, std::vector<std::pair<double, double>>>> shells{
+        {0,
+         {{13.073594, 0.005158300},
+          {6.541187, 0.060342398},
+          {4.573411, -0.197847092},
+          {1.637494, -0.081033997},
+          {0.819297, 0.232172591},
+          {0.409924, 0.291464289},
+          {0.2313, 0.433640483},
+          {0.102619, 0.213193992},
+          {0.051344, 0.004984800}}},
+        {0, {{0.127852, 1.0}}},
+        {1,
+         {{9.934169, 0.020907599},
+          {3.886955, 0.057269798},
+          {1.871016, 0.112268196},
+          {0.935757, 0.213008192},
+          {0.468003, 0.283581489},
+          {0.239473, 0.301120689},
+          {0.117063, 0.201693392},
+          {0.058547, 0.045357498},
+          {0.029281, 0.002977500}}},
+        {1, {{0.149161, 1.0}}},
+        {2, {{0.56116, 1.0}}}};
+    int basis_per_ion = 0;
+    for (int ishell = 0; ishell < shells.size(); ++ishell)
+    {
+      const int l = shells[ishell].first;
+      basis_per_ion += (l + 1) * (l + 2) / 2;
+      xml << "<basisGroup rid='C" << ishell << l << "' n='" << ishell << "' l='" << l << "' type='Gaussian'>";
+      for (const auto& [exponent, contraction] : shells[ishell].second)
+        xml << "<radfunc exponent='" << exponent << "' contraction='" << contraction << "'/>";
+      xml << "</basisGroup>";
+    }
+    xml << "</atomicBasisSet></basisset>";
+    // each orbital is centered on one basis function and mixes in all the others
+    const int basis_size = basis_per_ion * num_ions;
+    xml << "<sposet name='spo' basisset='LCAOBSet' size='" << num_orbitals << "'><occupation mode='ground'/>"
+        << "<coefficient size='" << num_orbitals << "' id='spoC'>";
+    for (int iorb = 0; iorb < num_orbitals; ++iorb)
+      for (int ibasis = 0; ibasis < basis_size; ++ibasis)
+        xml << (ibasis == iorb * basis_size / num_orbitals ? 1.0 : 0.1 * std::sin(iorb * basis_size + ibasis + 1))
+            << " ";
+    xml << "</coefficient></sposet></sposet_collection>"
+        << "<determinantset><slaterdeterminant>"
+        << "<determinant sposet='spo'/><determinant sposet='spo'/>"
+        << "</slaterdeterminant></determinantset>"
+        << "<jastrow type='Two-Body' name='J2' function='bspline'>";
+    for (const char* pair : {"u", "d"})
+      xml << "<correlation speciesA='u' speciesB='" << pair << "' size='8' rcut='" << rcut << "'>"
+          << "<coefficients id='u" << pair << "' type='Array'>0.5 0.35 0.24 0.16 0.1 0.06 0.03 0.01</coefficients>"
+          << "</correlation>";
+    xml << "</jastrow></wavefunction>";
+    return xml.str();
+  }
+
+  std::string hamiltonianXML(const std::string& pseudo_file) const
+  {
+    return "<hamiltonian name='h0' type='generic' target='e'>"
+           "<pairpot type='pseudo' name='PseudoPot' source='ion' wavefunction='psi0' format='xml'>"
+           "<pseudo elementType='C' href='" +
+        pseudo_file + "'/></pairpot></hamiltonian>";
+  }
+};
+
+void writeJSON(std::ostream& out,
+               const BenchmarkOptions& options,
+               const BenchmarkSystem& system,
+               const std::array<KernelTiming, NUM_KERNELS>& totals,
+               double setup_seconds,
+               double wall_seconds)
+{
+  out << std::defaultfloat << std::setprecision(8);
+  out << "{\n";
+  out << "  \"benchmark\": \"batched_kernels\",\n";
+  out << "  \"qmcpack_version\": \"" << QMCPACK_VERSION_MAJOR << "." << QMCPACK_VERSION_MINOR << "."
+      << QMCPACK_VERSION_PATCH << "\",\n";
+#ifdef QMCPACK_GIT_HASH
+  out << "  \"git_hash\": \"" << QMCPACK_GIT_HASH << "\",\n";
+#endif
+#ifdef QMC_COMPLEX
+  out << "  \"complex\": true,\n";
+#else
+  out << "  \"complex\": false,\n";
+#endif
+#ifdef MIXED_PRECISION
+  out << "  \"precision\": \"mixed\",\n";
+#else
+  out << "  \"precision\": \"full\",\n";
+#endif
+  out << "  \"electrons\": " << system.num_electrons << ",\n";
+  out << "  \"ions\": " << system.num_ions << ",\n";
+  out << "  \"walkers_per_crowd\": " << options.walkers_per_crowd << ",\n";
+  out << "  \"crowds\": " << options.num_crowds << ",\n";
+  out << "  \"steps\": " << options.num_steps << ",\n";
+  out << "  \"placement\": \"" << (options.first_touch ? "first_touch" : "main") << "\",\n";
+  out << "  \"bind_threads\": " << (options.bind_threads ? "true" : "false") << ",\n";
+  out << "  \"setup_seconds\": " << setup_seconds << ",\n";
+  out << "  \"wall_seconds\": " << wall_seconds << ",\n";
+  out << "  \"kernels\": [\n";
+  for (int kernel = 0; kernel < NUM_KERNELS; ++kernel)
+  {
+    const auto& timing = totals[kernel];
+    out << "    {\"name\": \"" << kernel_names[kernel] << "\", \"calls\": " << timing.calls
+        << ", \"walker_evaluations\": " << timing.walker_evaluations << ", \"seconds\": " << timing.seconds
+        << ", \"latency_us\": " << (timing.calls ? 1e6 * timing.seconds / timing.calls : 0.0)
+        << ", \"walkers_per_second\": "
+        << (timing.seconds > 0 ? timing.walker_evaluations * options.num_crowds / timing.seconds : 0.0) << "}"
+        << (kernel + 1 < NUM_KERNELS ? "," : "") << "\n";
+  }
+  out << "  ]\n";
+  out << "}" << std::endl;
+}
+
+} // namespace qmcplusplus
+
+using namespace qmcplusplus;
+
+int main(int argc, char** argv)
+{
+#ifdef HAVE_MPI
+  mpi3::environment env(argc, argv);
+  OHMMS::Controller->initialize(env);
+#endif
+  Communicate* comm = OHMMS::Controller;
+  DeviceManager::initializeGlobalDeviceManager(0, 1);
+  hdf_error_suppression hide_hdf_errors;
+
+  BenchmarkOptions options;
+  bool verbose = false;
+  int opt;
+  while ((opt = getopt(argc, argv, "he:w:c:s:r:p:j:fbv")) != -1)
+  {
+    switch (opt)
+    {
+    case 'e':
+      options.num_electrons = atoi(optarg);
+      break;
+    case 'w':
+      options.walkers_per_crowd = atoi(optarg);
+      break;
+    case 'c':
+      options.num_crowds = atoi(optarg);
+      break;
+    case 's':
+      options.num_steps = atoi(optarg);
+      break;
+    case 'r':
+      options.seed = atoi(optarg);
+      break;
+    case 'p':
+      options.pseudo_file = optarg;
+      break;
+    case 'j':
+      options.json_file = optarg;
+      break;
+    case 'f':
+      options.first_touch = true;
+      break;
+    case 'b':
+      options.bind_threads = true;
+      break;
+    case 'v':
+      verbose = true;
+      break;
+    default:
+      std::cout << "Usage: " << argv[0] << " [-e electrons] [-w walkers per crowd] [-c crowds] [-s steps]"
+                << " [-r seed] [-p pseudopotential file] [-j JSON output file] [-f] [-b] [-v]" << std::endl;
+      return opt == 'h' ? 0 : 1;
+    }
+  }
+  if (options.walkers_per_crowd < 1 || options.num_crowds < 1 || options.num_steps < 1)
+  {
+    std::cerr << "walkers per crowd, crowds and steps must be positive" << std::endl;
+    return 1;
+  }
+  if (!verbose || comm->rank() != 0)
+    outputManager.shutOff();
+
+  const BenchmarkSystem system(options.num_electrons);
+  Random.init(options.seed);
+
+  ParticleSetPool particle_pool(comm);
+  {
+    Libxml2Document doc;
+    doc.parseFromString(system.particlesXML());
+    xmlNodePtr sim_cell = xmlFirstElementChild(doc.getRoot());
+    particle_pool.readSimulationCellXML(sim_cell);
+    xmlNodePtr part_ion = xmlNextElementSibling(sim_cell);
+    particle_pool.put(part_ion);
+    particle_pool.put(xmlNextElementSibling(part_ion));
+    particle_pool.randomize();
+  }
+
+  ProjectData project("benchmark_batched_kernels", ProjectData::DriverVersion::BATCH);
+  WaveFunctionPool wavefunction_pool(project.getRuntimeOptions(), particle_pool, comm);
+  {
+    Libxml2Document doc;
+    doc.parseFromString(system.wavefunctionXML());
+    wavefunction_pool.put(doc.getRoot());
+  }
+
+  HamiltonianPool hamiltonian_pool(particle_pool, wavefunction_pool, comm);
+  {
+    Libxml2Document doc;
+    doc.parseFromString(system.hamiltonianXML(options.pseudo_file));
+    hamiltonian_pool.put(doc.getRoot());
+  }
+
+  auto& golden_elec = *particle_pool.getParticleSet("e");
+  auto& golden_twf  = *wavefunction_pool.getPrimary();
+  auto& golden_ham  = *hamiltonian_pool.getPrimary();
+  if (golden_ham.getHamiltonian("NonLocalECP") == nullptr)
+  {
+    std::cerr << "the pseudopotential " << options.pseudo_file << " has no non-local channel" << std::endl;
+    return 1;
+  }
+
+  DriverWalkerResourceCollection golden_resource;
+  golden_elec.createResource(golden_resource.pset_res);
+  golden_twf.createResource(golden_resource.twf_res);
+  golden_ham.createResource(golden_resource.ham_res);
+
+  if (options.bind_threads)
+  {
+    const auto& cpus = getProcessCPUs();
+    if (cpus.empty())
+      std::cerr << "binding threads is not supported on this platform" << std::endl;
+    else
+    {
+#pragma omp parallel
+      bindThreadToCPU(cpus[omp_get_thread_num() % cpus.size()]);
+    }
+  }
+
+  Timer setup_timer;
+  UPtrVector<BenchmarkCrowd> crowds(options.num_crowds);
+  auto makeCrowd = [&](int crowd_id) {
+    crowds[crowd_id] = std::make_unique<BenchmarkCrowd>(golden_resource, golden_elec, golden_twf, golden_ham,
+                                                        options.walkers_per_crowd,
+                                                        options.seed + crowd_id * (options.walkers_per_crowd + 1));
+  };
+  ParallelExecutor<> crowd_task;
+  if (options.first_touch)
+    crowd_task(options.num_crowds, makeCrowd);
+  else
+    for (int ic = 0; ic < options.num_crowds; ++ic)
+      makeCrowd(ic);
+  const double setup_seconds = setup_timer.elapsed();
+
+  // one untimed step to warm up caches and allocations
+  const int warmup_steps = 1;
+  Timer wall_timer;
+  crowd_task(
+      options.num_crowds,
+      [warmup_steps](int crowd_id, UPtrVector<BenchmarkCrowd>& crowds, int num_steps) {
+        crowds[crowd_id]->run(num_steps + warmup_steps, warmup_steps);
+      },
+      crowds, options.num_steps);
+  const double wall_seconds = wall_timer.elapsed();
+
+  // crowds run concurrently, report the mean over crowds and the throughput of all of them
+  std::array<KernelTiming, NUM_KERNELS> totals;
+  for (auto& crowd : crowds)
+    for (int kernel = 0; kernel < NUM_KERNELS; ++kernel)
+    {
+      totals[kernel].seconds += crowd->timings[kernel].seconds / options.num_crowds;
+      totals[kernel].calls += crowd->timings[kernel].calls;
+      totals[kernel].walker_evaluations += crowd->timings[kernel].walker_evaluations;
+    }
+  for (auto& timing : totals)
+  {
+    timing.calls /= options.num_crowds;
+    timing.walker_evaluations /= options.num_crowds;
+  }
+
+  if (comm->rank() == 0)
+  {
+    std::cout << "Batched kernels with " << system.num_electrons << " electrons, " << system.num_ions << " ions, "
+              << options.num_crowds << " crowds of " << options.walkers_per_crowd << " walkers, "
+              << options.num_steps << " steps, crowds created by "
+              << (options.first_touch ? "their threads" : "the main thread")
+              << (options.bind_threads ? ", threads bound to CPUs" : "") << std::endl;
+    std::cout << std::left << std::setw(48) << "  kernel" << std::right << std::setw(14) << "latency [us]"
+              << std::setw(20) << "walkers per second" << std::endl;
+    for (int kernel = 0; kernel < NUM_KERNELS; ++kernel)
+    {
+      const auto& timing = totals[kernel];
+      std::cout << "  " << std::left << std::setw(46) << kernel_names[kernel] << std::right << std::fixed
+                << std::setprecision(3) << std::setw(14) << 1e6 * timing.seconds / timing.calls
+                << std::setprecision(1) << std::setw(20)
+                << timing.walker_evaluations * options.num_crowds / timing.seconds << std::endl;
+    }
+    std::cout << "  setup time " << std::setprecision(3) << setup_seconds << " s, wall time " << wall_seconds << " s"
+              << std::endl;
+
+    if (!options.json_file.empty())
+    {
+      if (options.json_file == "-")
+        writeJSON(std::cout, options, system, totals, setup_seconds, wall_seconds);
+      else
+      {
+        std::ofstream json(options.json_file);
+        writeJSON(json, options, system, totals, setup_seconds, wall_seconds);
+      }
+    }
+  }
+
+  OHMMS::Controller->finalize();
+  return 0;
+}
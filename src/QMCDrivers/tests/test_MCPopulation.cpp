@@ -13,6 +13,8 @@
 #include "catch.hpp"
 #include <vector>
 #include <algorithm>
+#include <map>
+#include <mutex>
 
 #include "Configuration.h"
 #include "OhmmsPETE/TinyVector.h"
@@ -22,6 +24,10 @@
 #include "QMCWaveFunctions/tests/MinimalWaveFunctionPool.h"
 #include "QMCHamiltonians/tests/MinimalHamiltonianPool.h"
 #include "Utilities/RuntimeOptions.h"
+#include "Utilities/FairDivide.h"
+#include "QMCWaveFunctions/ConstantOrbital.h"
+#include "Concurrency/ParallelExecutor.hpp"
+#include "Concurrency/OpenMP.h"
 
 namespace qmcplusplus
 {
@@ -66,8 +72,37 @@ TEST_CASE("MCPopulation::createWalkers", "[particle][population]")
   CHECK(population2.get_walkers()[5]->R[0][0] == old_R00);
   CHECK(population2.get_walkers()[6]->R[0][0] == old_R00);
   CHECK(population2.get_walkers()[7]->R[0][0] == new_R00);
+
+  // created by the crowd tasks, the walkers and their configurations are in the same order
+  MCPopulation population3(1, comm->rank(), particle_pool.getParticleSet("e"), &twf, hamiltonian_pool.getPrimary());
+  population3.createWalkers(8, walker_confs, 1.5, 3);
+  CHECK(population3.get_walkers().size() == 8);
+  CHECK(population3.get_dead_walkers().size() == 4);
+  for (int iw = 0; iw < 8; ++iw)
+    CHECK(population3.get_walkers()[iw]->R[0][0] == population2.get_walkers()[iw]->R[0][0]);
 }
 
+/// records the thread making each clone
+class CloneThreadRecorder : public ConstantOrbital
+{
+public:
+  CloneThreadRecorder(std::map<const WaveFunctionComponent*, int>& clone_threads, std::mutex& clone_mutex)
+      : clone_threads_(clone_threads), clone_mutex_(clone_mutex)
+  {}
+
+  std::unique_ptr<WaveFunctionComponent> makeClone(ParticleSet& tpq) const override
+  {
+    auto clone = std::make_unique<ConstantOrbital>();
+    std::lock_guard<std::mutex> lock(clone_mutex_);
+    clone_threads_[clone.get()] = omp_get_thread_num();
+    return clone;
+  }
+
+private:
+  std::map<const WaveFunctionComponent*, int>& clone_threads_;
+  std::mutex& clone_mutex_;
+};
+
 
 TEST_CASE("MCPopulation::createWalkers_walker_ids", "[particle][population]")
 {
@@ -122,18 +157,41 @@ TEST_CASE("MCPopulation::createWalkers_walker_ids", "[particle][population]")
 }
 
 
-// TEST_CASE("MCPopulation::createWalkers first touch", "[particle][population]")
-// {
-//   MCPopulation population(1, 2);
-//   ParticleAttrib<TinyVector<QMCTraits::RealType, 3>> some_pos(2);
-//   some_pos[0] = TinyVector<double, 3>(1.0, 0.0, 0.0);
-//   some_pos[1] = TinyVector<double, 3>(0.0, 1.0, 0.0);
+TEST_CASE("MCPopulation::createWalkers first touch", "[particle][population]")
+{
+  using namespace testing;
+
+  RuntimeOptions runtime_options;
+  Communicate* comm = OHMMS::Controller;
+
+  auto particle_pool     = MinimalParticlePool::make_diamondC_1x1x1(comm);
+  auto wavefunction_pool = MinimalWaveFunctionPool::make_diamondC_1x1x1(runtime_options, comm, particle_pool);
+  auto hamiltonian_pool  = MinimalHamiltonianPool::make_hamWithEE(comm, particle_pool, wavefunction_pool);
+  std::map<const WaveFunctionComponent*, int> clone_threads;
+  std::mutex clone_mutex;
+  TrialWaveFunction twf(runtime_options);
+  twf.addComponent(std::make_unique<CloneThreadRecorder>(clone_threads, clone_mutex));
+  WalkerConfigurations walker_confs;
 
-//   population.createWalkers(8, 2, 16, some_pos);
-//   REQUIRE(population.get_walkers().size() == 16);
-//   // Someday here we should use hwloc or similar to query that the memory is close to
-//   // each thread.
-// }
+  const int num_walkers = 8;
+  const int num_crowds  = 3;
+  MCPopulation population(1, comm->rank(), particle_pool.getParticleSet("e"), &twf, hamiltonian_pool.getPrimary());
+  population.createWalkers(num_walkers, walker_confs, 1.5, num_crowds);
+  REQUIRE(clone_threads.size() == 12);
+
+  // the threads running the crowds, as the drivers schedule them
+  std::vector<int> crowd_threads(num_crowds);
+  ParallelExecutor<> crowd_task;
+  crowd_task(num_crowds, [&crowd_threads](int crowd_id) { crowd_threads[crowd_id] = omp_get_thread_num(); });
+
+  // each walker was cloned by the thread running the crowd redistributeWalkers gives it to
+  const auto walkers_per_crowd = fairDivide(num_walkers, num_crowds);
+  int iw                       = 0;
+  for (int crowd_id = 0; crowd_id < num_crowds; ++crowd_id)
+    for (int i = 0; i < walkers_per_crowd[crowd_id]; ++i, ++iw)
+      CHECK(clone_threads.at(population.get_twfs()[iw]->getOrbitals()[0].get()) == crowd_threads[crowd_id]);
+  CHECK(iw == num_walkers);
+}
 
 TEST_CASE("MCPopulation::redistributeWalkers", "[particle][population]")
 {
@@ -23,6 +23,12 @@
 #include "QMCDrivers/MCPopulation.h"
 #include "Concurrency/Info.hpp"
 #include "Concurrency/UtilityFunctions.hpp"
+#include "Concurrency/OpenMP.h"
+#include "Host/sysutil.h"
+#include <thread>
+#ifdef __linux__
+#include <sched.h>
+#endif
 
 namespace qmcplusplus
 {
@@ -259,4 +265,56 @@ TEST_CASE("QMCDriverNew test driver operations", "[drivers]")
   }
 }
 
+#ifdef __linux__
+TEST_CASE("QMCDriverNew pin_threads", "[drivers]")
+{
+  using namespace testing;
+  ProjectData test_project("test", ProjectData::DriverVersion::BATCH);
+  Communicate* comm = OHMMS::Controller;
+  outputManager.pause();
+
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(valid_vmc_input_sections[valid_vmc_input_vmc_tiny_index]);
+  REQUIRE(okay);
+  QMCDriverInput qmcdriver_input;
+  qmcdriver_input.readXML(doc.getRoot());
+  auto particle_pool = MinimalParticlePool::make_diamondC_1x1x1(comm);
+  auto wavefunction_pool =
+      MinimalWaveFunctionPool::make_diamondC_1x1x1(test_project.getRuntimeOptions(), comm, particle_pool);
+  auto hamiltonian_pool = MinimalHamiltonianPool::make_hamWithEE(comm, particle_pool, wavefunction_pool);
+  WalkerConfigurations walker_confs;
+  QMCDriverNewTestWrapper qmcdriver(test_project, std::move(qmcdriver_input), walker_confs,
+                                    MCPopulation(comm->size(), comm->rank(), particle_pool.getParticleSet("e"),
+                                                 wavefunction_pool.getPrimary(), hamiltonian_pool.getPrimary()),
+                                    comm);
+
+  auto countThreadCPUs = [] {
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    sched_getaffinity(0, sizeof(mask), &mask);
+    return CPU_COUNT(&mask);
+  };
+  const auto& cpus   = getProcessCPUs();
+  const int num_cpus = cpus.size();
+  REQUIRE(countThreadCPUs() == num_cpus);
+
+  qmcdriver.testPinThreads();
+  std::vector<int> thread_cpus(omp_get_max_threads());
+#pragma omp parallel
+  thread_cpus[omp_get_thread_num()] = countThreadCPUs();
+  // the main thread and the threads it starts keep all the CPUs, the workers are bound to one
+  CHECK(thread_cpus[0] == num_cpus);
+  for (int thread_id = 1; thread_id < thread_cpus.size(); ++thread_id)
+    CHECK(thread_cpus[thread_id] == 1);
+  int background_cpus = 0;
+  std::thread background([&] { background_cpus = countThreadCPUs(); });
+  background.join();
+  CHECK(background_cpus == num_cpus);
+
+#pragma omp parallel
+  bindThreadToCPUs(cpus);
+  outputManager.resume();
+}
+#endif
+
 } // namespace qmcplusplus
@@ -94,6 +94,78 @@ L2Potential::Return_t L2Potential::evaluate(ParticleSet& P)
 }
 
 
+void L2Potential::mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                              const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                              const RefVectorWithLeader<ParticleSet>& p_list) const
+{
+  assert(this == &o_list.getLeader());
+  const size_t nw    = o_list.size();
+  const size_t Nelec = p_list.getLeader().getTotalNum();
+
+  // per species: distances and angular factors of the pairs within rcut and the walker owning them
+  const size_t nspecies = PPset.size();
+  std::vector<std::vector<RealType>> dist_all(nspecies), factor_all(nspecies);
+  std::vector<std::vector<int>> walker_all(nspecies);
+
+  TrialWaveFunction::HessVector D2(Nelec);
+  for (size_t iw = 0; iw < nw; ++iw)
+  {
+    ParticleSet& P = p_list[iw];
+    // compute the Hessian, evaluateHessian accumulates into D2
+    D2 = 0.0;
+    // evaluateHessian gives the Hessian(log(Psi))
+    wf_list[iw].evaluateHessian(P, D2);
+    // add gradient terms to get (Hessian(Psi))/Psi instead
+    for (size_t n = 0; n < Nelec; n++)
+      for (size_t i = 0; i < DIM; i++)
+        for (size_t j = 0; j < DIM; j++)
+          D2[n](i, j) += P.G[n][i] * P.G[n][j];
+
+    const auto& d_table(P.getDistTableAB(myTableIndex));
+    for (size_t iel = 0; iel < Nelec; ++iel)
+    {
+      const auto Le    = P.L[iel];
+      const auto& ge   = P.G[iel];
+      const auto& D2e  = D2[iel];
+      const auto& dist = d_table.getDistRow(iel);
+      const auto& disp = d_table.getDisplRow(iel);
+      for (size_t iat = 0; iat < NumIons; ++iat)
+      {
+        RealType r = dist[iat];
+        if (PP[iat] != nullptr && r < PP[iat]->rcut)
+        {
+          PosType rv = disp[iat]; //SoA rv is r_I-r_e
+          RealType v = -r * r * std::real(Le);
+          for (int i = 0; i < DIM; ++i)
+            v += -r * r * std::real(ge[i] * ge[i]) - 2 * rv[i] * std::real(ge[i]);
+          for (int i = 0; i < DIM; ++i)
+            for (int j = 0; j < DIM; ++j)
+              v += rv[i] * std::real(D2e(i, j)) * rv[j];
+          const int ig = IonConfig.GroupID[iat];
+          dist_all[ig].push_back(r);
+          factor_all[ig].push_back(v);
+          walker_all[ig].push_back(iw);
+        }
+      }
+    }
+  }
+
+  for (size_t iw = 0; iw < nw; ++iw)
+    o_list.getCastedElement<L2Potential>(iw).value_ = 0.0;
+
+  std::vector<RealType> vL2_all;
+  for (size_t ig = 0; ig < nspecies; ++ig)
+  {
+    const size_t npairs = dist_all[ig].size();
+    if (npairs == 0)
+      continue;
+    vL2_all.resize(npairs);
+    PPset[ig]->vL2->evaluateV(npairs, dist_all[ig].data(), vL2_all.data());
+    for (size_t ip = 0; ip < npairs; ++ip)
+      o_list.getCastedElement<L2Potential>(walker_all[ig][ip]).value_ += factor_all[ig][ip] * vL2_all[ip];
+  }
+}
+
 void L2Potential::evaluateDK(ParticleSet& P, int iel, TensorType& D, PosType& K)
 {
   K = 0.0;
@@ -78,6 +78,14 @@ struct L2Potential : public OperatorBase
 
   Return_t evaluate(ParticleSet& P) override;
 
+  /** evaluate the L2 potentials of a crowd
+   *  the angular factors of the electron-ion pairs within rcut are gathered per ion species
+   *  over all the walkers and the radial potential is evaluated over all of them at once
+   */
+  void mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                   const RefVectorWithLeader<ParticleSet>& p_list) const override;
+
   void evaluateDK(ParticleSet& P, int iel, TensorType& D, PosType& K);
   void evaluateD(ParticleSet& P, int iel, TensorType& D);
 
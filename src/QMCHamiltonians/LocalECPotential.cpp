@@ -105,6 +105,68 @@ LocalECPotential::Return_t LocalECPotential::evaluate(ParticleSet& P)
   return value_;
 }
 
+void LocalECPotential::mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                                   const RefVectorWithLeader<ParticleSet>& p_list) const
+{
+  assert(this == &o_list.getLeader());
+#if !defined(REMOVE_TRACEMANAGER)
+  if (streaming_particles_)
+  {
+    OperatorBase::mw_evaluate(o_list, wf_list, p_list);
+    return;
+  }
+#endif
+  const size_t nw    = o_list.size();
+  const size_t Nelec = p_list.getLeader().getTotalNum();
+  for (size_t iw = 0; iw < nw; ++iw)
+    o_list.getCastedElement<LocalECPotential>(iw).value_ = 0.0;
+
+  std::vector<int> ions;
+  std::vector<RealType> dist_all;
+  std::vector<RealType> vloc_all;
+  for (int ig = 0; ig < PPset.size(); ++ig)
+  {
+    if (PPset[ig] == nullptr)
+      continue;
+    ions.clear();
+    for (int iat = 0; iat < NumIons; ++iat)
+      if (IonConfig.GroupID[iat] == ig)
+        ions.push_back(iat);
+    if (ions.empty())
+      continue;
+
+    // electron-ion distances of this species, walker by walker
+    const size_t npairs = Nelec * ions.size();
+    dist_all.resize(nw * npairs);
+    vloc_all.resize(nw * npairs);
+    for (size_t iw = 0; iw < nw; ++iw)
+    {
+      const auto& d_table(p_list[iw].getDistTableAB(myTableIndex));
+      RealType* restrict dist_w = dist_all.data() + iw * npairs;
+      for (size_t iel = 0; iel < Nelec; ++iel)
+      {
+        const auto& dist = d_table.getDistRow(iel);
+        for (size_t i = 0; i < ions.size(); ++i)
+          dist_w[iel * ions.size() + i] = dist[ions[i]];
+      }
+    }
+
+    PPset[ig]->evaluateV(nw * npairs, dist_all.data(), vloc_all.data());
+
+    for (size_t iw = 0; iw < nw; ++iw)
+    {
+      const RealType* restrict dist_w = dist_all.data() + iw * npairs;
+      const RealType* restrict vloc_w = vloc_all.data() + iw * npairs;
+      Return_t esum(0);
+#pragma omp simd reduction(+ : esum)
+      for (size_t ip = 0; ip < npairs; ++ip)
+        esum += vloc_w[ip] / dist_w[ip];
+      o_list.getCastedElement<LocalECPotential>(iw).value_ -= esum * gZeff[ig];
+    }
+  }
+}
+
 LocalECPotential::Return_t LocalECPotential::evaluateWithIonDerivs(ParticleSet& P,
                                                                    ParticleSet& ions,
                                                                    TrialWaveFunction& psi,
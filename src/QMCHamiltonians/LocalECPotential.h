@@ -75,6 +75,14 @@ struct LocalECPotential : public OperatorBase
 
   Return_t evaluate(ParticleSet& P) override;
 
+  /** evaluate the local potentials of a crowd
+   *  the electron-ion distances of all the walkers are gathered per ion species
+   *  and the radial potential is evaluated over all of them at once
+   */
+  void mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                   const RefVectorWithLeader<ParticleSet>& p_list) const override;
+
   Return_t evaluateWithIonDerivs(ParticleSet& P,
                                  ParticleSet& ions,
                                  TrialWaveFunction& psi,
@@ -20,6 +20,8 @@
 #include "Particle/DistanceTable.h"
 #include "Particle/MCWalkerConfiguration.h"
 #include "Utilities/IteratorUtility.h"
+#include "Numerics/SplineBound.hpp"
+#include "spline2/MultiBsplineData.hpp"
 
 #if defined(HAVE_LIBFFTW)
 #include <fftw3.h>
@@ -328,6 +330,7 @@ MPC::Return_t MPC::evalSR(ParticleSet& P) const
   {
     RealType esum(0);
     const auto& dist = d_aa.getDistRow(ipart);
+#pragma omp simd reduction(+ : esum)
     for (size_t j = 0; j < ipart; ++j)
       esum += cone / dist[j];
     SR += esum;
@@ -352,12 +355,84 @@ MPC::Return_t MPC::evalLR(ParticleSet& P) const
   return LR;
 }
 
+void MPC::evalLRPoints(size_t n, const double* u0, const double* u1, const double* u2, double* vals) const
+{
+  using spline2::MultiBsplineData;
+  const UBspline_3d_d* restrict spline = VlongSpline.get();
+  const double* restrict coefs         = spline->coefs;
+  const intptr_t xs                    = spline->x_stride;
+  const intptr_t ys                    = spline->y_stride;
+  const double x_delta_inv             = spline->x_grid.delta_inv;
+  const double y_delta_inv             = spline->y_grid.delta_inv;
+  const double z_delta_inv             = spline->z_grid.delta_inv;
+  // periodic spline, the last allowed grid index is num - 1
+  const int x_max = spline->x_grid.num - 1;
+  const int y_max = spline->y_grid.num - 1;
+  const int z_max = spline->z_grid.num - 1;
+#pragma omp simd
+  for (size_t ip = 0; ip < n; ++ip)
+  {
+    int ix, iy, iz;
+    double tx, ty, tz;
+    getSplineBound(u0[ip] * x_delta_inv, x_max, ix, tx);
+    getSplineBound(u1[ip] * y_delta_inv, y_max, iy, ty);
+    getSplineBound(u2[ip] * z_delta_inv, z_max, iz, tz);
+    double a[4], b[4], c[4];
+    MultiBsplineData<double>::compute_prefactors(a, tx);
+    MultiBsplineData<double>::compute_prefactors(b, ty);
+    MultiBsplineData<double>::compute_prefactors(c, tz);
+    double val = 0.0;
+    for (int i = 0; i < 4; i++)
+      for (int j = 0; j < 4; j++)
+      {
+        const double* restrict coefs_ij = coefs + (ix + i) * xs + (iy + j) * ys + iz;
+        val += a[i] * b[j] * (c[0] * coefs_ij[0] + c[1] * coefs_ij[1] + c[2] * coefs_ij[2] + c[3] * coefs_ij[3]);
+      }
+    vals[ip] = val;
+  }
+}
+
 MPC::Return_t MPC::evaluate(ParticleSet& P)
 {
   value_ = evalSR(P) + evalLR(P) + Vconst;
   return value_;
 }
 
+void MPC::mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                      const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                      const RefVectorWithLeader<ParticleSet>& p_list) const
+{
+  assert(this == &o_list.getLeader());
+  const size_t nw = o_list.size();
+
+  // reduced coordinates of the electrons of all the walkers folded into the cell
+  const size_t npoints = nw * NParticles;
+  std::vector<double> u0(npoints), u1(npoints), u2(npoints), vlong(npoints);
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    const ParticleSet& P = p_list[iw];
+    for (size_t i = 0; i < NParticles; i++)
+    {
+      PosType u = P.getLattice().toUnit(P.R[i]);
+      for (int j = 0; j < OHMMS_DIM; j++)
+        u[j] -= std::floor(u[j]);
+      u0[iw * NParticles + i] = u[0];
+      u1[iw * NParticles + i] = u[1];
+      u2[iw * NParticles + i] = u[2];
+    }
+  }
+  evalLRPoints(npoints, u0.data(), u1.data(), u2.data(), vlong.data());
+
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    auto& mpc   = o_list.getCastedElement<MPC>(iw);
+    RealType LR = 0.0;
+    for (size_t i = 0; i < NParticles; i++)
+      LR += vlong[iw * NParticles + i];
+    mpc.value_ = mpc.evalSR(p_list[iw]) + LR + Vconst;
+  }
+}
+
 bool MPC::put(xmlNodePtr cur)
 {
   Ecut = -1.0;
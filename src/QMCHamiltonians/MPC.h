@@ -26,6 +26,11 @@ class UBspline_3d_d;
 #endif
 namespace qmcplusplus
 {
+namespace testing
+{
+class TestMPC;
+}
+
 /** @ingroup hamiltonian
  *\brief Calculates the Model Periodic Coulomb potential using PBCs
  */
@@ -52,6 +57,10 @@ protected:
   void init_spline(const ParticleSet& ptcl);
   Return_t evalSR(ParticleSet& P) const;
   Return_t evalLR(ParticleSet& P) const;
+  /** evaluate VlongSpline at n points given by their reduced coordinates in [0,1)
+   *  same result as eval_UBspline_3d_d for each point, but the loop over points vectorizes
+   */
+  void evalLRPoints(size_t n, const double* u0, const double* u1, const double* u2, double* vals) const;
 
 public:
   // Store the average electron charge density in reciprocal space
@@ -82,6 +91,14 @@ public:
 
   Return_t evaluate(ParticleSet& P) override;
 
+  /** evaluate MPC for a crowd
+   *  the short range part uses the electron-electron table of each walker,
+   *  the long range spline is evaluated over the electrons of all the walkers at once
+   */
+  void mw_evaluate(const RefVectorWithLeader<OperatorBase>& o_list,
+                   const RefVectorWithLeader<TrialWaveFunction>& wf_list,
+                   const RefVectorWithLeader<ParticleSet>& p_list) const override;
+
   /** Do nothing */
   bool put(xmlNodePtr cur) override;
 
@@ -92,6 +109,8 @@ public:
   }
 
   std::unique_ptr<OperatorBase> makeClone(ParticleSet& qp, TrialWaveFunction& psi) override;
+
+  friend class testing::TestMPC;
 };
 
 } // namespace qmcplusplus
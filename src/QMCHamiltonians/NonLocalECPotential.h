@@ -22,6 +22,7 @@
 #include "QMCHamiltonians/ForceBase.h"
 #include "QMCHamiltonians/OperatorBase.h"
 #include "Particle/NeighborLists.h"
+#include <utility>
 namespace qmcplusplus
 {
 class NonLocalECPComponent;
@@ -154,6 +155,9 @@ public:
    */
   void setRandomGenerator(RandomBase<FullPrecRealType>* rng) override { myRNG = rng; }
 
+  /// return the number of quadrature points evaluated since the last call and reset the count
+  size_t takeQuadraturePointCount() { return std::exchange(quadrature_point_count_, 0); }
+
   void addObservables(PropertySetType& plist, BufferType& collectables) override;
 
   void setObservables(PropertySetType& plist) override;
@@ -227,6 +231,8 @@ private:
 #endif
   ///NLPP job list of ion-electron pairs by spin group
   std::vector<std::vector<NLPPJob<Real>>> nlpp_jobs;
+  ///quadrature points evaluated by evaluate and mw_evaluate, reported by the drivers
+  size_t quadrature_point_count_ = 0;
   /// mult walker shared resource
   ResourceHandle<NonLocalECPotentialMultiWalkerResource> mw_res_handle_;
 
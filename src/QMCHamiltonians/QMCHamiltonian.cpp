@@ -1015,6 +1015,14 @@ int QMCHamiltonian::makeNonLocalMoves(ParticleSet& P)
     return nlpp_ptr->makeNonLocalMovesPbyP(P);
 }
 
+size_t QMCHamiltonian::takeNonLocalQuadraturePointCount()
+{
+  if (nlpp_ptr == nullptr)
+    return 0;
+  else
+    return nlpp_ptr->takeQuadraturePointCount();
+}
+
 
 std::vector<int> QMCHamiltonian::mw_makeNonLocalMoves(const RefVectorWithLeader<QMCHamiltonian>& ham_list,
                                                       const RefVectorWithLeader<TrialWaveFunction>& wf_list,
@@ -359,6 +359,9 @@ public:
    */
   int makeNonLocalMoves(ParticleSet& P);
 
+  /// return the number of non-local pseudopotential quadrature points evaluated since the last call
+  size_t takeNonLocalQuadraturePointCount();
+
   /** determine if L2 potential is present
    */
   bool has_L2() { return l2_ptr != nullptr; }
@@ -0,0 +1,117 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "Configuration.h"
+#include "Particle/ParticleSet.h"
+#include "QMCHamiltonians/MPC.h"
+#include "einspline/bspline.h"
+#include "QMCWaveFunctions/TrialWaveFunction.h"
+#include "Utilities/RuntimeOptions.h"
+
+namespace qmcplusplus
+{
+namespace testing
+{
+/// access to the long range spline of MPC and to its packed evaluation
+class TestMPC
+{
+public:
+  static const UBspline_3d_d* getVlongSpline(const MPC& mpc) { return mpc.VlongSpline.get(); }
+  static void evalLRPoints(const MPC& mpc, size_t n, const double* u0, const double* u1, const double* u2, double* vals)
+  {
+    mpc.evalLRPoints(n, u0, u1, u2, vals);
+  }
+};
+} // namespace testing
+
+TEST_CASE("MPC batched", "[hamiltonian]")
+{
+  using Real = QMCTraits::RealType;
+
+  CrystalLattice<OHMMS_PRECISION, OHMMS_DIM> lattice;
+  lattice.BoxBConds = true; // periodic
+  lattice.R.diagonal(4.0);
+  lattice.reset();
+
+  const SimulationCell simulation_cell(lattice);
+  ParticleSet elec(simulation_cell);
+  elec.setName("e");
+  elec.create({2, 2});
+  elec.R[0]                    = {0.3, 0.5, 1.2};
+  elec.R[1]                    = {2.1, 3.4, 0.7};
+  elec.R[2]                    = {1.6, 0.2, 3.1};
+  elec.R[3]                    = {3.7, 2.5, 2.2};
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  const int upIdx              = tspecies.addSpecies("u");
+  const int downIdx            = tspecies.addSpecies("d");
+  const int chargeIdx          = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+
+  // a smooth electron density made of the shortest G-vectors
+  const Real vol = elec.getLattice().Volume;
+  for (int i = -1; i <= 1; i++)
+    for (int j = -1; j <= 1; j++)
+      for (int k = -1; k <= 1; k++)
+      {
+        elec.DensityReducedGvecs.push_back({i, j, k});
+        const int g2 = i * i + j * j + k * k;
+        elec.Density_G.push_back(g2 == 0 ? QMCTraits::ComplexType(4.0 / vol) : QMCTraits::ComplexType(0.02 / g2));
+      }
+
+  MPC mpc(elec, 4.0);
+  const auto* spline = testing::TestMPC::getVlongSpline(mpc);
+  REQUIRE(spline != nullptr);
+
+  // the packed evaluation against einspline, including points on the grid and at the cell boundary
+  const std::vector<double> u0{0.0, 0.25, 0.5, 0.999999, 0.13, 0.71, 0.42};
+  const std::vector<double> u1{0.0, 0.75, 0.33, 0.5, 0.999999, 0.08, 0.61};
+  const std::vector<double> u2{0.0, 0.5, 0.9, 0.2, 0.47, 0.999999, 0.35};
+  std::vector<double> vals(u0.size());
+  testing::TestMPC::evalLRPoints(mpc, u0.size(), u0.data(), u1.data(), u2.data(), vals.data());
+  for (int ip = 0; ip < u0.size(); ip++)
+  {
+    double val_ref;
+    eval_UBspline_3d_d(const_cast<UBspline_3d_d*>(spline), u0[ip], u1[ip], u2[ip], &val_ref);
+    CHECK(vals[ip] == Approx(val_ref));
+  }
+
+  // the second walker has electrons outside of the cell
+  ParticleSet elec2(elec);
+  elec2.R[0] = {-0.4, 1.1, 2.6};
+  elec2.R[3] = {5.2, -1.3, 0.9};
+
+  RuntimeOptions runtime_options;
+  TrialWaveFunction psi(runtime_options);
+  TrialWaveFunction psi2(runtime_options);
+  auto mpc2 = mpc.makeClone(elec2, psi2);
+
+  elec.update();
+  elec2.update();
+
+  // single walker references, evalLR uses eval_UBspline_3d_d
+  auto mpc_ref          = mpc.makeClone(elec, psi);
+  auto mpc2_ref         = mpc.makeClone(elec2, psi2);
+  const Real value_ref  = mpc_ref->evaluate(elec);
+  const Real value2_ref = mpc2_ref->evaluate(elec2);
+  CHECK(value_ref != Approx(value2_ref));
+
+  RefVectorWithLeader<OperatorBase> o_list(mpc, {mpc, *mpc2});
+  RefVectorWithLeader<TrialWaveFunction> twf_list(psi, {psi, psi2});
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec2});
+  mpc.mw_evaluate(o_list, twf_list, p_list);
+  CHECK(mpc.getValue() == Approx(value_ref));
+  CHECK(mpc2->getValue() == Approx(value2_ref));
+}
+
+} // namespace qmcplusplus
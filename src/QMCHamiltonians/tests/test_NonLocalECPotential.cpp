@@ -184,6 +184,12 @@ TEST_CASE("NonLocalECPotential", "[hamiltonian]")
   ListenerOption<Real> listener_opt{listeners, ion_listeners};
   testing::TestNonLocalECPotential::mw_evaluateImpl(nl_ecp, o_list, twf_list, p_list, false, listener_opt, true);
 
+  // quadrature points are counted on the operator of the walker they were evaluated for
+  const size_t quadrature_points = nl_ecp.takeQuadraturePointCount();
+  CHECK(quadrature_points > 0);
+  CHECK(nl_ecp2.takeQuadraturePointCount() == quadrature_points);
+  CHECK(nl_ecp.takeQuadraturePointCount() == 0);
+
   // I'd like to see this gone when legacy drivers are dropped but for now we'll check against
   // the single particle API
   auto value = o_list[0].evaluateDeterministic(p_list[0]);
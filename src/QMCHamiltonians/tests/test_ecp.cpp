@@ -16,6 +16,7 @@
 #include "Configuration.h"
 #include "Numerics/Quadrature.h"
 #include "QMCHamiltonians/ECPComponentBuilder.h"
+#include "QMCHamiltonians/LocalECPotential.h"
 #include "QMCHamiltonians/NonLocalECPComponent.h"
 #include "QMCHamiltonians/SOECPComponent.h"
 #include "Utilities/RuntimeOptions.h"
@@ -93,6 +94,71 @@ TEST_CASE("ReadFileBuffer_ecp", "[hamiltonian]")
   // TODO: add more checks that pseudopotential file was read correctly
 }
 
+TEST_CASE("LocalECPotential mw_evaluate", "[hamiltonian]")
+{
+  Communicate* c = OHMMS::Controller;
+
+  ECPComponentBuilder ecp("test_read_ecp", c);
+  REQUIRE(ecp.read_pp_file("C.BFD.xml"));
+
+  const SimulationCell simulation_cell;
+  ParticleSet ions(simulation_cell);
+  ions.setName("ion0");
+  ions.create({2});
+  ions.R[0]                     = {0.0, 0.0, 0.0};
+  ions.R[1]                     = {2.5, 0.5, -0.3};
+  SpeciesSet& ion_species       = ions.getSpeciesSet();
+  int pIdx                      = ion_species.addSpecies("C");
+  int pChargeIdx                = ion_species.addAttribute("charge");
+  ion_species(pChargeIdx, pIdx) = 4;
+  ions.update();
+
+  const int nw = 3;
+  std::vector<std::unique_ptr<ParticleSet>> elecs;
+  std::vector<std::unique_ptr<LocalECPotential>> local_ecps;
+  for (int iw = 0; iw < nw; iw++)
+  {
+    elecs.push_back(std::make_unique<ParticleSet>(simulation_cell));
+    ParticleSet& elec = *elecs.back();
+    elec.setName("e");
+    elec.create({4, 4});
+    // include pairs beyond the cutoff of the local potential grid and very close to the ions
+    for (int i = 0; i < 8; i++)
+      elec.R[i] = {0.6 * i - 1.5 + 0.2 * iw, 0.3 * (i % 3) - 0.25 * iw, 0.7 - 0.15 * i};
+    elec.R[3]                    = {0.01, 0.02, -0.01};
+    SpeciesSet& tspecies         = elec.getSpeciesSet();
+    int upIdx                    = tspecies.addSpecies("u");
+    int downIdx                  = tspecies.addSpecies("d");
+    int chargeIdx                = tspecies.addAttribute("charge");
+    tspecies(chargeIdx, upIdx)   = -1;
+    tspecies(chargeIdx, downIdx) = -1;
+
+    local_ecps.push_back(std::make_unique<LocalECPotential>(ions, elec));
+    local_ecps.back()->add(pIdx, std::unique_ptr<LocalECPotential::RadialPotentialType>(ecp.pp_loc->makeClone()),
+                           ecp.Zeff);
+    elec.update();
+  }
+
+  std::vector<LocalECPotential::Return_t> values_ref(nw);
+  for (int iw = 0; iw < nw; iw++)
+    values_ref[iw] = local_ecps[iw]->evaluate(*elecs[iw]);
+
+  RefVectorWithLeader<OperatorBase> o_list(*local_ecps[0]);
+  RefVectorWithLeader<ParticleSet> p_list(*elecs[0]);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    o_list.push_back(*local_ecps[iw]);
+    p_list.push_back(*elecs[iw]);
+  }
+  // LocalECPotential does not use the wavefunction
+  RuntimeOptions runtime_options;
+  TrialWaveFunction psi(runtime_options);
+  RefVectorWithLeader<TrialWaveFunction> wf_list(psi, std::vector<std::reference_wrapper<TrialWaveFunction>>(nw, psi));
+  local_ecps[0]->mw_evaluate(o_list, wf_list, p_list);
+  for (int iw = 0; iw < nw; iw++)
+    CHECK(local_ecps[iw]->getValue() == Approx(values_ref[iw]));
+}
+
 TEST_CASE("ReadFileBuffer_sorep", "[hamiltonian]")
 {
   Communicate* c = OHMMS::Controller;
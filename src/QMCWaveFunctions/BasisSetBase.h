@@ -147,6 +147,8 @@ struct SoaBasisSetBase
 
   virtual SoaBasisSetBase<T>* makeClone() const = 0;
   virtual void setBasisSetSize(int nbs)         = 0;
+  //Selects the offload kernels (true) or the host kernels (false) for the batched evaluations.
+  virtual void setOffload(bool use_offload) {}
 
   //Evaluates value, gradient, and laplacian for electron "iat".  Parks them into a temporary data structure "vgl".
   virtual void evaluateVGL(const ParticleSet& P, int iat, vgl_type& vgl) = 0;
@@ -155,6 +157,17 @@ struct SoaBasisSetBase
                               const RefVectorWithLeader<ParticleSet>& P_list,
                               int iat,
                               OffloadMWVGLArray& vgl) = 0;
+  //Same as mw_evaluateVGL but only computes the basis functions which can be nonzero for electron "iat" of any walker.
+  //    Returns the [first, last) ranges of the basis functions computed in ao_ranges. Other entries of vgl are untouched.
+  virtual void mw_evaluateVGLScreened(const RefVectorWithLeader<SoaBasisSetBase<T>>& basis_list,
+                                      const RefVectorWithLeader<ParticleSet>& P_list,
+                                      int iat,
+                                      OffloadMWVGLArray& vgl,
+                                      std::vector<std::pair<size_t, size_t>>& ao_ranges)
+  {
+    mw_evaluateVGL(basis_list, P_list, iat, vgl);
+    ao_ranges.assign(1, {0, BasisSetSize});
+  }
   //Evaluates value for electron "iat".  places it in a offload array for batched code.
   virtual void mw_evaluateValue(const RefVectorWithLeader<SoaBasisSetBase<T>>& basis_list,
                                 const RefVectorWithLeader<ParticleSet>& P_list,
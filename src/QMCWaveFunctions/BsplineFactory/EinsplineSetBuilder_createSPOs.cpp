@@ -30,6 +30,7 @@
 #include "BsplineReader.h"
 #include "BsplineSet.h"
 #include "createBsplineReader.h"
+#include "MemoryAccounting.h"
 
 #include <array>
 #include <string_view>
@@ -105,6 +106,7 @@ void EinsplineSetBuilder::set_metadata(int numOrbs,
 
 std::unique_ptr<SPOSet> EinsplineSetBuilder::createSPOSetFromXML(xmlNodePtr cur)
 {
+  ScopedMemoryTag spline_memory(MemoryTag::SPLINE);
   //use 2 bohr as the default when truncated orbitals are used based on the extend of the ions
   int numOrbs = 0;
   int sortBands(1);
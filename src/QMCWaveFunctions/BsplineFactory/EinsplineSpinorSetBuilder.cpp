@@ -25,11 +25,13 @@
 #include "einspline_helper.hpp"
 #include "BsplineReader.h"
 #include "createBsplineReader.h"
+#include "MemoryAccounting.h"
 
 namespace qmcplusplus
 {
 std::unique_ptr<SPOSet> EinsplineSpinorSetBuilder::createSPOSetFromXML(xmlNodePtr cur)
 {
+  ScopedMemoryTag spline_memory(MemoryTag::SPLINE);
   int numOrbs = 0;
   int sortBands(1);
   int spinSet       = 0;
@@ -47,7 +47,10 @@ std::unique_ptr<BackflowTransformation> BackflowBuilder::buildBackflowTransforma
 {
   xmlNodePtr curRoot = cur;
   auto BFTrans       = std::make_unique<BackflowTransformation>(targetPtcl);
-  cur                = curRoot->children;
+  OhmmsAttributeSet bfAttrib;
+  bfAttrib.add(BFTrans->qpTolerance, "qptol");
+  bfAttrib.put(curRoot);
+  cur = curRoot->children;
   while (cur != NULL)
   {
     std::string cname(getNodeName(cur));
@@ -21,7 +21,7 @@
 namespace qmcplusplus
 {
 BackflowTransformation::BackflowTransformation(ParticleSet& els)
-    : OptimizableObject("bf"), QP(els), cutOff(0.0), myTableIndex_(els.addTable(els))
+    : OptimizableObject("bf"), QP(els), cutOff(0.0), qpTolerance(1e-10), myTableIndex_(els.addTable(els))
 {
   NumTargets = els.getTotalNum();
   Bmat.resize(NumTargets);
@@ -29,6 +29,7 @@ BackflowTransformation::BackflowTransformation(ParticleSet& els)
   Amat.resize(NumTargets, NumTargets);
   newQP.resize(NumTargets);
   oldQP.resize(NumTargets);
+  detQP.resize(NumTargets);
   indexQP.resize(NumTargets);
   HESS_ID.diagonal(1.0);
   DummyHess    = 0.0;
@@ -38,6 +39,7 @@ BackflowTransformation::BackflowTransformation(ParticleSet& els)
 void BackflowTransformation::copyFrom(const BackflowTransformation& tr, ParticleSet& targetPtcl)
 {
   cutOff       = tr.cutOff;
+  qpTolerance  = tr.qpTolerance;
   numParams    = tr.numParams;
   numVarBefore = tr.numVarBefore;
   optIndexMap  = tr.optIndexMap;
@@ -65,10 +67,12 @@ BackflowTransformation::~BackflowTransformation() = default;
 void BackflowTransformation::acceptMove(const ParticleSet& P, int iat)
 {
   // update QP table
-  // may be faster if I do this one qp at a time, for now do full update
+  // all the qp are copied, indexQP only selects the determinant columns recomputed by the low-rank update
   for (int i = 0; i < NumTargets; i++)
     QP.R[i] = newQP[i];
   QP.update(0);
+  for (int jat : indexQP)
+    detQP[jat] = newQP[jat];
   indexQP.clear();
   switch (UpdateMode)
   {
@@ -97,6 +101,42 @@ void BackflowTransformation::restore(int iat)
     bfFuns[i]->restore(iat, UpdateMode);
 }
 
+void BackflowTransformation::mw_evaluatePbyP(const RefVectorWithLeader<BackflowTransformation>& bf_list,
+                                             const RefVectorWithLeader<ParticleSet>& p_list,
+                                             int iat,
+                                             bool with_grad)
+{
+  for (int iw = 0; iw < bf_list.size(); iw++)
+    if (with_grad)
+      bf_list[iw].evaluatePbyPWithGrad(p_list[iw], iat);
+    else
+      bf_list[iw].evaluatePbyP(p_list[iw], iat);
+}
+
+void BackflowTransformation::mw_accept_rejectMove(const RefVectorWithLeader<BackflowTransformation>& bf_list,
+                                                  const RefVectorWithLeader<ParticleSet>& p_list,
+                                                  int iat,
+                                                  const std::vector<bool>& isAccepted)
+{
+  for (int iw = 0; iw < bf_list.size(); iw++)
+    if (isAccepted[iw])
+      bf_list[iw].acceptMove(p_list[iw], iat);
+    else
+      bf_list[iw].restore(iat);
+}
+
+void BackflowTransformation::collectMovedQP()
+{
+  indexQP.clear();
+  const RealType tol2 = qpTolerance * qpTolerance;
+  for (int jat = 0; jat < NumTargets; jat++)
+  {
+    const PosType dr = newQP[jat] - detQP[jat];
+    if (dot(dr, dr) > tol2)
+      indexQP.push_back(jat);
+  }
+}
+
 void BackflowTransformation::checkInVariables(opt_variables_type& active)
 {
   for (int i = 0; i < bfFuns.size(); i++)
@@ -180,6 +220,7 @@ void BackflowTransformation::copyFromBuffer(ParticleSet& P, WFBufferType& buf)
   for (int i = 0; i < NumTargets; i++)
     QP.R[i] = storeQP[i];
   QP.update(0);
+  detQP = QP.R;
   for (int i = 0; i < bfFuns.size(); i++)
     bfFuns[i]->copyFromBuffer(buf);
 }
@@ -193,6 +234,7 @@ void BackflowTransformation::transformOnly(const ParticleSet& P)
   for (int i = 0; i < bfFuns.size(); i++)
     bfFuns[i]->evaluate(P, QP);
   QP.update(0); // update distance tables
+  detQP = QP.R;
 }
 
 /** calculate new quasi-particle coordinates after pbyp move
@@ -212,13 +254,7 @@ void BackflowTransformation::evaluatePbyP(const ParticleSet& P, int iat)
   indexQP.clear();
   for (int i = 0; i < bfFuns.size(); i++)
     bfFuns[i]->evaluatePbyP(P, iat, newQP);
-  for (int jat = 0; jat < NumTargets; jat++)
-  {
-    // make direct routine in OhmmsPETE later
-    RealType dr = std::sqrt(dot(newQP[jat] - QP.R[jat], newQP[jat] - QP.R[jat]));
-    if (dr > 1e-10)
-      indexQP.push_back(jat);
-  }
+  collectMovedQP();
   //debug
   /*
     dummyQP2.R = P.R;
@@ -258,12 +294,7 @@ void BackflowTransformation::evaluatePbyPWithGrad(const ParticleSet& P, int iat)
   std::copy(FirstOfA, LastOfA, FirstOfA_temp);
   for (int i = 0; i < bfFuns.size(); i++)
     bfFuns[i]->evaluatePbyP(P, iat, newQP, Amat_temp);
-  for (int jat = 0; jat < NumTargets; jat++)
-  {
-    RealType dr = std::sqrt(dot(newQP[jat] - QP.R[jat], newQP[jat] - QP.R[jat]));
-    if (dr > 1e-10)
-      indexQP.push_back(jat);
-  }
+  collectMovedQP();
 }
 
 /** calculate new quasi-particle coordinates after pbyp move
@@ -287,13 +318,7 @@ void BackflowTransformation::evaluatePbyPAll(const ParticleSet& P, int iat)
   std::copy(FirstOfB, LastOfB, FirstOfB_temp);
   for (int i = 0; i < bfFuns.size(); i++)
     bfFuns[i]->evaluatePbyP(P, iat, newQP, Bmat_temp, Amat_temp);
-  for (int jat = 0; jat < NumTargets; jat++)
-  {
-    // make direct routine in OhmmsPETE later
-    RealType dr = std::sqrt(dot(newQP[jat] - QP.R[jat], newQP[jat] - QP.R[jat]));
-    if (dr > 1e-10)
-      indexQP.push_back(jat);
-  }
+  collectMovedQP();
 }
 
 
@@ -345,6 +370,7 @@ void BackflowTransformation::evaluate(const ParticleSet& P)
           //
     */
   QP.update(0); // update distance tables
+  detQP = QP.R;
 }
 
 /** calculate quasi-particle coordinates and store in Pnew
@@ -397,6 +423,7 @@ void BackflowTransformation::evaluateDerivatives(const ParticleSet& P)
   for (int i = 0; i < bfFuns.size(); i++)
     bfFuns[i]->evaluateWithDerivatives(P, QP, Bmat_full, Amat, Cmat, Ymat, Xmat);
   QP.update(0);
+  detQP = QP.R;
 }
 
 void BackflowTransformation::testDeriv(const ParticleSet& P)
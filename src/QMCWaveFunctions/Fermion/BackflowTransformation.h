@@ -86,6 +86,16 @@ public:
   // cutoff of radial funtions
   RealType cutOff;
 
+  /** displacement below which a quasi-particle is left out of indexQP after a pbyp move
+   *
+   * Quasi-particles outside the backflow cutoff of the moved electron do not move at all;
+   * the tolerance additionally drops those inside the cutoff whose shift is negligible so
+   * that the determinants only recompute and update the columns in indexQP.
+   * acceptMove still copies every quasi-particle into QP. The shift is measured from detQP,
+   * so a determinant column is never further than qpTolerance from its quasi-particle.
+   */
+  RealType qpTolerance;
+
   // pos of first optimizable variable in global array
   int numVarBefore;
 
@@ -134,6 +144,13 @@ public:
   ParticleSet::ParticlePos newQP;
   ParticleSet::ParticlePos oldQP;
 
+  /** qp coordinates the determinant columns were last computed with
+   *
+   * QP follows every accepted move while the columns of the shifts below qpTolerance are kept.
+   * indexQP compares newQP against detQP so that such shifts cannot accumulate unnoticed.
+   */
+  ParticleSet::ParticlePos detQP;
+
   //Vector<PosType> storeQP;
   Vector<PosType> storeQP;
 
@@ -156,6 +173,20 @@ public:
 
   void restore(int iat = 0);
 
+  /** evaluatePbyP or evaluatePbyPWithGrad over walkers after ParticleSet::mw_makeMove
+   * @param with_grad if true, Amat_temp is also computed for ratioGrad
+   */
+  static void mw_evaluatePbyP(const RefVectorWithLeader<BackflowTransformation>& bf_list,
+                              const RefVectorWithLeader<ParticleSet>& p_list,
+                              int iat,
+                              bool with_grad);
+
+  /// acceptMove or restore over walkers
+  static void mw_accept_rejectMove(const RefVectorWithLeader<BackflowTransformation>& bf_list,
+                                   const RefVectorWithLeader<ParticleSet>& p_list,
+                                   int iat,
+                                   const std::vector<bool>& isAccepted);
+
   bool isOptimizable() const;
   void checkInVariables(opt_variables_type& active);
   void checkOutVariables(const opt_variables_type& active);
@@ -208,6 +239,10 @@ public:
   void testDeriv(const ParticleSet& P);
 
   void testPbyP(ParticleSet& P);
+
+private:
+  /// fill indexQP with the quasi-particles moved by more than qpTolerance from detQP
+  void collectMovedQP();
 };
 
 } // namespace qmcplusplus
@@ -22,6 +22,7 @@
 #include "Numerics/MatrixOperators.h"
 #include "QMCWaveFunctions/TWFFastDerivWrapper.h"
 #include "QMCWaveFunctions/RotatedSPOs.h"
+#include "MemoryAccounting.h"
 
 namespace qmcplusplus
 {
@@ -742,6 +743,7 @@ void DiracDeterminant<DU_TYPE>::evaluateDerivativesWF(ParticleSet& P,
 template<typename DU_TYPE>
 std::unique_ptr<DiracDeterminantBase> DiracDeterminant<DU_TYPE>::makeCopy(std::unique_ptr<SPOSet>&& spo) const
 {
+  ScopedMemoryTag determinant_memory(MemoryTag::DETERMINANT);
   return std::make_unique<DiracDeterminant<DU_TYPE>>(std::move(spo), FirstIndex, LastIndex, ndelay_,
                                                      matrix_inverter_kind_);
 }
@@ -21,6 +21,7 @@
 #include "QMCWaveFunctions/RotatedSPOs.h"
 #endif
 #include "CPU/SIMD/inner_product.hpp"
+#include "MemoryAccounting.h"
 #include <cassert>
 
 namespace qmcplusplus
@@ -1178,6 +1179,7 @@ void DiracDeterminantBatched<DET_ENGINE>::registerTWFFastDerivWrapper(const Part
 template<typename DET_ENGINE>
 std::unique_ptr<DiracDeterminantBase> DiracDeterminantBatched<DET_ENGINE>::makeCopy(std::unique_ptr<SPOSet>&& spo) const
 {
+  ScopedMemoryTag determinant_memory(MemoryTag::DETERMINANT);
   return std::make_unique<DiracDeterminantBatched<DET_ENGINE>>(std::move(spo), FirstIndex, LastIndex, ndelay_,
                                                                matrix_inverter_kind_);
 }
@@ -1187,6 +1189,7 @@ void DiracDeterminantBatched<DET_ENGINE>::createResource(ResourceCollection& col
 {
   collection.addResource(std::make_unique<DiracDeterminantBatchedMultiWalkerResource>());
   Phi->createResource(collection);
+  ScopedMemoryTag determinant_memory(MemoryTag::DETERMINANT);
   det_engine_.createResource(collection);
   collection.addResource(std::make_unique<typename DET_ENGINE::DetInverter>());
 }
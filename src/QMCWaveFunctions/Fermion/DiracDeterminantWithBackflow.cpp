@@ -32,7 +32,7 @@ DiracDeterminantWithBackflow::DiracDeterminantWithBackflow(std::unique_ptr<SPOSe
                                                            BackflowTransformation& BF,
                                                            int first,
                                                            int last)
-    : DiracDeterminantBase(getClassName(), std::move(spos), first, last), BFTrans_(BF)
+    : DiracDeterminantBase(getClassName(), std::move(spos), first, last), BFTrans_(BF), delayedInverse(false)
 {
   NumParticles = BFTrans_.QP.getTotalNum();
   NP           = 0;
@@ -66,6 +66,14 @@ void DiracDeterminantWithBackflow::resize(int nel, int morb)
   psiMinv_temp.resize(NumPtcls, norb);
   psiV.resize(norb);
   psiM_temp.resize(NumPtcls, norb);
+  // Woodbury scratch, only the leading k rows are used
+  movedQP.reserve(nel);
+  Vt.resize(nel, norb);
+  Rinv.resize(nel, nel);
+  Wt.resize(nel, nel);
+  RinvMinv.resize(nel, norb);
+  WorkSpaceR.resize(nel);
+  PivotR.resize(nel);
   // For forces
   /*  not used
   grad_source_psiM.resize(nel,norb);
@@ -189,36 +197,95 @@ void DiracDeterminantWithBackflow::copyFromBuffer(ParticleSet& P, WFBufferType&
  */
 DiracDeterminantWithBackflow::PsiValue DiracDeterminantWithBackflow::ratio(ParticleSet& P, int iat)
 {
-  // FIX FIX FIX : code Woodbury formula
-  psiM_temp = psiM;
-  // either code Woodbury or do multiple single particle updates
-  UpdateMode                        = ORB_PBYP_RATIO;
-  std::vector<int>::iterator it     = BFTrans_.indexQP.begin();
-  std::vector<int>::iterator it_end = BFTrans_.indexQP.end();
-  while (it != it_end)
+  UpdateMode = ORB_PBYP_RATIO;
+  evaluateMovedQP(false);
+  InverseTimer.start();
+  LogValue logRatio;
+  delayedInverse = useWoodbury();
+  if (delayedInverse)
+    logRatio = computeRinv(); // psiMinv is updated in acceptMove
+  else
   {
-    if (*it < FirstIndex || *it >= LastIndex)
+    psiM_temp = psiM;
+    for (int a = 0; a < movedQP.size(); a++)
+      for (int orb = 0; orb < NumOrbitals; orb++)
+        psiM_temp(orb, movedQP[a]) = Vt(a, orb);
+    psiMinv_temp = psiM_temp;
+    LogValue NewLog;
+    InvertWithLog(psiMinv_temp.data(), NumPtcls, NumOrbitals, WorkSpace.data(), Pivot.data(), NewLog);
+    logRatio = NewLog - log_value_;
+  }
+  InverseTimer.stop();
+  return curRatio = LogToValue<PsiValue>::convert(logRatio);
+}
+
+void DiracDeterminantWithBackflow::evaluateMovedQP(bool with_grad)
+{
+  movedQP.clear();
+  for (int qp : BFTrans_.indexQP)
+    if (qp >= FirstIndex && qp < LastIndex)
+      movedQP.push_back(qp - FirstIndex);
+  for (int a = 0; a < movedQP.size(); a++)
+  {
+    const int jat = movedQP[a];
+    const int qp  = FirstIndex + jat;
+    BFTrans_.QP.makeMove(qp, BFTrans_.newQP[qp] - BFTrans_.QP.R[qp]);
+    if (with_grad)
     {
-      ++it;
-      continue;
+      Phi->evaluateVGL(BFTrans_.QP, qp, psiV, dpsiV, d2psiV);
+      for (int orb = 0; orb < psiV.size(); orb++)
+        psiM_temp(orb, jat) = psiV[orb];
+      std::copy(dpsiV.begin(), dpsiV.end(), dpsiM_temp.begin(jat));
+      std::copy(grad_gradV.begin(), grad_gradV.end(), grad_grad_psiM_temp.begin(jat));
     }
-    int jat    = *it - FirstIndex;
-    PosType dr = BFTrans_.newQP[*it] - BFTrans_.QP.R[*it];
-    BFTrans_.QP.makeMove(*it, dr);
-    Phi->evaluateValue(BFTrans_.QP, *it, psiV);
-    for (int orb = 0; orb < psiV.size(); orb++)
-      psiM_temp(orb, jat) = psiV[orb];
-    BFTrans_.QP.rejectMove(*it);
-    it++;
+    else
+      Phi->evaluateValue(BFTrans_.QP, qp, psiV);
+    std::copy(psiV.begin(), psiV.end(), Vt[a]);
+    BFTrans_.QP.rejectMove(qp);
   }
-  // FIX FIX FIX : code Woodbury formula
-  psiMinv_temp = psiM_temp;
-  // FIX FIX FIX : code Woodbury formula
-  InverseTimer.start();
-  LogValue NewLog;
-  InvertWithLog(psiMinv_temp.data(), NumPtcls, NumOrbitals, WorkSpace.data(), Pivot.data(), NewLog);
-  InverseTimer.stop();
-  return curRatio = LogToValue<PsiValue>::convert(NewLog - log_value_);
+}
+
+DiracDeterminantWithBackflow::LogValue DiracDeterminantWithBackflow::computeRinv()
+{
+  const int k = movedQP.size();
+  LogValue logR;
+  if (k == 0)
+    return logR;
+  ValueType* restrict r = Rinv.data();
+  for (int a = 0; a < k; a++)
+    for (int b = 0; b < k; b++)
+      r[a * k + b] = simd::dot(psiMinv[movedQP[a]], Vt[b], NumOrbitals);
+  InvertWithLog(r, k, k, WorkSpaceR.data(), PivotR.data(), logR);
+  return logR;
+}
+
+void DiracDeterminantWithBackflow::updateInverse(ValueMatrix& psiMinv_new)
+{
+  const int k = movedQP.size();
+  if (k == 0)
+    return;
+  const ValueType* restrict r = Rinv.data();
+  for (int b = 0; b < k; b++)
+  {
+    for (int j = 0; j < NumPtcls; j++)
+      Wt(b, j) = simd::dot(psiMinv[j], Vt[b], NumOrbitals);
+    Wt(b, movedQP[b]) -= ValueType(1);
+  }
+  for (int a = 0; a < k; a++)
+  {
+    ValueType* restrict row = RinvMinv[a];
+    std::fill_n(row, NumOrbitals, ValueType(0));
+    for (int b = 0; b < k; b++)
+    {
+      const ValueType* restrict minv_row = psiMinv[movedQP[b]];
+      const ValueType rab                = r[a * k + b];
+      for (int orb = 0; orb < NumOrbitals; orb++)
+        row[orb] += rab * minv_row[orb];
+    }
+  }
+  // psiMinv_new -= Wt^T * RinvMinv, row-major view of the column-major gemm
+  BLAS::gemm('N', 'T', NumOrbitals, NumPtcls, k, ValueType(-1), RinvMinv.data(), RinvMinv.cols(), Wt.data(), Wt.cols(),
+             ValueType(1), psiMinv_new.data(), psiMinv_new.cols());
 }
 
 void DiracDeterminantWithBackflow::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<ValueType>& ratios)
@@ -260,37 +327,26 @@ DiracDeterminantWithBackflow::PsiValue DiracDeterminantWithBackflow::ratioGrad(P
                                                                                int iat,
                                                                                GradType& grad_iat)
 {
-  // FIX FIX FIX : code Woodbury formula
-  psiM_temp                         = psiM;
-  dpsiM_temp                        = dpsiM;
-  UpdateMode                        = ORB_PBYP_PARTIAL;
-  std::vector<int>::iterator it     = BFTrans_.indexQP.begin();
-  std::vector<int>::iterator it_end = BFTrans_.indexQP.end();
-  ParticleSet::ParticlePos dr;
-  while (it != it_end)
+  psiM_temp  = psiM;
+  dpsiM_temp = dpsiM;
+  UpdateMode = ORB_PBYP_PARTIAL;
+  evaluateMovedQP(true);
+  InverseTimer.start();
+  LogValue logRatio;
+  delayedInverse = false;
+  if (useWoodbury())
   {
-    if (*it < FirstIndex || *it >= LastIndex)
-    {
-      ++it;
-      continue;
-    }
-    int jat    = *it - FirstIndex;
-    PosType dr = BFTrans_.newQP[*it] - BFTrans_.QP.R[*it];
-    BFTrans_.QP.makeMove(*it, dr);
-    Phi->evaluateVGL(BFTrans_.QP, *it, psiV, dpsiV, d2psiV);
-    for (int orb = 0; orb < psiV.size(); orb++)
-      psiM_temp(orb, jat) = psiV[orb];
-    std::copy(dpsiV.begin(), dpsiV.end(), dpsiM_temp.begin(jat));
-    std::copy(grad_gradV.begin(), grad_gradV.end(), grad_grad_psiM_temp.begin(jat));
-    BFTrans_.QP.rejectMove(*it);
-    it++;
+    logRatio     = computeRinv();
+    psiMinv_temp = psiMinv;
+    updateInverse(psiMinv_temp);
+  }
+  else
+  {
+    psiMinv_temp = psiM_temp;
+    LogValue NewLog;
+    InvertWithLog(psiMinv_temp.data(), NumPtcls, NumOrbitals, WorkSpace.data(), Pivot.data(), NewLog);
+    logRatio = NewLog - log_value_;
   }
-  // FIX FIX FIX : code Woodbury formula
-  psiMinv_temp = psiM_temp;
-  // FIX FIX FIX : code Woodbury formula
-  InverseTimer.start();
-  LogValue NewLog;
-  InvertWithLog(psiMinv_temp.data(), NumPtcls, NumOrbitals, WorkSpace.data(), Pivot.data(), NewLog);
   InverseTimer.stop();
   // update Fmatdiag_temp
   for (int j = 0; j < NumPtcls; j++)
@@ -298,7 +354,7 @@ DiracDeterminantWithBackflow::PsiValue DiracDeterminantWithBackflow::ratioGrad(P
     Fmatdiag_temp[j] = simd::dot(psiMinv_temp[j], dpsiM_temp[j], NumOrbitals);
     grad_iat += dot(BFTrans_.Amat_temp(iat, FirstIndex + j), Fmatdiag_temp[j]);
   }
-  return curRatio = LogToValue<PsiValue>::convert(NewLog - log_value_);
+  return curRatio = LogToValue<PsiValue>::convert(logRatio);
 }
 
 void DiracDeterminantWithBackflow::testL(ParticleSet& P)
@@ -565,8 +621,18 @@ void DiracDeterminantWithBackflow::acceptMove(ParticleSet& P, int iat, bool safe
   switch (UpdateMode)
   {
   case ORB_PBYP_RATIO:
-    psiMinv = psiMinv_temp;
-    psiM    = psiM_temp;
+    if (delayedInverse)
+    {
+      updateInverse(psiMinv);
+      for (int a = 0; a < movedQP.size(); a++)
+        for (int orb = 0; orb < NumOrbitals; orb++)
+          psiM(orb, movedQP[a]) = Vt(a, orb);
+    }
+    else
+    {
+      psiMinv = psiMinv_temp;
+      psiM    = psiM_temp;
+    }
     break;
   case ORB_PBYP_PARTIAL:
     psiMinv        = psiMinv_temp;
@@ -586,12 +652,17 @@ void DiracDeterminantWithBackflow::acceptMove(ParticleSet& P, int iat, bool safe
     break;
   }
   UpdateTimer.stop();
-  curRatio = 1.0;
+  curRatio       = 1.0;
+  delayedInverse = false;
 }
 
 /** move was rejected. Nothing to restore for now.
 */
-void DiracDeterminantWithBackflow::restore(int iat) { curRatio = 1.0; }
+void DiracDeterminantWithBackflow::restore(int iat)
+{
+  curRatio       = 1.0;
+  delayedInverse = false;
+}
 
 void DiracDeterminantWithBackflow::evaluateDerivatives(ParticleSet& P,
                                                        const opt_variables_type& active,
@@ -57,6 +57,13 @@ public:
 
   std::string getClassName() const override { return "DiracDeterminantWithBackflow"; }
 
+#ifndef NDEBUG
+  /// return  for testing
+  ValueMatrix& getPsiMinv() override { return psiMinv; }
+#else
+  ValueMatrix& getPsiMinv() { return psiMinv; }
+#endif
+
   // in general, assume that P is the quasiparticle set
   void evaluateDerivatives(ParticleSet& P,
                            const opt_variables_type& active,
@@ -207,6 +214,39 @@ private:
   ParticleSet::ParticleGradient myG, myG_temp;
   ParticleSet::ParticleLaplacian myL, myL_temp;
 
+  /** Sherman-Morrison-Woodbury update of psiMinv for the k quasi-particles moved by a pbyp move
+   *
+   * With E the N x k selection of the moved columns and V the new columns of psiM,
+   * \f$ R = E^T A^{-1} V \f$, the ratio is det(R) and
+   * \f$ A'^{-1} = A^{-1} - (A^{-1} V - E) R^{-1} E^T A^{-1} \f$.
+   * Falls back to a full inversion when k is more than half of the determinant size.
+   */
+  ///local indices of the moved quasi-particles, E
+  std::vector<int> movedQP;
+  ///new columns of psiM of the moved quasi-particles stored as rows, V^T
+  ValueMatrix Vt;
+  ///R inverted in place
+  ValueMatrix Rinv;
+  ///\f$(A^{-1} V - E)^T\f$
+  ValueMatrix Wt;
+  ///\f$R^{-1} E^T A^{-1}\f$
+  ValueMatrix RinvMinv;
+  Vector<ValueType> WorkSpaceR;
+  Vector<IndexType> PivotR;
+  ///true if ratio() left the update of psiMinv to acceptMove
+  bool delayedInverse;
+
+  /** fill movedQP and Vt from the quasi-particles moved in BFTrans_.indexQP
+   * @param with_grad if true, psiM_temp and dpsiM_temp are also updated for ratioGrad
+   */
+  void evaluateMovedQP(bool with_grad);
+  ///compute Rinv from psiMinv and Vt, return log det(R)
+  LogValue computeRinv();
+  ///apply the rank-k update to psiMinv_new, which can be psiMinv itself
+  void updateInverse(ValueMatrix& psiMinv_new);
+  ///true if the Woodbury update is cheaper than a full inversion
+  inline bool useWoodbury() const { return 2 * movedQP.size() <= NumPtcls; }
+
   void dummyEvalLi(ValueType& L1, ValueType& L2, ValueType& L3);
 
   void evaluate_SPO(ValueMatrix& logdet, GradMatrix& dlogdet, HessMatrix& grad_grad_logdet);
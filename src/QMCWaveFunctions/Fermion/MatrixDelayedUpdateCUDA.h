@@ -27,6 +27,7 @@
 #include "DiracMatrixComputeCUDA.hpp"
 #include "ResourceCollection.h"
 #include "WaveFunctionTypes.hpp"
+#include "MemoryAccounting.h"
 
 namespace qmcplusplus
 {
@@ -99,6 +100,7 @@ public:
 
     std::unique_ptr<Resource> makeClone() const override
     {
+      ScopedMemoryTag determinant_memory(MemoryTag::DETERMINANT);
       return std::make_unique<MatrixDelayedUpdateCUDAMultiWalkerMem>(*this);
     }
   };
@@ -21,6 +21,7 @@
 #include "ResourceCollection.h"
 #include "DiracMatrixComputeOMPTarget.hpp"
 #include "WaveFunctionTypes.hpp"
+#include "MemoryAccounting.h"
 
 namespace qmcplusplus
 {
@@ -86,6 +87,7 @@ public:
 
     std::unique_ptr<Resource> makeClone() const override
     {
+      ScopedMemoryTag determinant_memory(MemoryTag::DETERMINANT);
       return std::make_unique<MatrixUpdateOMPTargetMultiWalkerMem>(*this);
     }
   };
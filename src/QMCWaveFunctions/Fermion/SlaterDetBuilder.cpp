@@ -24,6 +24,7 @@
 #include "Utilities/ProgressReportEngine.h"
 #include "OhmmsData/AttributeSet.h"
 #include "PlatformSelector.hpp"
+#include "MemoryAccounting.h"
 
 #include "QMCWaveFunctions/Fermion/SlaterDet.h"
 #include "QMCWaveFunctions/Fermion/MultiSlaterDetTableMethod.h"
@@ -368,6 +369,7 @@ std::unique_ptr<DiracDeterminantBase> SlaterDetBuilder::putDeterminant(
   else
     app_summary() << "      Using rank-1 Sherman-Morrison Fahy update (SM1)" << std::endl;
 
+  ScopedMemoryTag determinant_memory(MemoryTag::DETERMINANT);
   std::unique_ptr<DiracDeterminantBase> adet;
 
   if (BFTrans)
@@ -84,6 +84,71 @@ void SlaterDetWithBackflow::copyFromBuffer(ParticleSet& P, WFBufferType& buf)
     Dets[i]->copyFromBuffer(P, buf);
 }
 
+void SlaterDetWithBackflow::mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                         const RefVectorWithLeader<ParticleSet>& p_list,
+                                         int iat,
+                                         std::vector<PsiValue>& ratios) const
+{
+  BackflowTransformation::mw_evaluatePbyP(extract_BF_list(wfc_list), p_list, iat, false);
+  std::fill(ratios.begin(), ratios.end(), PsiValue(1));
+  std::vector<PsiValue> det_ratios(wfc_list.size());
+  for (int i = 0; i < Dets.size(); ++i)
+  {
+    Dets[i]->mw_calcRatio(extract_DetRef_list(wfc_list, i), p_list, iat, det_ratios);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      ratios[iw] *= det_ratios[iw];
+  }
+}
+
+void SlaterDetWithBackflow::mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                         const RefVectorWithLeader<ParticleSet>& p_list,
+                                         int iat,
+                                         std::vector<PsiValue>& ratios,
+                                         std::vector<GradType>& grad_new) const
+{
+  BackflowTransformation::mw_evaluatePbyP(extract_BF_list(wfc_list), p_list, iat, true);
+  std::fill(ratios.begin(), ratios.end(), PsiValue(1));
+  std::vector<PsiValue> det_ratios(wfc_list.size());
+  for (int i = 0; i < Dets.size(); ++i)
+  {
+    Dets[i]->mw_ratioGrad(extract_DetRef_list(wfc_list, i), p_list, iat, det_ratios, grad_new);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      ratios[iw] *= det_ratios[iw];
+  }
+}
+
+void SlaterDetWithBackflow::mw_accept_rejectMove(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                                 const RefVectorWithLeader<ParticleSet>& p_list,
+                                                 int iat,
+                                                 const std::vector<bool>& isAccepted,
+                                                 bool safe_to_delay) const
+{
+  BackflowTransformation::mw_accept_rejectMove(extract_BF_list(wfc_list), p_list, iat, isAccepted);
+  for (int i = 0; i < Dets.size(); ++i)
+    Dets[i]->mw_accept_rejectMove(extract_DetRef_list(wfc_list, i), p_list, iat, isAccepted);
+}
+
+RefVectorWithLeader<WaveFunctionComponent> SlaterDetWithBackflow::extract_DetRef_list(
+    const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+    int det_id) const
+{
+  RefVectorWithLeader<WaveFunctionComponent> Det_list(*wfc_list.getCastedLeader<SlaterDetWithBackflow>().Dets[det_id]);
+  Det_list.reserve(wfc_list.size());
+  for (WaveFunctionComponent& wfc : wfc_list)
+    Det_list.push_back(*static_cast<SlaterDetWithBackflow&>(wfc).Dets[det_id]);
+  return Det_list;
+}
+
+RefVectorWithLeader<BackflowTransformation> SlaterDetWithBackflow::extract_BF_list(
+    const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  RefVectorWithLeader<BackflowTransformation> bf_list(*wfc_list.getCastedLeader<SlaterDetWithBackflow>().BFTrans);
+  bf_list.reserve(wfc_list.size());
+  for (WaveFunctionComponent& wfc : wfc_list)
+    bf_list.push_back(*static_cast<SlaterDetWithBackflow&>(wfc).BFTrans);
+  return bf_list;
+}
+
 std::unique_ptr<WaveFunctionComponent> SlaterDetWithBackflow::makeClone(ParticleSet& tqp) const
 {
   auto bf = BFTrans->makeClone(tqp);
@@ -121,6 +121,29 @@ public:
     return ratio;
   }
 
+  /** batched ratio, the quasi-particles of all the walkers are moved before the determinants
+   * which only recompute the moved columns and apply a low-rank update
+   *
+   * The batched functions still loop over the walkers: every walker moves its own set of
+   * quasi-particles, so the column evaluations and low-rank updates are done one walker at a time.
+   */
+  void mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValue>& ratios) const override;
+
+  void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValue>& ratios,
+                    std::vector<GradType>& grad_new) const override;
+
+  void mw_accept_rejectMove(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list,
+                            int iat,
+                            const std::vector<bool>& isAccepted,
+                            bool safe_to_delay = false) const override;
+
   std::unique_ptr<WaveFunctionComponent> makeClone(ParticleSet& tqp) const override;
 
   SPOSetPtr getPhi(int i = 0) const { return Dets[i]->getPhi(); }
@@ -135,6 +158,14 @@ public:
   void testDerivGL(ParticleSet& P);
 
 private:
+  /// helper function for extracting the list of the det_id-th determinant over walkers
+  RefVectorWithLeader<WaveFunctionComponent> extract_DetRef_list(
+      const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+      int det_id) const;
+  /// helper function for extracting the list of backflow transformations over walkers
+  RefVectorWithLeader<BackflowTransformation> extract_BF_list(
+      const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const;
+
   ///container for the DiracDeterminants
   const std::vector<std::unique_ptr<Determinant_t>> Dets;
   /// backflow transformation
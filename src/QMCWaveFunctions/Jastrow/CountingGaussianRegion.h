@@ -357,6 +357,34 @@ public:
     }
   }
 
+  /** evaluate only the region sums with electron iat placed at r
+   * @param r proposed position of electron iat
+   * @param iat electron index
+   * @param sum_new [num_regions] region sums at the proposed position
+   *
+   * Value-only variant of evaluateTemp used by ratio-only paths. Does not touch the temporary arrays.
+   */
+  void evaluateTempSum(const PosType& r, int iat, RealType* restrict sum_new) const
+  {
+    RealType Lmax_new = Lmax[iat];
+    for (int I = 0; I < num_regions; ++I)
+    {
+      PosType lgrad;
+      RealType llap;
+      C[I]->evaluateLog(r, sum_new[I], lgrad, llap);
+      if (sum_new[I] > Lmax_new)
+        Lmax_new = sum_new[I];
+    }
+    RealType Nval_new = 0;
+    for (int I = 0; I < num_regions; ++I)
+    {
+      sum_new[I] = std::exp(sum_new[I] - Lmax_new);
+      Nval_new += sum_new[I];
+    }
+    for (int I = 0; I < num_regions; ++I)
+      sum_new[I] = sum[I] + sum_new[I] / Nval_new - val(I, iat);
+  }
+
   void evaluateTemp_print(std::ostream& os, const ParticleSet& P)
   {
     os << "CountingGaussianRegion::evaluateTemp_print" << std::endl;
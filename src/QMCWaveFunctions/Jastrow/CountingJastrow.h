@@ -16,9 +16,33 @@
 #include "Particle/ParticleSet.h"
 #include "QMCWaveFunctions/WaveFunctionComponent.h"
 #include "QMCWaveFunctions/Jastrow/CountingGaussianRegion.h"
+#include "Particle/VirtualParticleSet.h"
+#include "CPU/BLAS.hpp"
+#include "CPU/SIMD/inner_product.hpp"
+#include <ResourceCollection.h>
 
 namespace qmcplusplus
 {
+/** multi-walker scratch of CountingJastrow
+ *
+ * Region sums of a crowd are stacked row by row so that the products with F are done with a single gemm.
+ */
+struct CountingJastrowMultiWalkerMem : public Resource
+{
+  using RealType = QMCTraits::RealType;
+
+  /// region sums at the proposed positions, one row per walker or per virtual particle
+  Matrix<RealType> mw_sum_t;
+  /// F times the rows of mw_sum_t
+  Matrix<RealType> mw_FCsum_t;
+
+  CountingJastrowMultiWalkerMem() : Resource("CountingJastrowMultiWalkerMem") {}
+
+  CountingJastrowMultiWalkerMem(const CountingJastrowMultiWalkerMem&) : CountingJastrowMultiWalkerMem() {}
+
+  std::unique_ptr<Resource> makeClone() const override { return std::make_unique<CountingJastrowMultiWalkerMem>(*this); }
+};
+
 template<class RegionType>
 class CountingJastrow : public WaveFunctionComponent, public OptimizableObject
 {
@@ -87,6 +111,9 @@ protected:
   std::array<std::vector<int>, NUM_OPT_VAR> opt_index;
   std::array<std::vector<std::string>, NUM_OPT_VAR> opt_id;
 
+  /// multi-walker scratch, only valid on the crowd leader
+  ResourceHandle<CountingJastrowMultiWalkerMem> mw_mem_handle_;
+
   //================================================================================
 
 public:
@@ -244,35 +271,32 @@ public:
     // evaluate counting regions
     C->evaluate(P);
     std::fill(FCsum.begin(), FCsum.end(), 0);
+    for (int I = 0; I < num_regions; ++I)
+      for (int J = 0; J < num_regions; ++J)
+        FCsum[I] += F(I, J) * C->sum[J]; // MV
+    evaluateExponentsFromFCsum(P);
+  }
+
+  /** complete the exponents once the regions and FCsum are up to date
+   */
+  void evaluateExponentsFromFCsum(const ParticleSet& P)
+  {
     std::fill(FCgrad.begin(), FCgrad.end(), 0);
     std::fill(FClap.begin(), FClap.end(), 0);
-    Jval = 0;
-    std::fill(Jgrad.begin(), Jgrad.end(), 0);
-    std::fill(Jlap.begin(), Jlap.end(), 0);
 
     // evaluate FC products
     for (int I = 0; I < num_regions; ++I)
-    {
       for (int J = 0; J < num_regions; ++J)
-      {
-        FCsum[I] += F(I, J) * C->sum[J]; // MV
         for (int i = 0; i < num_els; ++i)
         {
           FCgrad(I, i) += F(I, J) * C->grad(J, i); // 3*nels*MV
           FClap(I, i) += F(I, J) * C->lap(J, i);   // nels*MV
         }
-      }
-    }
     // evaluate components of J
+    Jval = 0;
     for (int I = 0; I < num_regions; ++I)
-    {
       Jval += FCsum[I] * C->sum[I]; // VV
-      for (int i = 0; i < num_els; ++i)
-      {
-        Jgrad[i] += 2 * FCsum[I] * C->grad(I, i);                                      // 3*nels*VV
-        Jlap[i] += 2 * FCsum[I] * C->lap(I, i) + 2 * dot(FCgrad(I, i), C->grad(I, i)); // nels*VV
-      }
-    }
+    evaluateJgradJlap();
     // print out results every so often
     if (debug)
     {
@@ -284,6 +308,19 @@ public:
     }
   }
 
+  /** rebuild Jgrad and Jlap of all the electrons from FCsum, FCgrad and the regions
+   */
+  void evaluateJgradJlap()
+  {
+    std::fill(Jgrad.begin(), Jgrad.end(), 0);
+    std::fill(Jlap.begin(), Jlap.end(), 0);
+    for (int I = 0; I < num_regions; ++I)
+      for (int i = 0; i < num_els; ++i)
+      {
+        Jgrad[i] += 2 * FCsum[I] * C->grad(I, i);                                      // 3*nels*VV
+        Jlap[i] += 2 * FCsum[I] * C->lap(I, i) + 2 * dot(FCgrad(I, i), C->grad(I, i)); // nels*VV
+      }
+  }
 
   void evaluateExponents_print(std::ostream& os, const ParticleSet& P)
   {
@@ -421,6 +458,196 @@ public:
     return std::exp(static_cast<PsiValue>(Jval_t - Jval));
   }
 
+  /** exponent s^T F s of the region sums s
+   */
+  RealType evaluateJval(const RealType* restrict s) const
+  {
+    RealType jval = 0;
+    for (int I = 0; I < num_regions; ++I)
+      for (int J = 0; J < num_regions; ++J)
+        jval += s[I] * F(I, J) * s[J];
+    return jval;
+  }
+
+  void evaluateRatios(const VirtualParticleSet& VP, std::vector<ValueType>& ratios) override
+  {
+    std::vector<RealType> sum_new(num_regions);
+    for (int k = 0; k < ratios.size(); ++k)
+    {
+      C->evaluateTempSum(VP.R[k], VP.refPtcl, sum_new.data());
+      ratios[k] = std::exp(evaluateJval(sum_new.data()) - Jval);
+    }
+  }
+
+  LogValue evaluateGL(const ParticleSet& P,
+                      ParticleSet::ParticleGradient& G,
+                      ParticleSet::ParticleLaplacian& L,
+                      bool fromscratch) override
+  {
+    if (fromscratch)
+      evaluateExponents(P);
+    for (int i = 0; i < num_els; ++i)
+    {
+      G[i] += Jgrad[i];
+      L[i] += Jlap[i];
+    }
+    return log_value_ = Jval;
+  }
+
+  void createResource(ResourceCollection& collection) const override
+  {
+    collection.addResource(std::make_unique<CountingJastrowMultiWalkerMem>());
+  }
+
+  void acquireResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override
+  {
+    auto& wfc_leader          = wfc_list.getCastedLeader<CountingJastrow>();
+    wfc_leader.mw_mem_handle_ = collection.lendResource<CountingJastrowMultiWalkerMem>();
+  }
+
+  void releaseResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override
+  {
+    auto& wfc_leader = wfc_list.getCastedLeader<CountingJastrow>();
+    collection.takebackResource(wfc_leader.mw_mem_handle_);
+  }
+
+  void mw_evaluateLog(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                      const RefVectorWithLeader<ParticleSet>& p_list,
+                      const RefVector<ParticleSet::ParticleGradient>& G_list,
+                      const RefVector<ParticleSet::ParticleLaplacian>& L_list) const override
+  {
+    mw_evaluateGL(wfc_list, p_list, G_list, L_list, true);
+  }
+
+  void mw_evaluateGL(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                     const RefVectorWithLeader<ParticleSet>& p_list,
+                     const RefVector<ParticleSet::ParticleGradient>& G_list,
+                     const RefVector<ParticleSet::ParticleLaplacian>& L_list,
+                     bool fromscratch) const override
+  {
+    assert(this == &wfc_list.getLeader());
+    if (fromscratch)
+    {
+      auto& mw_mem = wfc_list.getCastedLeader<CountingJastrow>().mw_mem_handle_.getResource();
+      resizeMultiWalkerMem(mw_mem, wfc_list.size());
+      for (int iw = 0; iw < wfc_list.size(); iw++)
+      {
+        auto& wfc = wfc_list.getCastedElement<CountingJastrow>(iw);
+        wfc.C->evaluate(p_list[iw]);
+        std::copy_n(wfc.C->sum.data(), num_regions, mw_mem.mw_sum_t[iw]);
+      }
+      multiplyF(mw_mem, wfc_list.size());
+      for (int iw = 0; iw < wfc_list.size(); iw++)
+      {
+        auto& wfc = wfc_list.getCastedElement<CountingJastrow>(iw);
+        std::copy_n(mw_mem.mw_FCsum_t[iw], num_regions, wfc.FCsum.data());
+        wfc.evaluateExponentsFromFCsum(p_list[iw]);
+      }
+    }
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      wfc_list[iw].evaluateGL(p_list[iw], G_list[iw], L_list[iw], false);
+  }
+
+  void mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValue>& ratios) const override
+  {
+    assert(this == &wfc_list.getLeader());
+    mw_evaluateTempJval(wfc_list, p_list, iat);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      const auto& wfc = wfc_list.getCastedElement<CountingJastrow>(iw);
+      ratios[iw]      = std::exp(static_cast<PsiValue>(wfc.Jval_t - wfc.Jval));
+    }
+  }
+
+  void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValue>& ratios,
+                    std::vector<GradType>& grad_new) const override
+  {
+    assert(this == &wfc_list.getLeader());
+    mw_evaluateTempJval(wfc_list, p_list, iat);
+    const auto& mw_mem = wfc_list.getCastedLeader<CountingJastrow>().mw_mem_handle_.getResource();
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      const auto& wfc         = wfc_list.getCastedElement<CountingJastrow>(iw);
+      const RealType* FCsum_t = mw_mem.mw_FCsum_t[iw];
+      PosType grad_iat;
+      for (int I = 0; I < num_regions; ++I)
+        grad_iat += 2 * FCsum_t[I] * wfc.C->grad_t[I];
+      grad_new[iw] += grad_iat;
+      ratios[iw] = std::exp(static_cast<PsiValue>(wfc.Jval_t - wfc.Jval));
+    }
+  }
+
+  /** accepted walkers take the FC products from the shared scratch, Jgrad and Jlap are rebuilt only for them
+   */
+  void mw_accept_rejectMove(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list,
+                            int iat,
+                            const std::vector<bool>& isAccepted,
+                            bool safe_to_delay = false) const override
+  {
+    assert(this == &wfc_list.getLeader());
+    const auto& mw_mem = wfc_list.getCastedLeader<CountingJastrow>().mw_mem_handle_.getResource();
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      auto& wfc = wfc_list.getCastedElement<CountingJastrow>(iw);
+      if (!isAccepted[iw])
+      {
+        wfc.C->restore(iat);
+        continue;
+      }
+      wfc.C->acceptMove(p_list[iw], iat);
+      std::copy_n(mw_mem.mw_FCsum_t[iw], num_regions, wfc.FCsum.data());
+      for (int I = 0; I < num_regions; ++I)
+      {
+        wfc.FCgrad(I, iat) = 0;
+        wfc.FClap(I, iat)  = 0;
+        for (int J = 0; J < num_regions; ++J)
+        {
+          wfc.FCgrad(I, iat) += F(I, J) * wfc.C->grad(J, iat);
+          wfc.FClap(I, iat) += F(I, J) * wfc.C->lap(J, iat);
+        }
+      }
+      wfc.Jval       = wfc.Jval_t;
+      wfc.log_value_ = wfc.Jval;
+      wfc.evaluateJgradJlap();
+    }
+  }
+
+  void mw_evaluateRatios(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                         const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
+                         std::vector<std::vector<ValueType>>& ratios) const override
+  {
+    assert(this == &wfc_list.getLeader());
+    auto& mw_mem = wfc_list.getCastedLeader<CountingJastrow>().mw_mem_handle_.getResource();
+    int nrows    = 0;
+    for (const VirtualParticleSet& vp : vp_list)
+      nrows += vp.getTotalNum();
+    resizeMultiWalkerMem(mw_mem, nrows);
+
+    for (int iw = 0, row = 0; iw < wfc_list.size(); iw++)
+    {
+      const auto& wfc              = wfc_list.getCastedElement<CountingJastrow>(iw);
+      const VirtualParticleSet& vp = vp_list[iw];
+      for (int k = 0; k < vp.getTotalNum(); ++k, ++row)
+        wfc.C->evaluateTempSum(vp.R[k], vp.refPtcl, mw_mem.mw_sum_t[row]);
+    }
+    multiplyF(mw_mem, nrows);
+    for (int iw = 0, row = 0; iw < wfc_list.size(); iw++)
+    {
+      const auto& wfc = wfc_list.getCastedElement<CountingJastrow>(iw);
+      for (int k = 0; k < ratios[iw].size(); ++k, ++row)
+        ratios[iw][k] = std::exp(simd::dot(mw_mem.mw_sum_t[row], mw_mem.mw_FCsum_t[row], num_regions) - wfc.Jval);
+    }
+  }
+
   void registerData(ParticleSet& P, WFBufferType& buf) override
   {
     LogValue logValue     = evaluateLog(P, P.G, P.L);
@@ -683,6 +910,44 @@ public:
     debug_seqlen = seqlen;
     debug_period = period;
   }
+
+private:
+  void resizeMultiWalkerMem(CountingJastrowMultiWalkerMem& mw_mem, int nrows) const
+  {
+    mw_mem.mw_sum_t.resize(nrows, num_regions);
+    mw_mem.mw_FCsum_t.resize(nrows, num_regions);
+  }
+
+  /** mw_FCsum_t = mw_sum_t F for the first nrows rows
+   */
+  void multiplyF(CountingJastrowMultiWalkerMem& mw_mem, int nrows) const
+  {
+    BLAS::gemm('N', 'N', num_regions, nrows, num_regions, RealType(1), F.data(), num_regions, mw_mem.mw_sum_t.data(),
+               num_regions, RealType(0), mw_mem.mw_FCsum_t.data(), num_regions);
+  }
+
+  /** evaluate the regions of all the walkers with iat at its proposed position and set Jval_t
+   *
+   * Unlike evaluateTempExponents, Jgrad_t and Jlap_t of the other electrons are not computed.
+   * They are only needed by accepted walkers and are rebuilt in mw_accept_rejectMove.
+   */
+  void mw_evaluateTempJval(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                           const RefVectorWithLeader<ParticleSet>& p_list,
+                           int iat) const
+  {
+    auto& mw_mem = wfc_list.getCastedLeader<CountingJastrow>().mw_mem_handle_.getResource();
+    resizeMultiWalkerMem(mw_mem, wfc_list.size());
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      auto& wfc = wfc_list.getCastedElement<CountingJastrow>(iw);
+      wfc.C->evaluateTemp(p_list[iw], iat);
+      std::copy_n(wfc.C->sum_t.data(), num_regions, mw_mem.mw_sum_t[iw]);
+    }
+    multiplyF(mw_mem, wfc_list.size());
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      wfc_list.getCastedElement<CountingJastrow>(iw).Jval_t =
+          simd::dot(mw_mem.mw_sum_t[iw], mw_mem.mw_FCsum_t[iw], num_regions);
+  }
 };
 
 } // namespace qmcplusplus
@@ -22,11 +22,49 @@
 #include "Utilities/IteratorUtility.h"
 #include "CPU/SIMD/aligned_allocator.hpp"
 #include "CPU/SIMD/algorithm.hpp"
+#include <ResourceCollection.h>
 #include <map>
 #include <numeric>
 
 namespace qmcplusplus
 {
+/** multi-walker scratch of J1Spin
+ *
+ * Electron-ion distances of a crowd are gathered ion group by ion group, [ion group][row][ions of the group],
+ * where a row is a walker or a virtual particle. Each functor is then evaluated once over all the rows.
+ */
+template<typename T>
+struct J1SpinMultiWalkerMem : public Resource
+{
+  aligned_vector<T> mw_dist;
+  /// U, dU and d2U in the layout of mw_dist
+  aligned_vector<T> mw_U, mw_dU, mw_d2U;
+  /// scratch of the functors
+  aligned_vector<T> mw_dist_compressed;
+  aligned_vector<int> mw_dist_indices;
+  /// [begin, end) rows of each electron group
+  std::vector<std::pair<int, int>> row_ranges;
+
+  void resize(size_t n)
+  {
+    if (mw_dist.size() < n)
+    {
+      mw_dist.resize(n);
+      mw_U.resize(n);
+      mw_dU.resize(n);
+      mw_d2U.resize(n);
+      mw_dist_compressed.resize(n);
+      mw_dist_indices.resize(n);
+    }
+  }
+
+  J1SpinMultiWalkerMem() : Resource("J1SpinMultiWalkerMem") {}
+
+  J1SpinMultiWalkerMem(const J1SpinMultiWalkerMem&) : J1SpinMultiWalkerMem() {}
+
+  std::unique_ptr<Resource> makeClone() const override { return std::make_unique<J1SpinMultiWalkerMem>(*this); }
+};
+
 /** @ingroup WaveFunctionComponent
  *  @brief Specialization for one-body Jastrow function using multiple functors
  */
@@ -83,6 +121,8 @@ struct J1Spin : public WaveFunctionComponent
   std::vector<GradDerivVec> gradLogPsi;
   std::vector<ValueDerivVec> lapLogPsi;
 
+  ResourceHandle<J1SpinMultiWalkerMem<valT>> mw_mem_handle_;
+
   void resizeWFOptVectors()
   {
     dLogPsi.resize(myVars.size());
@@ -470,6 +510,142 @@ struct J1Spin : public WaveFunctionComponent
   }
 
 
+  void createResource(ResourceCollection& collection) const override
+  {
+    collection.addResource(std::make_unique<J1SpinMultiWalkerMem<valT>>());
+  }
+
+  void acquireResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override
+  {
+    auto& wfc_leader          = wfc_list.getCastedLeader<J1Spin<FT>>();
+    wfc_leader.mw_mem_handle_ = collection.lendResource<J1SpinMultiWalkerMem<valT>>();
+  }
+
+  void releaseResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override
+  {
+    auto& wfc_leader = wfc_list.getCastedLeader<J1Spin<FT>>();
+    collection.takebackResource(wfc_leader.mw_mem_handle_);
+  }
+
+  void mw_evaluateLog(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                      const RefVectorWithLeader<ParticleSet>& p_list,
+                      const RefVector<ParticleSet::ParticleGradient>& G_list,
+                      const RefVector<ParticleSet::ParticleLaplacian>& L_list) const override
+  {
+    mw_recompute(wfc_list, p_list);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      auto& wfc      = wfc_list.getCastedElement<J1Spin<FT>>(iw);
+      wfc.log_value_ = wfc.computeGL(G_list[iw], L_list[iw]);
+    }
+  }
+
+  void mw_evaluateGL(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                     const RefVectorWithLeader<ParticleSet>& p_list,
+                     const RefVector<ParticleSet::ParticleGradient>& G_list,
+                     const RefVector<ParticleSet::ParticleLaplacian>& L_list,
+                     bool fromscratch) const override
+  {
+    if (fromscratch)
+      mw_recompute(wfc_list, p_list);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      auto& wfc      = wfc_list.getCastedElement<J1Spin<FT>>(iw);
+      wfc.log_value_ = wfc.computeGL(G_list[iw], L_list[iw]);
+    }
+  }
+
+  /** value, gradient and laplacian are all computed so that accepting a ratio-only move needs no recomputation
+   */
+  void mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValue>& ratios) const override
+  {
+    mw_computeU3(wfc_list, p_list, iat);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      const auto& wfc = wfc_list.getCastedElement<J1Spin<FT>>(iw);
+      ratios[iw]      = std::exp(static_cast<PsiValue>(wfc.Vat[iat] - wfc.curAt));
+    }
+  }
+
+  void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValue>& ratios,
+                    std::vector<GradType>& grad_new) const override
+  {
+    mw_computeU3(wfc_list, p_list, iat);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      const auto& wfc = wfc_list.getCastedElement<J1Spin<FT>>(iw);
+      grad_new[iw] += wfc.curGrad;
+      ratios[iw] = std::exp(static_cast<PsiValue>(wfc.Vat[iat] - wfc.curAt));
+    }
+  }
+
+  void mw_accept_rejectMove(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list,
+                            int iat,
+                            const std::vector<bool>& isAccepted,
+                            bool safe_to_delay = false) const override
+  {
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      if (isAccepted[iw])
+      {
+        auto& wfc = wfc_list.getCastedElement<J1Spin<FT>>(iw);
+        assert(wfc.UpdateMode == ORB_PBYP_PARTIAL);
+        wfc.acceptMove(p_list[iw], iat);
+      }
+  }
+
+  void mw_evaluateRatios(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                         const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
+                         std::vector<std::vector<ValueType>>& ratios) const override
+  {
+    auto& mw_mem = wfc_list.getCastedLeader<J1Spin<FT>>().mw_mem_handle_.getResource();
+    const int nw = wfc_list.size();
+
+    // order the virtual particles by the group of their reference electron
+    std::vector<int> row_begin(nw);
+    int nrows = 0;
+    mw_mem.row_ranges.resize(NumTargetGroups);
+    for (int ig = 0; ig < NumTargetGroups; ig++)
+    {
+      mw_mem.row_ranges[ig].first = nrows;
+      for (int iw = 0; iw < nw; iw++)
+      {
+        const VirtualParticleSet& vp = vp_list[iw];
+        if (vp.getRefPS().getGroupID(vp.refPtcl) != ig)
+          continue;
+        row_begin[iw] = nrows;
+        nrows += vp.getTotalNum();
+      }
+      mw_mem.row_ranges[ig].second = nrows;
+    }
+
+    mw_mem.resize(nrows * Nions);
+    for (int iw = 0; iw < nw; iw++)
+    {
+      const VirtualParticleSet& vp = vp_list[iw];
+      const auto& d_ie(vp.getDistTableAB(myTableID));
+      for (int k = 0; k < vp.getTotalNum(); ++k)
+        gatherRow(mw_mem, nrows, row_begin[iw] + k, d_ie.getDistRow(k));
+    }
+    mw_evaluateRows(mw_mem, nrows);
+
+    for (int iw = 0; iw < nw; iw++)
+    {
+      const VirtualParticleSet& vp = vp_list[iw];
+      const auto& wfc              = wfc_list.getCastedElement<J1Spin<FT>>(iw);
+      for (int k = 0; k < ratios[iw].size(); ++k)
+        ratios[iw][k] = std::exp(wfc.Vat[vp.refPtcl] - sumRowU(mw_mem, nrows, row_begin[iw] + k));
+    }
+  }
+
   inline void registerData(ParticleSet& P, WFBufferType& buf) override
   {
     if (Bytes_in_WFBuffer == 0)
@@ -625,6 +801,129 @@ struct J1Spin : public WaveFunctionComponent
     }
     return g_return;
   }
+
+private:
+  /// copy one row of electron-ion distances into the ion group blocks of mw_dist
+  void gatherRow(J1SpinMultiWalkerMem<valT>& mw_mem, int nrows, int row, const DistRow& dist) const
+  {
+    for (int jg = 0; jg < NumGroups; ++jg)
+    {
+      const int len = Ions.last(jg) - Ions.first(jg);
+      std::copy_n(dist.data() + Ions.first(jg), len, mw_mem.mw_dist.data() + nrows * Ions.first(jg) + row * len);
+    }
+  }
+
+  /// evaluate U, dU and d2U of all the gathered rows, once per functor
+  void mw_evaluateRows(J1SpinMultiWalkerMem<valT>& mw_mem, int nrows) const
+  {
+    constexpr valT czero(0);
+    std::fill_n(mw_mem.mw_U.data(), nrows * Nions, czero);
+    std::fill_n(mw_mem.mw_dU.data(), nrows * Nions, czero);
+    std::fill_n(mw_mem.mw_d2U.data(), nrows * Nions, czero);
+    for (int jg = 0; jg < NumGroups; ++jg)
+    {
+      const int len = Ions.last(jg) - Ions.first(jg);
+      for (int ig = 0; ig < NumTargetGroups; ++ig)
+      {
+        const auto [first_row, last_row] = mw_mem.row_ranges[ig];
+        auto* func                       = J1UniqueFunctors[jg * NumTargetGroups + ig].get();
+        if (func && last_row > first_row)
+          func->evaluateVGL(-1, nrows * Ions.first(jg) + first_row * len, nrows * Ions.first(jg) + last_row * len,
+                            mw_mem.mw_dist.data(), mw_mem.mw_U.data(), mw_mem.mw_dU.data(), mw_mem.mw_d2U.data(),
+                            mw_mem.mw_dist_compressed.data(), mw_mem.mw_dist_indices.data());
+      }
+    }
+  }
+
+  valT sumRowU(const J1SpinMultiWalkerMem<valT>& mw_mem, int nrows, int row) const
+  {
+    valT u(0);
+    for (int jg = 0; jg < NumGroups; ++jg)
+    {
+      const int len = Ions.last(jg) - Ions.first(jg);
+      u += simd::accumulate_n(mw_mem.mw_U.data() + nrows * Ions.first(jg) + row * len, len, valT());
+    }
+    return u;
+  }
+
+  /** compute gradient and laplacian of one gathered row
+   * @return lap
+   */
+  valT accumulateRowGL(const J1SpinMultiWalkerMem<valT>& mw_mem,
+                       int nrows,
+                       int row,
+                       const DisplRow& displ,
+                       posT& grad) const
+  {
+    constexpr valT lapfac = OHMMS_DIM - RealType(1);
+    valT lap(0);
+    grad = posT();
+    for (int jg = 0; jg < NumGroups; ++jg)
+    {
+      const int first            = Ions.first(jg);
+      const int len              = Ions.last(jg) - first;
+      const valT* restrict du  = mw_mem.mw_dU.data() + nrows * first + row * len;
+      const valT* restrict d2u = mw_mem.mw_d2U.data() + nrows * first + row * len;
+      for (int j = 0; j < len; ++j)
+        lap += d2u[j] + lapfac * du[j];
+      for (int idim = 0; idim < OHMMS_DIM; ++idim)
+      {
+        const valT* restrict dX = displ.data(idim) + first;
+        valT s                  = valT();
+        for (int j = 0; j < len; ++j)
+          s += du[j] * dX[j];
+        grad[idim] += s;
+      }
+    }
+    return lap;
+  }
+
+  /** compute curAt, curGrad and curLap of all the walkers at the proposed position of iat
+   */
+  void mw_computeU3(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat) const
+  {
+    auto& mw_mem = wfc_list.getCastedLeader<J1Spin<FT>>().mw_mem_handle_.getResource();
+    const int nw = wfc_list.size();
+    mw_mem.resize(nw * Nions);
+    mw_mem.row_ranges.assign(NumTargetGroups, {0, 0});
+    mw_mem.row_ranges[p_list.getLeader().getGroupID(iat)] = {0, nw};
+    for (int iw = 0; iw < nw; iw++)
+      gatherRow(mw_mem, nw, iw, p_list[iw].getDistTableAB(myTableID).getTempDists());
+    mw_evaluateRows(mw_mem, nw);
+    for (int iw = 0; iw < nw; iw++)
+    {
+      auto& wfc      = wfc_list.getCastedElement<J1Spin<FT>>(iw);
+      wfc.UpdateMode = ORB_PBYP_PARTIAL;
+      wfc.curAt      = sumRowU(mw_mem, nw, iw);
+      wfc.curLap = accumulateRowGL(mw_mem, nw, iw, p_list[iw].getDistTableAB(myTableID).getTempDispls(), wfc.curGrad);
+    }
+  }
+
+  /// batched recompute of Vat, Grad and Lap, one electron of all the walkers at a time
+  void mw_recompute(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list) const
+  {
+    auto& mw_mem = wfc_list.getCastedLeader<J1Spin<FT>>().mw_mem_handle_.getResource();
+    const int nw = wfc_list.size();
+    mw_mem.resize(nw * Nions);
+    for (int iat = 0; iat < Nelec; ++iat)
+    {
+      mw_mem.row_ranges.assign(NumTargetGroups, {0, 0});
+      mw_mem.row_ranges[p_list.getLeader().getGroupID(iat)] = {0, nw};
+      for (int iw = 0; iw < nw; iw++)
+        gatherRow(mw_mem, nw, iw, p_list[iw].getDistTableAB(myTableID).getDistRow(iat));
+      mw_evaluateRows(mw_mem, nw);
+      for (int iw = 0; iw < nw; iw++)
+      {
+        auto& wfc     = wfc_list.getCastedElement<J1Spin<FT>>(iw);
+        wfc.Vat[iat]  = sumRowU(mw_mem, nw, iw);
+        wfc.Lap[iat] = accumulateRowGL(mw_mem, nw, iw, p_list[iw].getDistTableAB(myTableID).getDisplRow(iat),
+                                        wfc.Grad[iat]);
+      }
+    }
+  }
 };
 
 
@@ -13,6 +13,7 @@
 #ifndef QMCPLUSPLUS_EEIJASTROW_OPTIMIZED_SOA_H
 #define QMCPLUSPLUS_EEIJASTROW_OPTIMIZED_SOA_H
 #include "Configuration.h"
+#include <ResourceCollection.h>
 #if !defined(QMC_BUILD_SANDBOX_ONLY)
 #include "QMCWaveFunctions/WaveFunctionComponent.h"
 #endif
@@ -25,6 +26,59 @@
 
 namespace qmcplusplus
 {
+/** multi walker buffers of JeeIOrbitalSoA
+ *
+ * The e-e-I triplets of all the walkers in a crowd are gathered into one batch per functor
+ * so that the functor evaluation vectorizes across walkers.
+ * Each job (a walker and a position of the moved electron) owns a segment starting at an aligned offset.
+ */
+template<typename T>
+struct JeeIOrbitalSoAMultiWalkerMem : public Resource
+{
+  /// gathered distances
+  aligned_vector<T> Distjk, DistjI, DistkI;
+  /// gathered displacements
+  VectorSoaContainer<T, OHMMS_DIM> Disp_jk, Disp_jI, Disp_kI;
+  /// the other electron of each gathered triplet
+  std::vector<int> DistIndice_k;
+  /// functor value, gradients and hessians of the gathered triplets
+  VectorSoaContainer<T, 9> mVGL;
+  /// segment offset and size of each job in the batch
+  std::vector<size_t> job_offsets;
+  std::vector<int> job_sizes;
+  /// ions within the cutoff radius of the moved electron of each job
+  std::vector<std::vector<int>> job_ions_nearby;
+  /// value-only results of each job
+  std::vector<T> job_values;
+
+  void resize(size_t n, bool need_displ)
+  {
+    if (Distjk.size() < n)
+    {
+      Distjk.resize(n);
+      DistjI.resize(n);
+      DistkI.resize(n);
+      DistIndice_k.resize(n);
+      mVGL.resize(n);
+    }
+    if (need_displ && Disp_jk.size() < n)
+    {
+      Disp_jk.resize(n);
+      Disp_jI.resize(n);
+      Disp_kI.resize(n);
+    }
+  }
+
+  JeeIOrbitalSoAMultiWalkerMem() : Resource("JeeIOrbitalSoAMultiWalkerMem") {}
+
+  JeeIOrbitalSoAMultiWalkerMem(const JeeIOrbitalSoAMultiWalkerMem&) : JeeIOrbitalSoAMultiWalkerMem() {}
+
+  std::unique_ptr<Resource> makeClone() const override
+  {
+    return std::make_unique<JeeIOrbitalSoAMultiWalkerMem>(*this);
+  }
+};
+
 /** @ingroup WaveFunctionComponent
  *  @brief Specialization for three-body Jastrow function using multiple functors
  *
@@ -106,6 +160,29 @@ class JeeIOrbitalSoA : public WaveFunctionComponent
   std::vector<std::vector<PosType>> dgrad_dalpha;
   std::vector<std::vector<Tensor<RealType, 3>>> dhess_dalpha;
 
+  /// multi walker buffers
+  ResourceHandle<JeeIOrbitalSoAMultiWalkerMem<valT>> mw_mem_handle_;
+
+  /** a U3 evaluation of one electron position of one walker in a batch
+   * The output pointers are only used by mw_computeU3.
+   */
+  struct U3Job
+  {
+    JeeIOrbitalSoA* wfc;
+    int jel, jg;
+    const DistRow* distjI;
+    const DisplRow* displjI;
+    const DistRow* distjk;
+    const DisplRow* displjk;
+    valT* Uj;
+    posT* dUj;
+    valT* d2Uj;
+    Vector<valT>* Uk;
+    gContainer_type* dUk;
+    Vector<valT>* d2Uk;
+    std::vector<int>* ions_nearby;
+  };
+
   void resizeWFOptVectors()
   {
     dLogPsi.resize(myVars.size());
@@ -462,6 +539,14 @@ public:
       computeU3(P, iat, eI_table.getTempDists(), eI_table.getTempDispls(), ee_table.getTempDists(),
                 ee_table.getTempDispls(), cur_Uat, cur_dUat, cur_d2Uat, newUk, newdUk, newd2Uk, ions_nearby_new);
     }
+    updateAfterAccept(P, iat);
+  }
+
+  /** update the per-electron data and the compact lists once the old (and new) U3 of iat are computed
+   */
+  void updateAfterAccept(const ParticleSet& P, int iat)
+  {
+    const auto& eI_table = P.getDistTableAB(ei_Table_ID_);
 
 #pragma omp simd
     for (int jel = 0; jel < Nelec; jel++)
@@ -540,6 +625,153 @@ public:
     }
   }
 
+  void createResource(ResourceCollection& collection) const override
+  {
+    collection.addResource(std::make_unique<JeeIOrbitalSoAMultiWalkerMem<valT>>());
+  }
+
+  void acquireResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override
+  {
+    auto& wfc_leader          = wfc_list.getCastedLeader<JeeIOrbitalSoA<FT>>();
+    wfc_leader.mw_mem_handle_ = collection.lendResource<JeeIOrbitalSoAMultiWalkerMem<valT>>();
+  }
+
+  void releaseResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override
+  {
+    auto& wfc_leader = wfc_list.getCastedLeader<JeeIOrbitalSoA<FT>>();
+    collection.takebackResource(wfc_leader.mw_mem_handle_);
+  }
+
+  void mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValue>& ratios) const override
+  {
+    assert(this == &wfc_list.getLeader());
+    auto& mw_mem = wfc_list.getCastedLeader<JeeIOrbitalSoA<FT>>().mw_mem_handle_.getResource();
+    std::vector<U3Job> jobs;
+    jobs.reserve(wfc_list.size());
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      const ParticleSet& P = p_list[iw];
+      U3Job job{};
+      job.wfc    = &wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw);
+      job.jel    = iat;
+      job.jg     = P.GroupID[iat];
+      job.distjI = &P.getDistTableAB(ei_Table_ID_).getTempDists();
+      job.distjk = &P.getDistTableAA(ee_Table_ID_).getTempDists();
+      jobs.push_back(job);
+    }
+    mw_computeU(jobs, mw_mem);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      auto& wfc      = *jobs[iw].wfc;
+      wfc.UpdateMode = ORB_PBYP_RATIO;
+      wfc.cur_Uat    = mw_mem.job_values[iw];
+      wfc.DiffVal    = wfc.Uat[iat] - wfc.cur_Uat;
+      ratios[iw]     = std::exp(static_cast<PsiValue>(wfc.DiffVal));
+    }
+  }
+
+  void mw_evaluateRatios(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                         const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
+                         std::vector<std::vector<ValueType>>& ratios) const override
+  {
+    assert(this == &wfc_list.getLeader());
+    auto& mw_mem = wfc_list.getCastedLeader<JeeIOrbitalSoA<FT>>().mw_mem_handle_.getResource();
+    std::vector<U3Job> jobs;
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      const VirtualParticleSet& VP = vp_list[iw];
+      assert(VP.getTotalNum() == ratios[iw].size());
+      for (int k = 0; k < VP.getTotalNum(); ++k)
+      {
+        U3Job job{};
+        job.wfc    = &wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw);
+        job.jel    = VP.refPtcl;
+        job.jg     = VP.getRefPS().GroupID[VP.refPtcl];
+        job.distjI = &VP.getDistTableAB(ei_Table_ID_).getDistRow(k);
+        job.distjk = &VP.getDistTableAB(ee_Table_ID_).getDistRow(k);
+        jobs.push_back(job);
+      }
+    }
+    mw_computeU(jobs, mw_mem);
+    size_t ijob = 0;
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      for (int k = 0; k < ratios[iw].size(); ++k, ++ijob)
+        ratios[iw][k] = std::exp(jobs[ijob].wfc->Uat[jobs[ijob].jel] - mw_mem.job_values[ijob]);
+  }
+
+  void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValue>& ratios,
+                    std::vector<GradType>& grad_new) const override
+  {
+    assert(this == &wfc_list.getLeader());
+    auto& mw_mem = wfc_list.getCastedLeader<JeeIOrbitalSoA<FT>>().mw_mem_handle_.getResource();
+    std::vector<U3Job> jobs;
+    jobs.reserve(wfc_list.size());
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      auto& wfc = wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw);
+      jobs.push_back(wfc.makeNewPositionJob(p_list[iw], iat));
+    }
+    mw_computeU3(jobs, mw_mem);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+    {
+      auto& wfc      = *jobs[iw].wfc;
+      wfc.UpdateMode = ORB_PBYP_PARTIAL;
+      wfc.DiffVal    = wfc.Uat[iat] - wfc.cur_Uat;
+      grad_new[iw] += wfc.cur_dUat;
+      ratios[iw] = std::exp(static_cast<PsiValue>(wfc.DiffVal));
+    }
+  }
+
+  void mw_accept_rejectMove(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list,
+                            int iat,
+                            const std::vector<bool>& isAccepted,
+                            bool safe_to_delay = false) const override
+  {
+    assert(this == &wfc_list.getLeader());
+    auto& mw_mem = wfc_list.getCastedLeader<JeeIOrbitalSoA<FT>>().mw_mem_handle_.getResource();
+    // the old position of all the accepted walkers and the new position of the ratio-only ones go in one batch
+    std::vector<U3Job> jobs;
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      if (isAccepted[iw])
+      {
+        auto& wfc             = wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw);
+        const ParticleSet& P  = p_list[iw];
+        const auto& eI_table  = P.getDistTableAB(ei_Table_ID_);
+        const auto& ee_table  = P.getDistTableAA(ee_Table_ID_);
+        U3Job job{};
+        job.wfc         = &wfc;
+        job.jel         = iat;
+        job.jg          = P.GroupID[iat];
+        job.distjI      = &eI_table.getDistRow(iat);
+        job.displjI     = &eI_table.getDisplRow(iat);
+        job.distjk      = &ee_table.getOldDists();
+        job.displjk     = &ee_table.getOldDispls();
+        job.Uj          = &wfc.Uat[iat];
+        job.dUj         = &wfc.dUat_temp;
+        job.d2Uj        = &wfc.d2Uat[iat];
+        job.Uk          = &wfc.oldUk;
+        job.dUk         = &wfc.olddUk;
+        job.d2Uk        = &wfc.oldd2Uk;
+        job.ions_nearby = &wfc.ions_nearby_old;
+        jobs.push_back(job);
+        if (wfc.UpdateMode == ORB_PBYP_RATIO)
+          jobs.push_back(wfc.makeNewPositionJob(P, iat));
+      }
+    mw_computeU3(jobs, mw_mem);
+    for (int iw = 0; iw < wfc_list.size(); iw++)
+      if (isAccepted[iw])
+        wfc_list.getCastedElement<JeeIOrbitalSoA<FT>>(iw).updateAfterAccept(p_list[iw], iat);
+  }
+
   inline void recompute(const ParticleSet& P) override
   {
     const auto& eI_table = P.getDistTableAB(ei_Table_ID_);
@@ -631,24 +863,50 @@ public:
                                Vector<valT>& Uk,
                                gContainer_type& dUk,
                                Vector<valT>& d2Uk)
+  {
+    feeI.evaluateVGL(kel_counter, Distjk_Compressed.data(), DistjI_Compressed.data(), DistkI_Compressed.data(),
+                     mVGL.data(0), mVGL.data(1), mVGL.data(2), mVGL.data(3), mVGL.data(4), mVGL.data(5), mVGL.data(6),
+                     mVGL.data(7), mVGL.data(8));
+    accumulateU3(kel_counter, 0, mVGL, Disp_jk_Compressed, Disp_jI_Compressed, Disp_kI_Compressed, DistIndice_k.data(),
+                 Uj, dUj, d2Uj, Uk, dUk, d2Uk);
+  }
+
+  /** accumulate the contribution of a batch of e-e-I triplets to electron jel and the other electrons
+   * @param kel_counter number of triplets
+   * @param offset the first triplet in the buffers, must be aligned
+   * @param vgl functor value, gradients and hessians of the triplets
+   * @param disp_jk, disp_jI, disp_kI displacements of the triplets, destroyed on return
+   * @param kel_list the other electron of each triplet
+   */
+  static void accumulateU3(int kel_counter,
+                           size_t offset,
+                           VectorSoaContainer<valT, 9>& vgl,
+                           gContainer_type& disp_jk,
+                           gContainer_type& disp_jI,
+                           gContainer_type& disp_kI,
+                           const int* kel_list,
+                           valT& Uj,
+                           posT& dUj,
+                           valT& d2Uj,
+                           Vector<valT>& Uk,
+                           gContainer_type& dUk,
+                           Vector<valT>& d2Uk)
   {
     constexpr valT czero(0);
     constexpr valT cone(1);
     constexpr valT ctwo(2);
     constexpr valT lapfac = OHMMS_DIM - cone;
-
-    valT* restrict val     = mVGL.data(0);
-    valT* restrict gradF0  = mVGL.data(1);
-    valT* restrict gradF1  = mVGL.data(2);
-    valT* restrict gradF2  = mVGL.data(3);
-    valT* restrict hessF00 = mVGL.data(4);
-    valT* restrict hessF11 = mVGL.data(5);
-    valT* restrict hessF22 = mVGL.data(6);
-    valT* restrict hessF01 = mVGL.data(7);
-    valT* restrict hessF02 = mVGL.data(8);
-
-    feeI.evaluateVGL(kel_counter, Distjk_Compressed.data(), DistjI_Compressed.data(), DistkI_Compressed.data(), val,
-                     gradF0, gradF1, gradF2, hessF00, hessF11, hessF22, hessF01, hessF02);
+    assert(offset == getAlignedSize<valT>(offset));
+
+    valT* restrict val     = vgl.data(0) + offset;
+    valT* restrict gradF0  = vgl.data(1) + offset;
+    valT* restrict gradF1  = vgl.data(2) + offset;
+    valT* restrict gradF2  = vgl.data(3) + offset;
+    valT* restrict hessF00 = vgl.data(4) + offset;
+    valT* restrict hessF11 = vgl.data(5) + offset;
+    valT* restrict hessF22 = vgl.data(6) + offset;
+    valT* restrict hessF01 = vgl.data(7) + offset;
+    valT* restrict hessF02 = vgl.data(8) + offset;
 
     // compute the contribution to jel, kel
     Uj               = simd::accumulate_n(val, kel_counter, Uj);
@@ -660,9 +918,9 @@ public:
     std::fill_n(hessF11, kel_counter, czero);
     for (int idim = 0; idim < OHMMS_DIM; ++idim)
     {
-      valT* restrict jk = Disp_jk_Compressed.data(idim);
-      valT* restrict jI = Disp_jI_Compressed.data(idim);
-      valT* restrict kI = Disp_kI_Compressed.data(idim);
+      valT* restrict jk = disp_jk.data(idim) + offset;
+      valT* restrict jI = disp_jI.data(idim) + offset;
+      valT* restrict kI = disp_kI.data(idim) + offset;
       valT dUj_x(0);
 #pragma omp simd aligned(gradF0, gradF1, gradF2, hessF11, jk, jI, kI : QMC_SIMD_ALIGNMENT) reduction(+ : dUj_x)
       for (int kel_index = 0; kel_index < kel_counter; kel_index++)
@@ -678,7 +936,7 @@ public:
       }
       dUj[idim] += dUj_x;
 
-      valT* restrict jk0 = Disp_jk_Compressed.data(0);
+      valT* restrict jk0 = disp_jk.data(0) + offset;
       if (idim > 0)
       {
 #pragma omp simd aligned(jk, jk0 : QMC_SIMD_ALIGNMENT)
@@ -688,10 +946,10 @@ public:
 
       valT* restrict dUk_x = dUk.data(idim);
       for (int kel_index = 0; kel_index < kel_counter; kel_index++)
-        dUk_x[DistIndice_k[kel_index]] += kI[kel_index];
+        dUk_x[kel_list[kel_index]] += kI[kel_index];
     }
     valT sum(0);
-    valT* restrict jk0 = Disp_jk_Compressed.data(0);
+    valT* restrict jk0 = disp_jk.data(0) + offset;
 #pragma omp simd aligned(jk0, hessF01 : QMC_SIMD_ALIGNMENT) reduction(+ : sum)
     for (int kel_index = 0; kel_index < kel_counter; kel_index++)
       sum += hessF01[kel_index] * jk0[kel_index];
@@ -704,7 +962,7 @@ public:
 
     for (int kel_index = 0; kel_index < kel_counter; kel_index++)
     {
-      const int kel = DistIndice_k[kel_index];
+      const int kel = kel_list[kel_index];
       Uk[kel] += val[kel_index];
       d2Uk[kel] -= hessF00[kel_index];
     }
@@ -784,6 +1042,182 @@ public:
     }
   }
 
+  /// U3 job of the proposed position of iat, the results go to cur_* and new*
+  U3Job makeNewPositionJob(const ParticleSet& P, int iat)
+  {
+    const auto& eI_table = P.getDistTableAB(ei_Table_ID_);
+    const auto& ee_table = P.getDistTableAA(ee_Table_ID_);
+    U3Job job{};
+    job.wfc         = this;
+    job.jel         = iat;
+    job.jg          = P.GroupID[iat];
+    job.distjI      = &eI_table.getTempDists();
+    job.displjI     = &eI_table.getTempDispls();
+    job.distjk      = &ee_table.getTempDists();
+    job.displjk     = &ee_table.getTempDispls();
+    job.Uj          = &cur_Uat;
+    job.dUj         = &cur_dUat;
+    job.d2Uj        = &cur_d2Uat;
+    job.Uk          = &newUk;
+    job.dUk         = &newdUk;
+    job.d2Uk        = &newd2Uk;
+    job.ions_nearby = &ions_nearby_new;
+    return job;
+  }
+
+  /** gather the triplets of all the jobs with electron group jg for ion species ig and electron group kg
+   * @return the padded size of the batch, zero if there is nothing to compute
+   */
+  size_t mw_gatherTriplets(const std::vector<U3Job>& jobs,
+                           int jg,
+                           int ig,
+                           int kg,
+                           bool need_displ,
+                           JeeIOrbitalSoAMultiWalkerMem<valT>& mw_mem) const
+  {
+    const size_t njobs = jobs.size();
+    size_t total       = 0;
+    for (size_t ijob = 0; ijob < njobs; ijob++)
+    {
+      mw_mem.job_offsets[ijob] = total;
+      mw_mem.job_sizes[ijob]   = 0;
+      if (jobs[ijob].jg != jg)
+        continue;
+      size_t count = 0;
+      for (const int iat : mw_mem.job_ions_nearby[ijob])
+        if (Ions.GroupID[iat] == ig)
+          count += jobs[ijob].wfc->elecs_inside(kg, iat).size();
+      total = getAlignedSize<valT>(total + count);
+    }
+    if (total == 0)
+      return 0;
+    mw_mem.resize(total, need_displ);
+
+    for (size_t ijob = 0; ijob < njobs; ijob++)
+    {
+      const U3Job& job   = jobs[ijob];
+      const size_t start = mw_mem.job_offsets[ijob];
+      const size_t end   = ijob + 1 < njobs ? mw_mem.job_offsets[ijob + 1] : total;
+      size_t kel_counter = start;
+      if (job.jg == jg)
+        for (const int iat : mw_mem.job_ions_nearby[ijob])
+        {
+          if (Ions.GroupID[iat] != ig)
+            continue;
+          const auto& wfc = *job.wfc;
+          const valT r_jI = (*job.distjI)[iat];
+          for (int kind = 0; kind < wfc.elecs_inside(kg, iat).size(); kind++)
+          {
+            const int kel = wfc.elecs_inside(kg, iat)[kind];
+            if (kel == job.jel)
+              continue;
+            mw_mem.DistkI[kel_counter]       = wfc.elecs_inside_dist(kg, iat)[kind];
+            mw_mem.DistjI[kel_counter]       = r_jI;
+            mw_mem.Distjk[kel_counter]       = (*job.distjk)[kel];
+            mw_mem.DistIndice_k[kel_counter] = kel;
+            if (need_displ)
+            {
+              mw_mem.Disp_kI(kel_counter) = wfc.elecs_inside_displ(kg, iat)[kind];
+              mw_mem.Disp_jI(kel_counter) = (*job.displjI)[iat];
+              mw_mem.Disp_jk(kel_counter) = (*job.displjk)[kel];
+            }
+            kel_counter++;
+          }
+        }
+      mw_mem.job_sizes[ijob] = kel_counter - start;
+      // keep the padding harmless for the functor evaluation
+      for (; kel_counter < end; kel_counter++)
+      {
+        mw_mem.DistkI[kel_counter] = mw_mem.DistjI[kel_counter] = mw_mem.Distjk[kel_counter] = valT(0);
+        if (need_displ)
+          mw_mem.Disp_kI(kel_counter) = mw_mem.Disp_jI(kel_counter) = mw_mem.Disp_jk(kel_counter) = posT();
+      }
+    }
+    return total;
+  }
+
+  /// find the ions within the cutoff radius of the electron of each job
+  void mw_findIonsNearby(const std::vector<U3Job>& jobs, JeeIOrbitalSoAMultiWalkerMem<valT>& mw_mem) const
+  {
+    mw_mem.job_offsets.resize(jobs.size());
+    mw_mem.job_sizes.resize(jobs.size());
+    mw_mem.job_ions_nearby.resize(jobs.size());
+    for (size_t ijob = 0; ijob < jobs.size(); ijob++)
+    {
+      auto& ions_nearby = mw_mem.job_ions_nearby[ijob];
+      ions_nearby.clear();
+      for (int iat = 0; iat < Nion; ++iat)
+        if ((*jobs[ijob].distjI)[iat] < Ion_cutoff[iat])
+          ions_nearby.push_back(iat);
+    }
+  }
+
+  /// batched computeU, the values are stored in mw_mem.job_values
+  void mw_computeU(const std::vector<U3Job>& jobs, JeeIOrbitalSoAMultiWalkerMem<valT>& mw_mem) const
+  {
+    mw_findIonsNearby(jobs, mw_mem);
+    mw_mem.job_values.assign(jobs.size(), valT(0));
+    for (int jg = 0; jg < eGroups; ++jg)
+      for (int kg = 0; kg < eGroups; ++kg)
+        for (int ig = 0; ig < iGroups; ++ig)
+        {
+          const FT* feeI = F(ig, jg, kg);
+          if (feeI == nullptr)
+            continue;
+          const size_t total = mw_gatherTriplets(jobs, jg, ig, kg, false, mw_mem);
+          if (total == 0)
+            continue;
+          feeI->evaluateV(total, mw_mem.Distjk.data(), mw_mem.DistjI.data(), mw_mem.DistkI.data(), mw_mem.mVGL.data(0));
+          for (size_t ijob = 0; ijob < jobs.size(); ijob++)
+            mw_mem.job_values[ijob] = simd::accumulate_n(mw_mem.mVGL.data(0) + mw_mem.job_offsets[ijob],
+                                                         mw_mem.job_sizes[ijob], mw_mem.job_values[ijob]);
+        }
+  }
+
+  /// batched computeU3, the results go to the output pointers of each job
+  void mw_computeU3(const std::vector<U3Job>& jobs, JeeIOrbitalSoAMultiWalkerMem<valT>& mw_mem) const
+  {
+    constexpr valT czero(0);
+    mw_findIonsNearby(jobs, mw_mem);
+    for (size_t ijob = 0; ijob < jobs.size(); ijob++)
+    {
+      const U3Job& job = jobs[ijob];
+      *job.Uj          = czero;
+      *job.dUj         = posT();
+      *job.d2Uj        = czero;
+      std::fill_n(job.Uk->data(), Nelec, czero);
+      std::fill_n(job.d2Uk->data(), Nelec, czero);
+      for (int idim = 0; idim < OHMMS_DIM; ++idim)
+        std::fill_n(job.dUk->data(idim), Nelec, czero);
+      *job.ions_nearby = mw_mem.job_ions_nearby[ijob];
+    }
+
+    for (int jg = 0; jg < eGroups; ++jg)
+      for (int kg = 0; kg < eGroups; ++kg)
+        for (int ig = 0; ig < iGroups; ++ig)
+        {
+          const FT* feeI = F(ig, jg, kg);
+          if (feeI == nullptr)
+            continue;
+          const size_t total = mw_gatherTriplets(jobs, jg, ig, kg, true, mw_mem);
+          if (total == 0)
+            continue;
+          auto& vgl = mw_mem.mVGL;
+          feeI->evaluateVGL(total, mw_mem.Distjk.data(), mw_mem.DistjI.data(), mw_mem.DistkI.data(), vgl.data(0),
+                            vgl.data(1), vgl.data(2), vgl.data(3), vgl.data(4), vgl.data(5), vgl.data(6), vgl.data(7),
+                            vgl.data(8));
+          for (size_t ijob = 0; ijob < jobs.size(); ijob++)
+            if (mw_mem.job_sizes[ijob] > 0)
+            {
+              const U3Job& job   = jobs[ijob];
+              const size_t start = mw_mem.job_offsets[ijob];
+              accumulateU3(mw_mem.job_sizes[ijob], start, vgl, mw_mem.Disp_jk, mw_mem.Disp_jI, mw_mem.Disp_kI,
+                           mw_mem.DistIndice_k.data() + start, *job.Uj, *job.dUj, *job.d2Uj, *job.Uk, *job.dUk,
+                           *job.d2Uk);
+            }
+        }
+  }
+
   inline void registerData(ParticleSet& P, WFBufferType& buf) override
   {
     if (Bytes_in_WFBuffer == 0)
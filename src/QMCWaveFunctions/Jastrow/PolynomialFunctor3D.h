@@ -393,6 +393,49 @@ struct PolynomialFunctor3D : public OptimizableFunctorBase
     return val_tot;
   }
 
+  // same as above but stores the value of each triplet in val_array instead of the sum
+  inline void evaluateV(int Nptcl,
+                        const real_type* restrict r_12_array,
+                        const real_type* restrict r_1I_array,
+                        const real_type* restrict r_2I_array,
+                        real_type* restrict val_array) const
+  {
+    constexpr real_type czero(0);
+    constexpr real_type cone(1);
+    constexpr real_type chalf(0.5);
+
+    const real_type L = chalf * cutoff_radius;
+
+#pragma omp simd aligned(r_12_array, r_1I_array, r_2I_array, val_array : QMC_SIMD_ALIGNMENT)
+    for (int ptcl = 0; ptcl < Nptcl; ptcl++)
+    {
+      const real_type r_12 = r_12_array[ptcl];
+      const real_type r_1I = r_1I_array[ptcl];
+      const real_type r_2I = r_2I_array[ptcl];
+      real_type val        = czero;
+      real_type r2l(cone);
+      for (int l = 0; l <= N_eI; l++)
+      {
+        real_type r2m(r2l);
+        for (int m = 0; m <= N_eI; m++)
+        {
+          real_type r2n(r2m);
+          for (int n = 0; n <= N_ee; n++)
+          {
+            val += gamma(l, m, n) * r2n;
+            r2n *= r_12;
+          }
+          r2m *= r_2I;
+        }
+        r2l *= r_1I;
+      }
+      const real_type both_minus_L = (r_2I - L) * (r_1I - L);
+      for (int i = 0; i < C; i++)
+        val *= both_minus_L;
+      val_array[ptcl] = val;
+    }
+  }
+
   inline real_type evaluate(real_type r_12,
                             real_type r_1I,
                             real_type r_2I,
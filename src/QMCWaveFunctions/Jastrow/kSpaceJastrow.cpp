@@ -19,6 +19,8 @@
 #include <sstream>
 #include <algorithm>
 #include "LongRange/StructFact.h"
+#include "LongRange/KContainer.h"
+#include <ResourceCollection.h>
 #include "CPU/math.hpp"
 #include "CPU/e2iphi.h"
 #include "type_traits/ConvertToReal.h"
@@ -292,11 +294,8 @@ kSpaceJastrow::kSpaceJastrow(const ParticleSet& ions,
   TwoBody_rhoG.resize(nTwo);
   TwoBodyPhase.resize(nTwo);
   TwoBody_e2iGr_new.resize(nTwo);
-  TwoBody_e2iGr_old.resize(nTwo);
-  Delta_e2iGr.resize(nelecs, nTwo);
-  for (int iat = 0; iat < nelecs; iat++)
-    for (int i = 0; i < nTwo; i++)
-      Delta_e2iGr(iat, i) = ComplexType();
+  TwoBody_e2iGr_ptcl.resize(nelecs, nTwo);
+  mapTwoBodyGvecsToSK(elecs);
   // Set Ion_rhoG
   for (int i = 0; i < OneBodyGvecs.size(); i++)
   {
@@ -366,9 +365,85 @@ void kSpaceJastrow::setCoefficients(std::vector<RealType>& oneBodyCoefs, std::ve
 //                  Evaluation functions                     //
 ///////////////////////////////////////////////////////////////
 
-kSpaceJastrow::LogValue kSpaceJastrow::evaluateLog(const ParticleSet& P,
-                                                   ParticleSet::ParticleGradient& G,
-                                                   ParticleSet::ParticleLaplacian& L)
+struct kSpaceJastrowMultiWalkerMem : public Resource
+{
+  using RealType    = kSpaceJastrow::RealType;
+  using ComplexType = std::complex<RealType>;
+
+  /// phases of the batch, reused by the one-body and the two-body parts
+  Matrix<RealType> mw_phase;
+  /// e^{iG.r} of the one-body G-vectors, rows 2*iw and 2*iw+1 hold the proposed and the current position of walker iw
+  Matrix<ComplexType> mw_one_body_e2iGr;
+  /// e^{iG.r} of the two-body G-vectors at the proposed position, one row per walker
+  Matrix<ComplexType> mw_two_body_e2iGr;
+
+  kSpaceJastrowMultiWalkerMem() : Resource("kSpaceJastrowMultiWalkerMem") {}
+
+  kSpaceJastrowMultiWalkerMem(const kSpaceJastrowMultiWalkerMem&) : kSpaceJastrowMultiWalkerMem() {}
+
+  std::unique_ptr<Resource> makeClone() const override { return std::make_unique<kSpaceJastrowMultiWalkerMem>(*this); }
+};
+
+void kSpaceJastrow::mapTwoBodyGvecsToSK(const ParticleSet& elecs)
+{
+  TwoBodySKIndex.clear();
+  if (elecs.getLattice().SuperCellEnum == SUPERCELL_OPEN)
+    return;
+  const KContainer& k_lists = elecs.getSimulationCell().getKLists();
+  std::vector<int> sk_index(TwoBodyGvecs.size(), -1);
+  for (int iG = 0; iG < TwoBodyGvecs.size(); iG++)
+  {
+    const PosType& G    = TwoBodyGvecs[iG];
+    const RealType tol2 = 1.0e-8 * std::max(dot(G, G), RealType(1));
+    for (int ik = 0; ik < k_lists.numk; ik++)
+    {
+      const PosType dk = k_lists.kpts_cart[ik] - G;
+      if (dot(dk, dk) < tol2)
+      {
+        sk_index[iG] = ik;
+        break;
+      }
+    }
+    if (sk_index[iG] < 0)
+      return;
+  }
+  TwoBodySKIndex = std::move(sk_index);
+}
+
+void kSpaceJastrow::computeTwoBodyRhoG(const ParticleSet& P, bool reuse_sk)
+{
+  const int N    = P.getTotalNum();
+  const int nTwo = TwoBodyGvecs.size();
+  if (TwoBody_e2iGr_ptcl.rows() != N || TwoBody_e2iGr_ptcl.cols() != nTwo)
+    TwoBody_e2iGr_ptcl.resize(N, nTwo);
+  std::fill(TwoBody_rhoG.begin(), TwoBody_rhoG.end(), ComplexType());
+  // P.getSK() is kept current by ParticleSet::update and donePbyP
+  const bool use_sk =
+      reuse_sk && nTwo > 0 && !TwoBodySKIndex.empty() && P.hasSK() && P.getSK().isStorePerParticle();
+  for (int iat = 0; iat < N; iat++)
+  {
+    ComplexType* restrict e2iGr = TwoBody_e2iGr_ptcl[iat];
+    if (use_sk)
+    {
+      const RealType* restrict eikr_r = P.getSK().eikr_r[iat];
+      const RealType* restrict eikr_i = P.getSK().eikr_i[iat];
+      for (int iG = 0; iG < nTwo; iG++)
+        e2iGr[iG] = ComplexType(eikr_r[TwoBodySKIndex[iG]], eikr_i[TwoBodySKIndex[iG]]);
+    }
+    else
+    {
+      for (int iG = 0; iG < nTwo; iG++)
+        TwoBodyPhase[iG] = dot(TwoBodyGvecs[iG], P.R[iat]);
+      eval_e2iphi(nTwo, TwoBodyPhase.data(), e2iGr);
+    }
+    for (int iG = 0; iG < nTwo; iG++)
+      TwoBody_rhoG[iG] += e2iGr[iG];
+  }
+}
+
+kSpaceJastrow::LogValue kSpaceJastrow::evaluateGLFromRhoG(const ParticleSet& P,
+                                                          ParticleSet::ParticleGradient& G,
+                                                          ParticleSet::ParticleLaplacian& L)
 {
   RealType J1(0.0), J2(0.0);
   int N = P.getTotalNum();
@@ -390,33 +465,15 @@ kSpaceJastrow::LogValue kSpaceJastrow::evaluateLog(const ParticleSet& P,
   }
   // Do two-body part
   int nTwo = TwoBodyGvecs.size();
-  for (int i = 0; i < nTwo; i++)
-    TwoBody_rhoG[i] = ComplexType();
-  for (int iat = 0; iat < N; iat++)
-  {
-    PosType r(P.R[iat]);
-    for (int iG = 0; iG < nTwo; iG++)
-      TwoBodyPhase[iG] = dot(TwoBodyGvecs[iG], r);
-    eval_e2iphi(TwoBodyPhase, TwoBody_e2iGr_new);
-    for (int iG = 0; iG < nTwo; iG++)
-      TwoBody_rhoG[iG] += TwoBody_e2iGr_new[iG];
-  }
-  //     std::cerr << "TwoBody_rhoG = ";
-  //     for (int i=0; i<nTwo; i++)
-  //       std::cerr << TwoBody_rhoG[i]  << "  ";
-  //     std::cerr << std::endl;
   for (int i = 0; i < nTwo; i++)
     J2 += Prefactor * TwoBodyCoefs[i] * norm(TwoBody_rhoG[i]);
   for (int iat = 0; iat < N; iat++)
   {
-    PosType r(P.R[iat]);
-    for (int i = 0; i < nTwo; i++)
-      TwoBodyPhase[i] = dot(TwoBodyGvecs[i], r);
-    eval_e2iphi(TwoBodyPhase, TwoBody_e2iGr_new);
+    const ComplexType* restrict e2iGr = TwoBody_e2iGr_ptcl[iat];
     for (int i = 0; i < nTwo; i++)
     {
       PosType Gvec(TwoBodyGvecs[i]);
-      ComplexType z = TwoBody_e2iGr_new[i];
+      ComplexType z = e2iGr[i];
       G[iat] += -Prefactor * 2.0 * Gvec * TwoBodyCoefs[i] * imag(qmcplusplus::conj(TwoBody_rhoG[i]) * z);
       L[iat] +=
           Prefactor * 2.0 * TwoBodyCoefs[i] * dot(Gvec, Gvec) * (-real(z * qmcplusplus::conj(TwoBody_rhoG[i])) + 1.0);
@@ -425,109 +482,102 @@ kSpaceJastrow::LogValue kSpaceJastrow::evaluateLog(const ParticleSet& P,
   return J1 + J2;
 }
 
-
-kSpaceJastrow::GradType kSpaceJastrow::evalGrad(ParticleSet& P, int iat)
+void kSpaceJastrow::computeOneBodyE2iGr(const PosType& r, ComplexType* restrict e2iGr)
 {
-  //     RealType J1(0.0), J2(0.0);
-  kSpaceJastrow::GradType G;
-  int N = P.getTotalNum();
-  ComplexType eye(0.0, 1.0);
-  int nOne = OneBodyGvecs.size();
-  //     for (int iat=0; iat<N; iat++) {
-  PosType r(P.R[iat]);
+  const int nOne = OneBodyGvecs.size();
   for (int i = 0; i < nOne; i++)
     OneBodyPhase[i] = dot(OneBodyGvecs[i], r);
-  eval_e2iphi(OneBodyPhase, OneBody_e2iGr);
-  for (int i = 0; i < nOne; i++)
+  eval_e2iphi(nOne, OneBodyPhase.data(), e2iGr);
+}
+
+kSpaceJastrow::RealType kSpaceJastrow::oneBodyValue(const ComplexType* restrict e2iGr, GradType* grad) const
+{
+  const ComplexType eye(0.0, 1.0);
+  const RealType prefactor(Prefactor);
+  RealType J1(0.0);
+  for (int i = 0; i < OneBodyGvecs.size(); i++)
   {
-    ComplexType z = OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]);
-    //    J1 += Prefactor*real(z);
-    G += -Prefactor * real(z * eye) * OneBodyGvecs[i];
-    //    L[iat] += -Prefactor*dot(OneBodyGvecs[i],OneBodyGvecs[i])*real(z);
+    ComplexType z = OneBodyCoefs[i] * qmcplusplus::conj(e2iGr[i]);
+    J1 += prefactor * real(z);
+    if (grad)
+      *grad += -prefactor * real(z * eye) * OneBodyGvecs[i];
   }
-  //     }
-  // Do two-body part
-  int nTwo = TwoBodyGvecs.size();
-  for (int i = 0; i < nTwo; i++)
-    TwoBody_rhoG[i] = ComplexType();
-  for (int iat2 = 0; iat2 < N; iat2++)
+  return J1;
+}
+
+kSpaceJastrow::RealType kSpaceJastrow::twoBodyDelta(int iat, const ComplexType* restrict e2iGr_new, GradType* grad) const
+{
+  const RealType prefactor(Prefactor);
+  const ComplexType* restrict e2iGr_old = TwoBody_e2iGr_ptcl[iat];
+  RealType dJ2(0.0);
+  for (int i = 0; i < TwoBodyGvecs.size(); i++)
   {
-    PosType rp(P.R[iat2]);
-    for (int iG = 0; iG < nTwo; iG++)
-      TwoBodyPhase[iG] = dot(TwoBodyGvecs[iG], rp);
-    eval_e2iphi(TwoBodyPhase, TwoBody_e2iGr_new);
-    for (int iG = 0; iG < nTwo; iG++)
-      TwoBody_rhoG[iG] += TwoBody_e2iGr_new[iG];
-  }
-  //     std::cerr << "TwoBody_rhoG = ";
-  //     for (int i=0; i<nTwo; i++)
-  //       std::cerr << TwoBody_rhoG[i]  << "  ";
-  //     std::cerr << std::endl;
-  //     for (int i=0; i<nTwo; i++)
-  //       J2 += Prefactor*TwoBodyCoefs[i]*norm(TwoBody_rhoG[i]);
-  //     for (int iat=0; iat<N; iat++) {
-  //       PosType r(P.R[iat]);
-  for (int i = 0; i < nTwo; i++)
-    TwoBodyPhase[i] = dot(TwoBodyGvecs[i], r);
-  eval_e2iphi(TwoBodyPhase, TwoBody_e2iGr_new);
-  for (int i = 0; i < nTwo; i++)
+    ComplexType rho_G_new = TwoBody_rhoG[i] + e2iGr_new[i] - e2iGr_old[i];
+    dJ2 += TwoBodyCoefs[i] * (std::norm(rho_G_new) - std::norm(TwoBody_rhoG[i]));
+    // the gradient at the new position sees the updated rho_G
+    if (grad)
+      *grad += -prefactor * 2.0 * TwoBodyGvecs[i] * TwoBodyCoefs[i] *
+          imag(qmcplusplus::conj(rho_G_new) * e2iGr_new[i]);
+  }
+  return prefactor * dJ2;
+}
+
+void kSpaceJastrow::acceptTwoBody(int iat, const ComplexType* restrict e2iGr_new)
+{
+  ComplexType* restrict e2iGr_old = TwoBody_e2iGr_ptcl[iat];
+  for (int i = 0; i < TwoBodyGvecs.size(); i++)
   {
-    PosType Gvec(TwoBodyGvecs[i]);
-    ComplexType z = TwoBody_e2iGr_new[i];
-    G += -Prefactor * 2.0 * Gvec * TwoBodyCoefs[i] * imag(qmcplusplus::conj(TwoBody_rhoG[i]) * z);
-    //    L[iat] += Prefactor*2.0*TwoBodyCoefs[i]*dot(Gvec,Gvec)*(-real(z*qmcplusplus::conj(TwoBody_rhoG[i])) + 1.0);
+    TwoBody_rhoG[i] += e2iGr_new[i] - e2iGr_old[i];
+    e2iGr_old[i] = e2iGr_new[i];
   }
-  //     }
+}
+
+kSpaceJastrow::LogValue kSpaceJastrow::evaluateLog(const ParticleSet& P,
+                                                   ParticleSet::ParticleGradient& G,
+                                                   ParticleSet::ParticleLaplacian& L)
+{
+  computeTwoBodyRhoG(P, true);
+  return log_value_ = evaluateGLFromRhoG(P, G, L);
+}
+
+kSpaceJastrow::LogValue kSpaceJastrow::evaluateGL(const ParticleSet& P,
+                                                  ParticleSet::ParticleGradient& G,
+                                                  ParticleSet::ParticleLaplacian& L,
+                                                  bool fromscratch)
+{
+  if (fromscratch)
+    computeTwoBodyRhoG(P, true);
+  return log_value_ = evaluateGLFromRhoG(P, G, L);
+}
+
+kSpaceJastrow::GradType kSpaceJastrow::evalGrad(ParticleSet& P, int iat)
+{
+  GradType G;
+  computeOneBodyE2iGr(P.R[iat], OneBody_e2iGr.data());
+  oneBodyValue(OneBody_e2iGr.data(), &G);
+  // Do two-body part with the rho_G maintained by acceptMove
+  const RealType prefactor(Prefactor);
+  const ComplexType* restrict e2iGr = TwoBody_e2iGr_ptcl[iat];
+  for (int i = 0; i < TwoBodyGvecs.size(); i++)
+    G += -prefactor * 2.0 * TwoBodyGvecs[i] * TwoBodyCoefs[i] * imag(qmcplusplus::conj(TwoBody_rhoG[i]) * e2iGr[i]);
   return G;
 }
 
 kSpaceJastrow::PsiValue kSpaceJastrow::ratioGrad(ParticleSet& P, int iat, GradType& grad_iat)
 {
-  ComplexType eye(0.0, 1.0);
-  RealType J1new(0.0), J1old(0.0), J2new(0.0), J2old(0.0);
   const PosType &rnew(P.getActivePos()), &rold(P.R[iat]);
   // Compute one-body contribution
-  int nOne = OneBodyGvecs.size();
-  for (int i = 0; i < nOne; i++)
-    OneBodyPhase[i] = dot(OneBodyGvecs[i], rnew);
-  eval_e2iphi(OneBodyPhase, OneBody_e2iGr);
-  for (int i = 0; i < nOne; i++)
-  {
-    ComplexType z = OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]);
-    J1new += Prefactor * real(z);
-    grad_iat += -Prefactor * real(z * eye) * OneBodyGvecs[i];
-  }
-  for (int i = 0; i < nOne; i++)
-    OneBodyPhase[i] = dot(OneBodyGvecs[i], rold);
-  eval_e2iphi(OneBodyPhase, OneBody_e2iGr);
-  for (int i = 0; i < nOne; i++)
-    J1old += Prefactor * real(OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]));
+  computeOneBodyE2iGr(rnew, OneBody_e2iGr.data());
+  const RealType J1new = oneBodyValue(OneBody_e2iGr.data(), &grad_iat);
+  computeOneBodyE2iGr(rold, OneBody_e2iGr.data());
+  const RealType J1old = oneBodyValue(OneBody_e2iGr.data(), nullptr);
   // Now, do two-body part
-  int nTwo = TwoBodyGvecs.size();
-  for (int i = 0; i < nTwo; i++)
-    TwoBodyPhase[i] = dot(TwoBodyGvecs[i], rold);
-  eval_e2iphi(TwoBodyPhase, TwoBody_e2iGr_old);
+  const int nTwo = TwoBodyGvecs.size();
   for (int i = 0; i < nTwo; i++)
     TwoBodyPhase[i] = dot(TwoBodyGvecs[i], rnew);
   eval_e2iphi(TwoBodyPhase, TwoBody_e2iGr_new);
-  for (int i = 0; i < nTwo; i++)
-  {
-    ComplexType rho_G = TwoBody_rhoG[i];
-    J2old += Prefactor * TwoBodyCoefs[i] * std::norm(rho_G);
-  }
-  for (int i = 0; i < nTwo; i++)
-  {
-    ComplexType rho_G = TwoBody_rhoG[i] + TwoBody_e2iGr_new[i] - TwoBody_e2iGr_old[i];
-    J2new += Prefactor * TwoBodyCoefs[i] * std::norm(rho_G);
-  }
-  for (int i = 0; i < nTwo; i++)
-  {
-    PosType Gvec(TwoBodyGvecs[i]);
-    ComplexType z = TwoBody_e2iGr_new[i];
-    grad_iat += -Prefactor * 2.0 * TwoBodyGvecs[i] * TwoBodyCoefs[i] *
-        imag(qmcplusplus::conj(TwoBody_rhoG[i]) * TwoBody_e2iGr_new[i]);
-  }
-  return std::exp(static_cast<PsiValue>(J1new + J2new - (J1old + J2old)));
+  const RealType dJ2 = twoBodyDelta(iat, TwoBody_e2iGr_new.data(), &grad_iat);
+  return std::exp(static_cast<PsiValue>(J1new - J1old + dJ2));
 }
 
 /* evaluate the ratio with P.R[iat]
@@ -535,55 +585,29 @@ kSpaceJastrow::PsiValue kSpaceJastrow::ratioGrad(ParticleSet& P, int iat, GradTy
  */
 kSpaceJastrow::PsiValue kSpaceJastrow::ratio(ParticleSet& P, int iat)
 {
-  RealType J1new(0.0), J1old(0.0), J2new(0.0), J2old(0.0);
   const PosType &rnew(P.getActivePos()), &rold(P.R[iat]);
   // Compute one-body contribution
-  int nOne = OneBodyGvecs.size();
-  for (int i = 0; i < nOne; i++)
-    OneBodyPhase[i] = dot(OneBodyGvecs[i], rnew);
-  eval_e2iphi(OneBodyPhase, OneBody_e2iGr);
-  for (int i = 0; i < nOne; i++)
-    J1new += Prefactor * real(OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]));
-  for (int i = 0; i < nOne; i++)
-    OneBodyPhase[i] = dot(OneBodyGvecs[i], rold);
-  eval_e2iphi(OneBodyPhase, OneBody_e2iGr);
-  for (int i = 0; i < nOne; i++)
-    J1old += Prefactor * real(OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]));
+  computeOneBodyE2iGr(rnew, OneBody_e2iGr.data());
+  const RealType J1new = oneBodyValue(OneBody_e2iGr.data(), nullptr);
+  computeOneBodyE2iGr(rold, OneBody_e2iGr.data());
+  const RealType J1old = oneBodyValue(OneBody_e2iGr.data(), nullptr);
   // Now, do two-body part
-  int nTwo = TwoBodyGvecs.size();
-  for (int i = 0; i < nTwo; i++)
-    TwoBodyPhase[i] = dot(TwoBodyGvecs[i], rold);
-  eval_e2iphi(TwoBodyPhase, TwoBody_e2iGr_old);
+  const int nTwo = TwoBodyGvecs.size();
   for (int i = 0; i < nTwo; i++)
     TwoBodyPhase[i] = dot(TwoBodyGvecs[i], rnew);
   eval_e2iphi(TwoBodyPhase, TwoBody_e2iGr_new);
-  for (int i = 0; i < nTwo; i++)
-  {
-    ComplexType rho_G = TwoBody_rhoG[i];
-    J2old += Prefactor * TwoBodyCoefs[i] * std::norm(rho_G);
-  }
-  for (int i = 0; i < nTwo; i++)
-  {
-    ComplexType rho_G = TwoBody_rhoG[i] + TwoBody_e2iGr_new[i] - TwoBody_e2iGr_old[i];
-    J2new += Prefactor * TwoBodyCoefs[i] * std::norm(rho_G);
-  }
-  return std::exp(static_cast<PsiValue>(J1new + J2new - (J1old + J2old)));
+  const RealType dJ2 = twoBodyDelta(iat, TwoBody_e2iGr_new.data(), nullptr);
+  return std::exp(static_cast<PsiValue>(J1new - J1old + dJ2));
 }
 
 /** evaluate the ratio
 */
 void kSpaceJastrow::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<kSpaceJastrow::ValueType>& ratios)
 {
-  RealType J1new(0.0);
   const PosType& rnew(P.getActivePos());
   //     Compute one-body contribution
-  int nOne = OneBodyGvecs.size();
-  for (int i = 0; i < nOne; i++)
-    OneBodyPhase[i] = dot(OneBodyGvecs[i], rnew);
-  eval_e2iphi(OneBodyPhase, OneBody_e2iGr);
-  // //
-  for (int i = 0; i < nOne; i++)
-    J1new += Prefactor * real(OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]));
+  computeOneBodyE2iGr(rnew, OneBody_e2iGr.data());
+  const RealType J1new = oneBodyValue(OneBody_e2iGr.data(), nullptr);
   // Now, do two-body part
   int nTwo = TwoBodyGvecs.size();
   for (int i = 0; i < nTwo; i++)
@@ -592,23 +616,10 @@ void kSpaceJastrow::evaluateRatiosAlltoOne(ParticleSet& P, std::vector<kSpaceJas
   int N = P.getTotalNum();
   for (int n = 0; n < N; n++)
   {
-    RealType J1old(0.0), J2Rat(0.0);
-    const PosType& rold(P.R[n]);
-    for (int i = 0; i < nOne; i++)
-      OneBodyPhase[i] = dot(OneBodyGvecs[i], rold);
-    eval_e2iphi(OneBodyPhase, OneBody_e2iGr);
-    for (int i = 0; i < nOne; i++)
-      J1old += Prefactor * real(OneBodyCoefs[i] * qmcplusplus::conj(OneBody_e2iGr[i]));
-    for (int i = 0; i < nTwo; i++)
-      TwoBodyPhase[i] = dot(TwoBodyGvecs[i], rold);
-    eval_e2iphi(TwoBodyPhase, TwoBody_e2iGr_old);
-    for (int i = 0; i < nTwo; i++)
-    {
-      ComplexType rho_G_new = TwoBody_rhoG[i] + TwoBody_e2iGr_new[i] - TwoBody_e2iGr_old[i];
-      ComplexType rho_G_old = TwoBody_rhoG[i];
-      J2Rat += Prefactor * TwoBodyCoefs[i] * (std::norm(rho_G_new) - std::norm(rho_G_old));
-    }
-    ratios[n] = std::exp(J1new - J1old + J2Rat);
+    computeOneBodyE2iGr(P.R[n], OneBody_e2iGr.data());
+    const RealType J1old  = oneBodyValue(OneBody_e2iGr.data(), nullptr);
+    const RealType J2Rat  = twoBodyDelta(n, TwoBody_e2iGr_new.data(), nullptr);
+    ratios[n]             = std::exp(J1new - J1old + J2Rat);
   }
 }
 
@@ -621,13 +632,139 @@ void kSpaceJastrow::restore(int iat)
 
 void kSpaceJastrow::acceptMove(ParticleSet& P, int iat, bool safe_to_delay)
 {
-  for (int i = 0; i < TwoBody_e2iGr_new.size(); i++)
-    TwoBody_rhoG[i] += Delta_e2iGr(iat, i);
-  //TwoBody_e2iGr_new[i] - TwoBody_e2iGr_old[i];
-  // copy(eikr_new.data(),eikr_new.data()+MaxK,eikr[iat]);
-  // U += offU;
-  // dU += offdU;
-  // d2U += offd2U;
+  acceptTwoBody(iat, TwoBody_e2iGr_new.data());
+}
+
+void kSpaceJastrow::createResource(ResourceCollection& collection) const
+{
+  collection.addResource(std::make_unique<kSpaceJastrowMultiWalkerMem>());
+}
+
+void kSpaceJastrow::acquireResource(ResourceCollection& collection,
+                                    const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  auto& wfc_leader          = wfc_list.getCastedLeader<kSpaceJastrow>();
+  wfc_leader.mw_mem_handle_ = collection.lendResource<kSpaceJastrowMultiWalkerMem>();
+}
+
+void kSpaceJastrow::releaseResource(ResourceCollection& collection,
+                                    const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const
+{
+  auto& wfc_leader = wfc_list.getCastedLeader<kSpaceJastrow>();
+  collection.takebackResource(wfc_leader.mw_mem_handle_);
+}
+
+void kSpaceJastrow::mw_computeNewE2iGr(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                       const RefVectorWithLeader<ParticleSet>& p_list,
+                                       int iat) const
+{
+  auto& wfc_leader = wfc_list.getCastedLeader<kSpaceJastrow>();
+  auto& mw_mem     = wfc_leader.mw_mem_handle_.getResource();
+  const int nw     = wfc_list.size();
+  const int nOne   = OneBodyGvecs.size();
+  const int nTwo   = TwoBodyGvecs.size();
+
+  // the phases of all the walkers go through a single vectorized sincos call
+  if (nOne > 0)
+  {
+    mw_mem.mw_phase.resize(2 * nw, nOne);
+    mw_mem.mw_one_body_e2iGr.resize(2 * nw, nOne);
+    for (int iw = 0; iw < nw; iw++)
+    {
+      const PosType& rnew = p_list[iw].getActivePos();
+      const PosType& rold = p_list[iw].R[iat];
+      RealType* restrict phase_new = mw_mem.mw_phase[2 * iw];
+      RealType* restrict phase_old = mw_mem.mw_phase[2 * iw + 1];
+      for (int i = 0; i < nOne; i++)
+      {
+        phase_new[i] = dot(OneBodyGvecs[i], rnew);
+        phase_old[i] = dot(OneBodyGvecs[i], rold);
+      }
+    }
+    eval_e2iphi(2 * nw * nOne, mw_mem.mw_phase.data(), mw_mem.mw_one_body_e2iGr.data());
+  }
+
+  mw_mem.mw_phase.resize(nw, nTwo);
+  mw_mem.mw_two_body_e2iGr.resize(nw, nTwo);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    const PosType& rnew      = p_list[iw].getActivePos();
+    RealType* restrict phase = mw_mem.mw_phase[iw];
+    for (int i = 0; i < nTwo; i++)
+      phase[i] = dot(TwoBodyGvecs[i], rnew);
+  }
+  eval_e2iphi(nw * nTwo, mw_mem.mw_phase.data(), mw_mem.mw_two_body_e2iGr.data());
+}
+
+void kSpaceJastrow::mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                 const RefVectorWithLeader<ParticleSet>& p_list,
+                                 int iat,
+                                 std::vector<PsiValue>& ratios) const
+{
+  assert(this == &wfc_list.getLeader());
+  mw_computeNewE2iGr(wfc_list, p_list, iat);
+  auto& mw_mem = wfc_list.getCastedLeader<kSpaceJastrow>().mw_mem_handle_.getResource();
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+  {
+    const auto& wfc = wfc_list.getCastedElement<kSpaceJastrow>(iw);
+    RealType dJ1(0.0);
+    if (OneBodyGvecs.size() > 0)
+      dJ1 = wfc.oneBodyValue(mw_mem.mw_one_body_e2iGr[2 * iw], nullptr) -
+          wfc.oneBodyValue(mw_mem.mw_one_body_e2iGr[2 * iw + 1], nullptr);
+    const RealType dJ2 = wfc.twoBodyDelta(iat, mw_mem.mw_two_body_e2iGr[iw], nullptr);
+    ratios[iw]         = std::exp(static_cast<PsiValue>(dJ1 + dJ2));
+  }
+}
+
+void kSpaceJastrow::mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                 const RefVectorWithLeader<ParticleSet>& p_list,
+                                 int iat,
+                                 std::vector<PsiValue>& ratios,
+                                 std::vector<GradType>& grad_new) const
+{
+  assert(this == &wfc_list.getLeader());
+  mw_computeNewE2iGr(wfc_list, p_list, iat);
+  auto& mw_mem = wfc_list.getCastedLeader<kSpaceJastrow>().mw_mem_handle_.getResource();
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+  {
+    const auto& wfc = wfc_list.getCastedElement<kSpaceJastrow>(iw);
+    RealType dJ1(0.0);
+    if (OneBodyGvecs.size() > 0)
+      dJ1 = wfc.oneBodyValue(mw_mem.mw_one_body_e2iGr[2 * iw], &grad_new[iw]) -
+          wfc.oneBodyValue(mw_mem.mw_one_body_e2iGr[2 * iw + 1], nullptr);
+    const RealType dJ2 = wfc.twoBodyDelta(iat, mw_mem.mw_two_body_e2iGr[iw], &grad_new[iw]);
+    ratios[iw]         = std::exp(static_cast<PsiValue>(dJ1 + dJ2));
+  }
+}
+
+void kSpaceJastrow::mw_accept_rejectMove(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                         const RefVectorWithLeader<ParticleSet>& p_list,
+                                         int iat,
+                                         const std::vector<bool>& isAccepted,
+                                         bool safe_to_delay) const
+{
+  assert(this == &wfc_list.getLeader());
+  auto& mw_mem = wfc_list.getCastedLeader<kSpaceJastrow>().mw_mem_handle_.getResource();
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+    if (isAccepted[iw])
+      wfc_list.getCastedElement<kSpaceJastrow>(iw).acceptTwoBody(iat, mw_mem.mw_two_body_e2iGr[iw]);
+}
+
+void kSpaceJastrow::mw_evaluateGL(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                  const RefVectorWithLeader<ParticleSet>& p_list,
+                                  const RefVector<ParticleSet::ParticleGradient>& G_list,
+                                  const RefVector<ParticleSet::ParticleLaplacian>& L_list,
+                                  bool fromscratch) const
+{
+  assert(this == &wfc_list.getLeader());
+  // rho_G and e^{iG.r} are carried along by the accepted moves, only a from-scratch request recomputes them
+  for (int iw = 0; iw < wfc_list.size(); iw++)
+  {
+    auto& wfc = wfc_list.getCastedElement<kSpaceJastrow>(iw);
+    if (fromscratch)
+      wfc.computeTwoBodyRhoG(p_list[iw], true);
+    wfc.log_value_ = wfc.evaluateGLFromRhoG(p_list[iw], G_list[iw], L_list[iw]);
+  }
 }
 
 void kSpaceJastrow::registerData(ParticleSet& P, WFBufferType& buf)
@@ -658,19 +795,7 @@ kSpaceJastrow::LogValue kSpaceJastrow::updateBuffer(ParticleSet& P, WFBufferType
   return log_value_;
 }
 
-void kSpaceJastrow::copyFromBuffer(ParticleSet& P, WFBufferType& buf)
-{
-  for (int i = 0; i < TwoBodyCoefs.size(); i++)
-    TwoBody_rhoG[i] = ComplexType();
-  for (int iat = 0; iat < num_elecs; iat++)
-  {
-    for (int i = 0; i < TwoBodyCoefs.size(); i++)
-      TwoBodyPhase[i] = dot(TwoBodyGvecs[i], P.R[iat]);
-    eval_e2iphi(TwoBodyPhase, TwoBody_e2iGr_new);
-    for (int i = 0; i < TwoBodyCoefs.size(); i++)
-      TwoBody_rhoG[i] += TwoBody_e2iGr_new[i];
-  }
-}
+void kSpaceJastrow::copyFromBuffer(ParticleSet& P, WFBufferType& buf) { computeTwoBodyRhoG(P, false); }
 
 void kSpaceJastrow::checkInVariablesExclusive(opt_variables_type& active)
 {
@@ -782,31 +907,31 @@ kSpaceJastrow::kSpaceJastrow(const ParticleSet& ions)
 
 void kSpaceJastrow::copyFrom(const kSpaceJastrow& old)
 {
-  CellVolume        = old.CellVolume;
-  NormConstant      = old.NormConstant;
-  num_elecs         = old.num_elecs;
-  NumSpins          = old.NumSpins;
-  NumIons           = old.NumIons;
-  NumIonSpecies     = old.NumIonSpecies;
-  OneBodyGvecs      = old.OneBodyGvecs;
-  TwoBodyGvecs      = old.TwoBodyGvecs;
-  OneBodySymmCoefs  = old.OneBodySymmCoefs;
-  TwoBodySymmCoefs  = old.TwoBodySymmCoefs;
-  OneBodyCoefs      = old.OneBodyCoefs;
-  TwoBodyCoefs      = old.TwoBodyCoefs;
-  OneBodySymmType   = old.OneBodySymmType;
-  TwoBodySymmType   = old.TwoBodySymmType;
-  Ion_rhoG          = old.Ion_rhoG;
-  OneBody_rhoG      = old.OneBody_rhoG;
-  TwoBody_rhoG      = old.TwoBody_rhoG;
-  OneBodyPhase      = old.OneBodyPhase;
-  TwoBodyPhase      = old.TwoBodyPhase;
-  OneBody_e2iGr     = old.OneBody_e2iGr;
-  TwoBody_e2iGr_new = old.TwoBody_e2iGr_new;
-  TwoBody_e2iGr_old = old.TwoBody_e2iGr_old;
-  Delta_e2iGr       = old.Delta_e2iGr;
-  OneBodyID         = old.OneBodyID;
-  TwoBodyID         = old.TwoBodyID;
+  CellVolume         = old.CellVolume;
+  NormConstant       = old.NormConstant;
+  num_elecs          = old.num_elecs;
+  NumSpins           = old.NumSpins;
+  NumIons            = old.NumIons;
+  NumIonSpecies      = old.NumIonSpecies;
+  OneBodyGvecs       = old.OneBodyGvecs;
+  TwoBodyGvecs       = old.TwoBodyGvecs;
+  OneBodySymmCoefs   = old.OneBodySymmCoefs;
+  TwoBodySymmCoefs   = old.TwoBodySymmCoefs;
+  OneBodyCoefs       = old.OneBodyCoefs;
+  TwoBodyCoefs       = old.TwoBodyCoefs;
+  OneBodySymmType    = old.OneBodySymmType;
+  TwoBodySymmType    = old.TwoBodySymmType;
+  Ion_rhoG           = old.Ion_rhoG;
+  OneBody_rhoG       = old.OneBody_rhoG;
+  TwoBody_rhoG       = old.TwoBody_rhoG;
+  OneBodyPhase       = old.OneBodyPhase;
+  TwoBodyPhase       = old.TwoBodyPhase;
+  OneBody_e2iGr      = old.OneBody_e2iGr;
+  TwoBody_e2iGr_new  = old.TwoBody_e2iGr_new;
+  TwoBody_e2iGr_ptcl = old.TwoBody_e2iGr_ptcl;
+  TwoBodySKIndex     = old.TwoBodySKIndex;
+  OneBodyID          = old.OneBodyID;
+  TwoBodyID          = old.TwoBodyID;
   //copy the variable map
   myVars        = old.myVars;
   TwoBodyVarMap = old.TwoBodyVarMap;
@@ -24,6 +24,7 @@
 #ifndef QMCPLUSPLUS_LR_KSPACEJASTROW_H
 #define QMCPLUSPLUS_LR_KSPACEJASTROW_H
 
+#include <ResourceHandle.h>
 #include "QMCWaveFunctions/WaveFunctionComponent.h"
 #include "OhmmsData/libxmldefs.h"
 #include "OhmmsPETE/OhmmsVector.h"
@@ -65,6 +66,8 @@ public:
   }
 };
 
+struct kSpaceJastrowMultiWalkerMem;
+
 class kSpaceJastrow : public WaveFunctionComponent, public OptimizableObject
 {
 public:
@@ -112,8 +115,15 @@ private:
   // OneBodyGvecs, and TwoBodyGvecs, respectively
   std::vector<RealType> OneBodyPhase, TwoBodyPhase;
   //
-  std::vector<ComplexType> OneBody_e2iGr, TwoBody_e2iGr_new, TwoBody_e2iGr_old;
-  Matrix<ComplexType> Delta_e2iGr;
+  std::vector<ComplexType> OneBody_e2iGr, TwoBody_e2iGr_new;
+  // e^{iG.r} of every electron for TwoBodyGvecs. Rows are replaced on accepted moves
+  Matrix<ComplexType> TwoBody_e2iGr_ptcl;
+  // Index of each of TwoBodyGvecs in the k-point list of the electron structure factor.
+  // Empty if the structure factor does not contain all of them
+  std::vector<int> TwoBodySKIndex;
+
+  /// multi walker scratch of the batched APIs
+  ResourceHandle<kSpaceJastrowMultiWalkerMem> mw_mem_handle_;
 
   // Map of the optimizable variables:
   //std::map<std::string,RealType*> VarMap;
@@ -134,6 +144,29 @@ private:
   bool Equivalent(PosType G1, PosType G2);
   void StructureFactor(PosType G, std::vector<ComplexType>& rho_G);
 
+  /** locate TwoBodyGvecs in the k-point list of the electron structure factor
+   * TwoBodySKIndex is left empty if any of them is missing.
+   */
+  void mapTwoBodyGvecsToSK(const ParticleSet& elecs);
+  /** compute TwoBody_e2iGr_ptcl and TwoBody_rhoG from the electron positions
+   * @param reuse_sk if true, take e^{iG.r} from the per-particle storage of the electron structure factor when available
+   */
+  void computeTwoBodyRhoG(const ParticleSet& P, bool reuse_sk);
+  /// compute log value, gradients and laplacians using TwoBody_e2iGr_ptcl and TwoBody_rhoG
+  LogValue evaluateGLFromRhoG(const ParticleSet& P, ParticleSet::ParticleGradient& G, ParticleSet::ParticleLaplacian& L);
+  /// compute e^{iG.r} of the one-body G-vectors at r
+  void computeOneBodyE2iGr(const PosType& r, ComplexType* restrict e2iGr);
+  /** one-body Jastrow value from e^{iG.r}
+   * @param grad if not nullptr, the gradient is added
+   */
+  RealType oneBodyValue(const ComplexType* restrict e2iGr, GradType* grad) const;
+  /** change of the two-body Jastrow value when electron iat moves to the position of e2iGr_new
+   * @param grad if not nullptr, the gradient at the new position is added
+   */
+  RealType twoBodyDelta(int iat, const ComplexType* restrict e2iGr_new, GradType* grad) const;
+  /// update TwoBody_rhoG and TwoBody_e2iGr_ptcl after the move of electron iat is accepted
+  void acceptTwoBody(int iat, const ComplexType* restrict e2iGr_new);
+
   const ParticleSet& Ions;
   std::string OneBodyID;
   std::string TwoBodyID;
@@ -169,6 +202,11 @@ public:
                        ParticleSet::ParticleGradient& G,
                        ParticleSet::ParticleLaplacian& L) override;
 
+  LogValue evaluateGL(const ParticleSet& P,
+                      ParticleSet::ParticleGradient& G,
+                      ParticleSet::ParticleLaplacian& L,
+                      bool fromscratch) override;
+
   PsiValue ratio(ParticleSet& P, int iat) override;
 
   GradType evalGrad(ParticleSet& P, int iat) override;
@@ -177,6 +215,37 @@ public:
   void restore(int iat) override;
   void acceptMove(ParticleSet& P, int iat, bool safe_to_delay = false) override;
 
+  void createResource(ResourceCollection& collection) const override;
+
+  void acquireResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override;
+
+  void releaseResource(ResourceCollection& collection,
+                       const RefVectorWithLeader<WaveFunctionComponent>& wfc_list) const override;
+
+  void mw_calcRatio(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValue>& ratios) const override;
+
+  void mw_ratioGrad(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                    const RefVectorWithLeader<ParticleSet>& p_list,
+                    int iat,
+                    std::vector<PsiValue>& ratios,
+                    std::vector<GradType>& grad_new) const override;
+
+  void mw_accept_rejectMove(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                            const RefVectorWithLeader<ParticleSet>& p_list,
+                            int iat,
+                            const std::vector<bool>& isAccepted,
+                            bool safe_to_delay = false) const override;
+
+  void mw_evaluateGL(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                     const RefVectorWithLeader<ParticleSet>& p_list,
+                     const RefVector<ParticleSet::ParticleGradient>& G_list,
+                     const RefVector<ParticleSet::ParticleLaplacian>& L_list,
+                     bool fromscratch) const override;
+
   // Allocate per-walker data in the PooledData buffer
   void registerData(ParticleSet& P, WFBufferType& buf) override;
   // Walker move has been accepted -- update the buffer
@@ -208,6 +277,10 @@ public:
 
 private:
   void copyFrom(const kSpaceJastrow& old);
+  /// compute e^{iG.r} at the proposed positions of electron iat of all the walkers into the multi walker scratch
+  void mw_computeNewE2iGr(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                          const RefVectorWithLeader<ParticleSet>& p_list,
+                          int iat) const;
   std::vector<int> TwoBodyVarMap;
   std::vector<int> OneBodyVarMap;
 };
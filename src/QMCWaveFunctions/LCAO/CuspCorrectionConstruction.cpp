@@ -23,6 +23,9 @@
 #include "MultiQuinticSpline1D.h"
 #include "Numerics/MinimizeOneDim.h"
 #include "OhmmsData/AttributeSet.h"
+#include <cstdint>
+#include <iomanip>
+#include <sstream>
 
 
 namespace qmcplusplus
@@ -127,7 +130,10 @@ bool readCuspInfo(const std::string& cuspInfoFile,
   return success;
 }
 
-void saveCusp(const std::string& filename, const Matrix<CuspCorrectionParameters>& info, const std::string& id)
+void saveCusp(const std::string& filename,
+              const Matrix<CuspCorrectionParameters>& info,
+              const std::string& id,
+              const std::vector<std::string>& hashes)
 {
   const int num_centers      = info.rows();
   const int orbital_set_size = info.cols();
@@ -185,6 +191,8 @@ void saveCusp(const std::string& filename, const Matrix<CuspCorrectionParameters
       xmlNewProp(orb, (const xmlChar*)"a3", (const xmlChar*)a3.str().c_str());
       xmlNewProp(orb, (const xmlChar*)"a4", (const xmlChar*)a4.str().c_str());
       xmlNewProp(orb, (const xmlChar*)"a5", (const xmlChar*)a5.str().c_str());
+      if (!hashes.empty())
+        xmlNewProp(orb, (const xmlChar*)"hash", (const xmlChar*)hashes[mo_idx].c_str());
       xmlAddChild(ctr, orb);
     }
     xmlAddChild(spo, ctr);
@@ -195,6 +203,114 @@ void saveCusp(const std::string& filename, const Matrix<CuspCorrectionParameters
   xmlFreeDoc(doc);
 }
 
+std::vector<std::string> computeCuspInfoHashes(const ParticleSet& targetPtcl,
+                                               const ParticleSet& sourcePtcl,
+                                               const LCAOrbitalSet& lcao)
+{
+  const int num_centers = sourcePtcl.getTotalNum();
+  const int norbs       = lcao.getOrbitalSetSize();
+
+  ParticleSet probePtcl(targetPtcl);
+  LCAOrbitalSet probe("probe", std::unique_ptr<LCAOrbitalSet::basis_type>(lcao.myBasisSet->makeClone()), norbs,
+                      lcao.isIdentity(), false);
+  if (!lcao.isIdentity())
+    *probe.C = *lcao.C;
+
+  const SpeciesSet& tspecies(sourcePtcl.getSpeciesSet());
+  const int iz = tspecies.findAttribute("charge");
+
+  // values are rounded so that the hash doesn't depend on the last bits
+  std::ostringstream common;
+  common.setf(std::ios::scientific, std::ios::floatfield);
+  common.precision(10);
+  common << num_centers << " " << lcao.getBasisSetSize() << "\n";
+  if (iz >= 0)
+    for (int center_idx = 0; center_idx < num_centers; center_idx++)
+      common << tspecies(iz, sourcePtcl.GroupID[center_idx]) << " ";
+
+  // sample all the orbitals along a unit vector off the coordinate axes
+  const ParticleSet::SingleParticlePos dir(0.8, 0.48, 0.36);
+  const RealType probe_radii[] = {0.02, 0.1, 0.5};
+  const int num_radii          = sizeof(probe_radii) / sizeof(RealType);
+  Matrix<ValueType> samples(num_centers * num_radii, norbs);
+  ValueVector vals(norbs);
+  for (int center_idx = 0; center_idx < num_centers; center_idx++)
+    for (int ir = 0; ir < num_radii; ir++)
+    {
+      probePtcl.R[0] = sourcePtcl.R[center_idx];
+      probePtcl.makeMove(0, probe_radii[ir] * dir);
+      probe.evaluateValue(probePtcl, 0, vals);
+      std::copy_n(vals.data(), norbs, samples[center_idx * num_radii + ir]);
+    }
+
+  std::vector<std::string> hashes(norbs);
+  for (int mo_idx = 0; mo_idx < norbs; mo_idx++)
+  {
+    std::ostringstream sig;
+    sig.setf(std::ios::scientific, std::ios::floatfield);
+    sig.precision(10);
+    sig << common.str() << "\n";
+    for (int ip = 0; ip < samples.rows(); ip++)
+      sig << samples(ip, mo_idx) << " ";
+
+    // 64-bit FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : sig.str())
+    {
+      hash ^= static_cast<unsigned char>(c);
+      hash *= 1099511628211ULL;
+    }
+
+    std::ostringstream hex;
+    hex << std::hex << std::setw(16) << std::setfill('0') << hash;
+    hashes[mo_idx] = hex.str();
+  }
+  return hashes;
+}
+
+std::vector<std::string> readCuspInfoHashes(const std::string& cuspInfoFile,
+                                            const std::string& objectName,
+                                            int OrbitalSetSize)
+{
+  std::vector<std::string> hashes;
+  Libxml2Document adoc;
+  if (!adoc.parse(cuspInfoFile))
+    return hashes;
+
+  for (xmlNodePtr cur = adoc.getRoot()->children; cur != NULL; cur = cur->next)
+    if (getNodeName(cur) == "sposet")
+    {
+      std::string name;
+      OhmmsAttributeSet spoAttrib;
+      spoAttrib.add(name, "name");
+      spoAttrib.put(cur);
+      if (name != objectName)
+        continue;
+
+      hashes.resize(OrbitalSetSize);
+      // every center stores the same hashes, the first one is enough
+      for (xmlNodePtr ctr = cur->children; ctr != NULL; ctr = ctr->next)
+        if (getNodeName(ctr) == "center")
+        {
+          for (xmlNodePtr orb_node = ctr->children; orb_node != NULL; orb_node = orb_node->next)
+            if (getNodeName(orb_node) == "orbital")
+            {
+              int orb = -1;
+              std::string hash;
+              OhmmsAttributeSet orbAttrib;
+              orbAttrib.add(orb, "num");
+              orbAttrib.add(hash, "hash");
+              orbAttrib.put(orb_node);
+              if (orb >= 0 && orb < OrbitalSetSize)
+                hashes[orb] = hash;
+            }
+          break;
+        }
+      break;
+    }
+  return hashes;
+}
+
 void broadcastCuspInfo(CuspCorrectionParameters& param, Communicate& Comm, int root)
 {
 #ifdef HAVE_MPI
@@ -663,7 +779,8 @@ void generateCuspInfo(Matrix<CuspCorrectionParameters>& info,
                       const ParticleSet& sourcePtcl,
                       const LCAOrbitalSet& lcao,
                       const std::string& id,
-                      Communicate& Comm)
+                      Communicate& Comm,
+                      const std::vector<bool>& fit_orbital)
 {
   const int num_centers      = info.rows();
   const int orbital_set_size = info.cols();
@@ -686,100 +803,121 @@ void generateCuspInfo(Matrix<CuspCorrectionParameters>& info,
   using GridType = OneDimGridBase<RealType>;
   int npts       = 500;
 
+  std::vector<int> fit_mos;
+  for (int mo_idx = 0; mo_idx < orbital_set_size; mo_idx++)
+    if (fit_orbital.empty() || fit_orbital[mo_idx])
+    {
+      fit_mos.push_back(mo_idx);
+      // orbitals which turn out to need no correction keep the default parameters
+      for (int center_idx = 0; center_idx < num_centers; center_idx++)
+        info(center_idx, mo_idx) = CuspCorrectionParameters();
+    }
+
   // Parallelize correction of MO's across MPI ranks
   std::vector<int> offset;
-  FairDivideLow(orbital_set_size, Comm.size(), offset);
+  FairDivideLow(fit_mos.size(), Comm.size(), offset);
 
-  int start_mo = offset[Comm.rank()];
-  int end_mo   = offset[Comm.rank() + 1];
-  app_log() << "  Number of molecular orbitals to compute correction on this rank: " << end_mo - start_mo << std::endl;
+  const int start_fit = offset[Comm.rank()];
+  const int end_fit   = offset[Comm.rank() + 1];
+  app_log() << "  Number of molecular orbitals to compute correction on this rank: " << end_fit - start_fit
+            << std::endl;
 
-// Specify dynamic scheduling explicitly for load balancing.   Each iteration should take enough
-// time that scheduling overhead is not an issue.
-#pragma omp parallel for schedule(dynamic) collapse(2)
-  for (int center_idx = 0; center_idx < num_centers; center_idx++)
+#pragma omp parallel
   {
-    for (int mo_idx = start_mo; mo_idx < end_mo; mo_idx++)
-    {
-      ParticleSet localTargetPtcl(targetPtcl);
-      ParticleSet localSourcePtcl(sourcePtcl);
+    // per-thread copies, reused for all the (center, orbital) pairs of this thread
+    ParticleSet localTargetPtcl(targetPtcl);
+    ParticleSet localSourcePtcl(sourcePtcl);
 
-      LCAOrbitalSet local_phi("local_phi", std::unique_ptr<LCAOrbitalSet::basis_type>(phi.myBasisSet->makeClone()),
-                              phi.getOrbitalSetSize(), phi.isIdentity(), phi.isOMPoffload());
+    LCAOrbitalSet local_phi("local_phi", std::unique_ptr<LCAOrbitalSet::basis_type>(phi.myBasisSet->makeClone()),
+                            phi.getOrbitalSetSize(), phi.isIdentity(), phi.isOMPoffload());
 
-      LCAOrbitalSet local_eta("local_eta", std::unique_ptr<LCAOrbitalSet::basis_type>(eta.myBasisSet->makeClone()),
-                              eta.getOrbitalSetSize(), eta.isIdentity(), eta.isOMPoffload());
+    LCAOrbitalSet local_eta("local_eta", std::unique_ptr<LCAOrbitalSet::basis_type>(eta.myBasisSet->makeClone()),
+                            eta.getOrbitalSetSize(), eta.isIdentity(), eta.isOMPoffload());
 
-#pragma omp critical
-      app_log() << "   Working on MO: " << mo_idx << " Center: " << center_idx << std::endl;
+    SpeciesSet& tspecies(localSourcePtcl.getSpeciesSet());
+    const int iz = tspecies.addAttribute("charge");
+
+    // The split depends only on the center. A thread redoes it only when it moves to another center.
+    int split_center = -1;
 
+// Specify dynamic scheduling explicitly for load balancing.   Each iteration should take enough
+// time that scheduling overhead is not an issue.
+#pragma omp for schedule(dynamic) collapse(2)
+    for (int center_idx = 0; center_idx < num_centers; center_idx++)
+    {
+      for (int ifit = start_fit; ifit < end_fit; ifit++)
       {
-        ScopedTimer local_timer(splitPhiEtaTimer);
+        const int mo_idx = fit_mos[ifit];
 
-        *local_eta.C = *lcao.C;
-        *local_phi.C = *lcao.C;
-        splitPhiEta(center_idx, corrCenter, local_phi, local_eta);
-      }
+#pragma omp critical
+        app_log() << "   Working on MO: " << mo_idx << " Center: " << center_idx << std::endl;
 
-      bool corrO = false;
-      auto& cref(*(local_phi.C));
-      for (int ip = 0; ip < cref.cols(); ip++)
-      {
-        if (std::abs(cref(mo_idx, ip)) > 0)
+        if (center_idx != split_center)
         {
-          corrO = true;
-          break;
+          ScopedTimer local_timer(splitPhiEtaTimer);
+
+          *local_eta.C = *lcao.C;
+          *local_phi.C = *lcao.C;
+          splitPhiEta(center_idx, corrCenter, local_phi, local_eta);
+          split_center = center_idx;
         }
-      }
 
-      if (corrO)
-      {
-        OneMolecularOrbital etaMO(&localTargetPtcl, &localSourcePtcl, &local_eta);
-        etaMO.changeOrbital(center_idx, mo_idx);
+        bool corrO = false;
+        auto& cref(*(local_phi.C));
+        for (int ip = 0; ip < cref.cols(); ip++)
+        {
+          if (std::abs(cref(mo_idx, ip)) > 0)
+          {
+            corrO = true;
+            break;
+          }
+        }
 
-        OneMolecularOrbital phiMO(&localTargetPtcl, &localSourcePtcl, &local_phi);
-        phiMO.changeOrbital(center_idx, mo_idx);
+        if (corrO)
+        {
+          OneMolecularOrbital etaMO(&localTargetPtcl, &localSourcePtcl, &local_eta);
+          etaMO.changeOrbital(center_idx, mo_idx);
 
-        SpeciesSet& tspecies(localSourcePtcl.getSpeciesSet());
-        int iz     = tspecies.addAttribute("charge");
-        RealType Z = tspecies(iz, localSourcePtcl.GroupID[center_idx]);
+          OneMolecularOrbital phiMO(&localTargetPtcl, &localSourcePtcl, &local_phi);
+          phiMO.changeOrbital(center_idx, mo_idx);
 
-        RealType Rc_max = 0.2;
-        RealType rc     = 0.1;
+          RealType Z = tspecies(iz, localSourcePtcl.GroupID[center_idx]);
 
-        RealType dx = rc * 1.2 / npts;
-        ValueVector pos(npts);
-        ValueVector ELideal(npts);
-        ValueVector ELcurr(npts);
-        for (int i = 0; i < npts; i++)
-        {
-          pos[i] = (i + 1.0) * dx;
-        }
+          RealType Rc_max = 0.2;
+          RealType rc     = 0.1;
 
-        RealType eta0 = etaMO.phi(0.0);
-        ValueVector ELorig(npts);
-        CuspCorrection cusp(info(center_idx, mo_idx));
-        {
-          ScopedTimer local_timer(computeTimer);
-          minimizeForRc(cusp, phiMO, Z, rc, Rc_max, eta0, pos, ELcurr, ELideal);
+          RealType dx = rc * 1.2 / npts;
+          ValueVector pos(npts);
+          ValueVector ELideal(npts);
+          ValueVector ELcurr(npts);
+          for (int i = 0; i < npts; i++)
+          {
+            pos[i] = (i + 1.0) * dx;
+          }
+
+          RealType eta0 = etaMO.phi(0.0);
+          ValueVector ELorig(npts);
+          CuspCorrection cusp(info(center_idx, mo_idx));
+          {
+            ScopedTimer local_timer(computeTimer);
+            minimizeForRc(cusp, phiMO, Z, rc, Rc_max, eta0, pos, ELcurr, ELideal);
+          }
+          // Update shared object.  Each iteration accesses a different element and
+          // this is an array (no bookkeeping data to update), so no synchronization
+          // is necessary.
+          info(center_idx, mo_idx) = cusp.cparam;
         }
-        // Update shared object.  Each iteration accesses a different element and
-        // this is an array (no bookkeeping data to update), so no synchronization
-        // is necessary.
-        info(center_idx, mo_idx) = cusp.cparam;
       }
     }
   }
 
   for (int root = 0; root < Comm.size(); root++)
   {
-    int start_mo = offset[root];
-    int end_mo   = offset[root + 1];
-    for (int mo_idx = start_mo; mo_idx < end_mo; mo_idx++)
+    for (int ifit = offset[root]; ifit < offset[root + 1]; ifit++)
     {
       for (int center_idx = 0; center_idx < num_centers; center_idx++)
       {
-        broadcastCuspInfo(info(center_idx, mo_idx), Comm, root);
+        broadcastCuspInfo(info(center_idx, fit_mos[ifit]), Comm, root);
       }
     }
   }
@@ -104,8 +104,32 @@ bool readCuspInfo(const std::string& cuspInfoFile,
                   int OrbitalSetSize,
                   Matrix<CuspCorrectionParameters>& info);
 
-/// save cusp correction info to a file.
-void saveCusp(const std::string& filename, const Matrix<CuspCorrectionParameters>& info, const std::string& id);
+/** save cusp correction info to a file.
+ * @param hashes if not empty, the hash of each orbital from computeCuspInfoHashes, stored along with its parameters
+ */
+void saveCusp(const std::string& filename,
+              const Matrix<CuspCorrectionParameters>& info,
+              const std::string& id,
+              const std::vector<std::string>& hashes = {});
+
+/** Hash the inputs of the cusp correction construction of each orbital
+ * Every orbital is sampled close to each center, where the correction applies,
+ * so that any change in the geometry, the basis set or its MO coefficients changes its hash.
+ * @param targetPtcl electrons, used to evaluate the orbitals
+ * @param sourcePtcl ions
+ * @param lcao uncorrected orbitals
+ * @return hexadecimal string per orbital
+ */
+std::vector<std::string> computeCuspInfoHashes(const ParticleSet& targetPtcl,
+                                               const ParticleSet& sourcePtcl,
+                                               const LCAOrbitalSet& lcao);
+
+/** Read the orbital hashes stored by saveCusp
+ * @return hash per orbital, empty for orbitals without a hash. Empty if the file or the SPOSet is not found.
+ */
+std::vector<std::string> readCuspInfoHashes(const std::string& cuspInfoFile,
+                                            const std::string& objectName,
+                                            int OrbitalSetSize);
 
 /// Divide molecular orbital into atomic S-orbitals on this center (phi), and everything else (eta).
 void splitPhiEta(int center, const std::vector<bool>& corrCenter, LCAOrbitalSet& phi, LCAOrbitalSet& eta);
@@ -272,12 +296,18 @@ void applyCuspCorrection(const Matrix<CuspCorrectionParameters>& info,
                          SoaCuspCorrection& cusp,
                          const std::string& id);
 
+/** Fit the cusp correction parameters
+ * (center, orbital) pairs are distributed over MPI ranks by orbital and over threads within a center.
+ * @param info parameters, [center][orbital]. Orbitals not fitted are left untouched.
+ * @param fit_orbital orbitals to fit, all of them if empty
+ */
 void generateCuspInfo(Matrix<CuspCorrectionParameters>& info,
                       const ParticleSet& targetPtcl,
                       const ParticleSet& sourcePtcl,
                       const LCAOrbitalSet& lcao,
                       const std::string& id,
-                      Communicate& Comm);
+                      Communicate& Comm,
+                      const std::vector<bool>& fit_orbital = {});
 
 } // namespace qmcplusplus
 
@@ -36,6 +36,7 @@
 #include "Utilities/ProgressReportEngine.h"
 #include "CPU/math.hpp"
 
+#include <algorithm>
 #include <array>
 
 namespace qmcplusplus
@@ -473,6 +474,7 @@ std::unique_ptr<SPOSet> LCAOrbitalBuilder::createSPOSetFromXML(xmlNodePtr cur)
   ReportEngine PRE(ClassName, "createSPO(xmlNodePtr)");
   std::string spo_name(""), cusp_file(""), optimize("no");
   std::string basisset_name("LCAOBSet");
+  std::string screening("no");
   size_t norbs(0);
   OhmmsAttributeSet spoAttrib;
   spoAttrib.add(spo_name, "name");
@@ -481,6 +483,7 @@ std::unique_ptr<SPOSet> LCAOrbitalBuilder::createSPOSetFromXML(xmlNodePtr cur)
   spoAttrib.add(basisset_name, "basisset");
   spoAttrib.add(norbs, "size");
   spoAttrib.add(norbs, "orbitals", {}, TagStatus::DELETED);
+  spoAttrib.add(screening, "screening", {"no", "yes"});
   spoAttrib.put(cur);
 
   const bool useOffload = CPUOMPTargetSelector::selectPlatform(useGPU) == PlatformKind::OMPTARGET;
@@ -510,9 +513,11 @@ std::unique_ptr<SPOSet> LCAOrbitalBuilder::createSPOSetFromXML(xmlNodePtr cur)
 #else
     app_summary() << "        Using cusp correction." << std::endl;
     if (useOffload)
-      app_warning() << "    LCAO with cusp correction doesn't support OpenMP offload. Running on CPU." << std::endl;
+      app_summary() << "    Running OpenMP offload code path. The cusp correction is applied on CPU." << std::endl;
+    else
+      app_summary() << "    Running on CPU." << std::endl;
     auto lcwc = std::make_unique<LCAOrbitalSetWithCorrection>(spo_name, std::move(myBasisSet), norbs, identity,
-                                                              sourcePtcl, targetPtcl);
+                                                              sourcePtcl, targetPtcl, useOffload);
     if (!identity)
       loadMO(lcwc->lcao, cur);
     sposet = std::move(lcwc);
@@ -527,6 +532,9 @@ std::unique_ptr<SPOSet> LCAOrbitalBuilder::createSPOSetFromXML(xmlNodePtr cur)
     auto lcos = std::make_unique<LCAOrbitalSet>(spo_name, std::move(myBasisSet), norbs, identity, useOffload);
     if (!identity)
       loadMO(*lcos, cur);
+    lcos->setCenterScreening(screening == "yes");
+    if (lcos->isCenterScreening())
+      app_summary() << "    Skipping basis centers beyond their cutoff radius in batched evaluation." << std::endl;
     sposet = std::move(lcos);
   }
 
@@ -556,8 +564,30 @@ std::unique_ptr<SPOSet> LCAOrbitalBuilder::createSPOSetFromXML(xmlNodePtr cur)
     myComm->bcast(file_exists);
     app_log() << "  Cusp correction file " << cusp_file << (file_exists ? " exits." : " doesn't exist.") << std::endl;
 
-    // validate file if it exists
+    // the file is a cache of the parameters. Those of an orbital are reused only if its hash matches.
+    // Only rank 0 compares and writes the file, the hashes are computed there and only if needed.
+    std::vector<std::string> cusp_hashes;
+    Vector<int> is_current(orbital_set_size);
+    is_current = 0;
     if (file_exists)
+    {
+      if (myComm->rank() == 0)
+      {
+        const auto stored_hashes = readCuspInfoHashes(cusp_file, spo_name, orbital_set_size);
+        // files without any hash are reused as they are
+        const bool no_hash =
+            std::all_of(stored_hashes.begin(), stored_hashes.end(), [](const std::string& h) { return h.empty(); });
+        if (!no_hash)
+          cusp_hashes = computeCuspInfoHashes(tmp_targetPtcl, sourcePtcl, lcwc.lcao);
+        for (int orb_idx = 0; orb_idx < stored_hashes.size(); orb_idx++)
+          is_current[orb_idx] = no_hash || stored_hashes[orb_idx] == cusp_hashes[orb_idx];
+      }
+      myComm->bcast(is_current);
+    }
+    const int num_current = std::count(is_current.begin(), is_current.end(), 1);
+
+    // validate file if any of its orbitals is current
+    if (num_current > 0)
     {
       bool valid = 0;
       if (myComm->rank() == 0)
@@ -571,11 +601,23 @@ std::unique_ptr<SPOSet> LCAOrbitalBuilder::createSPOSetFromXML(xmlNodePtr cur)
           broadcastCuspInfo(info(center_idx, orb_idx), *myComm, 0);
 #endif
     }
-    else
+
+    if (num_current < orbital_set_size)
     {
-      generateCuspInfo(info, tmp_targetPtcl, sourcePtcl, lcwc.lcao, spo_name, *myComm);
+      if (file_exists)
+        app_log() << "  Recomputing cusp correction of " << orbital_set_size - num_current << " out of "
+                  << orbital_set_size << " orbitals and overwriting " << cusp_file << std::endl;
+      std::vector<bool> fit_orbital(orbital_set_size);
+      for (int orb_idx = 0; orb_idx < orbital_set_size; orb_idx++)
+        fit_orbital[orb_idx] = !is_current[orb_idx];
+      generateCuspInfo(info, tmp_targetPtcl, sourcePtcl, lcwc.lcao, spo_name, *myComm, fit_orbital);
       if (myComm->rank() == 0)
-        saveCusp(cusp_file, info, spo_name);
+      {
+        // the hashes of a new file validate it in the next runs
+        if (cusp_hashes.empty())
+          cusp_hashes = computeCuspInfoHashes(tmp_targetPtcl, sourcePtcl, lcwc.lcao);
+        saveCusp(cusp_file, info, spo_name, cusp_hashes);
+      }
     }
 
     applyCuspCorrection(info, tmp_targetPtcl, sourcePtcl, lcwc.lcao, lcwc.cusp, spo_name);
@@ -15,9 +15,19 @@
 #include "CPU/BLAS.hpp"
 #include "OMPTarget/ompBLAS.hpp"
 #include <ResourceCollection.h>
+#include <atomic>
 
 namespace qmcplusplus
 {
+struct LCAOrbitalSet::ScreeningStats
+{
+  /// number of screened mw_evaluateVGL calls
+  std::atomic<size_t> num_calls{0};
+  /// accumulated number of basis functions entering the MO GEMM
+  std::atomic<size_t> num_used_aos{0};
+  /// accumulated number of basis functions in the dense evaluation
+  std::atomic<size_t> num_total_aos{0};
+};
 
 struct LCAOrbitalSet::LCAOMultiWalkerMem : public Resource
 {
@@ -38,6 +48,7 @@ struct LCAOrbitalSet::LCAOMultiWalkerMem : public Resource
   OffloadVector<const ValueType*> invRow_deviceptr_list; // [NVPs]
   OffloadMatrix<ValueType> rg_buffer;                    // [4][NVPs]
   OffloadVector<size_t> nVP_index_list;                  // [NVPs]
+  std::vector<std::pair<size_t, size_t>> ao_ranges;      // [first, last) of the AOs within cutoff radius
 };
 
 LCAOrbitalSet::LCAOrbitalSet(const std::string& my_name,
@@ -49,12 +60,15 @@ LCAOrbitalSet::LCAOrbitalSet(const std::string& my_name,
       BasisSetSize(bs ? bs->getBasisSetSize() : 0),
       Identity(identity),
       useOMPoffload_(use_offload),
+      use_center_screening_(false),
+      screening_stats_(std::make_shared<ScreeningStats>()),
       basis_timer_(createGlobalTimer("LCAOrbitalSet::Basis", timer_level_fine)),
       mo_timer_(createGlobalTimer("LCAOrbitalSet::MO", timer_level_fine))
 {
   if (!bs)
     throw std::runtime_error("LCAOrbitalSet cannot take nullptr as its  basis set!");
-  myBasisSet     = std::move(bs);
+  myBasisSet = std::move(bs);
+  myBasisSet->setOffload(useOMPoffload_);
   OrbitalSetSize = norbs;
   Temp.resize(BasisSetSize);
   Temph.resize(BasisSetSize);
@@ -78,6 +92,8 @@ LCAOrbitalSet::LCAOrbitalSet(const LCAOrbitalSet& in)
       C_copy(in.C_copy),
       Identity(in.Identity),
       useOMPoffload_(in.useOMPoffload_),
+      use_center_screening_(in.use_center_screening_),
+      screening_stats_(in.screening_stats_),
       basis_timer_(in.basis_timer_),
       mo_timer_(in.mo_timer_)
 {
@@ -93,6 +109,21 @@ LCAOrbitalSet::LCAOrbitalSet(const LCAOrbitalSet& in)
   LCAOrbitalSet::checkObject();
 }
 
+LCAOrbitalSet::~LCAOrbitalSet()
+{
+  // the last copy reports the sparsity of the screened evaluation accumulated by all the clones
+  if (screening_stats_.use_count() == 1 && screening_stats_->num_calls > 0)
+    app_log() << "  LCAOrbitalSet " << getName() << " center screening: " << screening_stats_->num_calls
+              << " batched VGL evaluations used " << getScreenedBasisFraction() * 100
+              << "% of the basis functions in the MO GEMM." << std::endl;
+}
+
+double LCAOrbitalSet::getScreenedBasisFraction() const
+{
+  const size_t num_total_aos = screening_stats_->num_total_aos;
+  return num_total_aos == 0 ? 1.0 : static_cast<double>(screening_stats_->num_used_aos) / num_total_aos;
+}
+
 void LCAOrbitalSet::setOrbitalSetSize(int norbs)
 {
   throw std::runtime_error("LCAOrbitalSet::setOrbitalSetSize should not be called");
@@ -438,12 +469,6 @@ void LCAOrbitalSet::mw_evaluateVGL(const RefVectorWithLeader<SPOSet>& spo_list,
                                    const RefVector<ValueVector>& d2psi_v_list) const
 {
   assert(this == &spo_list.getLeader());
-  if (!useOMPoffload_)
-  {
-    SPOSet::mw_evaluateVGL(spo_list, P_list, iat, psi_v_list, dpsi_v_list, d2psi_v_list);
-    return;
-  }
-
   auto& spo_leader = spo_list.getCastedLeader<LCAOrbitalSet>();
   auto& phi_vgl_v  = spo_leader.mw_mem_handle_.getResource().phi_vgl_v;
 
@@ -474,46 +499,57 @@ void LCAOrbitalSet::mw_evaluateVGLImplGEMM(const RefVectorWithLeader<SPOSet>& sp
   assert(this == &spo_list.getLeader());
   auto& spo_leader   = spo_list.getCastedLeader<LCAOrbitalSet>();
   auto& basis_vgl_mw = spo_leader.mw_mem_handle_.getResource().basis_vgl_mw;
+  auto& ao_ranges    = spo_leader.mw_mem_handle_.getResource().ao_ranges;
   basis_vgl_mw.resize(DIM_VGL, spo_list.size(), BasisSetSize);
 
   {
     ScopedTimer local(basis_timer_);
     auto basis_list = spo_leader.extractBasisRefList(spo_list);
-    myBasisSet->mw_evaluateVGL(basis_list, P_list, iat, basis_vgl_mw);
+    if (isCenterScreening())
+      myBasisSet->mw_evaluateVGLScreened(basis_list, P_list, iat, basis_vgl_mw, ao_ranges);
+    else
+      myBasisSet->mw_evaluateVGL(basis_list, P_list, iat, basis_vgl_mw);
   }
-  // basis_vgl_mw correct on device
-#if defined(ENABLE_OFFLOAD)
-  int dummy_handle = 0;
-  int success      = 0;
+  // basis_vgl_mw correct on device if useOMPoffload_, on host otherwise
 
-  if (Identity)
+#if defined(ENABLE_OFFLOAD)
+  if (useOMPoffload_)
   {
-    const size_t output_size = phi_vgl_v.size(2);
-    const size_t nw          = phi_vgl_v.size(1);
-    for (size_t idim = 0; idim < DIM_VGL; idim++)
+    int dummy_handle = 0;
+    int success      = 0;
+
+    if (Identity)
     {
-      success = ompBLAS::copy(dummy_handle, output_size * nw, basis_vgl_mw.device_data_at(idim, 0, 0), 1,
-                              phi_vgl_v.device_data_at(idim, 0, 0), 1);
+      const size_t output_size = phi_vgl_v.size(2);
+      const size_t nw          = phi_vgl_v.size(1);
+      for (size_t idim = 0; idim < DIM_VGL; idim++)
+      {
+        success = ompBLAS::copy(dummy_handle, output_size * nw, basis_vgl_mw.device_data_at(idim, 0, 0), 1,
+                                phi_vgl_v.device_data_at(idim, 0, 0), 1);
+        if (success != 0)
+          throw std::runtime_error("In LCAOrbitalSet::mw_evaluateVGLImplGEMM ompBLAS::copy failed.");
+      }
+    }
+    else
+    {
+      const size_t requested_orb_size = phi_vgl_v.size(2);
+      assert(requested_orb_size <= OrbitalSetSize);
+
+      auto* c_devptr = C->device_data();
+      success        = ompBLAS::gemm(dummy_handle, 'T', 'N',
+                                     requested_orb_size,        // MOs
+                                     spo_list.size() * DIM_VGL, // walkers * DIM_VGL
+                                     BasisSetSize,              // AOs
+                                     1, c_devptr, BasisSetSize, basis_vgl_mw.device_data(), BasisSetSize, 0,
+                                     phi_vgl_v.device_data(), requested_orb_size);
       if (success != 0)
-        throw std::runtime_error("In LCAOrbitalSet::mw_evaluateVGLImplGEMM ompBLAS::copy failed.");
+        throw std::runtime_error("In LCAOrbitalSet::mw_evaluateVGLImplGEMM ompBLAS::gemm failed.");
     }
+    // phi_vgl_v correct on device
+    return;
   }
-  else
-  {
-    const size_t requested_orb_size = phi_vgl_v.size(2);
-    assert(requested_orb_size <= OrbitalSetSize);
+#endif
 
-    auto* c_devptr = C->device_data();
-    success        = ompBLAS::gemm(dummy_handle, 'T', 'N',
-                                   requested_orb_size,        // MOs
-                                   spo_list.size() * DIM_VGL, // walkers * DIM_VGL
-                                   BasisSetSize,              // AOs
-                                   1, c_devptr, BasisSetSize, basis_vgl_mw.device_data(), BasisSetSize, 0,
-                                   phi_vgl_v.device_data(), requested_orb_size);
-    if (success != 0)
-      throw std::runtime_error("In LCAOrbitalSet::mw_evaluateVGLImplGEMM ompBLAS::gemm failed.");
-  }
-#else
   if (Identity)
   {
     // output_size can be smaller than BasisSetSize
@@ -524,25 +560,48 @@ void LCAOrbitalSet::mw_evaluateVGLImplGEMM(const RefVectorWithLeader<SPOSet>& sp
       for (int iw = 0; iw < nw; iw++)
         std::copy_n(basis_vgl_mw.data_at(idim, iw, 0), output_size, phi_vgl_v.data_at(idim, iw, 0));
   }
-  else
+  else if (isCenterScreening())
   {
+    // only the column blocks of C of the centers within the cutoff radius contribute.
     const size_t requested_orb_size = phi_vgl_v.size(2);
     assert(requested_orb_size <= OrbitalSetSize);
+    ScopedTimer local(mo_timer_);
+    ValueMatrix C_partial_view(C->data(), requested_orb_size, BasisSetSize);
+    if (ao_ranges.empty())
+      std::fill_n(phi_vgl_v.data(), phi_vgl_v.size(), ValueType(0));
+    size_t num_used_aos = 0;
+    for (size_t ir = 0; ir < ao_ranges.size(); ir++)
     {
-      ScopedTimer local(mo_timer_);
-      ValueMatrix C_partial_view(C->data(), requested_orb_size, BasisSetSize);
-      // TODO: make class for general blas interface in Platforms
-      // have instance of that class as member of LCAOrbitalSet, call gemm through that
+      const auto [first, last] = ao_ranges[ir];
       BLAS::gemm('T', 'N',
                  requested_orb_size,        // MOs
                  spo_list.size() * DIM_VGL, // walkers * DIM_VGL
-                 BasisSetSize,              // AOs
-                 1, C_partial_view.data(), BasisSetSize, basis_vgl_mw.data(), BasisSetSize, 0, phi_vgl_v.data(),
-                 requested_orb_size);
+                 last - first,              // AOs within cutoff
+                 1, C_partial_view.data() + first, BasisSetSize, basis_vgl_mw.data() + first, BasisSetSize,
+                 ir == 0 ? 0 : 1, phi_vgl_v.data(), requested_orb_size);
+      num_used_aos += last - first;
     }
+    screening_stats_->num_calls++;
+    screening_stats_->num_used_aos += num_used_aos;
+    screening_stats_->num_total_aos += BasisSetSize;
   }
-#endif
-  // phi_vgl_v correct on device if ENABLE_OFFLOAD
+  else
+  {
+    const size_t requested_orb_size = phi_vgl_v.size(2);
+    assert(requested_orb_size <= OrbitalSetSize);
+    ScopedTimer local(mo_timer_);
+    ValueMatrix C_partial_view(C->data(), requested_orb_size, BasisSetSize);
+    // TODO: make class for general blas interface in Platforms
+    // have instance of that class as member of LCAOrbitalSet, call gemm through that
+    BLAS::gemm('T', 'N',
+               requested_orb_size,        // MOs
+               spo_list.size() * DIM_VGL, // walkers * DIM_VGL
+               BasisSetSize,              // AOs
+               1, C_partial_view.data(), BasisSetSize, basis_vgl_mw.data(), BasisSetSize, 0, phi_vgl_v.data(),
+               requested_orb_size);
+  }
+  // the determinants may run their updates on device
+  phi_vgl_v.updateTo();
 }
 
 void LCAOrbitalSet::mw_evaluateValueVPsImplGEMM(const RefVectorWithLeader<SPOSet>& spo_list,
@@ -612,12 +671,6 @@ void LCAOrbitalSet::mw_evaluateValue(const RefVectorWithLeader<SPOSet>& spo_list
                                      const RefVector<ValueVector>& psi_v_list) const
 {
   assert(this == &spo_list.getLeader());
-  if (!useOMPoffload_)
-  {
-    SPOSet::mw_evaluateValue(spo_list, P_list, iat, psi_v_list);
-    return;
-  }
-
   auto& spo_leader = spo_list.getCastedLeader<LCAOrbitalSet>();
   auto& phi_v      = spo_leader.mw_mem_handle_.getResource().phi_v;
   phi_v.resize(spo_list.size(), OrbitalSetSize);
@@ -646,32 +699,38 @@ void LCAOrbitalSet::mw_evaluateValueImplGEMM(const RefVectorWithLeader<SPOSet>&
   myBasisSet->mw_evaluateValue(basis_list, P_list, iat, basis_v_mw);
 
 #if defined(ENABLE_OFFLOAD)
-  auto* basis_devptr = basis_v_mw.device_data_at(0, 0);
-  auto* phi_devptr   = phi_v.device_data_at(0, 0);
-  int dummy_handle   = 0;
-  int success        = 0;
-
-  if (Identity)
+  if (useOMPoffload_)
   {
-    success = ompBLAS::copy(dummy_handle, OrbitalSetSize * nw, basis_devptr, 1, phi_devptr, 1);
-    if (success != 0)
-      throw std::runtime_error("In LCAOrbitalSet::mw_evaluateValueImplGEMM ompBLAS::copy failed.");
-  }
-  else
-  {
-    const size_t requested_orb_size = phi_v.size(1);
-    assert(requested_orb_size <= OrbitalSetSize);
+    auto* basis_devptr = basis_v_mw.device_data_at(0, 0);
+    auto* phi_devptr   = phi_v.device_data_at(0, 0);
+    int dummy_handle   = 0;
+    int success        = 0;
 
-    auto* c_devptr = C->device_data();
-    success        = ompBLAS::gemm(dummy_handle, 'T', 'N',
-                                   requested_orb_size, // MOs
-                                   nw,                 // walkers
-                                   BasisSetSize,       // AOs
-                                   1, c_devptr, BasisSetSize, basis_devptr, BasisSetSize, 0, phi_devptr, requested_orb_size);
-    if (success != 0)
-      throw std::runtime_error("In LCAOrbitalSet::mw_evaluateValueImplGEMM ompBLAS::gemm failed.");
+    if (Identity)
+    {
+      success = ompBLAS::copy(dummy_handle, OrbitalSetSize * nw, basis_devptr, 1, phi_devptr, 1);
+      if (success != 0)
+        throw std::runtime_error("In LCAOrbitalSet::mw_evaluateValueImplGEMM ompBLAS::copy failed.");
+    }
+    else
+    {
+      const size_t requested_orb_size = phi_v.size(1);
+      assert(requested_orb_size <= OrbitalSetSize);
+
+      auto* c_devptr = C->device_data();
+      success        = ompBLAS::gemm(dummy_handle, 'T', 'N',
+                                     requested_orb_size, // MOs
+                                     nw,                 // walkers
+                                     BasisSetSize,       // AOs
+                                     1, c_devptr, BasisSetSize, basis_devptr, BasisSetSize, 0, phi_devptr,
+                                     requested_orb_size);
+      if (success != 0)
+        throw std::runtime_error("In LCAOrbitalSet::mw_evaluateValueImplGEMM ompBLAS::gemm failed.");
+    }
+    return;
   }
-#else
+#endif
+
   if (Identity)
   {
     std::copy_n(basis_v_mw.data_at(0, 0), OrbitalSetSize * nw, phi_v.data_at(0, 0));
@@ -688,7 +747,7 @@ void LCAOrbitalSet::mw_evaluateValueImplGEMM(const RefVectorWithLeader<SPOSet>&
                1, C_partial_view.data(), BasisSetSize, basis_v_mw.data(), BasisSetSize, 0, phi_v.data(),
                requested_orb_size);
   }
-#endif
+  phi_v.updateTo();
 }
 
 void LCAOrbitalSet::mw_evaluateDetRatios(const RefVectorWithLeader<SPOSet>& spo_list,
@@ -791,12 +850,6 @@ void LCAOrbitalSet::mw_evaluateVGLandDetRatioGrads(const RefVectorWithLeader<SPO
   assert(phi_vgl_v.size(0) == DIM_VGL);
   assert(phi_vgl_v.size(1) == spo_list.size());
 
-  if (!useOMPoffload_)
-  {
-    SPOSet::mw_evaluateVGLandDetRatioGrads(spo_list, P_list, iat, invRow_ptr_list, phi_vgl_v, ratios, grads);
-    return;
-  }
-
   mw_evaluateVGLImplGEMM(spo_list, P_list, iat, phi_vgl_v);
   // Device data of phi_vgl_v must be up-to-date upon return
   // phi_vgl_v.updateTo(); // moved updateTo to mw_evaluateVGLImplGEMM
@@ -804,55 +857,60 @@ void LCAOrbitalSet::mw_evaluateVGLandDetRatioGrads(const RefVectorWithLeader<SPO
   const size_t nw             = spo_list.size();
   const size_t norb_requested = phi_vgl_v.size(2);
 #if defined(ENABLE_OFFLOAD)
-  auto& spo_leader            = spo_list.getCastedLeader<LCAOrbitalSet>();
-  auto& invRow_deviceptr_list = spo_leader.mw_mem_handle_.getResource().invRow_deviceptr_list;
-  auto& rg_buffer             = spo_leader.mw_mem_handle_.getResource().rg_buffer;
-
-  invRow_deviceptr_list.resize(nw);
-  rg_buffer.resize(4, nw);
-
-  for (size_t iw = 0; iw < nw; iw++)
-    invRow_deviceptr_list[iw] = invRow_ptr_list[iw];
-
-  auto* invRow_deviceptr_list_ptr = invRow_deviceptr_list.data();
-  auto* phi_vgl_v_ptr             = phi_vgl_v.data();
-  auto* rg_buffer_ptr             = rg_buffer.data();
-  const size_t phi_vgl_stride     = nw * norb_requested;
-
-  PRAGMA_OFFLOAD("omp target teams distribute \
-                  map(always,to: invRow_deviceptr_list_ptr[:nw]) \
-                  map(to: phi_vgl_v_ptr[:nw*norb_requested]) \
-                  map(always, from: rg_buffer_ptr[:rg_buffer.size()])")
-  for (size_t iw = 0; iw < nw; iw++)
+  // the screened path evaluates the orbitals on the host for host determinants
+  if (useOMPoffload_)
   {
-    auto* phi_v_ptr  = phi_vgl_v_ptr + iw * norb_requested;
-    auto* phi_gx_ptr = phi_v_ptr + phi_vgl_stride;
-    auto* phi_gy_ptr = phi_gx_ptr + phi_vgl_stride;
-    auto* phi_gz_ptr = phi_gy_ptr + phi_vgl_stride;
-    auto* invRow     = invRow_deviceptr_list_ptr[iw];
-
-    ValueType ratio(0), grad_x(0), grad_y(0), grad_z(0);
-    PRAGMA_OFFLOAD("omp parallel for reduction(+: ratio, grad_x, grad_y, grad_z)")
-    for (size_t iorb = 0; iorb < norb_requested; iorb++)
+    auto& spo_leader            = spo_list.getCastedLeader<LCAOrbitalSet>();
+    auto& invRow_deviceptr_list = spo_leader.mw_mem_handle_.getResource().invRow_deviceptr_list;
+    auto& rg_buffer             = spo_leader.mw_mem_handle_.getResource().rg_buffer;
+
+    invRow_deviceptr_list.resize(nw);
+    rg_buffer.resize(4, nw);
+
+    for (size_t iw = 0; iw < nw; iw++)
+      invRow_deviceptr_list[iw] = invRow_ptr_list[iw];
+
+    auto* invRow_deviceptr_list_ptr = invRow_deviceptr_list.data();
+    auto* phi_vgl_v_ptr             = phi_vgl_v.data();
+    auto* rg_buffer_ptr             = rg_buffer.data();
+    const size_t phi_vgl_stride     = nw * norb_requested;
+
+    PRAGMA_OFFLOAD("omp target teams distribute \
+                    map(always,to: invRow_deviceptr_list_ptr[:nw]) \
+                    map(to: phi_vgl_v_ptr[:nw*norb_requested]) \
+                    map(always, from: rg_buffer_ptr[:rg_buffer.size()])")
+    for (size_t iw = 0; iw < nw; iw++)
     {
-      ratio += phi_v_ptr[iorb] * invRow[iorb];
-      grad_x += phi_gx_ptr[iorb] * invRow[iorb];
-      grad_y += phi_gy_ptr[iorb] * invRow[iorb];
-      grad_z += phi_gz_ptr[iorb] * invRow[iorb];
+      auto* phi_v_ptr  = phi_vgl_v_ptr + iw * norb_requested;
+      auto* phi_gx_ptr = phi_v_ptr + phi_vgl_stride;
+      auto* phi_gy_ptr = phi_gx_ptr + phi_vgl_stride;
+      auto* phi_gz_ptr = phi_gy_ptr + phi_vgl_stride;
+      auto* invRow     = invRow_deviceptr_list_ptr[iw];
+
+      ValueType ratio(0), grad_x(0), grad_y(0), grad_z(0);
+      PRAGMA_OFFLOAD("omp parallel for reduction(+: ratio, grad_x, grad_y, grad_z)")
+      for (size_t iorb = 0; iorb < norb_requested; iorb++)
+      {
+        ratio += phi_v_ptr[iorb] * invRow[iorb];
+        grad_x += phi_gx_ptr[iorb] * invRow[iorb];
+        grad_y += phi_gy_ptr[iorb] * invRow[iorb];
+        grad_z += phi_gz_ptr[iorb] * invRow[iorb];
+      }
+
+      rg_buffer_ptr[iw]          = ratio;
+      rg_buffer_ptr[iw + nw]     = grad_x / ratio;
+      rg_buffer_ptr[iw + nw * 2] = grad_y / ratio;
+      rg_buffer_ptr[iw + nw * 3] = grad_z / ratio;
     }
 
-    rg_buffer_ptr[iw]          = ratio;
-    rg_buffer_ptr[iw + nw]     = grad_x / ratio;
-    rg_buffer_ptr[iw + nw * 2] = grad_y / ratio;
-    rg_buffer_ptr[iw + nw * 3] = grad_z / ratio;
-  }
-
-  for (size_t iw = 0; iw < nw; iw++)
-  {
-    ratios[iw] = rg_buffer[0][iw];
-    grads[iw]  = {rg_buffer[1][iw], rg_buffer[2][iw], rg_buffer[3][iw]};
+    for (size_t iw = 0; iw < nw; iw++)
+    {
+      ratios[iw] = rg_buffer[0][iw];
+      grads[iw]  = {rg_buffer[1][iw], rg_buffer[2][iw], rg_buffer[3][iw]};
+    }
+    return;
   }
-#else
+#endif
   for (int iw = 0; iw < nw; iw++)
   {
     ratios[iw] = simd::dot(invRow_ptr_list[iw], phi_vgl_v.data_at(0, iw, 0), norb_requested);
@@ -861,7 +919,6 @@ void LCAOrbitalSet::mw_evaluateVGLandDetRatioGrads(const RefVectorWithLeader<SPO
       dphi[idim] = simd::dot(invRow_ptr_list[iw], phi_vgl_v.data_at(idim + 1, iw, 0), norb_requested) / ratios[iw];
     grads[iw] = dphi;
   }
-#endif
 }
 
 void LCAOrbitalSet::evaluateVGH(const ParticleSet& P, int iat, ValueVector& psi, GradVector& dpsi, HessVector& dhpsi)
@@ -55,6 +55,8 @@ public:
 
   LCAOrbitalSet(const LCAOrbitalSet& in);
 
+  ~LCAOrbitalSet() override;
+
   bool isOMPoffload() const override { return useOMPoffload_; }
 
   std::string getClassName() const final { return "LCAOrbitalSet"; }
@@ -79,6 +81,17 @@ public:
 
   bool isIdentity() const { return Identity; };
 
+  /** enable/disable screening of the basis centers by their cutoff radius in mw_evaluateVGL
+   * Only the centers within their cutoff radius of any walker's electron are evaluated and
+   * only the matching column blocks of C enter the MO GEMM on the host. Not used with Identity or offload.
+   */
+  void setCenterScreening(bool screening) { use_center_screening_ = screening; }
+
+  bool isCenterScreening() const { return use_center_screening_ && !Identity && !useOMPoffload_; }
+
+  /// fraction of the basis functions actually used by the screened MO GEMMs so far, 1 if never screened.
+  double getScreenedBasisFraction() const;
+
   /** check consistency between Identity and C
     *
     */
@@ -229,6 +242,9 @@ public:
   void acquireResource(ResourceCollection& collection, const RefVectorWithLeader<SPOSet>& spo_list) const final;
   void releaseResource(ResourceCollection& collection, const RefVectorWithLeader<SPOSet>& spo_list) const final;
 
+  /// adds the cusp correction on top of the packed walker GEMM
+  friend class LCAOrbitalSetWithCorrection;
+
 protected:
   ///number of Single-particle orbitals
   const IndexType BasisSetSize;
@@ -238,6 +254,8 @@ protected:
   const bool Identity;
   /// whether offload is on or off at runtime.
   const bool useOMPoffload_;
+  /// whether basis centers beyond their cutoff radius are skipped in mw_evaluateVGL
+  bool use_center_screening_;
 
   ///Temp(BasisSetSize) : Row index=V,Gx,Gy,Gz,L
   vgl_type Temp;
@@ -330,6 +348,9 @@ private:
 
   struct LCAOMultiWalkerMem;
   ResourceHandle<LCAOMultiWalkerMem> mw_mem_handle_;
+  /// sparsity statistics of the screened evaluation, shared among clones
+  struct ScreeningStats;
+  std::shared_ptr<ScreeningStats> screening_stats_;
   /// timer for basis set
   NewTimer& basis_timer_;
   /// timer for MO
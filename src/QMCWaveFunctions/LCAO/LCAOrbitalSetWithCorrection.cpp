@@ -11,6 +11,7 @@
 
 
 #include "LCAOrbitalSetWithCorrection.h"
+#include "CPU/SIMD/inner_product.hpp"
 
 namespace qmcplusplus
 {
@@ -19,8 +20,11 @@ LCAOrbitalSetWithCorrection::LCAOrbitalSetWithCorrection(const std::string& my_n
                                                          size_t norbs,
                                                          bool identity,
                                                          ParticleSet& ions,
-                                                         ParticleSet& els)
-    : SPOSet(my_name), lcao(my_name + "_modified", std::move(bs), norbs, identity, false), cusp(ions, els, norbs)
+                                                         ParticleSet& els,
+                                                         bool use_offload)
+    : SPOSet(my_name),
+      lcao(my_name + "_modified", std::move(bs), norbs, identity, use_offload),
+      cusp(ions, els, norbs)
 {
   OrbitalSetSize = norbs;
 }
@@ -52,6 +56,67 @@ void LCAOrbitalSetWithCorrection::evaluateVGL(const ParticleSet& P,
   cusp.add_vector_vgl(P, iat, psi, dpsi, d2psi);
 }
 
+void LCAOrbitalSetWithCorrection::mw_evaluateValue(const RefVectorWithLeader<SPOSet>& spo_list,
+                                                   const RefVectorWithLeader<ParticleSet>& P_list,
+                                                   int iat,
+                                                   const RefVector<ValueVector>& psi_v_list) const
+{
+  assert(this == &spo_list.getLeader());
+  auto& spo_leader = spo_list.getCastedLeader<LCAOrbitalSetWithCorrection>();
+  spo_leader.lcao.mw_evaluateValue(extractLCAORefList(spo_list), P_list, iat, psi_v_list);
+  for (int iw = 0; iw < spo_list.size(); iw++)
+    spo_list.getCastedElement<LCAOrbitalSetWithCorrection>(iw).cusp.addV(P_list[iw], iat, psi_v_list[iw]);
+}
+
+void LCAOrbitalSetWithCorrection::mw_evaluateVGL(const RefVectorWithLeader<SPOSet>& spo_list,
+                                                 const RefVectorWithLeader<ParticleSet>& P_list,
+                                                 int iat,
+                                                 const RefVector<ValueVector>& psi_v_list,
+                                                 const RefVector<GradVector>& dpsi_v_list,
+                                                 const RefVector<ValueVector>& d2psi_v_list) const
+{
+  assert(this == &spo_list.getLeader());
+  auto& spo_leader = spo_list.getCastedLeader<LCAOrbitalSetWithCorrection>();
+  spo_leader.lcao.mw_evaluateVGL(extractLCAORefList(spo_list), P_list, iat, psi_v_list, dpsi_v_list, d2psi_v_list);
+  for (int iw = 0; iw < spo_list.size(); iw++)
+    spo_list.getCastedElement<LCAOrbitalSetWithCorrection>(iw).cusp.add_vector_vgl(P_list[iw], iat, psi_v_list[iw],
+                                                                                    dpsi_v_list[iw],
+                                                                                    d2psi_v_list[iw]);
+}
+
+void LCAOrbitalSetWithCorrection::mw_evaluateVGLandDetRatioGrads(const RefVectorWithLeader<SPOSet>& spo_list,
+                                                                 const RefVectorWithLeader<ParticleSet>& P_list,
+                                                                 int iat,
+                                                                 const std::vector<const ValueType*>& invRow_ptr_list,
+                                                                 OffloadMWVGLArray& phi_vgl_v,
+                                                                 std::vector<ValueType>& ratios,
+                                                                 std::vector<GradType>& grads) const
+{
+  assert(this == &spo_list.getLeader());
+  assert(phi_vgl_v.size(0) == DIM_VGL);
+  assert(phi_vgl_v.size(1) == spo_list.size());
+
+  auto& spo_leader = spo_list.getCastedLeader<LCAOrbitalSetWithCorrection>();
+  // uncorrected orbitals of all the walkers in one GEMM, then the correction is added on the host.
+  // invRow_ptr_list are host pointers since this class is not offloaded as a whole, see isOMPoffload().
+  spo_leader.lcao.mw_evaluateVGLImplGEMM(extractLCAORefList(spo_list), P_list, iat, phi_vgl_v);
+  phi_vgl_v.updateFrom();
+  SoaCuspCorrection::mw_addVGL(extractCuspRefList(spo_list), P_list, iat, phi_vgl_v);
+  // Device data of phi_vgl_v must be up-to-date upon return
+  phi_vgl_v.updateTo();
+
+  const size_t nw             = spo_list.size();
+  const size_t norb_requested = phi_vgl_v.size(2);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    ratios[iw] = simd::dot(invRow_ptr_list[iw], phi_vgl_v.data_at(0, iw, 0), norb_requested);
+    GradType dphi;
+    for (size_t idim = 0; idim < DIM; idim++)
+      dphi[idim] = simd::dot(invRow_ptr_list[iw], phi_vgl_v.data_at(idim + 1, iw, 0), norb_requested) / ratios[iw];
+    grads[iw] = dphi;
+  }
+}
+
 void LCAOrbitalSetWithCorrection::evaluate_notranspose(const ParticleSet& P,
                                                        int first,
                                                        int last,
@@ -64,4 +129,40 @@ void LCAOrbitalSetWithCorrection::evaluate_notranspose(const ParticleSet& P,
     cusp.add_vgl(P, iat, i, logdet, dlogdet, d2logdet);
 }
 
+void LCAOrbitalSetWithCorrection::acquireResource(ResourceCollection& collection,
+                                                  const RefVectorWithLeader<SPOSet>& spo_list) const
+{
+  assert(this == &spo_list.getLeader());
+  auto& spo_leader = spo_list.getCastedLeader<LCAOrbitalSetWithCorrection>();
+  spo_leader.lcao.acquireResource(collection, extractLCAORefList(spo_list));
+}
+
+void LCAOrbitalSetWithCorrection::releaseResource(ResourceCollection& collection,
+                                                  const RefVectorWithLeader<SPOSet>& spo_list) const
+{
+  assert(this == &spo_list.getLeader());
+  auto& spo_leader = spo_list.getCastedLeader<LCAOrbitalSetWithCorrection>();
+  spo_leader.lcao.releaseResource(collection, extractLCAORefList(spo_list));
+}
+
+RefVectorWithLeader<SPOSet> LCAOrbitalSetWithCorrection::extractLCAORefList(
+    const RefVectorWithLeader<SPOSet>& spo_list)
+{
+  RefVectorWithLeader<SPOSet> lcao_list(spo_list.getCastedLeader<LCAOrbitalSetWithCorrection>().lcao);
+  lcao_list.reserve(spo_list.size());
+  for (size_t iw = 0; iw < spo_list.size(); iw++)
+    lcao_list.push_back(spo_list.getCastedElement<LCAOrbitalSetWithCorrection>(iw).lcao);
+  return lcao_list;
+}
+
+RefVectorWithLeader<SoaCuspCorrection> LCAOrbitalSetWithCorrection::extractCuspRefList(
+    const RefVectorWithLeader<SPOSet>& spo_list)
+{
+  RefVectorWithLeader<SoaCuspCorrection> cusp_list(spo_list.getCastedLeader<LCAOrbitalSetWithCorrection>().cusp);
+  cusp_list.reserve(spo_list.size());
+  for (size_t iw = 0; iw < spo_list.size(); iw++)
+    cusp_list.push_back(spo_list.getCastedElement<LCAOrbitalSetWithCorrection>(iw).cusp);
+  return cusp_list;
+}
+
 } // namespace qmcplusplus
@@ -35,14 +35,15 @@ public:
      * @param identity if true, the MO coefficients matrix is identity
      * @param ions
      * @param els
-     * @param rl report level
+     * @param use_offload if true, the uncorrected orbitals of a batch of walkers are evaluated with offload
      */
   LCAOrbitalSetWithCorrection(const std::string& my_name,
                               std::unique_ptr<basis_type>&& bs,
                               size_t norbs,
                               bool identity,
                               ParticleSet& ions,
-                              ParticleSet& els);
+                              ParticleSet& els,
+                              bool use_offload = false);
 
   LCAOrbitalSetWithCorrection(const LCAOrbitalSetWithCorrection& in) = default;
 
@@ -56,6 +57,26 @@ public:
 
   void evaluateVGL(const ParticleSet& P, int iat, ValueVector& psi, GradVector& dpsi, ValueVector& d2psi) final;
 
+  void mw_evaluateValue(const RefVectorWithLeader<SPOSet>& spo_list,
+                        const RefVectorWithLeader<ParticleSet>& P_list,
+                        int iat,
+                        const RefVector<ValueVector>& psi_v_list) const final;
+
+  void mw_evaluateVGL(const RefVectorWithLeader<SPOSet>& spo_list,
+                      const RefVectorWithLeader<ParticleSet>& P_list,
+                      int iat,
+                      const RefVector<ValueVector>& psi_v_list,
+                      const RefVector<GradVector>& dpsi_v_list,
+                      const RefVector<ValueVector>& d2psi_v_list) const final;
+
+  void mw_evaluateVGLandDetRatioGrads(const RefVectorWithLeader<SPOSet>& spo_list,
+                                      const RefVectorWithLeader<ParticleSet>& P_list,
+                                      int iat,
+                                      const std::vector<const ValueType*>& invRow_ptr_list,
+                                      OffloadMWVGLArray& phi_vgl_v,
+                                      std::vector<ValueType>& ratios,
+                                      std::vector<GradType>& grads) const final;
+
   void evaluate_notranspose(const ParticleSet& P,
                             int first,
                             int last,
@@ -69,12 +90,21 @@ public:
     lcao.finalizeConstruction();
   }
 
+  void createResource(ResourceCollection& collection) const final { lcao.createResource(collection); }
+  void acquireResource(ResourceCollection& collection, const RefVectorWithLeader<SPOSet>& spo_list) const final;
+  void releaseResource(ResourceCollection& collection, const RefVectorWithLeader<SPOSet>& spo_list) const final;
+
   friend class LCAOrbitalBuilder;
 
 private:
   LCAOrbitalSet lcao;
 
   SoaCuspCorrection cusp;
+
+  /// helper function for extracting a list of the uncorrected orbital sets
+  static RefVectorWithLeader<SPOSet> extractLCAORefList(const RefVectorWithLeader<SPOSet>& spo_list);
+  /// helper function for extracting a list of the cusp corrections
+  static RefVectorWithLeader<SoaCuspCorrection> extractCuspRefList(const RefVectorWithLeader<SPOSet>& spo_list);
 };
 } // namespace qmcplusplus
 #endif
@@ -20,6 +20,11 @@
 
 namespace qmcplusplus
 {
+namespace testing
+{
+class TestSoaAtomicBasisSet;
+}
+
 /* A basis set for a center type 
    *
    * @tparam ROT : radial function type, e.g.,NGFunctor<T>
@@ -124,6 +129,9 @@ public:
     Rmax = (rmax > 0) ? rmax : MultiRnl.rmax();
   }
 
+  /// return the cutoff radius beyond which all the basis functions of this center vanish
+  inline RealType getRmax() const { return Rmax; }
+
   ///set the current offset
   inline void setCenter(int c, int offset) {}
 
@@ -734,6 +742,7 @@ public:
    * @param [in] center_idx current center index (for indexing into displ_list)
    * @param [in] BasisOffset index of first basis function of this center (for indexing into psi_vgl)
    * @param [in] NumCenters total number of centers in system (for indexing into displ_list)
+   * @param [in] use_offload if false, the electrons are processed in tiles on the host
    *  
   */
 
@@ -747,7 +756,8 @@ public:
                              const size_t nBasTot,
                              const size_t center_idx,
                              const size_t BasisOffset,
-                             const size_t NumCenters)
+                             const size_t NumCenters,
+                             const bool use_offload)
   {
     assert(this == &atom_bs_list.getLeader());
     auto& atom_bs_leader = atom_bs_list.template getCastedLeader<SoaAtomicBasisSet<ROT, SH>>();
@@ -761,6 +771,17 @@ public:
     assert(psi_vgl.size(1) == nElec);
     assert(psi_vgl.size(2) == nBasTot);
 
+    if (!use_offload)
+    {
+      // the radial and angular parts of a tile of electrons are evaluated and contracted in a single pass
+      ScopedTimer local_timer(psi_timer_);
+      const RealType* displ_center = displ_list.data() + 3 * nElec * center_idx;
+      const RealType* Tv_center    = Tv_list.data() + 3 * nElec * center_idx;
+      for (size_t first = 0; first < nElec; first += HostElecTileSize)
+        evaluateVGLTile(atom_bs_leader.mw_mem_handle_.getResource(), psi_vgl, displ_center, Tv_center, BasisOffset,
+                        first, std::min(HostElecTileSize, nElec - first));
+      return;
+    }
 
     auto& ylm_vgl = atom_bs_leader.mw_mem_handle_.getResource().ylm_vgl;
     auto& rnl_vgl = atom_bs_leader.mw_mem_handle_.getResource().rnl_vgl;
@@ -942,6 +963,7 @@ public:
    * @param [in] center_idx current center index (for indexing into displ_list)
    * @param [in] BasisOffset index of first basis function of this center (for indexing into psi)
    * @param [in] NumCenters total number of centers in system (for indexing into displ_list)
+   * @param [in] use_offload if false, the electrons are processed in tiles on the host
    *  
   */
   template<typename LAT, typename VT>
@@ -954,7 +976,8 @@ public:
                            const size_t nBasTot,
                            const size_t center_idx,
                            const size_t BasisOffset,
-                           const size_t NumCenters)
+                           const size_t NumCenters,
+                           const bool use_offload)
   {
     assert(this == &atom_bs_list.getLeader());
     auto& atom_bs_leader = atom_bs_list.template getCastedLeader<SoaAtomicBasisSet<ROT, SH>>();
@@ -967,6 +990,17 @@ public:
     assert(psi.size(0) == nElec);
     assert(psi.size(1) == nBasTot);
 
+    if (!use_offload)
+    {
+      // the radial and angular parts of a tile of electrons are evaluated and contracted in a single pass
+      ScopedTimer local_timer(psi_timer_);
+      const RealType* displ_center = displ_list.data() + 3 * nElec * center_idx;
+      const RealType* Tv_center    = Tv_list.data() + 3 * nElec * center_idx;
+      for (size_t first = 0; first < nElec; first += HostElecTileSize)
+        evaluateVTile(atom_bs_leader.mw_mem_handle_.getResource(), psi, displ_center, Tv_center, BasisOffset, first,
+                      std::min(HostElecTileSize, nElec - first));
+      return;
+    }
 
     auto& ylm_v = atom_bs_leader.mw_mem_handle_.getResource().ylm_v;
     auto& rnl_v = atom_bs_leader.mw_mem_handle_.getResource().rnl_v;
@@ -1104,6 +1138,9 @@ public:
   }
 
 private:
+  /// number of electrons processed together by the fused batched kernels on the host
+  static constexpr size_t HostElecTileSize = 16;
+
   /// multi walker shared memory buffer
   struct SoaAtomicBSetMultiWalkerMem : public Resource
   {
@@ -1123,8 +1160,238 @@ private:
     OffloadArray3D dr;          // [Nelec][PBC][xyz] ion->elec displacement for each image
     OffloadArray2D r;           // [Nelec][PBC]      ion->elec distance for each image
     OffloadVector correctphase; // [Nelec]           overall phase
+
+    // host tile buffers, the electrons of the tile are the fastest index
+    Array<RealType, 2> tile_xyz;  // [x,y,z,1/r][Ntile] ion->elec displacement for the current image
+    Array<RealType, 3> tile_rnl;  // [3][NRnl][Ntile]
+    Array<RealType, 3> tile_ylm;  // [5][NYlm][Ntile]
+    Array<ValueType, 3> tile_psi; // [5][NBasis][Ntile]
+    Vector<ValueType> tile_phase; // [Ntile]            overall phase
   };
 
+  /** fill the overall phase and the ion->elec displacements of the tile buffers for one periodic image
+   * @param displ displacement from each electron to this center [nElec, 3]
+   * @param Tv translation vectors for the overall phase [nElec, 3]
+   * @return true if any electron of the tile is within Rmax of this image
+   */
+  bool prepareTile(SoaAtomicBSetMultiWalkerMem& mem,
+                   const RealType* restrict displ,
+                   const RealType* restrict Tv,
+                   const size_t first,
+                   const size_t nTile,
+                   const int i_xyz)
+  {
+    RealType* restrict x    = mem.tile_xyz.data_at(0, 0);
+    RealType* restrict y    = mem.tile_xyz.data_at(1, 0);
+    RealType* restrict z    = mem.tile_xyz.data_at(2, 0);
+    RealType* restrict rinv = mem.tile_xyz.data_at(3, 0);
+    const auto* image       = periodic_image_displacements_.data() + 3 * i_xyz;
+
+    if (i_xyz == 0)
+      for (size_t i_e = 0; i_e < nTile; i_e++)
+      {
+#if not defined(QMC_COMPLEX)
+        mem.tile_phase[i_e] = 1.0;
+#else
+        RealType phasearg = 0;
+        for (size_t i_dim = 0; i_dim < 3; i_dim++)
+          phasearg += SuperTwist[i_dim] * Tv[i_dim + 3 * (first + i_e)];
+        RealType s, c;
+        qmcplusplus::sincos(-phasearg, &s, &c);
+        mem.tile_phase[i_e] = ValueType(c, s);
+#endif
+      }
+
+    bool in_range = false;
+    for (size_t i_e = 0; i_e < nTile; i_e++)
+    {
+      x[i_e]           = -(displ[3 * (first + i_e)] + image[0]);
+      y[i_e]           = -(displ[3 * (first + i_e) + 1] + image[1]);
+      z[i_e]           = -(displ[3 * (first + i_e) + 2] + image[2]);
+      const RealType r = std::sqrt(x[i_e] * x[i_e] + y[i_e] * y[i_e] + z[i_e] * z[i_e]);
+      // the electrons beyond Rmax get rinv = 0 and vanishing radial functions
+      rinv[i_e] = r < Rmax ? RealType(1) / r : RealType(0);
+      in_range  = in_range || r < Rmax;
+    }
+    return in_range;
+  }
+
+  /** evaluate VGL of the basis functions of this center for a tile of electrons on the host
+   *
+   * For each periodic image, the radial functions and the angular parts of the nTile electrons are evaluated
+   * into small tile buffers and contracted right away into the tile of basis values, with the electrons as the
+   * innermost, vectorized loop. The result is written into psi_vgl once all the images are accumulated.
+   */
+  template<typename VT>
+  void evaluateVGLTile(SoaAtomicBSetMultiWalkerMem& mem,
+                       Array<VT, 3, OffloadPinnedAllocator<VT>>& psi_vgl,
+                       const RealType* restrict displ,
+                       const RealType* restrict Tv,
+                       const size_t BasisOffset,
+                       const size_t first,
+                       const size_t nTile)
+  {
+    constexpr RealType ctwo(2);
+    const size_t nRnl      = RnlID.size();
+    const size_t nYlm      = Ylm.size();
+    const size_t bset_size = BasisSetSize;
+    const int Nxyz         = (PBCImages[0] + 1) * (PBCImages[1] + 1) * (PBCImages[2] + 1);
+
+    mem.tile_xyz.resize(4, HostElecTileSize);
+    mem.tile_rnl.resize(3, nRnl, HostElecTileSize);
+    mem.tile_ylm.resize(5, nYlm, HostElecTileSize);
+    mem.tile_psi.resize(5, bset_size, HostElecTileSize);
+    mem.tile_phase.resize(HostElecTileSize);
+    std::fill(mem.tile_psi.begin(), mem.tile_psi.end(), ValueType(0));
+
+    const RealType* restrict x    = mem.tile_xyz.data_at(0, 0);
+    const RealType* restrict y    = mem.tile_xyz.data_at(1, 0);
+    const RealType* restrict z    = mem.tile_xyz.data_at(2, 0);
+    const RealType* restrict rinv = mem.tile_xyz.data_at(3, 0);
+    const ValueType* restrict correctphase = mem.tile_phase.data();
+
+    for (int i_xyz = 0; i_xyz < Nxyz; i_xyz++)
+    {
+      if (!prepareTile(mem, displ, Tv, first, nTile, i_xyz))
+        continue;
+
+      for (size_t i_e = 0; i_e < nTile; i_e++)
+      {
+        if (rinv[i_e] > 0)
+          MultiRnl.evaluate(RealType(1) / rinv[i_e], tempS.data(0), tempS.data(1), tempS.data(2));
+        else
+          for (size_t i_comp = 0; i_comp < 3; i_comp++)
+            std::fill_n(tempS.data(i_comp), nRnl, RealType(0));
+        for (size_t i_comp = 0; i_comp < 3; i_comp++)
+          for (size_t nl = 0; nl < nRnl; nl++)
+            mem.tile_rnl(i_comp, nl, i_e) = tempS.data(i_comp)[nl];
+
+        Ylm.evaluateVGL(x[i_e], y[i_e], z[i_e]);
+        for (size_t i_comp = 0; i_comp < 5; i_comp++)
+          for (size_t lm = 0; lm < nYlm; lm++)
+            mem.tile_ylm(i_comp, lm, i_e) = Ylm[i_comp][lm];
+      }
+
+      ///Phase for PBC containing the phase for the nearest image displacement and the correction due to the Distance table.
+      const ValueType image_phase = periodic_image_phase_factors_[i_xyz];
+      for (size_t ib = 0; ib < bset_size; ++ib)
+      {
+        const RealType* restrict phi   = mem.tile_rnl.data_at(0, NL[ib], 0);
+        const RealType* restrict dphi  = mem.tile_rnl.data_at(1, NL[ib], 0);
+        const RealType* restrict d2phi = mem.tile_rnl.data_at(2, NL[ib], 0);
+        const RealType* restrict ylm_v = mem.tile_ylm.data_at(0, LM[ib], 0);
+        const RealType* restrict ylm_x = mem.tile_ylm.data_at(1, LM[ib], 0);
+        const RealType* restrict ylm_y = mem.tile_ylm.data_at(2, LM[ib], 0);
+        const RealType* restrict ylm_z = mem.tile_ylm.data_at(3, LM[ib], 0);
+        const RealType* restrict ylm_l = mem.tile_ylm.data_at(4, LM[ib], 0);
+        ValueType* restrict psi        = mem.tile_psi.data_at(0, ib, 0);
+        ValueType* restrict dpsi_x     = mem.tile_psi.data_at(1, ib, 0);
+        ValueType* restrict dpsi_y     = mem.tile_psi.data_at(2, ib, 0);
+        ValueType* restrict dpsi_z     = mem.tile_psi.data_at(3, ib, 0);
+        ValueType* restrict d2psi      = mem.tile_psi.data_at(4, ib, 0);
+
+#pragma omp simd
+        for (size_t i_e = 0; i_e < nTile; i_e++)
+        {
+          const ValueType Phase    = image_phase * correctphase[i_e];
+          const RealType drnloverr = rinv[i_e] * dphi[i_e];
+          const RealType ang       = ylm_v[i_e];
+          const RealType gr_x      = drnloverr * x[i_e];
+          const RealType gr_y      = drnloverr * y[i_e];
+          const RealType gr_z      = drnloverr * z[i_e];
+          const RealType vr        = phi[i_e];
+
+          psi[i_e] += ang * vr * Phase;
+          dpsi_x[i_e] += (ang * gr_x + vr * ylm_x[i_e]) * Phase;
+          dpsi_y[i_e] += (ang * gr_y + vr * ylm_y[i_e]) * Phase;
+          dpsi_z[i_e] += (ang * gr_z + vr * ylm_z[i_e]) * Phase;
+          d2psi[i_e] += (ang * (ctwo * drnloverr + d2phi[i_e]) +
+                         ctwo * (gr_x * ylm_x[i_e] + gr_y * ylm_y[i_e] + gr_z * ylm_z[i_e]) + vr * ylm_l[i_e]) *
+              Phase;
+        }
+      }
+    }
+
+    for (size_t i_comp = 0; i_comp < 5; i_comp++)
+      for (size_t i_e = 0; i_e < nTile; i_e++)
+      {
+        VT* restrict out = psi_vgl.data_at(i_comp, first + i_e, BasisOffset);
+        for (size_t ib = 0; ib < bset_size; ++ib)
+          out[ib] = mem.tile_psi(i_comp, ib, i_e);
+      }
+  }
+
+  /** evaluate the values of the basis functions of this center for a tile of electrons on the host
+   *
+   * Same fused scheme as evaluateVGLTile.
+   */
+  template<typename VT>
+  void evaluateVTile(SoaAtomicBSetMultiWalkerMem& mem,
+                     Array<VT, 2, OffloadPinnedAllocator<VT>>& psi,
+                     const RealType* restrict displ,
+                     const RealType* restrict Tv,
+                     const size_t BasisOffset,
+                     const size_t first,
+                     const size_t nTile)
+  {
+    const size_t nRnl      = RnlID.size();
+    const size_t nYlm      = Ylm.size();
+    const size_t bset_size = BasisSetSize;
+    const int Nxyz         = (PBCImages[0] + 1) * (PBCImages[1] + 1) * (PBCImages[2] + 1);
+
+    mem.tile_xyz.resize(4, HostElecTileSize);
+    mem.tile_rnl.resize(1, nRnl, HostElecTileSize);
+    mem.tile_ylm.resize(1, nYlm, HostElecTileSize);
+    mem.tile_psi.resize(1, bset_size, HostElecTileSize);
+    mem.tile_phase.resize(HostElecTileSize);
+    std::fill(mem.tile_psi.begin(), mem.tile_psi.end(), ValueType(0));
+
+    const RealType* restrict x    = mem.tile_xyz.data_at(0, 0);
+    const RealType* restrict y    = mem.tile_xyz.data_at(1, 0);
+    const RealType* restrict z    = mem.tile_xyz.data_at(2, 0);
+    const RealType* restrict rinv = mem.tile_xyz.data_at(3, 0);
+    const ValueType* restrict correctphase = mem.tile_phase.data();
+
+    for (int i_xyz = 0; i_xyz < Nxyz; i_xyz++)
+    {
+      if (!prepareTile(mem, displ, Tv, first, nTile, i_xyz))
+        continue;
+
+      for (size_t i_e = 0; i_e < nTile; i_e++)
+      {
+        if (rinv[i_e] > 0)
+          MultiRnl.evaluate(RealType(1) / rinv[i_e], tempS.data(0));
+        else
+          std::fill_n(tempS.data(0), nRnl, RealType(0));
+        for (size_t nl = 0; nl < nRnl; nl++)
+          mem.tile_rnl(0, nl, i_e) = tempS.data(0)[nl];
+
+        Ylm.evaluateV(x[i_e], y[i_e], z[i_e]);
+        for (size_t lm = 0; lm < nYlm; lm++)
+          mem.tile_ylm(0, lm, i_e) = Ylm[0][lm];
+      }
+
+      ///Phase for PBC containing the phase for the nearest image displacement and the correction due to the Distance table.
+      const ValueType image_phase = periodic_image_phase_factors_[i_xyz];
+      for (size_t ib = 0; ib < bset_size; ++ib)
+      {
+        const RealType* restrict phi   = mem.tile_rnl.data_at(0, NL[ib], 0);
+        const RealType* restrict ylm_v = mem.tile_ylm.data_at(0, LM[ib], 0);
+        ValueType* restrict psi_tile   = mem.tile_psi.data_at(0, ib, 0);
+#pragma omp simd
+        for (size_t i_e = 0; i_e < nTile; i_e++)
+          psi_tile[i_e] += ylm_v[i_e] * phi[i_e] * (image_phase * correctphase[i_e]);
+      }
+    }
+
+    for (size_t i_e = 0; i_e < nTile; i_e++)
+    {
+      VT* restrict out = psi.data_at(first + i_e, BasisOffset);
+      for (size_t ib = 0; ib < bset_size; ++ib)
+        out[ib] = mem.tile_psi(0, ib, i_e);
+    }
+  }
+
   /// multi walker resource handle
   ResourceHandle<SoaAtomicBSetMultiWalkerMem> mw_mem_handle_;
   ///size of the basis set
@@ -1171,6 +1438,7 @@ private:
   friend class AOBasisBuilder;
   template<typename COT>
   friend class RadialOrbitalSetBuilder;
+  friend class testing::TestSoaAtomicBasisSet;
 };
 
 } // namespace qmcplusplus
@@ -24,21 +24,37 @@ SoaCuspCorrection::SoaCuspCorrection(ParticleSet& ions, ParticleSet& els, size_t
   NumTargets = els.getTotalNum();
   LOBasisSet.resize(NumCenters);
   myVGL.resize(5, MaxOrbSize);
+  myRadialScratch.resize(3, MaxOrbSize);
 }
 
 SoaCuspCorrection::SoaCuspCorrection(const SoaCuspCorrection& a) = default;
 
-inline void SoaCuspCorrection::evaluateVGL(const ParticleSet& P, int iat, VGLVector& vgl)
+inline bool SoaCuspCorrection::accumulateVGL(const ParticleSet& P, int iat, size_t norbs)
 {
-  assert(MaxOrbSize >= vgl.size());
-  myVGL = 0.0;
-
   const auto& d_table = P.getDistTableAB(myTableIndex);
   const auto& dist    = (P.getActivePtcl() == iat) ? d_table.getTempDists() : d_table.getDistRow(iat);
   const auto& displ   = (P.getActivePtcl() == iat) ? d_table.getTempDispls() : d_table.getDisplRow(iat);
+
+  bool touched = false;
   for (int c = 0; c < NumCenters; c++)
-    if (LOBasisSet[c])
-      LOBasisSet[c]->evaluate_vgl(dist[c], displ[c], myVGL[0], myVGL[1], myVGL[2], myVGL[3], myVGL[4]);
+    if (LOBasisSet[c] && dist[c] < LOBasisSet[c]->getRmax())
+    {
+      if (!touched)
+      {
+        std::fill_n(myVGL.data(), myVGL.size(), 0.0);
+        touched = true;
+      }
+      LOBasisSet[c]->evaluate_vgl(dist[c], displ[c], norbs, myVGL[0], myVGL[1], myVGL[2], myVGL[3], myVGL[4],
+                                  myRadialScratch.data());
+    }
+  return touched;
+}
+
+inline void SoaCuspCorrection::evaluateVGL(const ParticleSet& P, int iat, VGLVector& vgl)
+{
+  assert(MaxOrbSize >= vgl.size());
+  if (!accumulateVGL(P, iat, vgl.size()))
+    return;
 
   {
     const auto v_in  = myVGL[0];
@@ -69,14 +85,8 @@ void SoaCuspCorrection::evaluate_vgl(const ParticleSet& P,
                                      ValueVector& d2psi)
 {
   assert(MaxOrbSize >= psi.size());
-  myVGL = 0.0;
-
-  const auto& d_table = P.getDistTableAB(myTableIndex);
-  const auto& dist    = (P.getActivePtcl() == iat) ? d_table.getTempDists() : d_table.getDistRow(iat);
-  const auto& displ   = (P.getActivePtcl() == iat) ? d_table.getTempDispls() : d_table.getDisplRow(iat);
-  for (int c = 0; c < NumCenters; c++)
-    if (LOBasisSet[c])
-      LOBasisSet[c]->evaluate_vgl(dist[c], displ[c], myVGL[0], myVGL[1], myVGL[2], myVGL[3], myVGL[4]);
+  if (!accumulateVGL(P, iat, psi.size()))
+    return;
 
   const auto v_in  = myVGL[0];
   const auto gx_in = myVGL[1];
@@ -101,14 +111,8 @@ void SoaCuspCorrection::evaluate_vgl(const ParticleSet& P,
                                      ValueMatrix& d2psi)
 {
   assert(MaxOrbSize >= psi.cols());
-  myVGL = 0.0;
-
-  const auto& d_table = P.getDistTableAB(myTableIndex);
-  const auto& dist    = (P.getActivePtcl() == iat) ? d_table.getTempDists() : d_table.getDistRow(iat);
-  const auto& displ   = (P.getActivePtcl() == iat) ? d_table.getTempDispls() : d_table.getDisplRow(iat);
-  for (int c = 0; c < NumCenters; c++)
-    if (LOBasisSet[c])
-      LOBasisSet[c]->evaluate_vgl(dist[c], displ[c], myVGL[0], myVGL[1], myVGL[2], myVGL[3], myVGL[4]);
+  if (!accumulateVGL(P, iat, psi.cols()))
+    return;
 
   const auto v_in  = myVGL[0];
   const auto gx_in = myVGL[1];
@@ -128,22 +132,40 @@ void SoaCuspCorrection::evaluate_vgl(const ParticleSet& P,
 void SoaCuspCorrection::evaluateV(const ParticleSet& P, int iat, ValueVector& psi)
 {
   assert(MaxOrbSize >= psi.size());
-  ValueType* tmp_vals = myVGL[0];
-
-  std::fill_n(tmp_vals, myVGL.size(), 0.0);
 
   const auto& d_table = P.getDistTableAB(myTableIndex);
   const auto& dist    = (P.getActivePtcl() == iat) ? d_table.getTempDists() : d_table.getDistRow(iat);
 
-  //THIS IS SERIAL, only way to avoid this is to use myVGL
+  // values are accumulated directly into psi
   for (int c = 0; c < NumCenters; c++)
     if (LOBasisSet[c])
-      LOBasisSet[c]->evaluate(dist[c], tmp_vals);
+      LOBasisSet[c]->evaluate(dist[c], psi.size(), psi.data(), myRadialScratch.data());
+}
 
-  { //collect
-    const auto v_in = myVGL[0];
-    for (size_t i = 0; i < psi.size(); ++i)
-      psi[i] += v_in[i];
+void SoaCuspCorrection::mw_addVGL(const RefVectorWithLeader<SoaCuspCorrection>& cusp_list,
+                                  const RefVectorWithLeader<ParticleSet>& P_list,
+                                  int iat,
+                                  OffloadMWVGLArray& phi_vgl_v)
+{
+  const size_t nw    = cusp_list.size();
+  const size_t norbs = phi_vgl_v.size(2);
+  assert(phi_vgl_v.size(0) == 5);
+  assert(phi_vgl_v.size(1) == nw);
+
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    auto& cusp = cusp_list[iw];
+    assert(cusp.MaxOrbSize >= norbs);
+    const auto& d_table = P_list[iw].getDistTableAB(cusp.myTableIndex);
+    const auto& dist    = (P_list[iw].getActivePtcl() == iat) ? d_table.getTempDists() : d_table.getDistRow(iat);
+    const auto& displ   = (P_list[iw].getActivePtcl() == iat) ? d_table.getTempDispls() : d_table.getDisplRow(iat);
+    // [VGL, walker, Orbs] layout, accumulate directly without intermediate storage
+    for (int c = 0; c < cusp.NumCenters; c++)
+      if (cusp.LOBasisSet[c])
+        cusp.LOBasisSet[c]->evaluate_vgl(dist[c], displ[c], norbs, phi_vgl_v.data_at(0, iw, 0),
+                                         phi_vgl_v.data_at(1, iw, 0), phi_vgl_v.data_at(2, iw, 0),
+                                         phi_vgl_v.data_at(3, iw, 0), phi_vgl_v.data_at(4, iw, 0),
+                                         cusp.myRadialScratch.data());
   }
 }
 
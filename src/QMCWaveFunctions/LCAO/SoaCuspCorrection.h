@@ -41,6 +41,8 @@ class SoaCuspCorrection
   using ValueVector = SPOSet::ValueVector;
   using PosType     = ParticleSet::PosType;
 
+  using OffloadMWVGLArray = SPOSet::OffloadMWVGLArray;
+
   ///number of centers, e.g., ions
   size_t NumCenters;
   ///number of quantum particles
@@ -63,6 +65,13 @@ class SoaCuspCorrection
   std::vector<std::shared_ptr<const COT>> LOBasisSet;
 
   Matrix<RealType> myVGL;
+  /// scratch for the radial functions of one center, shared by all the centers
+  Matrix<RealType> myRadialScratch;
+
+  /** accumulate the VGL of the first norbs orbitals from all the centers within their cutoff into myVGL
+   * @return false if no center is within its cutoff and myVGL is untouched
+   */
+  bool accumulateVGL(const ParticleSet& P, int iat, size_t norbs);
 
 public:
   /** constructor
@@ -93,6 +102,17 @@ public:
    */
   void evaluateV(const ParticleSet& P, int iat, ValueVector& psi);
 
+  /** add the correction of electron iat to a batch of walkers
+   * @param cusp_list a batch of SoaCuspCorrection
+   * @param P_list a batch of quantum particlesets
+   * @param iat active particle
+   * @param phi_vgl_v [VGL, walker, Orbs] values, gradients and laplacians, accumulated
+   */
+  static void mw_addVGL(const RefVectorWithLeader<SoaCuspCorrection>& cusp_list,
+                        const RefVectorWithLeader<ParticleSet>& P_list,
+                        int iat,
+                        OffloadMWVGLArray& phi_vgl_v);
+
   /** add a new set of Centered Atomic Orbitals
    * @param icenter the index of the center
    * @param aos a set of Centered Atomic Orbitals
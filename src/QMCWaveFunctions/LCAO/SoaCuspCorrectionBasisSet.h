@@ -59,50 +59,63 @@ public:
     AOs.add_spline(mo_idx, radial_spline);
   }
 
-  inline void evaluate(const T r, T* restrict vals) const
+  /// cutoff radius beyond which the correction vanishes
+  inline QMCT::RealType getRmax() const { return r_max_; }
+
+  /** accumulate the corrections to the first norbs orbitals
+   * @param r distance to the center
+   * @param norbs number of orbitals accumulated in vals
+   * @param vals values, accumulated
+   * @param scratch buffer of at least getNumOrbs() elements
+   * @return false if r is beyond the cutoff and vals is untouched
+   */
+  inline bool evaluate(const T r, const size_t norbs, T* restrict vals, T* restrict scratch) const
   {
-    //assume output vars are zero'd
     if (r >= r_max_)
-      return;
+      return false;
 
-    size_t nr = AOs.getNumSplines();
-    //FIXME ad-hoc allocation for performance
-    std::vector<T> phi(nr);
-
-    AOs.evaluate(r, phi.data());
-    for (size_t i = 0; i < nr; ++i)
-      //vals[ID[i]]+=phi[i];
-      vals[i] += phi[i];
+    assert(norbs <= AOs.getNumSplines());
+    AOs.evaluate(r, scratch);
+    for (size_t i = 0; i < norbs; ++i)
+      vals[i] += scratch[i];
+    return true;
   }
 
-  inline void evaluate_vgl(const T r,
+  /** accumulate the corrections to the value, gradient and laplacian of the first norbs orbitals
+   * @param scratch buffer of at least 3*getNumOrbs() elements
+   * @return false if r is beyond the cutoff and the outputs are untouched
+   */
+  inline bool evaluate_vgl(const T r,
                            const PosType& dr,
+                           const size_t norbs,
                            T* restrict u,
                            T* restrict du_x,
                            T* restrict du_y,
                            T* restrict du_z,
-                           T* restrict d2u) const
+                           T* restrict d2u,
+                           T* restrict scratch) const
   {
-    //assume output vars are zero'd
     if (r >= r_max_)
-      return;
+      return false;
 
-    size_t nr = AOs.getNumSplines();
-    //FIXME ad-hoc allocation for performance
-    std::vector<T> phi(nr);
-    std::vector<T> dphi(nr);
-    std::vector<T> d2phi(nr);
+    const size_t nr = AOs.getNumSplines();
+    assert(norbs <= nr);
+    T* restrict phi   = scratch;
+    T* restrict dphi  = scratch + nr;
+    T* restrict d2phi = scratch + 2 * nr;
 
-    AOs.evaluate(r, phi.data(), dphi.data(), d2phi.data());
-    for (size_t i = 0; i < nr; ++i)
+    AOs.evaluate(r, phi, dphi, d2phi);
+    const T rinv = T(1) / r;
+    for (size_t i = 0; i < norbs; ++i)
     {
-      const size_t j = i; //ID[i];
-      u[j] += phi[i];
-      du_x[j] -= dphi[i] * dr[0] / r; // Displacements have opposite sign (relative to AOS)
-      du_y[j] -= dphi[i] * dr[1] / r;
-      du_z[j] -= dphi[i] * dr[2] / r;
-      d2u[j] += d2phi[i] + 2 * dphi[i] / r;
+      const T dphi_r = dphi[i] * rinv;
+      u[i] += phi[i];
+      du_x[i] -= dphi_r * dr[0]; // Displacements have opposite sign (relative to AOS)
+      du_y[i] -= dphi_r * dr[1];
+      du_z[i] -= dphi_r * dr[2];
+      d2u[i] += d2phi[i] + 2 * dphi_r;
     }
+    return true;
   }
 };
 } // namespace qmcplusplus
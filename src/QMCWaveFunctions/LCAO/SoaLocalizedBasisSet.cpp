@@ -11,6 +11,7 @@
 
 
 #include <memory>
+#include <algorithm>
 #include "SoaLocalizedBasisSet.h"
 #include "Particle/DistanceTable.h"
 #include "SoaAtomicBasisSet.h"
@@ -35,6 +36,8 @@ struct SoaLocalizedBasisSet<COT, ORBT>::SoaLocalizedBSetMultiWalkerMem : public
 
   Vector<RealType, OffloadPinnedAllocator<RealType>> Tv_list;
   Vector<RealType, OffloadPinnedAllocator<RealType>> displ_list_tr;
+  /// centers within the cutoff radius of at least one walker, used by mw_evaluateVGLScreened
+  std::vector<bool> is_active_center;
 };
 
 template<class COT, typename ORBT>
@@ -95,7 +98,8 @@ template<class COT, typename ORBT>
 SoaLocalizedBasisSet<COT, ORBT>::SoaLocalizedBasisSet(ParticleSet& ions, ParticleSet& els)
     : ions_(ions),
       myTableIndex(els.addTable(ions, DTModes::NEED_FULL_TABLE_ANYTIME | DTModes::NEED_VP_FULL_TABLE_ON_HOST)),
-      SuperTwist(0.0)
+      SuperTwist(0.0),
+      use_offload_(false)
 {
   NumCenters = ions.getTotalNum();
   NumTargets = els.getTotalNum();
@@ -112,7 +116,8 @@ SoaLocalizedBasisSet<COT, ORBT>::SoaLocalizedBasisSet(const SoaLocalizedBasisSet
       ions_(a.ions_),
       myTableIndex(a.myTableIndex),
       SuperTwist(a.SuperTwist),
-      BasisOffset(a.BasisOffset)
+      BasisOffset(a.BasisOffset),
+      use_offload_(a.use_offload_)
 {
   LOBasisSet.reserve(a.LOBasisSet.size());
   for (auto& elem : a.LOBasisSet)
@@ -252,10 +257,80 @@ void SoaLocalizedBasisSet<COT, ORBT>::mw_evaluateVGL(const RefVectorWithLeader<S
   {
     auto one_species_basis_list = extractOneSpeciesBasisRefList(basis_list, IonID[c]);
     LOBasisSet[IonID[c]]->mw_evaluateVGL(one_species_basis_list, pset_leader.getLattice(), vgl_v, displ_list_tr,
-                                         Tv_list, Nw, BasisSetSize, c, BasisOffset[c], NumCenters);
+                                         Tv_list, Nw, BasisSetSize, c, BasisOffset[c], NumCenters, use_offload_);
   }
 }
 
+template<class COT, typename ORBT>
+void SoaLocalizedBasisSet<COT, ORBT>::mw_evaluateVGLScreened(
+    const RefVectorWithLeader<SoaBasisSetBase<ORBT>>& basis_list,
+    const RefVectorWithLeader<ParticleSet>& P_list,
+    int iat,
+    OffloadMWVGLArray& vgl_v,
+    std::vector<std::pair<size_t, size_t>>& ao_ranges)
+{
+  assert(this == &basis_list.getLeader());
+  auto& basis_leader = basis_list.template getCastedLeader<SoaLocalizedBasisSet<COT, ORBT>>();
+  const auto& IonID(ions_.GroupID);
+  auto& pset_leader = P_list.getLeader();
+
+  size_t Nw = P_list.size();
+  assert(vgl_v.size(0) == 5);
+  assert(vgl_v.size(1) == Nw);
+  assert(vgl_v.size(2) == BasisSetSize);
+
+  auto& Tv_list       = basis_leader.mw_mem_handle_.getResource().Tv_list;
+  auto& displ_list_tr = basis_leader.mw_mem_handle_.getResource().displ_list_tr;
+  auto& is_active     = basis_leader.mw_mem_handle_.getResource().is_active_center;
+  Tv_list.resize(3 * NumCenters * Nw);
+  displ_list_tr.resize(3 * NumCenters * Nw);
+  is_active.assign(NumCenters, false);
+
+  for (size_t iw = 0; iw < P_list.size(); iw++)
+  {
+    const auto& coordR  = P_list[iw].activeR(iat);
+    const auto& d_table = P_list[iw].getDistTableAB(myTableIndex);
+    const bool is_temp  = P_list[iw].getActivePtcl() == iat;
+    const auto& dist    = is_temp ? d_table.getTempDists() : d_table.getDistRow(iat);
+    const auto& displ   = is_temp ? d_table.getTempDispls() : d_table.getDisplRow(iat);
+    for (int c = 0; c < NumCenters; c++)
+    {
+      // the distance table holds the minimum image distance, no periodic image of the center can be closer.
+      if (dist[c] < LOBasisSet[IonID[c]]->getRmax())
+        is_active[c] = true;
+      for (size_t idim = 0; idim < 3; idim++)
+      {
+        Tv_list[idim + 3 * (iw + c * Nw)]       = (ions_.R[c][idim] - coordR[idim]) - displ[c][idim];
+        displ_list_tr[idim + 3 * (iw + c * Nw)] = displ[c][idim];
+      }
+    }
+  }
+#if defined(QMC_COMPLEX)
+  Tv_list.updateTo();
+#endif
+  displ_list_tr.updateTo();
+
+  ao_ranges.clear();
+  for (int c = 0; c < NumCenters; c++)
+    if (is_active[c])
+    {
+      auto one_species_basis_list = extractOneSpeciesBasisRefList(basis_list, IonID[c]);
+      LOBasisSet[IonID[c]]->mw_evaluateVGL(one_species_basis_list, pset_leader.getLattice(), vgl_v, displ_list_tr,
+                                           Tv_list, Nw, BasisSetSize, c, BasisOffset[c], NumCenters, use_offload_);
+      ao_ranges.emplace_back(BasisOffset[c], BasisOffset[c] + LOBasisSet[IonID[c]]->getBasisSetSize());
+    }
+
+  // centers may be reordered with respect to the basis functions. Merge adjacent blocks for fewer but larger GEMMs.
+  std::sort(ao_ranges.begin(), ao_ranges.end());
+  size_t merged = 0;
+  for (size_t i = 1; i < ao_ranges.size(); i++)
+    if (ao_ranges[merged].second == ao_ranges[i].first)
+      ao_ranges[merged].second = ao_ranges[i].second;
+    else
+      ao_ranges[++merged] = ao_ranges[i];
+  if (!ao_ranges.empty())
+    ao_ranges.resize(merged + 1);
+}
 
 template<class COT, typename ORBT>
 void SoaLocalizedBasisSet<COT, ORBT>::evaluateVGH(const ParticleSet& P, int iat, vgh_type& vgh)
@@ -344,7 +419,7 @@ void SoaLocalizedBasisSet<COT, ORBT>::mw_evaluateValueVPs(const RefVectorWithLea
   {
     auto one_species_basis_list = extractOneSpeciesBasisRefList(basis_list, IonID[c]);
     LOBasisSet[IonID[c]]->mw_evaluateV(one_species_basis_list, vps_leader.getLattice(), vp_basis_v, displ_list_tr,
-                                       Tv_list, nVPs, BasisSetSize, c, BasisOffset[c], NumCenters);
+                                       Tv_list, nVPs, BasisSetSize, c, BasisOffset[c], NumCenters, use_offload_);
   }
   // vp_basis_v.updateFrom();
 }
@@ -409,7 +484,7 @@ void SoaLocalizedBasisSet<COT, ORBT>::mw_evaluateValue(const RefVectorWithLeader
   {
     auto one_species_basis_list = extractOneSpeciesBasisRefList(basis_list, IonID[c]);
     LOBasisSet[IonID[c]]->mw_evaluateV(one_species_basis_list, pset_leader.getLattice(), vals, displ_list_tr, Tv_list,
-                                       Nw, BasisSetSize, c, BasisOffset[c], NumCenters);
+                                       Nw, BasisSetSize, c, BasisOffset[c], NumCenters, use_offload_);
   }
 }
 
@@ -98,6 +98,8 @@ public:
    */
   void setBasisSetSize(int nbs) override;
 
+  void setOffload(bool use_offload) override { use_offload_ = use_offload; }
+
   /**  Determine which orbitals are S-type.  Used by cusp correction.
     */
   void queryOrbitalsForSType(const std::vector<bool>& corrCenter, std::vector<bool>& is_s_orbital) const override;
@@ -142,6 +144,19 @@ public:
                       int iat,
                       OffloadMWVGLArray& vgl) override;
 
+  /** compute VGL using packed array with all walkers, skipping the centers beyond their cutoff radius for all walkers
+   * @param basis_list list of basis sets (one for each walker)
+   * @param P_list list of quantum particleset (one for each walker)
+   * @param iat active particle
+   * @param vgl   Array(n_walkers, 5, BasisSetSize), only the entries within ao_ranges are assigned
+   * @param ao_ranges sorted and merged [first, last) ranges of the basis functions of the evaluated centers
+   */
+  void mw_evaluateVGLScreened(const RefVectorWithLeader<SoaBasisSetBase<ORBT>>& basis_list,
+                              const RefVectorWithLeader<ParticleSet>& P_list,
+                              int iat,
+                              OffloadMWVGLArray& vgl,
+                              std::vector<std::pair<size_t, size_t>>& ao_ranges) override;
+
   /** compute VGH 
    * @param P quantum particleset
    * @param iat active particle
@@ -209,6 +224,8 @@ public:
       int id);
 
 private:
+  /// if true, the batched evaluations run the offload kernels, otherwise the host tile kernels
+  bool use_offload_;
   /// multi walker shared memory buffer
   struct SoaLocalizedBSetMultiWalkerMem;
   /// multi walker resource handle
@@ -126,12 +126,7 @@ void RotatedSPOs::resetParametersExclusive(const opt_variables_type& active)
   }
 
   if (use_global_rot_)
-  {
-    std::vector<ValueType> old_param(m_full_rot_inds_.size());
-    std::copy_n(myVarsFull_.data(), myVarsFull_.size(), old_param.data());
-
-    applyDeltaRotation(delta_param, old_param, myVarsFull_);
-  }
+    accumulateDeltaRotation(delta_param);
   else
   {
     apply_rotation(delta_param, false);
@@ -146,6 +141,7 @@ void RotatedSPOs::writeVariationalParameters(hdf_archive& hout)
   hout.push("RotatedSPOs");
   if (use_global_rot_)
   {
+    syncFullRotationParameters();
     hout.push("rotation_global");
     const std::string rot_global_name = std::string("rotation_global_") + SPOSet::getName();
 
@@ -216,6 +212,9 @@ void RotatedSPOs::readVariationalParameters(hdf_archive& hin)
     hin.pop();
 
     applyFullRotation(myVarsFull_, true);
+    // the accumulated rotation is rebuilt from myVarsFull_ at the next delta rotation
+    global_rot_mat_.resize(0, 0);
+    full_params_outdated_ = false;
   }
   else if (grp_hist_exists)
   {
@@ -391,7 +390,10 @@ void RotatedSPOs::apply_rotation(const std::vector<ValueType>& param, bool use_s
     it into a unitary matrix via rot_mat = exp(-rot_mat). 
     Finally, apply unitary matrix to orbs.
   */
-  exponentiate_antisym_matrix(rot_mat);
+  if (const size_t nocc = getOccVirtBlockSize(m_act_rot_inds_); nocc > 0)
+    exponentiate_occ_virt_matrix(nocc, rot_mat);
+  else
+    exponentiate_antisym_matrix(rot_mat);
   {
     ScopedTimer local(apply_rotation_timer_);
     Phi_->applyRotation(rot_mat, use_stored_copy);
@@ -434,7 +436,10 @@ void RotatedSPOs::constructDeltaRotation(const std::vector<ValueType>& delta_par
   ValueMatrix delta_rot_mat(nmo, nmo);
 
   constructAntiSymmetricMatrix(act_rot_inds, delta_param, delta_rot_mat);
-  exponentiate_antisym_matrix(delta_rot_mat);
+  if (const size_t nocc = getOccVirtBlockSize(act_rot_inds); nocc > 0)
+    exponentiate_occ_virt_matrix(nocc, delta_rot_mat);
+  else
+    exponentiate_antisym_matrix(delta_rot_mat);
 
   // Apply delta rotation to old rotation.
   BLAS::gemm('N', 'N', nmo, nmo, nmo, 1.0, delta_rot_mat.data(), nmo, old_rot_mat.data(), nmo, 0.0, new_rot_mat.data(),
@@ -445,6 +450,47 @@ void RotatedSPOs::constructDeltaRotation(const std::vector<ValueType>& delta_par
   extractParamsFromAntiSymmetricMatrix(full_rot_inds, log_rot_mat, new_param);
 }
 
+void RotatedSPOs::accumulateDeltaRotation(const std::vector<ValueType>& delta_param)
+{
+  const size_t nmo = Phi_->getOrbitalSetSize();
+  if (global_rot_mat_.rows() != nmo)
+  {
+    // only done once, later steps update the accumulated rotation in place
+    global_rot_mat_.resize(nmo, nmo);
+    constructAntiSymmetricMatrix(m_full_rot_inds_, myVarsFull_, global_rot_mat_);
+    exponentiate_antisym_matrix(global_rot_mat_);
+  }
+
+  ValueMatrix delta_mat(nmo, nmo);
+  constructAntiSymmetricMatrix(m_act_rot_inds_, delta_param, delta_mat);
+  if (const size_t nocc = getOccVirtBlockSize(m_act_rot_inds_); nocc > 0)
+    applyOccVirtRotation(nocc, delta_mat, global_rot_mat_);
+  else
+  {
+    exponentiate_antisym_matrix(delta_mat);
+    ValueMatrix old_rot_mat(global_rot_mat_);
+    BLAS::gemm('N', 'N', nmo, nmo, nmo, ValueType(1.0), delta_mat.data(), nmo, old_rot_mat.data(), nmo, ValueType(0.0),
+               global_rot_mat_.data(), nmo);
+  }
+  full_params_outdated_ = true;
+
+  {
+    ScopedTimer local(apply_rotation_timer_);
+    Phi_->applyRotation(global_rot_mat_, true);
+  }
+}
+
+void RotatedSPOs::syncFullRotationParameters()
+{
+  if (!full_params_outdated_)
+    return;
+  const size_t nmo = global_rot_mat_.rows();
+  ValueMatrix log_rot_mat(nmo, nmo);
+  log_antisym_matrix(global_rot_mat_, log_rot_mat);
+  extractParamsFromAntiSymmetricMatrix(m_full_rot_inds_, log_rot_mat, myVarsFull_);
+  full_params_outdated_ = false;
+}
+
 void RotatedSPOs::applyFullRotation(const std::vector<ValueType>& full_param, bool use_stored_copy)
 {
   assert(full_param.size() == m_full_rot_inds_.size());
@@ -539,6 +585,181 @@ void RotatedSPOs::exponentiate_antisym_matrix(ValueMatrix& mat)
       copy_with_complex_cast(mat_d[i + n * j], mat[i][j]);
 }
 
+size_t RotatedSPOs::getOccVirtBlockSize(const RotationIndices& rot_indices)
+{
+  if (rot_indices.empty())
+    return 0;
+  int max_p = 0;
+  for (const auto& [p, q] : rot_indices)
+    max_p = std::max(max_p, p);
+  const int nocc = max_p + 1;
+  for (const auto& [p, q] : rot_indices)
+    if (q < nocc)
+      return 0;
+  return nocc;
+}
+
+namespace
+{
+/** matrix functions of G = B B^dagger entering the exponential of K = [[0, B], [-B^dagger, 0]]
+ * @param B pointer to the nocc x nvirt block, row major with leading dimension ldb
+ * @param cos_m cos(X)
+ * @param sinc_m sin(X)/X
+ * @param cosc_m (cos(X) - 1)/X^2
+ * with X = sqrt(G). Only the nocc x nocc hermitian eigenproblem of G is solved.
+ */
+template<typename T>
+void computeOccVirtExpFactors(const T* B,
+                              size_t ldb,
+                              size_t nocc,
+                              size_t nvirt,
+                              Matrix<T>& cos_m,
+                              Matrix<T>& sinc_m,
+                              Matrix<T>& cosc_m)
+{
+  using RealType = RealAlias<T>;
+  const int n    = nocc;
+  Matrix<T> gram(nocc, nocc);
+  // row major gram = B B^dagger
+  BLAS::gemm('C', 'N', n, n, nvirt, T(1.0), B, ldb, B, ldb, T(0.0), gram.data(), n);
+
+  std::vector<std::complex<RealType>> mat_h(n * n, 0);
+  std::vector<RealType> eval(n, 0);
+  std::vector<std::complex<RealType>> work(2 * n, 0);
+  std::vector<RealType> rwork(3 * n, 0);
+  //unpack row-major gram into column major format.
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      mat_h[i + n * j] = gram[i][j];
+
+  char JOBZ('V');
+  char UPLO('U');
+  int N(n);
+  int LDA(n);
+  int LWORK(2 * n);
+  int info = 0;
+  LAPACK::heev(JOBZ, UPLO, N, &mat_h.at(0), LDA, &eval.at(0), &work.at(0), LWORK, &rwork.at(0), info);
+  if (info != 0)
+  {
+    std::ostringstream msg;
+    msg << "heev failed with info = " << info << " in RotatedSPOs::exponentiate_occ_virt_matrix";
+    throw std::runtime_error(msg.str());
+  }
+
+  // G is positive semi-definite. Use the Taylor series near zero to avoid 0/0.
+  std::vector<RealType> fcos(n), fsinc(n), fcosc(n);
+  for (int k = 0; k < n; ++k)
+  {
+    const RealType lambda = std::max(eval[k], RealType(0));
+    const RealType x      = std::sqrt(lambda);
+    fcos[k]               = std::cos(x);
+    if (lambda < RealType(1e-6))
+    {
+      fsinc[k] = RealType(1) - lambda / RealType(6) + lambda * lambda / RealType(120);
+      fcosc[k] = RealType(-0.5) + lambda / RealType(24) - lambda * lambda / RealType(720);
+    }
+    else
+    {
+      fsinc[k] = std::sin(x) / x;
+      fcosc[k] = (fcos[k] - RealType(1)) / lambda;
+    }
+  }
+
+  // f(G) = V f(LAMBDA) V^dagger. For the real build the imaginary part is discarded.
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+    {
+      std::complex<RealType> c(0), s(0), d(0);
+      for (int k = 0; k < n; ++k)
+      {
+        const std::complex<RealType> vv = mat_h[i + n * k] * std::conj(mat_h[j + n * k]);
+        c += fcos[k] * vv;
+        s += fsinc[k] * vv;
+        d += fcosc[k] * vv;
+      }
+      copy_with_complex_cast(c, cos_m[i][j]);
+      copy_with_complex_cast(s, sinc_m[i][j]);
+      copy_with_complex_cast(d, cosc_m[i][j]);
+    }
+}
+} // namespace
+
+void RotatedSPOs::exponentiate_occ_virt_matrix(size_t nocc, ValueMatrix& mat)
+{
+  const size_t nmo = mat.rows();
+  assert(nocc <= nmo);
+  const size_t nvirt = nmo - nocc;
+  if (nvirt == 0)
+  {
+    mat = ValueType(0);
+    for (size_t i = 0; i < nmo; i++)
+      mat[i][i] = ValueType(1);
+    return;
+  }
+
+  const ValueType* B = mat[0] + nocc;
+  ValueMatrix cos_m(nocc, nocc), sinc_m(nocc, nocc), cosc_m(nocc, nocc);
+  computeOccVirtExpFactors(B, nmo, nocc, nvirt, cos_m, sinc_m, cosc_m);
+
+  // All matrices are row major. C = A B is computed as C^T = B^T A^T by column-major BLAS.
+  ValueMatrix sinc_b(nocc, nvirt), cosc_b(nocc, nvirt);
+  BLAS::gemm('N', 'N', nvirt, nocc, nocc, ValueType(1.0), B, nmo, sinc_m.data(), nocc, ValueType(0.0), sinc_b.data(),
+             nvirt);
+  BLAS::gemm('N', 'N', nvirt, nocc, nocc, ValueType(1.0), B, nmo, cosc_m.data(), nocc, ValueType(0.0), cosc_b.data(),
+             nvirt);
+  // virtual-virtual block 1 + B^dagger cosc(X) B, B is still intact
+  BLAS::gemm('N', 'C', nvirt, nvirt, nocc, ValueType(1.0), cosc_b.data(), nvirt, B, nmo, ValueType(0.0),
+             mat[nocc] + nocc, nmo);
+  for (size_t a = nocc; a < nmo; a++)
+    mat[a][a] += ValueType(1);
+
+  for (size_t i = 0; i < nocc; i++)
+  {
+    for (size_t j = 0; j < nocc; j++)
+      mat[i][j] = cos_m[i][j];
+    for (size_t a = 0; a < nvirt; a++)
+    {
+      mat[i][nocc + a] = sinc_b[i][a];
+      mat[nocc + a][i] = -qmcplusplus::conj(sinc_b[i][a]);
+    }
+  }
+}
+
+void RotatedSPOs::applyOccVirtRotation(size_t nocc, const ValueMatrix& kappa, ValueMatrix& rot_mat)
+{
+  const size_t nmo = rot_mat.rows();
+  assert(kappa.rows() == nmo && kappa.cols() == nmo && rot_mat.cols() == nmo);
+  assert(nocc <= nmo);
+  const size_t nvirt = nmo - nocc;
+  if (nvirt == 0)
+    return;
+
+  const ValueType* B = kappa[0] + nocc;
+  ValueMatrix cos_m(nocc, nocc), sinc_m(nocc, nocc), cosc_m(nocc, nocc);
+  computeOccVirtExpFactors(B, nmo, nocc, nvirt, cos_m, sinc_m, cosc_m);
+
+  // split rot_mat = [R_o, R_v] by columns and let P = R_v B^dagger. Then
+  //   rot_mat exp(K) = [R_o cos(X) - P sinc(X), R_v + (R_o sinc(X) + P cosc(X)) B]
+  ValueType* Ro = rot_mat.data();
+  ValueType* Rv = rot_mat.data() + nocc;
+  ValueMatrix p_mat(nmo, nocc), occ_cols(nmo, nocc), w_mat(nmo, nocc);
+  BLAS::gemm('C', 'N', nocc, nmo, nvirt, ValueType(1.0), B, nmo, Rv, nmo, ValueType(0.0), p_mat.data(), nocc);
+
+  BLAS::gemm('N', 'N', nocc, nmo, nocc, ValueType(1.0), cos_m.data(), nocc, Ro, nmo, ValueType(0.0), occ_cols.data(),
+             nocc);
+  BLAS::gemm('N', 'N', nocc, nmo, nocc, ValueType(-1.0), sinc_m.data(), nocc, p_mat.data(), nocc, ValueType(1.0),
+             occ_cols.data(), nocc);
+
+  BLAS::gemm('N', 'N', nocc, nmo, nocc, ValueType(1.0), sinc_m.data(), nocc, Ro, nmo, ValueType(0.0), w_mat.data(),
+             nocc);
+  BLAS::gemm('N', 'N', nocc, nmo, nocc, ValueType(1.0), cosc_m.data(), nocc, p_mat.data(), nocc, ValueType(1.0),
+             w_mat.data(), nocc);
+  BLAS::gemm('N', 'N', nvirt, nmo, nocc, ValueType(1.0), B, nmo, w_mat.data(), nocc, ValueType(1.0), Rv, nmo);
+
+  for (size_t i = 0; i < nmo; i++)
+    std::copy_n(occ_cols[i], nocc, rot_mat[i]);
+}
+
 void RotatedSPOs::log_antisym_matrix(const ValueMatrix& mat, ValueMatrix& output)
 {
   const int n = mat.rows();
@@ -1626,14 +1847,16 @@ std::unique_ptr<SPOSet> RotatedSPOs::makeClone() const
 {
   auto myclone = std::make_unique<RotatedSPOs>(my_name_, std::unique_ptr<SPOSet>(Phi_->makeClone()));
 
-  myclone->params_          = this->params_;
-  myclone->params_supplied_ = this->params_supplied_;
-  myclone->m_act_rot_inds_  = this->m_act_rot_inds_;
-  myclone->m_full_rot_inds_ = this->m_full_rot_inds_;
-  myclone->myVars           = this->myVars;
-  myclone->myVarsFull_      = this->myVarsFull_;
-  myclone->history_params_  = this->history_params_;
-  myclone->use_global_rot_  = this->use_global_rot_;
+  myclone->params_               = this->params_;
+  myclone->params_supplied_      = this->params_supplied_;
+  myclone->m_act_rot_inds_       = this->m_act_rot_inds_;
+  myclone->m_full_rot_inds_      = this->m_full_rot_inds_;
+  myclone->myVars                = this->myVars;
+  myclone->myVarsFull_           = this->myVarsFull_;
+  myclone->history_params_       = this->history_params_;
+  myclone->use_global_rot_       = this->use_global_rot_;
+  myclone->global_rot_mat_       = this->global_rot_mat_;
+  myclone->full_params_outdated_ = this->full_params_outdated_;
   return myclone;
 }
 
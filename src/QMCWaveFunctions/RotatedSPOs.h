@@ -115,6 +115,22 @@ public:
   // matrices of the form A=e^K, where K is antisymmetric/antihermitian.
   static void log_antisym_matrix(const ValueMatrix& mat, ValueMatrix& output);
 
+  // Return nocc if every rotation (p,q) in rot_indices satisfies p < nocc <= q, with nocc = 1 + max(p).
+  // Such rotations only couple the occupied and virtual orbitals and the antisymmetric matrix
+  // K = [[0, B], [-B^dagger, 0]] is determined by its nocc x nvirt block B. Return 0 otherwise.
+  static size_t getOccVirtBlockSize(const RotationIndices& rot_indices);
+
+  // Compute the matrix exponential of an antisymmetric/antihermitian matrix whose only nonzero entries are
+  // in the occupied-virtual blocks. Uses the closed form
+  //   exp(K) = [[cos(X), sinc(X) B], [-B^dagger sinc(X), 1 + B^dagger cosc(X) B]]
+  // with X = sqrt(B B^dagger), which only needs the nocc x nocc eigenproblem of B B^dagger
+  // instead of the nmo x nmo one used by exponentiate_antisym_matrix.
+  static void exponentiate_occ_virt_matrix(size_t nocc, ValueMatrix& mat);
+
+  // Right-multiply rot_mat in place by exp(K), K an antisymmetric/antihermitian matrix with nonzero entries only
+  // in the occupied-virtual blocks. exp(K) is never formed and the cost is O(nocc nmo^2) instead of O(nmo^3).
+  static void applyOccVirtRotation(size_t nocc, const ValueMatrix& kappa, ValueMatrix& rot_mat);
+
   //A particular SPOSet used for Orbitals
   std::unique_ptr<SPOSet> Phi_;
 
@@ -468,6 +484,20 @@ private:
   /// Full set of rotation matrix parameters for use in global rotation method
   std::vector<ValueType> myVarsFull_;
 
+  /// accumulated global rotation matrix exp(myVarsFull_), empty until the first delta rotation
+  ValueMatrix global_rot_mat_;
+
+  /// true if myVarsFull_ lags behind global_rot_mat_
+  bool full_params_outdated_ = false;
+
+  /** accumulate a delta rotation into global_rot_mat_ and apply it to the stored coefficients.
+   * myVarsFull_ is only updated by syncFullRotationParameters when needed
+   */
+  void accumulateDeltaRotation(const std::vector<ValueType>& delta_param);
+
+  /// extract myVarsFull_ from global_rot_mat_ if it is outdated
+  void syncFullRotationParameters();
+
   /// timer for apply_rotation
   NewTimer& apply_rotation_timer_;
 
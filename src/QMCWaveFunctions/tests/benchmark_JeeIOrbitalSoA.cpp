@@ -0,0 +1,142 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2023 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+
+/** \file
+ *  Micro benchmark of the batched JeeIOrbitalSoA ratioGrad/accept path
+ *  against the per-walker fallback of WaveFunctionComponent.
+ */
+
+#include "catch.hpp"
+
+#include "OhmmsData/Libxml2Doc.h"
+#include "Particle/ParticleSet.h"
+#include "QMCWaveFunctions/WaveFunctionComponent.h"
+#include "QMCWaveFunctions/Jastrow/PolynomialFunctor3D.h"
+#include "QMCWaveFunctions/Jastrow/JeeIOrbitalSoA.h"
+#include "QMCWaveFunctions/Jastrow/eeI_JastrowBuilder.h"
+#include "Utilities/RandomGenerator.h"
+#include <ResourceCollection.h>
+
+namespace qmcplusplus
+{
+TEST_CASE("JeeIOrbitalSoA batched benchmark", "[wavefunction][benchmark]")
+{
+  using PosType  = QMCTraits::PosType;
+  using PsiValue = WaveFunctionComponent::PsiValue;
+  using GradType = WaveFunctionComponent::GradType;
+
+  Communicate* c = OHMMS::Controller;
+
+  const int num_ions    = 4;
+  const int num_elec    = 32;
+  const int num_walkers = 8;
+
+  const SimulationCell simulation_cell;
+  ParticleSet ions(simulation_cell);
+  ParticleSet elec(simulation_cell);
+
+  ions.setName("ion");
+  ions.create({num_ions});
+  for (int i = 0; i < num_ions; i++)
+    ions.R[i] = {2.0 * i - 3.0, 0.0, 0.0};
+  ions.getSpeciesSet().addSpecies("O");
+  ions.update();
+
+  elec.setName("elec");
+  elec.create({num_elec / 2, num_elec / 2});
+  RandomGenerator rng;
+  for (int i = 0; i < num_elec; i++)
+    elec.R[i] = {8.0 * rng() - 4.0, 4.0 * rng() - 2.0, 4.0 * rng() - 2.0};
+  SpeciesSet& target_species(elec.getSpeciesSet());
+  int upIdx                          = target_species.addSpecies("u");
+  int downIdx                        = target_species.addSpecies("d");
+  int chargeIdx                      = target_species.addAttribute("charge");
+  target_species(chargeIdx, upIdx)   = -1;
+  target_species(chargeIdx, downIdx) = -1;
+
+  const char* particles = R"(<tmp>
+    <jastrow name="J3" type="eeI" function="polynomial" source="ion" print="no">
+      <correlation ispecies="O" especies="u" isize="3" esize="3" rcut="5">
+        <coefficients id="uuO" type="Array" optimize="yes"> 8.227710241e-06 2.480817653e-06 -5.354068112e-06 -1.112644787e-05 -2.208006078e-06 5.213121933e-06 -1.537865869e-05 8.899030233e-06 6.257255156e-06 3.214580988e-06 -7.716743107e-06 -5.275682077e-06 -1.778457637e-06 7.926231121e-06 1.767406868e-06 5.451359059e-08 2.801423724e-06 4.577282736e-06 7.634608083e-06 -9.510673173e-07 -2.344131575e-06 -1.878777219e-06 3.937363358e-07 5.065353773e-07 5.086724869e-07 -1.358768154e-07</coefficients>
+      </correlation>
+      <correlation ispecies="O" especies1="u" especies2="d" isize="3" esize="3" rcut="5">
+        <coefficients id="udO" type="Array" optimize="yes"> -6.939530224e-06 2.634169299e-05 4.046077477e-05 -8.002682388e-06 -5.396795988e-06 6.697370507e-06 5.433953051e-05 -6.336849668e-06 3.680471431e-05 -2.996059772e-05 1.99365828e-06 -3.222705626e-05 -8.091669063e-06 4.15738535e-06 4.843939112e-06 3.563650208e-07 3.786332474e-05 -1.418336941e-05 2.282691374e-05 1.29239286e-06 -4.93580873e-06 -3.052539228e-06 9.870288001e-08 1.844286407e-06 2.970561871e-07 -4.364303677e-08</coefficients>
+      </correlation>
+    </jastrow>
+</tmp>
+)";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(particles));
+
+  eeI_JastrowBuilder jastrow(c, elec, ions);
+  auto j3 = jastrow.buildComponent(xmlFirstElementChild(doc.getRoot()));
+  REQUIRE(dynamic_cast<JeeIOrbitalSoA<PolynomialFunctor3D>*>(j3.get()) != nullptr);
+
+  ResourceCollection pset_res("test_pset_res");
+  ResourceCollection wfc_res("test_wfc_res");
+  elec.createResource(pset_res);
+  j3->createResource(wfc_res);
+
+  std::vector<std::unique_ptr<ParticleSet>> elec_clones;
+  std::vector<std::unique_ptr<WaveFunctionComponent>> j3_clones;
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec});
+  RefVectorWithLeader<WaveFunctionComponent> wfc_list(*j3, {*j3});
+  for (int iw = 1; iw < num_walkers; iw++)
+  {
+    elec_clones.push_back(std::make_unique<ParticleSet>(elec));
+    j3_clones.push_back(j3->makeClone(*elec_clones.back()));
+    p_list.push_back(*elec_clones.back());
+    wfc_list.push_back(*j3_clones.back());
+  }
+
+  ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, p_list);
+  ResourceCollectionTeamLock<WaveFunctionComponent> mw_wfc_lock(wfc_res, wfc_list);
+
+  std::vector<ParticleSet::ParticleGradient> G_list(num_walkers, ParticleSet::ParticleGradient(num_elec));
+  std::vector<ParticleSet::ParticleLaplacian> L_list(num_walkers, ParticleSet::ParticleLaplacian(num_elec));
+  ParticleSet::mw_update(p_list);
+  j3->mw_evaluateLog(wfc_list, p_list, makeRefVector<ParticleSet::ParticleGradient>(G_list),
+                     makeRefVector<ParticleSet::ParticleLaplacian>(L_list));
+
+  std::vector<PosType> displ(num_walkers);
+  std::vector<PsiValue> ratios(num_walkers);
+  std::vector<GradType> grads(num_walkers);
+  std::vector<bool> isAccepted(num_walkers);
+  for (int iw = 0; iw < num_walkers; iw++)
+  {
+    displ[iw]      = {0.05 * (rng() - 0.5), 0.05 * (rng() - 0.5), 0.05 * (rng() - 0.5)};
+    isAccepted[iw] = iw % 2 == 0;
+  }
+
+  // one sweep of single particle moves with half of the walkers accepting
+  auto sweep = [&](bool batched) {
+    for (int iat = 0; iat < num_elec; iat++)
+    {
+      ParticleSet::mw_makeMove(p_list, iat, displ);
+      if (batched)
+      {
+        j3->mw_ratioGrad(wfc_list, p_list, iat, ratios, grads);
+        j3->mw_accept_rejectMove(wfc_list, p_list, iat, isAccepted);
+      }
+      else
+      {
+        j3->WaveFunctionComponent::mw_ratioGrad(wfc_list, p_list, iat, ratios, grads);
+        j3->WaveFunctionComponent::mw_accept_rejectMove(wfc_list, p_list, iat, isAccepted);
+      }
+      ParticleSet::mw_accept_rejectMove(p_list, iat, isAccepted);
+    }
+  };
+
+  BENCHMARK("per-walker ratioGrad+accept sweep") { sweep(false); };
+  BENCHMARK("batched ratioGrad+accept sweep") { sweep(true); };
+}
+} // namespace qmcplusplus
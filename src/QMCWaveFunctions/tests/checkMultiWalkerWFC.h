@@ -0,0 +1,211 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef QMCPLUSPLUS_CHECKMULTIWALKERWFC_H
+#define QMCPLUSPLUS_CHECKMULTIWALKERWFC_H
+
+#include "catch.hpp"
+#include "Particle/ParticleSet.h"
+#include "Particle/VirtualParticleSet.h"
+#include "QMCWaveFunctions/WaveFunctionComponent.h"
+
+namespace qmcplusplus
+{
+namespace testing
+{
+/** single walker copies of the walkers of a batch, the reference of the batched APIs of a wavefunction component
+ */
+class SingleWalkerReferences
+{
+public:
+  SingleWalkerReferences(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                         const RefVectorWithLeader<ParticleSet>& p_list)
+  {
+    for (int iw = 0; iw < p_list.size(); iw++)
+    {
+      psets_.push_back(std::make_unique<ParticleSet>(p_list[iw]));
+      wfcs_.push_back(wfc_list[iw].makeClone(*psets_.back()));
+    }
+  }
+
+  ParticleSet& pset(int iw) { return *psets_[iw]; }
+  WaveFunctionComponent& wfc(int iw) { return *wfcs_[iw]; }
+
+private:
+  std::vector<std::unique_ptr<ParticleSet>> psets_;
+  std::vector<std::unique_ptr<WaveFunctionComponent>> wfcs_;
+};
+
+/// check mw_evaluateLog against evaluateLog of the single walker references
+inline void checkMWEvaluateLog(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                               const RefVectorWithLeader<ParticleSet>& p_list,
+                               SingleWalkerReferences& refs)
+{
+  const int nw    = p_list.size();
+  const int nelec = p_list.getLeader().getTotalNum();
+  std::vector<ParticleSet::ParticleGradient> G_list(nw, ParticleSet::ParticleGradient(nelec));
+  std::vector<ParticleSet::ParticleLaplacian> L_list(nw, ParticleSet::ParticleLaplacian(nelec));
+  ParticleSet::mw_update(p_list);
+  wfc_list.getLeader().mw_evaluateLog(wfc_list, p_list, makeRefVector<ParticleSet::ParticleGradient>(G_list),
+                                      makeRefVector<ParticleSet::ParticleLaplacian>(L_list));
+  for (int iw = 0; iw < nw; iw++)
+  {
+    ParticleSet::ParticleGradient G_ref(nelec);
+    ParticleSet::ParticleLaplacian L_ref(nelec);
+    refs.pset(iw).update();
+    const auto log_ref = refs.wfc(iw).evaluateLog(refs.pset(iw), G_ref, L_ref);
+    CHECK(wfc_list[iw].get_log_value() == LogComplexApprox(log_ref));
+    for (int iat = 0; iat < nelec; iat++)
+    {
+      CHECK(std::real(L_list[iw][iat]) == Approx(std::real(L_ref[iat])));
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+        CHECK(std::real(G_list[iw][iat][idim]) == Approx(std::real(G_ref[iat][idim])));
+    }
+  }
+}
+
+/** check a sweep of batched single particle moves against the single walker references
+ *
+ * Walker iw moves every electron by displ[iw]. Electron 1 only computes the ratio and the other electrons also
+ * the gradient. All the moves of the first walker are accepted, the second walker rejects the odd electrons.
+ * The log values and the gradients after the sweep are compared as well.
+ */
+inline void checkMWParticleMoves(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                 const RefVectorWithLeader<ParticleSet>& p_list,
+                                 SingleWalkerReferences& refs,
+                                 const std::vector<ParticleSet::PosType>& displ)
+{
+  using GradType = WaveFunctionComponent::GradType;
+  using PsiValue = WaveFunctionComponent::PsiValue;
+
+  auto& wfc_leader = wfc_list.getLeader();
+  const int nw     = p_list.size();
+  const int nelec  = p_list.getLeader().getTotalNum();
+  std::vector<PsiValue> ratios(nw);
+  std::vector<GradType> grads(nw);
+  for (int iat = 0; iat < nelec; iat++)
+  {
+    const bool ratio_only = iat == 1;
+    ParticleSet::mw_makeMove(p_list, iat, displ);
+    std::fill(grads.begin(), grads.end(), GradType());
+    if (ratio_only)
+      wfc_leader.mw_calcRatio(wfc_list, p_list, iat, ratios);
+    else
+      wfc_leader.mw_ratioGrad(wfc_list, p_list, iat, ratios, grads);
+
+    std::vector<bool> isAccepted(nw);
+    for (int iw = 0; iw < nw; iw++)
+    {
+      isAccepted[iw]     = iw == 0 || iat % 2 == 0;
+      ParticleSet& P_ref = refs.pset(iw);
+      P_ref.makeMove(iat, displ[iw]);
+      GradType grad_ref;
+      PsiValue ratio_ref = ratio_only ? refs.wfc(iw).ratio(P_ref, iat) : refs.wfc(iw).ratioGrad(P_ref, iat, grad_ref);
+      CHECK(std::real(ratios[iw]) == Approx(std::real(ratio_ref)));
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+        CHECK(std::real(grads[iw][idim]) == Approx(std::real(grad_ref[idim])));
+      if (isAccepted[iw])
+      {
+        refs.wfc(iw).acceptMove(P_ref, iat);
+        P_ref.acceptMove(iat);
+      }
+      else
+      {
+        refs.wfc(iw).restore(iat);
+        P_ref.rejectMove(iat);
+      }
+    }
+    wfc_leader.mw_accept_rejectMove(wfc_list, p_list, iat, isAccepted);
+    ParticleSet::mw_accept_rejectMove(p_list, iat, isAccepted);
+  }
+  ParticleSet::mw_donePbyP(p_list);
+
+  for (int iw = 0; iw < nw; iw++)
+  {
+    CHECK(wfc_list[iw].get_log_value() == LogComplexApprox(refs.wfc(iw).get_log_value()));
+    for (int iat = 0; iat < nelec; iat++)
+    {
+      GradType grad     = wfc_list[iw].evalGrad(p_list[iw], iat);
+      GradType grad_ref = refs.wfc(iw).evalGrad(refs.pset(iw), iat);
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+        CHECK(std::real(grad[idim]) == Approx(std::real(grad_ref[idim])));
+    }
+  }
+}
+
+/// check mw_evaluateGL after a sweep against evaluateLog of the single walker references
+inline void checkMWEvaluateGL(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                              const RefVectorWithLeader<ParticleSet>& p_list,
+                              SingleWalkerReferences& refs)
+{
+  const int nw    = p_list.size();
+  const int nelec = p_list.getLeader().getTotalNum();
+  std::vector<ParticleSet::ParticleGradient> G_list(nw, ParticleSet::ParticleGradient(nelec));
+  std::vector<ParticleSet::ParticleLaplacian> L_list(nw, ParticleSet::ParticleLaplacian(nelec));
+  for (int iw = 0; iw < nw; iw++)
+  {
+    G_list[iw] = 0;
+    L_list[iw] = 0;
+  }
+  wfc_list.getLeader().mw_evaluateGL(wfc_list, p_list, makeRefVector<ParticleSet::ParticleGradient>(G_list),
+                                     makeRefVector<ParticleSet::ParticleLaplacian>(L_list), false);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    ParticleSet::ParticleGradient G_ref(nelec);
+    ParticleSet::ParticleLaplacian L_ref(nelec);
+    const auto log_ref = refs.wfc(iw).evaluateLog(refs.pset(iw), G_ref, L_ref);
+    CHECK(wfc_list[iw].get_log_value() == LogComplexApprox(log_ref));
+    for (int iat = 0; iat < nelec; iat++)
+    {
+      CHECK(std::real(L_list[iw][iat]) == Approx(std::real(L_ref[iat])));
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+        CHECK(std::real(G_list[iw][iat][idim]) == Approx(std::real(G_ref[iat][idim])));
+    }
+  }
+}
+
+/** check the batched and the single walker virtual particle ratios against the single walker references
+ *
+ * The reference ratios are those of single particle moves of the reference electron to the virtual positions.
+ */
+inline void checkMWEvaluateRatios(const RefVectorWithLeader<WaveFunctionComponent>& wfc_list,
+                                  const RefVectorWithLeader<const VirtualParticleSet>& vp_list,
+                                  SingleWalkerReferences& refs)
+{
+  using ValueType = WaveFunctionComponent::ValueType;
+
+  const int nw = vp_list.size();
+  std::vector<std::vector<ValueType>> ratios(nw);
+  for (int iw = 0; iw < nw; iw++)
+    ratios[iw].resize(vp_list[iw].getTotalNum());
+  wfc_list.getLeader().mw_evaluateRatios(wfc_list, vp_list, ratios);
+  for (int iw = 0; iw < nw; iw++)
+  {
+    const VirtualParticleSet& vp = vp_list[iw];
+    const int iat                = vp.refPtcl;
+    std::vector<ValueType> ratios_scalar(vp.getTotalNum());
+    wfc_list[iw].evaluateRatios(vp, ratios_scalar);
+    ParticleSet& P_ref = refs.pset(iw);
+    for (int k = 0; k < vp.getTotalNum(); k++)
+    {
+      P_ref.makeMove(iat, vp.R[k] - P_ref.R[iat]);
+      const ValueType ratio_ref = refs.wfc(iw).ratio(P_ref, iat);
+      refs.wfc(iw).restore(iat);
+      P_ref.rejectMove(iat);
+      CHECK(ratios[iw][k] == ValueApprox(ratio_ref));
+      CHECK(ratios_scalar[k] == ValueApprox(ratio_ref));
+    }
+  }
+}
+
+} // namespace testing
+} // namespace qmcplusplus
+#endif
@@ -17,6 +17,9 @@
 #include "QMCWaveFunctions/Jastrow/RadialJastrowBuilder.h"
 #include "QMCWaveFunctions/WaveFunctionFactory.h"
 #include "Utilities/RuntimeOptions.h"
+#include "QMCHamiltonians/NLPPJob.h"
+#include "checkMultiWalkerWFC.h"
+#include <ResourceCollection.h>
 
 namespace qmcplusplus
 {
@@ -247,4 +250,108 @@ TEST_CASE("J1 spin evaluate derivatives multiparticle Jastrow", "[wavefunction]"
     CHECK(cloned_dhpsioverpsi[i] == ValueApprox(expected_dhpsioverpsi[i]));
   }
 }
+
+TEST_CASE("J1 spin batched", "[wavefunction]")
+{
+  using PosType = QMCTraits::PosType;
+
+  Communicate* c = OHMMS::Controller;
+
+  ParticleSetPool ptcl = ParticleSetPool(c);
+  auto ions_uptr       = std::make_unique<ParticleSet>(ptcl.getSimulationCell());
+  auto elec_uptr       = std::make_unique<ParticleSet>(ptcl.getSimulationCell());
+  ParticleSet& ions_(*ions_uptr);
+  ParticleSet& elec_(*elec_uptr);
+
+  ions_.setName("ion0");
+  ptcl.addParticleSet(std::move(ions_uptr));
+  ions_.create({2});
+  ions_.R[0]                 = {0.0, 0.0, 0.0};
+  ions_.R[1]                 = {1.2, 0.0, 0.0};
+  SpeciesSet& ispecies       = ions_.getSpeciesSet();
+  int HIdx                   = ispecies.addSpecies("H");
+  int ichargeIdx             = ispecies.addAttribute("charge");
+  ispecies(ichargeIdx, HIdx) = 1.0;
+
+  elec_.setName("e");
+  ptcl.addParticleSet(std::move(elec_uptr));
+  elec_.create({2, 2});
+  elec_.R[0] = {0.5, 0.5, 0.5};
+  elec_.R[1] = {1.0, -0.3, 0.2};
+  elec_.R[2] = {-0.5, -0.5, -0.5};
+  elec_.R[3] = {0.8, 0.4, -0.6};
+
+  SpeciesSet& tspecies         = elec_.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int massIdx                  = tspecies.addAttribute("mass");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  tspecies(massIdx, upIdx)     = 1.0;
+  tspecies(massIdx, downIdx)   = 1.0;
+  tspecies(chargeIdx, upIdx)   = -1.0;
+  tspecies(chargeIdx, downIdx) = -1.0;
+  elec_.resetGroups();
+
+  ions_.update();
+  elec_.addTable(elec_);
+  const int ei_table_index = elec_.addTable(ions_);
+  elec_.update();
+
+  const char* jasxml = R"(<wavefunction name="psi0" target="e">
+<jastrow name="J1" type="One-Body" function="Bspline" print="yes" source="ion0" spin="yes">
+  <correlation speciesA="H" speciesB="u" cusp="0.0" size="3" rcut="5.0">
+    <coefficients id="J1uH" type="Array"> 0.5 0.2 0.1 </coefficients>
+  </correlation>
+  <correlation speciesA="H" speciesB="d" cusp="0.0" size="3" rcut="5.0">
+    <coefficients id="J1dH" type="Array"> 0.3 0.15 0.05 </coefficients>
+  </correlation>
+</jastrow>
+</wavefunction>
+)";
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(jasxml);
+  REQUIRE(okay);
+  WaveFunctionFactory wf_factory(elec_, ptcl.getPool(), c);
+  RuntimeOptions runtime_options;
+  auto twf_ptr = wf_factory.buildTWF(doc.getRoot(), runtime_options);
+  auto& j1     = *twf_ptr->getOrbitals()[0];
+  REQUIRE(j1.getClassName() == "J1Spin");
+
+  ParticleSet elec_clone(elec_);
+  auto j1_clone = j1.makeClone(elec_clone);
+
+  ResourceCollection pset_res("test_pset_res");
+  ResourceCollection wfc_res("test_wfc_res");
+  elec_.createResource(pset_res);
+  j1.createResource(wfc_res);
+
+  RefVectorWithLeader<ParticleSet> p_list(elec_, {elec_, elec_clone});
+  RefVectorWithLeader<WaveFunctionComponent> j1_list(j1, {j1, *j1_clone});
+  ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, p_list);
+  ResourceCollectionTeamLock<WaveFunctionComponent> mw_wfc_lock(wfc_res, j1_list);
+
+  // single walker references
+  testing::SingleWalkerReferences refs(j1_list, p_list);
+  testing::checkMWEvaluateLog(j1_list, p_list, refs);
+  testing::checkMWParticleMoves(j1_list, p_list, refs, {{0.1, -0.2, 0.15}, {-0.05, 0.1, 0.2}});
+  testing::checkMWEvaluateGL(j1_list, p_list, refs);
+
+  // NLPP ratios with reference electrons of different spins
+  const int nknot = 3;
+  VirtualParticleSet vp(elec_, nknot), vp_clone(elec_clone, nknot);
+  RefVectorWithLeader<VirtualParticleSet> vp_list(vp, {vp, vp_clone});
+  ResourceCollection vp_res("test_vp_res");
+  vp.createResource(vp_res);
+  ResourceCollectionTeamLock<VirtualParticleSet> mw_vp_lock(vp_res, vp_list);
+
+  const auto& ei_table1 = elec_.getDistTableAB(ei_table_index);
+  NLPPJob<RealType> job1(1, 0, ei_table1.getDistances()[0][1], -ei_table1.getDisplacements()[0][1]);
+  const auto& ei_table2 = elec_clone.getDistTableAB(ei_table_index);
+  NLPPJob<RealType> job2(0, 3, ei_table2.getDistances()[3][0], -ei_table2.getDisplacements()[3][0]);
+  std::vector<PosType> deltaV1{{0.1, 0.2, 0.3}, {0.1, 0.3, 0.2}, {0.2, 0.1, 0.3}};
+  std::vector<PosType> deltaV2{{0.02, 0.01, 0.03}, {0.02, 0.03, 0.01}, {0.03, 0.01, 0.02}};
+  VirtualParticleSet::mw_makeMoves(vp_list, p_list, {deltaV1, deltaV2}, {job1, job2}, false);
+
+  testing::checkMWEvaluateRatios(j1_list, RefVectorWithLeader<const VirtualParticleSet>(vp, {vp, vp_clone}), refs);
+}
 } // namespace qmcplusplus
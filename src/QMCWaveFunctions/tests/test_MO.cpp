@@ -19,10 +19,43 @@
 #include "Numerics/GaussianBasisSet.h"
 #include "QMCWaveFunctions/LCAO/LCAOrbitalBuilder.h"
 #include "QMCWaveFunctions/SPOSetBuilderFactory.h"
+#include "QMCWaveFunctions/LCAO/SoaLocalizedBasisSet.h"
+#include "QMCWaveFunctions/LCAO/SoaAtomicBasisSet.h"
+#include "QMCWaveFunctions/LCAO/MultiQuinticSpline1D.h"
+#include "QMCWaveFunctions/LCAO/MultiFunctorAdapter.h"
+#include "Numerics/SoaCartesianTensor.h"
 #include <ResourceCollection.h>
 
 namespace qmcplusplus
 {
+namespace testing
+{
+/// access to the multi walker buffers of the atomic basis sets of a cartesian LCAO basis
+class TestSoaAtomicBasisSet
+{
+public:
+  /** true if the last batched evaluations of every atomic basis set ran the host tile kernels
+   *
+   * Must be called while the multi walker resource is acquired by basis.
+   */
+  template<typename ROT>
+  static bool usedHostTiles(const LCAOrbitalSet::basis_type& basis)
+  {
+    using AtomicBasisSet = SoaAtomicBasisSet<ROT, SoaCartesianTensor<QMCTraits::RealType>>;
+    auto* localized = dynamic_cast<const SoaLocalizedBasisSet<AtomicBasisSet, LCAOrbitalSet::ValueType>*>(&basis);
+    REQUIRE(localized != nullptr);
+    for (const auto& aos : localized->LOBasisSet)
+    {
+      const auto& mem = aos->mw_mem_handle_.getResource();
+      // the offload kernels evaluate into ylm_vgl/ylm_v, the host tile kernels into tile_psi
+      if (mem.tile_psi.size() == 0 || mem.ylm_vgl.size() != 0 || mem.ylm_v.size() != 0)
+        return false;
+    }
+    return true;
+  }
+};
+} // namespace testing
+
 void test_He(bool transform)
 {
   std::ostringstream section_name;
@@ -462,6 +495,240 @@ void test_EtOH_mw(bool transform)
 TEST_CASE("mw_evaluate Numerical EtOH", "[wavefunction]") { test_EtOH_mw(true); }
 TEST_CASE("mw_evaluate GTO EtOH", "[wavefunction]") { test_EtOH_mw(false); }
 
+void test_EtOH_mw_screened(bool transform)
+{
+  Communicate* c = OHMMS::Controller;
+
+  Libxml2Document doc;
+  bool okay = doc.parse("ethanol.structure.xml");
+  REQUIRE(okay);
+
+  const SimulationCell simulation_cell;
+  auto ions_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto& ions(*ions_ptr);
+  XMLParticleParser parse_ions(ions);
+  OhmmsXPathObject particleset_ion("//particleset[@name='ion0']", doc.getXPathContext());
+  REQUIRE(particleset_ion.size() == 1);
+  parse_ions.readXML(particleset_ion[0]);
+  ions.update();
+
+  auto elec_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto& elec(*elec_ptr);
+  XMLParticleParser parse_elec(elec);
+  OhmmsXPathObject particleset_elec("//particleset[@name='e']", doc.getXPathContext());
+  REQUIRE(particleset_elec.size() == 1);
+  parse_elec.readXML(particleset_elec[0]);
+
+  elec.R = 0.0;
+  elec.addTable(ions);
+  elec.update();
+
+  Libxml2Document doc2;
+  okay = doc2.parse("ethanol.wfnoj.xml");
+  REQUIRE(okay);
+
+  WaveFunctionComponentBuilder::PSetMap particle_set_map;
+  particle_set_map.emplace(elec_ptr->getName(), std::move(elec_ptr));
+  particle_set_map.emplace(ions_ptr->getName(), std::move(ions_ptr));
+
+  SPOSetBuilderFactory bf(c, elec, particle_set_map);
+
+  OhmmsXPathObject MO_base("//determinantset", doc2.getXPathContext());
+  REQUIRE(MO_base.size() == 1);
+  if (!transform)
+  {
+    xmlSetProp(MO_base[0], castCharToXMLChar("transform"), castCharToXMLChar("no"));
+    xmlSetProp(MO_base[0], castCharToXMLChar("key"), castCharToXMLChar("GTO"));
+  }
+  xmlSetProp(MO_base[0], castCharToXMLChar("cuspCorrection"), castCharToXMLChar("no"));
+
+  const auto bb_ptr = bf.createSPOSetBuilder(MO_base[0]);
+  auto& bb(*bb_ptr);
+
+  OhmmsXPathObject slater_base("//determinant", doc2.getXPathContext());
+  xmlSetProp(slater_base[0], castCharToXMLChar("screening"), castCharToXMLChar("yes"));
+  auto sposet = bb.createSPOSet(slater_base[0]);
+  auto& lcao  = dynamic_cast<LCAOrbitalSet&>(*sposet);
+  REQUIRE(lcao.isCenterScreening());
+
+  // walker 1 is next to the molecule, walker 2 is far beyond the cutoff radius of all the centers
+  ParticleSet elec_2(elec);
+  elec.R[0] = {0.0001, 0.0, 0.0};
+  elec.update();
+  elec_2.R[0] = {1000.0, 0.0, 0.0};
+  elec_2.update();
+
+  const size_t n_mo = sposet->getOrbitalSetSize();
+  SPOSet::ValueVector psiref(n_mo);
+  SPOSet::GradVector dpsiref(n_mo);
+  SPOSet::ValueVector d2psiref(n_mo);
+  sposet->evaluateVGL(elec, 0, psiref, dpsiref, d2psiref);
+
+  std::unique_ptr<SPOSet> sposet_2(sposet->makeClone());
+  RefVectorWithLeader<SPOSet> spo_list(*sposet, {*sposet, *sposet_2});
+  RefVectorWithLeader<ParticleSet> P_list(elec, {elec, elec_2});
+
+  SPOSet::ValueVector psi_1(n_mo), psi_2(n_mo);
+  SPOSet::GradVector dpsi_1(n_mo), dpsi_2(n_mo);
+  SPOSet::ValueVector d2psi_1(n_mo), d2psi_2(n_mo);
+  RefVector<SPOSet::ValueVector> psi_list   = {psi_1, psi_2};
+  RefVector<SPOSet::GradVector> dpsi_list   = {dpsi_1, dpsi_2};
+  RefVector<SPOSet::ValueVector> d2psi_list = {d2psi_1, d2psi_2};
+
+  ResourceCollection pset_res("test_pset_res");
+  ResourceCollection spo_res("test_spo_res");
+  elec.createResource(pset_res);
+  sposet->createResource(spo_res);
+  ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, P_list);
+  ResourceCollectionTeamLock<SPOSet> mw_sposet_lock(spo_res, spo_list);
+
+  sposet->mw_evaluateVGL(spo_list, P_list, 0, psi_list, dpsi_list, d2psi_list);
+
+  for (size_t iorb = 0; iorb < n_mo; iorb++)
+  {
+    CHECK(std::real(psi_1[iorb]) == Approx(std::real(psiref[iorb])));
+    CHECK(std::real(d2psi_1[iorb]) == Approx(std::real(d2psiref[iorb])));
+    for (size_t idim = 0; idim < SPOSet::DIM; idim++)
+      CHECK(std::real(dpsi_1[iorb][idim]) == Approx(std::real(dpsiref[iorb][idim])));
+    CHECK(std::real(psi_2[iorb]) == Approx(0.0));
+  }
+  // all centers are within the cutoff radius of the first walker
+  CHECK(lcao.getScreenedBasisFraction() == Approx(1.0));
+
+  // move the first walker far away as well, no basis function is needed.
+  P_list[0].R[0] = {0.0, -1000.0, 0.0};
+  P_list[0].update();
+  sposet->mw_evaluateVGL(spo_list, P_list, 0, psi_list, dpsi_list, d2psi_list);
+  for (size_t iorb = 0; iorb < n_mo; iorb++)
+  {
+    CHECK(std::real(psi_1[iorb]) == Approx(0.0));
+    CHECK(std::real(d2psi_1[iorb]) == Approx(0.0));
+  }
+  CHECK(lcao.getScreenedBasisFraction() == Approx(0.5));
+}
+
+TEST_CASE("mw_evaluate screened Numerical EtOH", "[wavefunction]") { test_EtOH_mw_screened(true); }
+TEST_CASE("mw_evaluate screened GTO EtOH", "[wavefunction]") { test_EtOH_mw_screened(false); }
+
+void test_EtOH_mw_many_walkers(bool transform)
+{
+  Communicate* c = OHMMS::Controller;
+
+  Libxml2Document doc;
+  bool okay = doc.parse("ethanol.structure.xml");
+  REQUIRE(okay);
+
+  const SimulationCell simulation_cell;
+  auto ions_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto& ions(*ions_ptr);
+  XMLParticleParser parse_ions(ions);
+  OhmmsXPathObject particleset_ion("//particleset[@name='ion0']", doc.getXPathContext());
+  REQUIRE(particleset_ion.size() == 1);
+  parse_ions.readXML(particleset_ion[0]);
+  ions.update();
+
+  auto elec_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto& elec(*elec_ptr);
+  XMLParticleParser parse_elec(elec);
+  OhmmsXPathObject particleset_elec("//particleset[@name='e']", doc.getXPathContext());
+  REQUIRE(particleset_elec.size() == 1);
+  parse_elec.readXML(particleset_elec[0]);
+
+  elec.R = 0.0;
+  elec.addTable(ions);
+  elec.update();
+
+  Libxml2Document doc2;
+  okay = doc2.parse("ethanol.wfnoj.xml");
+  REQUIRE(okay);
+
+  WaveFunctionComponentBuilder::PSetMap particle_set_map;
+  particle_set_map.emplace(elec_ptr->getName(), std::move(elec_ptr));
+  particle_set_map.emplace(ions_ptr->getName(), std::move(ions_ptr));
+
+  SPOSetBuilderFactory bf(c, elec, particle_set_map);
+
+  OhmmsXPathObject MO_base("//determinantset", doc2.getXPathContext());
+  REQUIRE(MO_base.size() == 1);
+  if (!transform)
+  {
+    xmlSetProp(MO_base[0], castCharToXMLChar("transform"), castCharToXMLChar("no"));
+    xmlSetProp(MO_base[0], castCharToXMLChar("key"), castCharToXMLChar("GTO"));
+  }
+  xmlSetProp(MO_base[0], castCharToXMLChar("cuspCorrection"), castCharToXMLChar("no"));
+
+  const auto bb_ptr = bf.createSPOSetBuilder(MO_base[0]);
+  auto& bb(*bb_ptr);
+
+  OhmmsXPathObject slater_base("//determinant", doc2.getXPathContext());
+  auto sposet = bb.createSPOSet(slater_base[0]);
+
+  // more walkers than electrons processed together by the batched atomic basis kernels, including a partial tile
+  const size_t nw   = 37;
+  const size_t n_mo = sposet->getOrbitalSetSize();
+  std::vector<ParticleSet> elecs(nw, elec);
+  std::vector<std::unique_ptr<SPOSet>> spos(nw);
+  std::vector<SPOSet::ValueVector> psi(nw, SPOSet::ValueVector(n_mo)), psi_v(nw, SPOSet::ValueVector(n_mo));
+  std::vector<SPOSet::ValueVector> d2psi(nw, SPOSet::ValueVector(n_mo));
+  std::vector<SPOSet::GradVector> dpsi(nw, SPOSet::GradVector(n_mo));
+  RefVectorWithLeader<SPOSet> spo_list(*sposet);
+  RefVectorWithLeader<ParticleSet> P_list(elecs[0]);
+  RefVector<SPOSet::ValueVector> psi_list, psi_v_list, d2psi_list;
+  RefVector<SPOSet::GradVector> dpsi_list;
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    elecs[iw].R[0] = {0.1 * iw - 1.5, 0.03 * iw, -0.05 * iw};
+    elecs[iw].update();
+    spos[iw] = sposet->makeClone();
+    spo_list.push_back(*spos[iw]);
+    P_list.push_back(elecs[iw]);
+    psi_list.push_back(psi[iw]);
+    psi_v_list.push_back(psi_v[iw]);
+    dpsi_list.push_back(dpsi[iw]);
+    d2psi_list.push_back(d2psi[iw]);
+  }
+
+  ResourceCollection pset_res("test_pset_res");
+  ResourceCollection spo_res("test_spo_res");
+  elec.createResource(pset_res);
+  sposet->createResource(spo_res);
+  {
+    ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, P_list);
+    ResourceCollectionTeamLock<SPOSet> mw_sposet_lock(spo_res, spo_list);
+    spo_list.getLeader().mw_evaluateVGL(spo_list, P_list, 0, psi_list, dpsi_list, d2psi_list);
+    spo_list.getLeader().mw_evaluateValue(spo_list, P_list, 0, psi_v_list);
+
+    // the host build evaluates the basis of all the walkers with the tile kernels, not walker by walker
+    auto& lcao = dynamic_cast<LCAOrbitalSet&>(*sposet);
+    REQUIRE(!lcao.isOMPoffload());
+    REQUIRE(!lcao.isCenterScreening());
+    if (transform)
+      CHECK(testing::TestSoaAtomicBasisSet::usedHostTiles<MultiQuinticSpline1D<QMCTraits::RealType>>(
+          *lcao.myBasisSet));
+    else
+      CHECK(testing::TestSoaAtomicBasisSet::usedHostTiles<MultiFunctorAdapter<GaussianCombo<QMCTraits::RealType>>>(
+          *lcao.myBasisSet));
+  }
+
+  SPOSet::ValueVector psiref(n_mo), d2psiref(n_mo);
+  SPOSet::GradVector dpsiref(n_mo);
+  for (size_t iw = 0; iw < nw; iw++)
+  {
+    spos[iw]->evaluateVGL(elecs[iw], 0, psiref, dpsiref, d2psiref);
+    for (size_t iorb = 0; iorb < n_mo; iorb++)
+    {
+      CHECK(std::real(psi[iw][iorb]) == Approx(std::real(psiref[iorb])));
+      CHECK(std::real(psi_v[iw][iorb]) == Approx(std::real(psiref[iorb])));
+      CHECK(std::real(d2psi[iw][iorb]) == Approx(std::real(d2psiref[iorb])));
+      for (size_t idim = 0; idim < SPOSet::DIM; idim++)
+        CHECK(std::real(dpsi[iw][iorb][idim]) == Approx(std::real(dpsiref[iorb][idim])));
+    }
+  }
+}
+
+TEST_CASE("mw_evaluate many walkers Numerical EtOH", "[wavefunction]") { test_EtOH_mw_many_walkers(true); }
+TEST_CASE("mw_evaluate many walkers GTO EtOH", "[wavefunction]") { test_EtOH_mw_many_walkers(false); }
+
 void test_Ne(bool transform)
 {
   std::ostringstream section_name;
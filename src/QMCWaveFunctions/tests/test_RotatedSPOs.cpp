@@ -558,6 +558,59 @@ TEST_CASE("RotatedSPOs exp-log matrix", "[wavefunction]")
 #endif
 }
 
+TEST_CASE("RotatedSPOs occupied-virtual exponential", "[wavefunction]")
+{
+  using ValueType   = SPOSet::ValueType;
+  using ValueMatrix = SPOSet::ValueMatrix;
+
+  int nel = 2;
+  int nmo = 5;
+  RotatedSPOs::RotationIndices rot_ind;
+  RotatedSPOs::createRotationIndices(nel, nmo, rot_ind);
+  RotatedSPOs::RotationIndices full_rot_ind;
+  RotatedSPOs::createRotationIndicesFull(nel, nmo, full_rot_ind);
+
+  CHECK(RotatedSPOs::getOccVirtBlockSize(rot_ind) == nel);
+  CHECK(RotatedSPOs::getOccVirtBlockSize(full_rot_ind) == 0);
+
+  std::vector<ValueType> params = {0.3, -0.2, 0.15, -0.1, 0.25, 0.05};
+
+  ValueMatrix kappa(nmo, nmo);
+  RotatedSPOs::constructAntiSymmetricMatrix(rot_ind, params, kappa);
+
+  ValueMatrix dense_exp(kappa);
+  RotatedSPOs::exponentiate_antisym_matrix(dense_exp);
+  ValueMatrix block_exp(kappa);
+  RotatedSPOs::exponentiate_occ_virt_matrix(nel, block_exp);
+
+  CheckMatrixResult check_exp = checkMatrix(block_exp, dense_exp, true);
+  CHECKED_ELSE(check_exp.result) { FAIL(check_exp.result_message); }
+
+  // zero rotation goes through the small eigenvalue branch
+  ValueMatrix zero_exp(nmo, nmo);
+  zero_exp = ValueType(0);
+  RotatedSPOs::exponentiate_occ_virt_matrix(nel, zero_exp);
+  for (int i = 0; i < nmo; i++)
+    for (int j = 0; j < nmo; j++)
+      CHECK(zero_exp[i][j] == ValueApprox(ValueType(i == j ? 1.0 : 0.0)));
+
+  // accumulate onto a general rotation, compare to the dense product done by constructDeltaRotation
+  std::vector<ValueType> old_params(full_rot_ind.size());
+  for (int i = 0; i < old_params.size(); i++)
+    old_params[i] = 0.1 * (i % 3) - 0.05 * i;
+  ValueMatrix accumulated(nmo, nmo);
+  RotatedSPOs::constructAntiSymmetricMatrix(full_rot_ind, old_params, accumulated);
+  RotatedSPOs::exponentiate_antisym_matrix(accumulated);
+  RotatedSPOs::applyOccVirtRotation(nel, kappa, accumulated);
+
+  std::vector<ValueType> new_params(full_rot_ind.size());
+  ValueMatrix expected(nmo, nmo);
+  RotatedSPOs::constructDeltaRotation(params, old_params, rot_ind, full_rot_ind, new_params, expected);
+
+  CheckMatrixResult check_acc = checkMatrix(accumulated, expected, true);
+  CHECKED_ELSE(check_acc.result) { FAIL(check_acc.result_message); }
+}
+
 TEST_CASE("RotatedSPOs hcpBe", "[wavefunction]")
 {
   //until the parameter passing issue gets worked out, we won't do this test, since ostensibly
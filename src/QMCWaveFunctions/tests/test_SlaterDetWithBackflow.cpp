@@ -0,0 +1,366 @@
+//////////////////////////////////////////////////////////////////////////////////////
+// This file is distributed under the University of Illinois/NCSA Open Source License.
+// See LICENSE file in top directory for details.
+//
+// Copyright (c) 2024 QMCPACK developers.
+//
+// File developed by: QMCPACK developers
+//
+// File created by: QMCPACK developers
+//////////////////////////////////////////////////////////////////////////////////////
+
+#include "catch.hpp"
+
+#include "OhmmsData/Libxml2Doc.h"
+#include "Particle/ParticleSet.h"
+#include "QMCWaveFunctions/ElectronGas/FreeOrbital.h"
+#include "QMCWaveFunctions/Fermion/BackflowBuilder.h"
+#include "QMCWaveFunctions/Fermion/BackflowTransformation.h"
+#include "QMCWaveFunctions/Fermion/SlaterDetWithBackflow.h"
+#include <ResourceCollection.h>
+#include <algorithm>
+
+namespace qmcplusplus
+{
+using RealType     = QMCTraits::RealType;
+using PosType      = QMCTraits::PosType;
+using LogValue     = WaveFunctionComponent::LogValue;
+using PsiValue     = WaveFunctionComponent::PsiValue;
+using GradType     = WaveFunctionComponent::GradType;
+using WFBufferType = WaveFunctionComponent::WFBufferType;
+
+namespace
+{
+std::unique_ptr<BackflowTransformation> createBackflow(ParticleSet& elec, const std::string& qptol = "1e-10")
+{
+  const std::string bf_xml = R"(<backflow qptol=")" + qptol + R"(">
+  <transformation name="eeB" type="e-e" function="Bspline">
+    <correlation cusp="0.0" size="4" type="shortrange" init="no" speciesA="u" speciesB="u" rcut="1.6">
+      <coefficients id="uuB" type="Array"> 0.12 0.08 0.04 0.01 </coefficients>
+    </correlation>
+    <correlation cusp="0.0" size="4" type="shortrange" init="no" speciesA="u" speciesB="d" rcut="1.6">
+      <coefficients id="udB" type="Array"> 0.10 0.06 0.03 0.01 </coefficients>
+    </correlation>
+  </transformation>
+</backflow>)";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(bf_xml));
+
+  const std::map<std::string, const std::unique_ptr<ParticleSet>> pool;
+  BackflowBuilder bf_builder(elec, pool);
+  return bf_builder.buildBackflowTransformation(doc.getRoot());
+}
+
+std::unique_ptr<SlaterDetWithBackflow> createBackflowSlaterDet(
+    ParticleSet& elec,
+    const std::string& qptol                             = "1e-10",
+    std::vector<DiracDeterminantWithBackflow*>* det_ptrs = nullptr)
+{
+  auto bf = createBackflow(elec, qptol);
+
+  // five orbitals per spin
+#ifdef QMC_COMPLEX
+  const std::vector<PosType> kup{{0, 0, 0}, {0.5, 0.3, 0.1}, {-0.5, -0.3, -0.1}, {0.1, -0.4, 0.6}, {-0.1, 0.4, -0.6}};
+  const std::vector<PosType> kdn{{0, 0, 0}, {0.3, -0.5, 0.2}, {-0.3, 0.5, -0.2}, {0.6, 0.1, -0.4}, {-0.6, -0.1, 0.4}};
+#else
+  const std::vector<PosType> kup{{0, 0, 0}, {0.5, 0.3, 0.1}, {0.1, -0.4, 0.6}};
+  const std::vector<PosType> kdn{{0, 0, 0}, {0.3, -0.5, 0.2}, {0.6, 0.1, -0.4}};
+#endif
+  std::vector<std::unique_ptr<DiracDeterminantWithBackflow>> dets;
+  dets.push_back(
+      std::make_unique<DiracDeterminantWithBackflow>(std::make_unique<FreeOrbital>("free_up", kup), *bf, 0, 5));
+  dets.push_back(
+      std::make_unique<DiracDeterminantWithBackflow>(std::make_unique<FreeOrbital>("free_dn", kdn), *bf, 5, 10));
+  if (det_ptrs)
+    for (auto& det : dets)
+      det_ptrs->push_back(det.get());
+  return std::make_unique<SlaterDetWithBackflow>(elec, std::move(dets), std::move(bf));
+}
+
+/// log(psi) and its gradient at particle iat from scratch
+LogValue referenceLog(const ParticleSet& elec, const WaveFunctionComponent& psi, int iat, GradType& grad)
+{
+  ParticleSet elec_ref(elec);
+  elec_ref.update();
+  auto psi_ref = psi.makeClone(elec_ref);
+  ParticleSet::ParticleGradient G(elec.getTotalNum());
+  ParticleSet::ParticleLaplacian L(elec.getTotalNum());
+  G                     = 0.0;
+  L                     = 0.0;
+  const LogValue logpsi = psi_ref->evaluateLog(elec_ref, G, L);
+  grad                  = G[iat];
+  return logpsi;
+}
+} // namespace
+
+TEST_CASE("SlaterDetWithBackflow low-rank update", "[wavefunction][fermion]")
+{
+  const SimulationCell simulation_cell;
+  ParticleSet elec(simulation_cell);
+  elec.setName("e");
+  elec.create({5, 5});
+  // pairs closer than the backflow cutoff move several quasi-particles at once
+  elec.R[0] = {0.0, 0.0, 0.0};
+  elec.R[1] = {0.7, 0.1, -0.2};
+  elec.R[2] = {3.0, 0.5, 0.3};
+  elec.R[3] = {-2.5, 1.8, 0.6};
+  elec.R[4] = {0.4, -3.1, 1.2};
+  elec.R[5] = {0.3, 0.6, 0.4};
+  elec.R[6] = {3.4, -0.3, -0.5};
+  elec.R[7] = {-1.2, 2.9, -1.7};
+  elec.R[8] = {1.9, 1.7, 2.8};
+  elec.R[9] = {-3.0, -2.2, -0.9};
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  const int upIdx              = tspecies.addSpecies("u");
+  const int downIdx            = tspecies.addSpecies("d");
+  const int chargeIdx          = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+
+  auto psi = createBackflowSlaterDet(elec);
+  elec.update();
+
+  WFBufferType buf;
+  psi->registerData(elec, buf);
+
+  GradType grad_ref;
+  LogValue log_old = referenceLog(elec, *psi, 0, grad_ref);
+
+  const std::vector<PosType> displs{{0.1, -0.05, 0.2}, {-0.2, 0.1, 0.05}, {0.05, 0.15, -0.1}};
+  for (int step = 0; step < 2; step++)
+    for (int iat = 0; iat < elec.getTotalNum(); iat++)
+    {
+      const PosType& dr = displs[(iat + step) % displs.size()];
+      elec.makeMove(iat, dr);
+      PsiValue ratio;
+      GradType grad_new;
+      // the first sweep updates the inverse in ratioGrad, the second one delays it to acceptMove
+      if (step == 0)
+        ratio = psi->ratioGrad(elec, iat, grad_new);
+      else
+        ratio = psi->ratio(elec, iat);
+
+      ParticleSet elec_new(elec);
+      elec_new.R[iat] = elec.R[iat] + dr;
+      const LogValue log_new   = referenceLog(elec_new, *psi, iat, grad_ref);
+      const PsiValue ratio_ref = LogToValue<PsiValue>::convert(log_new - log_old);
+      CHECK(std::real(ratio) == Approx(std::real(ratio_ref)));
+      CHECK(std::imag(ratio) == Approx(std::imag(ratio_ref)));
+      if (step == 0)
+        for (int idim = 0; idim < OHMMS_DIM; idim++)
+          CHECK(std::real(grad_new[idim]) == Approx(std::real(grad_ref[idim])));
+
+      // reject every third move
+      if (iat % 3 == 2)
+      {
+        psi->restore(iat);
+        elec.rejectMove(iat);
+      }
+      else
+      {
+        psi->acceptMove(elec, iat);
+        elec.acceptMove(iat);
+        log_old = log_new;
+      }
+    }
+}
+
+TEST_CASE("BackflowTransformation qptol", "[wavefunction][fermion]")
+{
+  const SimulationCell simulation_cell;
+  ParticleSet elec(simulation_cell);
+  elec.setName("e");
+  elec.create({5, 5});
+  for (int i = 0; i < 10; i++)
+    elec.R[i] = {0.7 * (i % 4) - 1.0, 0.5 * (i % 3) - 0.5, 0.3 * i - 1.4};
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  const int upIdx              = tspecies.addSpecies("u");
+  const int downIdx            = tspecies.addSpecies("d");
+  const int chargeIdx          = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+
+  // a loose tolerance leaves the small shifts out of indexQP
+  auto bf = createBackflow(elec, "0.05");
+  CHECK(bf->qpTolerance == Approx(0.05));
+  elec.update();
+  bf->evaluate(elec);
+
+  const std::vector<PosType> displs{{0.1, -0.05, 0.2}, {-0.2, 0.1, 0.05}, {0.05, 0.15, -0.1}};
+  int num_skipped = 0;
+  for (int iat = 0; iat < elec.getTotalNum(); iat++)
+  {
+    elec.makeMove(iat, displs[iat % displs.size()]);
+    bf->evaluatePbyP(elec, iat);
+    for (int jat = 0; jat < elec.getTotalNum(); jat++)
+    {
+      const PosType dr = bf->newQP[jat] - bf->QP.R[jat];
+      if (dot(dr, dr) > 0 && std::find(bf->indexQP.begin(), bf->indexQP.end(), jat) == bf->indexQP.end())
+        num_skipped++;
+    }
+    bf->acceptMove(elec, iat);
+    elec.acceptMove(iat);
+  }
+  CHECK(num_skipped > 0);
+
+  // the quasi-particles below the tolerance are still moved
+  auto bf_ref = createBackflow(elec);
+  bf_ref->evaluate(elec);
+  for (int iat = 0; iat < elec.getTotalNum(); iat++)
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+      CHECK(bf->QP.R[iat][idim] == Approx(bf_ref->QP.R[iat][idim]));
+}
+
+TEST_CASE("SlaterDetWithBackflow qptol", "[wavefunction][fermion]")
+{
+  const SimulationCell simulation_cell;
+  ParticleSet elec(simulation_cell);
+  elec.setName("e");
+  elec.create({5, 5});
+  for (int i = 0; i < 10; i++)
+    elec.R[i] = {0.7 * (i % 4) - 1.0, 0.5 * (i % 3) - 0.5, 0.3 * i - 1.4};
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  const int upIdx              = tspecies.addSpecies("u");
+  const int downIdx            = tspecies.addSpecies("d");
+  const int chargeIdx          = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+
+  const std::string qptol = "0.002";
+  std::vector<DiracDeterminantWithBackflow*> dets;
+  auto psi                   = createBackflowSlaterDet(elec, qptol, &dets);
+  BackflowTransformation& bf = dets[0]->BFTrans_;
+  elec.update();
+  WFBufferType buf;
+  psi->registerData(elec, buf);
+
+  // small steps of one electron shift its neighbours by less than qptol each time
+  const PosType step{0.004, -0.002, 0.003};
+  int num_skipped = 0;
+  for (int istep = 0; istep < 80; istep++)
+  {
+    const int iat = istep % 2;
+    elec.makeMove(iat, step);
+    psi->ratio(elec, iat);
+    for (int jat = 0; jat < elec.getTotalNum(); jat++)
+    {
+      const PosType dr = bf.newQP[jat] - bf.QP.R[jat];
+      if (dot(dr, dr) > 0 && std::find(bf.indexQP.begin(), bf.indexQP.end(), jat) == bf.indexQP.end())
+        num_skipped++;
+    }
+    psi->acceptMove(elec, iat);
+    elec.acceptMove(iat);
+  }
+  CHECK(num_skipped > 0);
+
+  // the determinant columns stay within qptol of the quasi-particles
+  for (int jat = 0; jat < elec.getTotalNum(); jat++)
+  {
+    const PosType dr = bf.QP.R[jat] - bf.detQP[jat];
+    CHECK(std::sqrt(dot(dr, dr)) <= bf.qpTolerance);
+  }
+
+  // log values and inverses agree with a fresh evaluation up to the column shifts below qptol
+  ParticleSet elec_ref(elec);
+  elec_ref.update();
+  std::vector<DiracDeterminantWithBackflow*> dets_ref;
+  auto psi_ref = createBackflowSlaterDet(elec_ref, qptol, &dets_ref);
+  ParticleSet::ParticleGradient G(elec.getTotalNum());
+  ParticleSet::ParticleLaplacian L(elec.getTotalNum());
+  G = 0.0;
+  L = 0.0;
+  psi_ref->evaluateLog(elec_ref, G, L);
+  for (int idet = 0; idet < dets.size(); idet++)
+  {
+    CHECK(std::real(dets[idet]->get_log_value()) == Approx(std::real(dets_ref[idet]->get_log_value())).margin(0.01));
+    CHECK(std::imag(dets[idet]->get_log_value()) == Approx(std::imag(dets_ref[idet]->get_log_value())).margin(0.01));
+    auto& minv     = dets[idet]->getPsiMinv();
+    auto& minv_ref = dets_ref[idet]->getPsiMinv();
+    for (int i = 0; i < minv.rows(); i++)
+      for (int j = 0; j < minv.cols(); j++)
+      {
+        CHECK(std::real(minv(i, j)) == Approx(std::real(minv_ref(i, j))).epsilon(0.01));
+        CHECK(std::imag(minv(i, j)) == Approx(std::imag(minv_ref(i, j))).epsilon(0.01));
+      }
+  }
+}
+
+TEST_CASE("SlaterDetWithBackflow batched", "[wavefunction][fermion]")
+{
+  const SimulationCell simulation_cell;
+  ParticleSet elec(simulation_cell);
+  elec.setName("e");
+  elec.create({5, 5});
+  for (int i = 0; i < 10; i++)
+    elec.R[i] = {0.9 * (i % 4) - 1.2, 0.6 * (i % 3) - 0.5, 0.35 * i - 1.5};
+  SpeciesSet& tspecies         = elec.getSpeciesSet();
+  const int upIdx              = tspecies.addSpecies("u");
+  const int downIdx            = tspecies.addSpecies("d");
+  const int chargeIdx          = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+
+  auto psi = createBackflowSlaterDet(elec);
+
+  ParticleSet elec_clone(elec);
+  elec_clone.R[3] = {0.2, 0.1, -0.4};
+  auto psi_clone   = psi->makeClone(elec_clone);
+
+  ResourceCollection pset_res("test_pset_res");
+  elec.createResource(pset_res);
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec_clone});
+  RefVectorWithLeader<WaveFunctionComponent> wfc_list(*psi, {*psi, *psi_clone});
+  ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, p_list);
+
+  ParticleSet::mw_update(p_list);
+  WFBufferType buf, buf_clone;
+  psi->registerData(elec, buf);
+  psi_clone->registerData(elec_clone, buf_clone);
+
+  const int nw = 2;
+  std::vector<LogValue> log_old(nw);
+  GradType grad_ref;
+  for (int iw = 0; iw < nw; iw++)
+    log_old[iw] = referenceLog(p_list[iw], wfc_list[iw], 0, grad_ref);
+
+  std::vector<PosType> displ{{0.15, -0.1, 0.05}, {-0.1, 0.2, 0.1}};
+  std::vector<PsiValue> ratios(nw);
+  std::vector<GradType> grads(nw);
+  const std::vector<bool> isAccepted{true, false};
+  for (int step = 0; step < 2; step++)
+    for (int iat = 0; iat < elec.getTotalNum(); iat++)
+    {
+      ParticleSet::mw_makeMove(p_list, iat, displ);
+      std::vector<LogValue> log_new(nw);
+      std::vector<GradType> grads_ref(nw);
+      for (int iw = 0; iw < nw; iw++)
+      {
+        ParticleSet elec_new(p_list[iw]);
+        elec_new.R[iat] = p_list[iw].R[iat] + displ[iw];
+        log_new[iw]     = referenceLog(elec_new, wfc_list[iw], iat, grads_ref[iw]);
+      }
+
+      if (step == 0)
+      {
+        std::fill(grads.begin(), grads.end(), GradType(0));
+        psi->mw_ratioGrad(wfc_list, p_list, iat, ratios, grads);
+      }
+      else
+        psi->mw_calcRatio(wfc_list, p_list, iat, ratios);
+      for (int iw = 0; iw < nw; iw++)
+      {
+        const PsiValue ratio_ref = LogToValue<PsiValue>::convert(log_new[iw] - log_old[iw]);
+        CHECK(std::real(ratios[iw]) == Approx(std::real(ratio_ref)));
+        if (step == 0)
+          for (int idim = 0; idim < OHMMS_DIM; idim++)
+            CHECK(std::real(grads[iw][idim]) == Approx(std::real(grads_ref[iw][idim])));
+      }
+
+      psi->mw_accept_rejectMove(wfc_list, p_list, iat, isAccepted);
+      ParticleSet::mw_accept_rejectMove(p_list, iat, isAccepted);
+      for (int iw = 0; iw < nw; iw++)
+        if (isAccepted[iw])
+          log_old[iw] = log_new[iw];
+    }
+}
+} // namespace qmcplusplus
@@ -20,6 +20,9 @@
 #include "QMCWaveFunctions/Jastrow/CountingGaussianRegion.h"
 #include "QMCWaveFunctions/Jastrow/CountingJastrow.h"
 #include "QMCWaveFunctions/Jastrow/CountingJastrowBuilder.h"
+#include "Particle/VirtualParticleSet.h"
+#include <ResourceCollection.h>
+#include "checkMultiWalkerWFC.h"
 
 #include <stdio.h>
 
@@ -397,4 +400,84 @@ TEST_CASE("CountingJastrow", "[wavefunction]")
 #endif
 }
 
+TEST_CASE("CountingJastrow batched", "[wavefunction]")
+{
+  Communicate* c = OHMMS::Controller;
+
+  const SimulationCell simulation_cell;
+  ParticleSet elec(simulation_cell);
+  const int num_els = 4;
+  elec.setName("e");
+  elec.create({num_els});
+  elec.R[0] = {2.4601162537, 6.7476360528, -1.9073129953};
+  elec.R[1] = {2.2585811248, 2.1282254384, 0.051545776028};
+  elec.R[2] = {0.84796873937, 5.1735597110, 0.84642416761};
+  elec.R[3] = {3.1597337850, 5.1079432473, 1.0545953717};
+
+  const char* cj_normgauss_xml = R"(<jastrow name="ncjf_normgauss" type="Counting">
+      <var name="F" opt="true">
+        4.4903e-01 5.3502e-01 5.2550e-01 6.8081e-01
+                   5.1408e-01 4.8658e-01 6.2182e-01
+                              2.7189e-01 9.4951e-01
+                                         0.0000e+00
+      </var>
+      <region type="normalized_gaussian" reference_id="g0" opt="true" >
+        <function id="g0">
+          <var name="A" opt="False">-1.0 -0.0 -0.0 -1.0 -0.0 -1.0</var>
+          <var name="B" opt="False">-2.6136335251 -5.01928226905 0.0</var>
+          <var name="C" opt="False">-32.0242747</var>
+        </function>
+        <function id="g1">
+          <var name="A" opt="true">-1.0 -0.0 -0.0 -1.0 -0.0 -1.0</var>
+          <var name="B" opt="true">-3.74709851168 -3.70007145722 0.0</var>
+          <var name="C" opt="true">-27.7312760448</var>
+        </function>
+        <function id="g2">
+          <var name="A" opt="true">-1.0 -0.0 -0.0 -1.0 -0.0 -1.0</var>
+          <var name="B" opt="true">-6.11011670935 -1.66504047682 0.0</var>
+          <var name="C" opt="true">-40.1058859913</var>
+        </function>
+        <function id="g3">
+          <var name="A" opt="true">-1.0 -0.0 -0.0 -1.0 -0.0 -1.0</var>
+          <var name="B" opt="true">-8.10584803421 -7.78608266172 0.0</var>
+          <var name="C" opt="true">-126.327855569</var>
+        </function>
+      </region>
+    </jastrow>)";
+  Libxml2Document doc;
+  REQUIRE(doc.parseFromString(cj_normgauss_xml));
+  CountingJastrowBuilder cjb(c, elec);
+  auto cj = cjb.buildComponent(doc.getRoot());
+  REQUIRE(dynamic_cast<CountingJastrow<CountingGaussianRegion>*>(cj.get()) != nullptr);
+
+  ParticleSet elec_clone(elec);
+  elec_clone.R[1] = {2.5, 2.4, 0.3};
+  auto cj_clone   = cj->makeClone(elec_clone);
+
+  ResourceCollection pset_res("test_pset_res");
+  ResourceCollection wfc_res("test_wfc_res");
+  elec.createResource(pset_res);
+  cj->createResource(wfc_res);
+
+  RefVectorWithLeader<ParticleSet> p_list(elec, {elec, elec_clone});
+  RefVectorWithLeader<WaveFunctionComponent> cj_list(*cj, {*cj, *cj_clone});
+  ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, p_list);
+  ResourceCollectionTeamLock<WaveFunctionComponent> mw_wfc_lock(wfc_res, cj_list);
+
+  // single walker references
+  testing::SingleWalkerReferences refs(cj_list, p_list);
+  testing::checkMWEvaluateLog(cj_list, p_list, refs);
+  testing::checkMWParticleMoves(cj_list, p_list, refs,
+                                {{0.0984629815, 0.0144420719, 0.1334309321}, {-0.1026409581, 0.2289767772, 0.4901380586}});
+
+  testing::checkMWEvaluateGL(cj_list, p_list, refs);
+
+  // virtual particle ratios
+  const int nknot = 3;
+  VirtualParticleSet vp(elec, nknot), vp_clone(elec_clone, nknot);
+  vp.makeMoves(elec, 0, {{0.1, 0.2, 0.3}, {0.1, 0.3, 0.2}, {0.2, 0.1, 0.3}});
+  vp_clone.makeMoves(elec_clone, 3, {{0.02, 0.01, 0.03}, {0.02, 0.03, 0.01}, {0.03, 0.01, 0.02}});
+  testing::checkMWEvaluateRatios(cj_list, RefVectorWithLeader<const VirtualParticleSet>(vp, {vp, vp_clone}), refs);
+}
+
 } //namespace qmcplusplus
@@ -20,6 +20,7 @@
 #include "QMCWaveFunctions/Jastrow/kSpaceJastrow.h"
 #include "QMCWaveFunctions/Jastrow/kSpaceJastrowBuilder.h"
 #include "ParticleIO/LatticeIO.h"
+#include <ResourceCollection.h>
 
 #include <stdio.h>
 #include <string>
@@ -104,4 +105,182 @@ TEST_CASE("kspace jastrow", "[wavefunction]")
   double logpsi_real = std::real(jas->evaluateLog(elec_, elec_.G, elec_.L));
   CHECK(logpsi_real == Approx(-4.4088303951)); // !!!! value not checked
 }
+TEST_CASE("kspace jastrow batched", "[wavefunction]")
+{
+  using PosType  = QMCTraits::PosType;
+  using GradType = WaveFunctionComponent::GradType;
+  using PsiValue = WaveFunctionComponent::PsiValue;
+
+  Communicate* c = OHMMS::Controller;
+
+  const char* xmltext = R"(<tmp>
+  <simulationcell>
+     <parameter name="lattice" units="bohr">
+              6.00000000        0.00000000        0.00000000
+              0.00000000        6.00000000        0.00000000
+              0.00000000        0.00000000        6.00000000
+     </parameter>
+     <parameter name="bconds">
+        p p p
+     </parameter>
+     <parameter name="LR_dim_cutoff"> 15 </parameter>
+  </simulationcell>
+</tmp>)";
+  Libxml2Document doc;
+  bool okay = doc.parseFromString(xmltext);
+  REQUIRE(okay);
+
+  ParticleSet::ParticleLayout lattice;
+  LatticeParser lp(lattice);
+  lp.put(xmlFirstElementChild(doc.getRoot()));
+
+  const SimulationCell simulation_cell(lattice);
+  ParticleSet ions_(simulation_cell);
+  ParticleSet elec_(simulation_cell);
+
+  ions_.setName("ion");
+  ions_.create({1});
+  ions_.R[0] = {0.0, 0.0, 0.0};
+  elec_.setName("elec");
+  elec_.create({2, 2});
+  elec_.R[0]                   = {-0.28, 0.0225, -2.709};
+  elec_.R[1]                   = {-1.08389, 1.9679, -0.0128914};
+  elec_.R[2]                   = {1.2, -0.7, 0.45};
+  elec_.R[3]                   = {2.1, 1.3, -1.6};
+  SpeciesSet& tspecies         = elec_.getSpeciesSet();
+  int upIdx                    = tspecies.addSpecies("u");
+  int downIdx                  = tspecies.addSpecies("d");
+  int chargeIdx                = tspecies.addAttribute("charge");
+  tspecies(chargeIdx, upIdx)   = -1;
+  tspecies(chargeIdx, downIdx) = -1;
+  elec_.createSK();
+
+  const char* particles = R"(<tmp>
+<jastrow name="Jk" type="kSpace" source="ion">
+  <correlation kc="1.5" type="One-Body" symmetry="isotropic">
+    <coefficients id="cG1" type="Array">
+      0.3 0.1 -0.2 0.05
+    </coefficients>
+  </correlation>
+  <correlation kc="1.5" type="Two-Body" symmetry="isotropic">
+    <coefficients id="cG2" type="Array">
+      -100. -50.
+    </coefficients>
+  </correlation>
+</jastrow>
+</tmp>
+)";
+  okay                  = doc.parseFromString(particles);
+  REQUIRE(okay);
+
+  kSpaceJastrowBuilder jastrow(c, elec_, ions_);
+  std::unique_ptr<WaveFunctionComponent> jas(jastrow.buildComponent(xmlFirstElementChild(doc.getRoot())));
+
+  ParticleSet elec_clone(elec_);
+  elec_clone.R[2] = {0.3, 1.1, -2.2};
+  auto jas_clone  = jas->makeClone(elec_clone);
+
+  ResourceCollection pset_res("test_pset_res");
+  ResourceCollection wfc_res("test_wfc_res");
+  elec_.createResource(pset_res);
+  jas->createResource(wfc_res);
+
+  RefVectorWithLeader<ParticleSet> p_ref_list(elec_, {elec_, elec_clone});
+  RefVectorWithLeader<WaveFunctionComponent> jas_ref_list(*jas, {*jas, *jas_clone});
+  ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, p_ref_list);
+  ResourceCollectionTeamLock<WaveFunctionComponent> mw_wfc_lock(wfc_res, jas_ref_list);
+
+  ParticleSet::mw_update(p_ref_list);
+  std::vector<ParticleSet::ParticleGradient> G_list(2);
+  std::vector<ParticleSet::ParticleLaplacian> L_list(2);
+  for (int iw = 0; iw < 2; iw++)
+  {
+    G_list[iw].resize(elec_.getTotalNum());
+    L_list[iw].resize(elec_.getTotalNum());
+  }
+  jas->mw_evaluateLog(jas_ref_list, p_ref_list, makeRefVector<ParticleSet::ParticleGradient>(G_list),
+                      makeRefVector<ParticleSet::ParticleLaplacian>(L_list));
+
+  // reference values are computed from scratch on a copy of each walker
+  auto evaluate_from_scratch = [&](const ParticleSet& P, ParticleSet::ParticleGradient& G,
+                                   ParticleSet::ParticleLaplacian& L) {
+    ParticleSet P_copy(P);
+    P_copy.update();
+    auto jas_copy = jas->makeClone(P_copy);
+    G.resize(P.getTotalNum());
+    L.resize(P.getTotalNum());
+    G = 0;
+    L = 0;
+    return std::real(jas_copy->evaluateLog(P_copy, G, L));
+  };
+
+  const int iat = 2;
+  std::vector<PosType> displ{{0.2, -0.1, 0.3}, {-0.4, 0.25, 0.1}};
+  ParticleSet::mw_makeMove(p_ref_list, iat, displ);
+
+  std::vector<PsiValue> ratios(2), ratios_grad(2);
+  std::vector<GradType> grad_new(2);
+  jas->mw_calcRatio(jas_ref_list, p_ref_list, iat, ratios);
+  jas->mw_ratioGrad(jas_ref_list, p_ref_list, iat, ratios_grad, grad_new);
+
+  std::vector<double> log_old(2), log_new(2);
+  std::vector<ParticleSet::ParticleGradient> G_ref(2);
+  std::vector<ParticleSet::ParticleLaplacian> L_ref(2);
+  for (int iw = 0; iw < 2; iw++)
+  {
+    ParticleSet& P = p_ref_list[iw];
+    log_old[iw]    = evaluate_from_scratch(P, G_ref[iw], L_ref[iw]);
+    ParticleSet P_moved(P);
+    P_moved.R[iat] = P.getActivePos();
+    log_new[iw]    = evaluate_from_scratch(P_moved, G_ref[iw], L_ref[iw]);
+
+    CHECK(std::real(ratios[iw]) == Approx(std::exp(log_new[iw] - log_old[iw])));
+    CHECK(std::real(ratios_grad[iw]) == Approx(std::exp(log_new[iw] - log_old[iw])));
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+      CHECK(std::real(grad_new[iw][idim]) == Approx(std::real(G_ref[iw][iat][idim])));
+  }
+
+  // accept the move on the first walker only
+  std::vector<bool> isAccepted{true, false};
+  jas->mw_accept_rejectMove(jas_ref_list, p_ref_list, iat, isAccepted);
+  ParticleSet::mw_accept_rejectMove(p_ref_list, iat, isAccepted);
+  ParticleSet::mw_donePbyP(p_ref_list);
+
+  for (int iw = 0; iw < 2; iw++)
+  {
+    G_list[iw] = 0;
+    L_list[iw] = 0;
+  }
+  jas->mw_evaluateGL(jas_ref_list, p_ref_list, makeRefVector<ParticleSet::ParticleGradient>(G_list),
+                     makeRefVector<ParticleSet::ParticleLaplacian>(L_list), false);
+  for (int iw = 0; iw < 2; iw++)
+  {
+    const double log_ref = evaluate_from_scratch(p_ref_list[iw], G_ref[iw], L_ref[iw]);
+    CHECK(std::real(jas_ref_list[iw].get_log_value()) == Approx(log_ref));
+    for (int jat = 0; jat < elec_.getTotalNum(); jat++)
+    {
+      for (int idim = 0; idim < OHMMS_DIM; idim++)
+        CHECK(std::real(G_list[iw][jat][idim]) == Approx(std::real(G_ref[iw][jat][idim])));
+      CHECK(std::real(L_list[iw][jat]) == Approx(std::real(L_ref[iw][jat])));
+    }
+  }
+
+  // e^{iG.r} taken from the per-particle structure factor gives the same value as the one computed from scratch
+  ParticleSet::ParticleGradient G_nosk;
+  ParticleSet::ParticleLaplacian L_nosk;
+  const double log_nosk = evaluate_from_scratch(elec_, G_nosk, L_nosk);
+  ParticleSet::ParticleGradient G_sk(elec_.getTotalNum());
+  ParticleSet::ParticleLaplacian L_sk(elec_.getTotalNum());
+  G_sk = 0;
+  L_sk = 0;
+  elec_.turnOnPerParticleSK();
+  elec_.update();
+  CHECK(std::real(jas->evaluateLog(elec_, G_sk, L_sk)) == Approx(log_nosk));
+  for (int jat = 0; jat < elec_.getTotalNum(); jat++)
+  {
+    for (int idim = 0; idim < OHMMS_DIM; idim++)
+      CHECK(std::real(G_sk[jat][idim]) == Approx(std::real(G_nosk[jat][idim])));
+    CHECK(std::real(L_sk[jat]) == Approx(std::real(L_nosk[jat])));
+  }
+}
 } // namespace qmcplusplus
@@ -22,6 +22,7 @@
 #include "ParticleBase/ParticleAttribOps.h"
 #include <ResourceCollection.h>
 #include "QMCHamiltonians/NLPPJob.h"
+#include "checkMultiWalkerWFC.h"
 
 #include <stdio.h>
 #include <string>
@@ -249,6 +250,12 @@ void test_J3_polynomial3D(const DynamicCoordinateKind kind_selected)
   CHECK(ValueApprox(nlpp_ratios[1][0]) == ValueType(1.0013145208));
   CHECK(ValueApprox(nlpp_ratios[1][1]) == ValueType(1.0011137724));
   CHECK(ValueApprox(nlpp_ratios[1][2]) == ValueType(1.0017225742));
+
+  // batched single particle moves against the single walker path
+  testing::SingleWalkerReferences refs(j3_ref_list, p_ref_list);
+  testing::checkMWEvaluateLog(j3_ref_list, p_ref_list, refs);
+  testing::checkMWParticleMoves(j3_ref_list, p_ref_list, refs, {{0.1, -0.2, 0.15}, {-0.05, 0.1, 0.2}});
+  testing::checkMWEvaluateGL(j3_ref_list, p_ref_list, refs);
 }
 
 TEST_CASE("PolynomialFunctor3D Jastrow", "[wavefunction]")
@@ -24,6 +24,8 @@
 #include "QMCWaveFunctions/LCAO/CuspCorrectionConstruction.h"
 
 #include "QMCWaveFunctions/SPOSetBuilderFactory.h"
+#include <ResourceCollection.h>
+#include <cstdio>
 
 namespace qmcplusplus
 {
@@ -548,6 +550,251 @@ TEST_CASE("Ethanol MO with cusp", "[wavefunction]")
 }
 
 
+void test_EtOH_cusp_batched(bool use_offload)
+{
+  Communicate* c = OHMMS::Controller;
+
+  Libxml2Document doc;
+  bool okay = doc.parse("ethanol.structure.xml");
+  REQUIRE(okay);
+
+  const SimulationCell simulation_cell;
+  auto ions_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto& ions(*ions_ptr);
+  XMLParticleParser parse_ions(ions);
+  OhmmsXPathObject particleset_ion("//particleset[@name='ion0']", doc.getXPathContext());
+  REQUIRE(particleset_ion.size() == 1);
+  parse_ions.readXML(particleset_ion[0]);
+  ions.update();
+
+  auto elec_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto& elec(*elec_ptr);
+  XMLParticleParser parse_elec(elec);
+  OhmmsXPathObject particleset_elec("//particleset[@name='e']", doc.getXPathContext());
+  REQUIRE(particleset_elec.size() == 1);
+  parse_elec.readXML(particleset_elec[0]);
+
+  elec.R = 0.0;
+  elec.addTable(ions);
+  elec.update();
+
+  Libxml2Document doc2;
+  okay = doc2.parse("ethanol.wfnoj.xml");
+  REQUIRE(okay);
+
+  WaveFunctionComponentBuilder::PSetMap particle_set_map;
+  particle_set_map.emplace(elec_ptr->getName(), std::move(elec_ptr));
+  particle_set_map.emplace(ions_ptr->getName(), std::move(ions_ptr));
+
+  SPOSetBuilderFactory bf(c, elec, particle_set_map);
+
+  OhmmsXPathObject MO_base("//determinantset", doc2.getXPathContext());
+  REQUIRE(MO_base.size() == 1);
+
+  xmlSetProp(MO_base[0], castCharToXMLChar("cuspCorrection"), castCharToXMLChar("yes"));
+  // the packed walker GEMM of the uncorrected orbitals runs with and without offload
+  if (use_offload)
+    xmlSetProp(MO_base[0], castCharToXMLChar("gpu"), castCharToXMLChar("omptarget"));
+
+  const auto bb_ptr = bf.createSPOSetBuilder(MO_base[0]);
+  auto& bb(*bb_ptr);
+
+  OhmmsXPathObject slater_base("//determinant", doc2.getXPathContext());
+  auto sposet = bb.createSPOSet(slater_base[0]);
+  std::unique_ptr<SPOSet> sposet_2(sposet->makeClone());
+
+  // walker 1 has electron 0 near the O atom, walker 2 near a C atom.
+  ParticleSet elec_2(elec);
+  elec.R[0] = {-2.10, 0.50, 0.0};
+  elec.update();
+  elec_2.R[0] = {2.31, 0.51, 0.02};
+  elec_2.update();
+
+  const size_t n_mo = sposet->getOrbitalSetSize();
+  SPOSet::ValueVector psiref_1(n_mo), psiref_2(n_mo);
+  SPOSet::GradVector dpsiref_1(n_mo), dpsiref_2(n_mo);
+  SPOSet::ValueVector d2psiref_1(n_mo), d2psiref_2(n_mo);
+  sposet->evaluateVGL(elec, 0, psiref_1, dpsiref_1, d2psiref_1);
+  sposet_2->evaluateVGL(elec_2, 0, psiref_2, dpsiref_2, d2psiref_2);
+  // from "Ethanol MO with cusp"
+  CHECK(psiref_1[0] == Approx(4.3617329704));
+  CHECK(d2psiref_1[0] == Approx(-293.2869628790));
+
+  RefVectorWithLeader<SPOSet> spo_list(*sposet, {*sposet, *sposet_2});
+  RefVectorWithLeader<ParticleSet> P_list(elec, {elec, elec_2});
+
+  ResourceCollection pset_res("test_pset_res");
+  ResourceCollection spo_res("test_spo_res");
+  elec.createResource(pset_res);
+  sposet->createResource(spo_res);
+  ResourceCollectionTeamLock<ParticleSet> mw_pset_lock(pset_res, P_list);
+  ResourceCollectionTeamLock<SPOSet> mw_sposet_lock(spo_res, spo_list);
+
+  SPOSet::ValueVector psi_1(n_mo), psi_2(n_mo);
+  SPOSet::GradVector dpsi_1(n_mo), dpsi_2(n_mo);
+  SPOSet::ValueVector d2psi_1(n_mo), d2psi_2(n_mo);
+  RefVector<SPOSet::ValueVector> psi_list   = {psi_1, psi_2};
+  RefVector<SPOSet::GradVector> dpsi_list   = {dpsi_1, dpsi_2};
+  RefVector<SPOSet::ValueVector> d2psi_list = {d2psi_1, d2psi_2};
+
+  sposet->mw_evaluateVGL(spo_list, P_list, 0, psi_list, dpsi_list, d2psi_list);
+  for (size_t iorb = 0; iorb < n_mo; iorb++)
+  {
+    CHECK(psi_1[iorb] == Approx(psiref_1[iorb]));
+    CHECK(psi_2[iorb] == Approx(psiref_2[iorb]));
+    CHECK(d2psi_1[iorb] == Approx(d2psiref_1[iorb]));
+    CHECK(d2psi_2[iorb] == Approx(d2psiref_2[iorb]));
+    for (size_t idim = 0; idim < SPOSet::DIM; idim++)
+    {
+      CHECK(dpsi_1[iorb][idim] == Approx(dpsiref_1[iorb][idim]));
+      CHECK(dpsi_2[iorb][idim] == Approx(dpsiref_2[iorb][idim]));
+    }
+  }
+
+  sposet->mw_evaluateValue(spo_list, P_list, 0, psi_list);
+  for (size_t iorb = 0; iorb < n_mo; iorb++)
+  {
+    CHECK(psi_1[iorb] == Approx(psiref_1[iorb]));
+    CHECK(psi_2[iorb] == Approx(psiref_2[iorb]));
+  }
+
+  // with invRow = e_0, the ratio is orbital 0 and the grad is its log derivative
+  SPOSet::ValueVector inv_row(n_mo);
+  inv_row    = 0.0;
+  inv_row[0] = 1.0;
+  std::vector<const SPOSet::ValueType*> inv_row_ptr(2, inv_row.data());
+  SPOSet::OffloadMWVGLArray phi_vgl_v;
+  phi_vgl_v.resize(SPOSet::DIM_VGL, 2, n_mo);
+  std::vector<SPOSet::ValueType> ratios(2);
+  std::vector<SPOSet::GradType> grads(2);
+  sposet->mw_evaluateVGLandDetRatioGrads(spo_list, P_list, 0, inv_row_ptr, phi_vgl_v, ratios, grads);
+  CHECK(ratios[0] == Approx(psiref_1[0]));
+  CHECK(ratios[1] == Approx(psiref_2[0]));
+  for (size_t idim = 0; idim < SPOSet::DIM; idim++)
+  {
+    CHECK(grads[0][idim] == Approx(dpsiref_1[0][idim] / psiref_1[0]));
+    CHECK(grads[1][idim] == Approx(dpsiref_2[0][idim] / psiref_2[0]));
+  }
+  for (size_t iorb = 0; iorb < n_mo; iorb++)
+  {
+    CHECK(phi_vgl_v(0, 1, iorb) == Approx(psiref_2[iorb]));
+    CHECK(phi_vgl_v(3, 1, iorb) == Approx(dpsiref_2[iorb][2]));
+    CHECK(phi_vgl_v(4, 1, iorb) == Approx(d2psiref_2[iorb]));
+  }
+}
+
+TEST_CASE("Ethanol MO with cusp batched", "[wavefunction]") { test_EtOH_cusp_batched(false); }
+TEST_CASE("Ethanol MO with cusp batched offload", "[wavefunction]") { test_EtOH_cusp_batched(true); }
+
+TEST_CASE("cusp info hash", "[wavefunction]")
+{
+  Communicate* c = OHMMS::Controller;
+
+  Libxml2Document doc;
+  bool okay = doc.parse("hcn.structure.xml");
+  REQUIRE(okay);
+
+  const SimulationCell simulation_cell;
+  auto ions_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto& ions(*ions_ptr);
+  XMLParticleParser parse_ions(ions);
+  OhmmsXPathObject particleset_ion("//particleset[@name='ion0']", doc.getXPathContext());
+  REQUIRE(particleset_ion.size() == 1);
+  parse_ions.readXML(particleset_ion[0]);
+  ions.update();
+
+  auto elec_ptr = std::make_unique<ParticleSet>(simulation_cell);
+  auto& elec(*elec_ptr);
+  XMLParticleParser parse_elec(elec);
+  OhmmsXPathObject particleset_elec("//particleset[@name='e']", doc.getXPathContext());
+  REQUIRE(particleset_elec.size() == 1);
+  parse_elec.readXML(particleset_elec[0]);
+
+  elec.R = 0.0;
+  elec.addTable(ions);
+  elec.update();
+
+  Libxml2Document doc2;
+  okay = doc2.parse("hcn.wfnoj.xml");
+  REQUIRE(okay);
+
+  WaveFunctionComponentBuilder::PSetMap particle_set_map;
+  particle_set_map.emplace(elec_ptr->getName(), std::move(elec_ptr));
+  particle_set_map.emplace(ions_ptr->getName(), std::move(ions_ptr));
+
+  SPOSetBuilderFactory bf(c, elec, particle_set_map);
+
+  OhmmsXPathObject MO_base("//determinantset", doc2.getXPathContext());
+  REQUIRE(MO_base.size() == 1);
+  xmlSetProp(MO_base[0], castCharToXMLChar("cuspCorrection"), castCharToXMLChar("yes"));
+
+  const auto bb_ptr = bf.createSPOSetBuilder(MO_base[0]);
+  auto& bb(*bb_ptr);
+
+  // a new file, all the orbitals are fitted
+  const std::string cusp_file("hcn_updet_hash.cuspInfo.xml");
+  std::remove(cusp_file.c_str());
+  OhmmsXPathObject slater_base("//determinant", doc2.getXPathContext());
+  xmlSetProp(slater_base[0], castCharToXMLChar("cuspInfo"), castCharToXMLChar(cusp_file.c_str()));
+  auto sposet = bb.createSPOSet(slater_base[0]);
+
+  const int norbs     = sposet->getOrbitalSetSize();
+  const int ncenters  = ions.getTotalNum();
+  const auto hashes   = readCuspInfoHashes(cusp_file, "updet", norbs);
+  REQUIRE(hashes.size() == norbs);
+  for (const auto& hash : hashes)
+    CHECK(hash.size() == 16);
+  CHECK(readCuspInfoHashes(cusp_file, "downdet", norbs).empty());
+  CHECK(readCuspInfoHashes("no_such_file.cuspInfo.xml", "updet", norbs).empty());
+
+  // electron near the N atom
+  elec.R[0] = {-1.09, 0.0, 0.0};
+  elec.update();
+  SPOSet::ValueVector values(norbs), values_2(norbs);
+  sposet->evaluateValue(elec, 0, values);
+
+  // corrupt the parameters of two orbitals and mark only one of them stale.
+  // The stale orbital is fitted again, the other one keeps the corrupted parameters of the file.
+  // the electron is almost on top of N, shift the constant of the corrected orbitals rather than their radius
+  const int stale_orb   = 2;
+  const int current_orb = 4;
+  Matrix<CuspCorrectionParameters> info(ncenters, norbs);
+  REQUIRE(readCuspInfo(cusp_file, "updet", norbs, info));
+  auto stale_hashes = hashes;
+  for (int center_idx = 0; center_idx < ncenters; center_idx++)
+  {
+    info(center_idx, stale_orb).C += 0.5;
+    info(center_idx, current_orb).C += 0.5;
+  }
+  stale_hashes[stale_orb] = "stale";
+  saveCusp(cusp_file, info, "updet", stale_hashes);
+
+  auto sposet_2 = bb.createSPOSet(slater_base[0]);
+  sposet_2->evaluateValue(elec, 0, values_2);
+  for (int iorb = 0; iorb < norbs; iorb++)
+    if (iorb == current_orb)
+      CHECK(values_2[iorb] != Approx(values[iorb]));
+    else
+      CHECK(values_2[iorb] == Approx(values[iorb]));
+  CHECK(readCuspInfoHashes(cusp_file, "updet", norbs) == hashes);
+  Matrix<CuspCorrectionParameters> info_refit(ncenters, norbs);
+  REQUIRE(readCuspInfo(cusp_file, "updet", norbs, info_refit));
+  for (int center_idx = 0; center_idx < ncenters; center_idx++)
+  {
+    CHECK(info_refit(center_idx, stale_orb).C == Approx(info(center_idx, stale_orb).C - 0.5));
+    CHECK(info_refit(center_idx, current_orb).C == Approx(info(center_idx, current_orb).C));
+  }
+
+  // a file without hashes is reused as it is
+  saveCusp(cusp_file, info, "updet");
+  auto sposet_3 = bb.createSPOSet(slater_base[0]);
+  sposet_3->evaluateValue(elec, 0, values_2);
+  CHECK(values_2[stale_orb] != Approx(values[stale_orb]));
+  CHECK(values_2[current_orb] != Approx(values[current_orb]));
+
+  std::remove(cusp_file.c_str());
+}
+
 TEST_CASE("broadcastCuspInfo", "[wavefunction]")
 {
   Communicate* c = OHMMS::Controller;
@@ -25,6 +25,14 @@ namespace qmcplusplus
 {
 bool timer_max_level_exceeded = false;
 
+int get_timer_thread_slot()
+{
+  for (int level = omp_get_level(); level > 1; level--)
+    if (omp_get_ancestor_thread_num(level) != 0)
+      return -1;
+  return omp_get_level() > 0 ? omp_get_ancestor_thread_num(1) : 0;
+}
+
 #ifndef ENABLE_TIMERS
 template<class CLOCK>
 void TimerType<CLOCK>::start()
@@ -49,33 +57,31 @@ void TimerType<CLOCK>::start()
     nvtxRangePushA(name.c_str());
 #endif
 
-    bool is_true_master(true);
-    for (int level = omp_get_level(); level > 0; level--)
-      if (omp_get_ancestor_thread_num(level) != 0)
-        is_true_master = false;
-    if (is_true_master)
+    const int slot = get_timer_thread_slot();
+    if (slot >= 0 && slot < thread_data.size())
     {
+      ThreadData& td = thread_data[slot];
       if (manager)
       {
-        // compute current_stack_key
-        TimerType* parent = manager->current_timer();
+        // compute current_stack_key from the innermost timer running on this thread
+        TimerType* parent = manager->current_timer(slot);
         if (parent)
         {
-          current_stack_key = parent->get_stack_key();
-          current_stack_key.add_id(timer_id);
+          td.current_stack_key = parent->get_stack_key(slot);
+          td.current_stack_key.add_id(timer_id);
         }
         else
         {
-          current_stack_key = StackKey();
-          current_stack_key.add_id(timer_id);
+          td.current_stack_key = StackKey();
+          td.current_stack_key.add_id(timer_id);
         }
 
-        manager->push_timer(this);
+        manager->push_timer(this, slot);
       }
-      start_time = CLOCK::now();
+      td.start_time = CLOCK::now();
     }
 #else
-    start_time                            = CLOCK::now();
+    thread_data[0].start_time = CLOCK::now();
 #endif
   }
 }
@@ -95,26 +101,29 @@ void TimerType<CLOCK>::stop()
     nvtxRangePop();
 #endif
 
-    bool is_true_master(true);
-    for (int level = omp_get_level(); level > 0; level--)
-      if (omp_get_ancestor_thread_num(level) != 0)
-        is_true_master = false;
-    if (is_true_master)
+    const int slot = get_timer_thread_slot();
+    if (slot >= 0 && slot < thread_data.size())
     {
-      std::chrono::duration<double> elapsed = CLOCK::now() - start_time;
-      total_time += elapsed.count();
-      num_calls++;
+      ThreadData& td                        = thread_data[slot];
+      std::chrono::duration<double> elapsed = CLOCK::now() - td.start_time;
+      td.total_time += elapsed.count();
+      td.num_calls++;
 
-      per_stack_total_time[current_stack_key] += elapsed.count();
-      per_stack_num_calls[current_stack_key] += 1;
+      td.per_stack_total_time[td.current_stack_key] += elapsed.count();
+      td.per_stack_num_calls[td.current_stack_key] += 1;
 
       if (manager)
-        manager->pop_timer(this);
+      {
+        if (manager->is_tracing())
+          manager->record_trace_event(slot, timer_id, td.start_time, elapsed.count());
+        manager->pop_timer(this, slot);
+      }
     }
 #else
-    std::chrono::duration<double> elapsed = CLOCK::now() - start_time;
-    total_time += elapsed.count();
-    num_calls++;
+    ThreadData& td                        = thread_data[0];
+    std::chrono::duration<double> elapsed = CLOCK::now() - td.start_time;
+    td.total_time += elapsed.count();
+    td.num_calls++;
 #endif
   }
 }
@@ -21,6 +21,7 @@
 #include <string>
 #include <algorithm>
 #include <map>
+#include <vector>
 #include "config.h"
 #include "Clock.h"
 
@@ -128,19 +129,44 @@ public:
 // N = 2 gives 16 nesting levels
 using StackKey = StackKeyParam<2>;
 
+/** Slot of the calling thread in the per-thread timer data.
+ * Threads of the outermost OpenMP team (one per crowd in the batched drivers) get their thread number.
+ * Threads spawned by nested parallel regions return -1 unless they are the master of every nested team,
+ * in which case they are accounted to their outermost ancestor.
+ */
+int get_timer_thread_slot();
+
 /** Timer accumulates time and call counts
  * @tparam CLOCK can be a std::chrono clock or FakeChronoClock
+ *
+ * Each thread slot owns its measurements so that start/stop from different crowds never touch shared data.
+ * The accessors without a thread slot argument report the master thread (slot 0).
  */
 template<class CLOCK>
 class TimerType
 {
 protected:
-  /// start time of the current measurement
-  typename CLOCK::time_point start_time;
-  /// total time accumulated of all the calls
-  double total_time;
-  /// total call counts
-  long num_calls;
+  /// measurements owned by a single thread slot, padded to avoid false sharing between threads
+  struct alignas(64) ThreadData
+  {
+    /// start time of the current measurement
+    typename CLOCK::time_point start_time;
+    /// total time accumulated of all the calls
+    double total_time = 0.0;
+    /// total call counts
+    long num_calls = 0;
+#ifdef USE_STACK_TIMERS
+    /// stack key of the current measurement
+    StackKey current_stack_key;
+    /// total time accumulated per stack key
+    std::map<StackKey, double> per_stack_total_time;
+    /// total call counts per stack key
+    std::map<StackKey, long> per_stack_num_calls;
+#endif
+  };
+
+  /// measurements per thread slot
+  std::vector<ThreadData> thread_data;
   /// name of this timer
   std::string name;
   /// if false, timer start/stop becomes no-op.
@@ -151,36 +177,32 @@ protected:
   timer_id_t timer_id;
   /// timer manager which allocated this timer object. nullptr if USE_STACK_TIMERS is not used.
   TimerManager<TimerType<CLOCK>>* manager;
-#ifdef USE_STACK_TIMERS
-  /// stack key of the current measurement
-  StackKey current_stack_key;
-
-  /// total time accumulated per stack key
-  std::map<StackKey, double> per_stack_total_time;
-  /// total call counts per stack key
-  std::map<StackKey, long> per_stack_num_calls;
-#endif
 
 #ifdef USE_VTUNE_TASKS
   __itt_string_handle* task_name;
 #endif
 public:
+  using clock_type = CLOCK;
+
   void start();
   void stop();
 
+  /// number of thread slots this timer records
+  inline int get_num_thread_slots() const { return thread_data.size(); }
+
 #ifdef USE_STACK_TIMERS
-  std::map<StackKey, double>& get_per_stack_total_time() { return per_stack_total_time; }
+  std::map<StackKey, double>& get_per_stack_total_time(int slot = 0) { return thread_data[slot].per_stack_total_time; }
 
-  StackKey& get_stack_key() { return current_stack_key; }
+  StackKey& get_stack_key(int slot = 0) { return thread_data[slot].current_stack_key; }
 #endif
 
 
-  inline double get_total() const { return total_time; }
-  inline long get_num_calls() const { return num_calls; }
+  inline double get_total(int slot = 0) const { return thread_data[slot].total_time; }
+  inline long get_num_calls(int slot = 0) const { return thread_data[slot].num_calls; }
 
 #ifdef USE_STACK_TIMERS
-  inline double get_total(const StackKey& key) { return per_stack_total_time[key]; }
-  inline long get_num_calls(const StackKey& key) { return per_stack_num_calls[key]; }
+  inline double get_total(const StackKey& key, int slot = 0) { return thread_data[slot].per_stack_total_time[key]; }
+  inline long get_num_calls(const StackKey& key, int slot = 0) { return thread_data[slot].per_stack_num_calls[key]; }
 #endif
 
   timer_id_t get_id() const { return timer_id; }
@@ -191,15 +213,18 @@ public:
 
   inline void reset()
   {
-    num_calls  = 0;
-    total_time = 0.0;
+    for (auto& td : thread_data)
+    {
+      td.num_calls  = 0;
+      td.total_time = 0.0;
+    }
   }
 
   TimerType(const std::string& myname,
             TimerManager<TimerType<CLOCK>>* mymanager,
-            timer_levels mytimer = timer_level_fine)
-      : total_time(0.0),
-        num_calls(0),
+            timer_levels mytimer = timer_level_fine,
+            int num_thread_slots = 1)
+      : thread_data(std::max(num_thread_slots, 1)),
         name(myname),
         active(true),
         timer_level(mytimer),
@@ -229,6 +254,9 @@ public:
 
   template<class CLOCK1>
   friend void set_num_calls(TimerType<CLOCK1>* timer, long num_calls_input);
+
+  template<class CLOCK1>
+  friend void set_thread_total_time(TimerType<CLOCK1>* timer, int slot, double total_time_input, long num_calls_input);
 };
 
 using NewTimer  = TimerType<ChronoClock>;
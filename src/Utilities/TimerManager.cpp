@@ -20,6 +20,7 @@
 #include <cstdio>
 #include <algorithm>
 #include <array>
+#include <iomanip>
 #include <stdexcept>
 #include <libxml/xmlwriter.h>
 #include "Configuration.h"
@@ -39,6 +40,20 @@ const std::array<std::string, num_timer_levels> timer_level_names = {"none", "co
 const char TIMER_STACK_SEPARATOR = '/';
 
 std::unique_ptr<TimerManager<NewTimer>> global_timer_manager;
+
+/// quote a string for JSON output
+std::string json_string(const std::string& in)
+{
+  std::string out("\"");
+  for (const char c : in)
+  {
+    if (c == '"' || c == '\\')
+      out += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      out += c;
+  }
+  return out + '"';
+}
 } // namespace
 
 TimerManager<NewTimer>& getGlobalTimerManager()
@@ -53,6 +68,23 @@ NewTimer& createGlobalTimer(const std::string& myname, timer_levels mylevel)
   return *getGlobalTimerManager().createTimer(myname, mylevel);
 }
 
+template<class TIMER>
+TimerManager<TIMER>::TimerManager()
+    : CurrentTimerStacks(std::max(omp_get_max_threads(), 1)),
+      tracing_(false),
+      trace_sample_period_(1),
+      trace_min_duration_(0.0),
+      timer_threshold(timer_level_coarse),
+      max_timer_id(1),
+      max_timers_exceeded(false)
+{
+  for (auto& stack : CurrentTimerStacks)
+    stack.timers.reserve(StackKey::max_level);
+#ifdef USE_VTUNE_TASKS
+  task_domain = __itt_domain_create("QMCPACK");
+#endif
+}
+
 template<class TIMER>
 void TimerManager<TIMER>::initializeTimer(TIMER& t)
 {
@@ -86,7 +118,7 @@ TIMER* TimerManager<TIMER>::createTimer(const std::string& myname, timer_levels
   TIMER* t = nullptr;
   {
     const std::lock_guard<std::mutex> lock(timer_list_lock_);
-    timer_storage_.push_back(std::make_unique<TIMER>(myname, this, mytimer));
+    timer_storage_.push_back(std::make_unique<TIMER>(myname, this, mytimer, get_num_thread_slots()));
     t = timer_storage_.back().get();
     initializeTimer(*t);
   }
@@ -94,10 +126,10 @@ TIMER* TimerManager<TIMER>::createTimer(const std::string& myname, timer_levels
 }
 
 template<class TIMER>
-void TimerManager<TIMER>::push_timer(TIMER* t)
+void TimerManager<TIMER>::push_timer(TIMER* t, int slot)
 {
   // current_timer() can be nullptr when the stack was empty.
-  if (t == current_timer())
+  if (t == current_timer(slot))
   {
     std::cerr << "Timer " << t->get_name()
               << " instance is already at the top of the stack. "
@@ -106,13 +138,13 @@ void TimerManager<TIMER>::push_timer(TIMER* t)
     throw std::runtime_error("TimerManager push_timer error!");
   }
   else
-    CurrentTimerStack.push_back(t);
+    CurrentTimerStacks[slot].timers.push_back(t);
 }
 
 template<class TIMER>
-void TimerManager<TIMER>::pop_timer(TIMER* t)
+void TimerManager<TIMER>::pop_timer(TIMER* t, int slot)
 {
-  TIMER* stack_top = current_timer();
+  TIMER* stack_top = current_timer(slot);
   if (stack_top == nullptr)
   {
     std::cerr << "Timer stack pop failed on an empty stack! Requested \"" << t->get_name() << "\"." << std::endl;
@@ -126,7 +158,7 @@ void TimerManager<TIMER>::pop_timer(TIMER* t)
     throw std::runtime_error("TimerManager pop_timer error!");
   }
   else
-    CurrentTimerStack.pop_back();
+    CurrentTimerStacks[slot].timers.pop_back();
 }
 
 template<class TIMER>
@@ -164,28 +196,73 @@ std::string TimerManager<TIMER>::get_timer_threshold_string() const
 }
 
 
+struct ProfileData
+{
+  double time;
+  double calls;
+
+  ProfileData& operator+=(const ProfileData& pd)
+  {
+    time += pd.time;
+    calls += pd.calls;
+    return *this;
+  }
+};
+
+/// append min/max/mean over the thread slots which made any call
+template<class STATS>
+void push_thread_stats(STATS& stats, const std::vector<ProfileData>& per_slot)
+{
+  double tmin  = std::numeric_limits<double>::max();
+  double tmax  = 0.0;
+  double tsum  = 0.0;
+  int nthreads = 0;
+  for (const ProfileData& pd : per_slot)
+    if (pd.calls > 0)
+    {
+      tmin = std::min(tmin, pd.time);
+      tmax = std::max(tmax, pd.time);
+      tsum += pd.time;
+      nthreads++;
+    }
+  stats.timeMinList.push_back(nthreads > 0 ? tmin : 0.0);
+  stats.timeMaxList.push_back(tmax);
+  stats.timeMeanList.push_back(nthreads > 0 ? tsum / nthreads : 0.0);
+}
+
 template<class TIMER>
 void TimerManager<TIMER>::collate_flat_profile(Communicate* comm, FlatProfileData& p)
 {
+  const int num_slots = get_num_thread_slots();
+  std::vector<std::vector<ProfileData>> thread_profiles;
   for (int i = 0; i < timer_storage_.size(); ++i)
   {
     TIMER& timer = *timer_storage_[i];
     nameList_t::iterator it(p.nameList.find(timer.get_name()));
+    int ind;
     if (it == p.nameList.end())
     {
-      int ind                      = p.nameList.size();
+      ind                          = p.nameList.size();
       p.nameList[timer.get_name()] = ind;
       p.timeList.push_back(timer.get_total());
       p.callList.push_back(timer.get_num_calls());
+      thread_profiles.emplace_back(num_slots, ProfileData{0.0, 0.0});
     }
     else
     {
-      int ind = (*it).second;
+      ind = (*it).second;
       p.timeList[ind] += timer.get_total();
       p.callList[ind] += timer.get_num_calls();
     }
+    for (int slot = 0; slot < std::min(num_slots, timer.get_num_thread_slots()); slot++)
+      thread_profiles[ind][slot] +=
+          ProfileData{timer.get_total(slot), static_cast<double>(timer.get_num_calls(slot))};
   }
 
+  // thread statistics are not reduced over ranks
+  for (const auto& per_slot : thread_profiles)
+    push_thread_stats(p, per_slot);
+
   if (comm)
   {
     comm->allreduce(p.timeList);
@@ -193,19 +270,6 @@ void TimerManager<TIMER>::collate_flat_profile(Communicate* comm, FlatProfileDat
   }
 }
 
-struct ProfileData
-{
-  double time;
-  double calls;
-
-  ProfileData& operator+=(const ProfileData& pd)
-  {
-    time += pd.time;
-    calls += pd.calls;
-    return *this;
-  }
-};
-
 int get_level(const std::string& stack_name)
 {
   int level = 0;
@@ -249,21 +313,57 @@ void TimerManager<TIMER>::collate_stack_profile(Communicate* comm, StackProfileD
   // map's keys will also place the stacks in depth-first order.
   // The order in which sibling timers are encountered in the code is not
   // preserved. They will be ordered alphabetically instead.
+  const int num_slots = get_num_thread_slots();
   std::map<std::string, ProfileData> all_stacks;
+  std::map<std::string, std::vector<ProfileData>> thread_stacks;
+  // stacks of the other threads, rooted at the outermost timer each of them started
+  std::map<std::string, std::vector<ProfileData>> rooted_stacks;
   for (int i = 0; i < timer_storage_.size(); ++i)
   {
     TIMER& timer = *timer_storage_[i];
-    for (const auto& [key, time] : timer.get_per_stack_total_time())
-    {
-      ProfileData pd;
-      std::string stack_name;
-      get_stack_name_from_id(key, stack_name);
-      pd.time  = timer.get_total(key);
-      pd.calls = timer.get_num_calls(key);
+    for (int slot = 0; slot < std::min(num_slots, timer.get_num_thread_slots()); slot++)
+      for (const auto& [key, time] : timer.get_per_stack_total_time(slot))
+      {
+        ProfileData pd;
+        std::string stack_name;
+        get_stack_name_from_id(key, stack_name);
+        pd.time  = timer.get_total(key, slot);
+        pd.calls = timer.get_num_calls(key, slot);
+
+        auto& stacks = slot == 0 ? thread_stacks : rooted_stacks;
+        auto [it, inserted] = stacks.try_emplace(stack_name, num_slots, ProfileData{0.0, 0.0});
+        it->second[slot] += pd;
+        if (slot == 0)
+          all_stacks[stack_name] += pd;
+      }
+  }
 
-      all_stacks[stack_name] += pd;
-    }
+  // Threads other than the master start their stacks inside a parallel region and miss the timers
+  // the master entered before it. Graft them below the unique master stack ending with the same root timer.
+  // Without a unique match, keep them as separate top level stacks.
+  for (const auto& [stack_name, per_slot] : rooted_stacks)
+  {
+    const auto root_end         = stack_name.find(TIMER_STACK_SEPARATOR);
+    const std::string root_name = stack_name.substr(0, root_end);
+    const std::string* match    = nullptr;
+    int num_matches             = 0;
+    for (const auto& [master_name, data] : all_stacks)
+      if (get_leaf_name(master_name) == root_name)
+      {
+        match = &master_name;
+        num_matches++;
+      }
+
+    std::string grafted_name = stack_name;
+    if (num_matches == 1)
+      grafted_name = *match + (root_end == std::string::npos ? "" : stack_name.substr(root_end));
+
+    auto [it, inserted] = thread_stacks.try_emplace(grafted_name, num_slots, ProfileData{0.0, 0.0});
+    for (int slot = 1; slot < num_slots; slot++)
+      it->second[slot] += per_slot[slot];
   }
+  for (const auto& [stack_name, per_slot] : thread_stacks)
+    all_stacks.try_emplace(stack_name, ProfileData{0.0, 0.0});
 
   // Fill in the output data structure (but don't compute exclusive time yet)
   int idx = 0;
@@ -274,6 +374,7 @@ void TimerManager<TIMER>::collate_stack_profile(Communicate* comm, StackProfileD
     p.timeList.push_back(data.time);
     p.timeExclList.push_back(data.time);
     p.callList.push_back(data.calls);
+    push_thread_stats(p, thread_stacks.at(stack_name));
     idx++;
   }
 
@@ -329,14 +430,22 @@ void TimerManager<TIMER>::print_flat(Communicate* comm)
     {
       std::array<char, 256> tmpout;
       std::map<std::string, int>::iterator it(p.nameList.begin()), it_end(p.nameList.end());
+      int length = std::snprintf(tmpout.data(), tmpout.size(), "%-40s  %9s  %13s  %16s  %12s  %9s  %9s  %9s  %9s\n",
+                                 "Timer", "Time", "Calls", "Time_per_call", "Time_per_thr", "Thread_min", "Thread_max",
+                                 "Thread_mean", "Imbalance");
+      if (length < 0)
+        throw std::runtime_error("Error generating timer string");
+      app_log() << std::string_view(tmpout.data(), length);
       while (it != it_end)
       {
         int i = (*it).second;
-        int length =
-            std::snprintf(tmpout.data(), tmpout.size(), "%-40s  %9.4f  %13ld  %16.9f  %12.6f TIMER\n",
+        length =
+            std::snprintf(tmpout.data(), tmpout.size(),
+                          "%-40s  %9.4f  %13ld  %16.9f  %12.6f  %9.4f  %9.4f  %9.4f  %9.2f TIMER\n",
                           (*it).first.c_str(), p.timeList[i], p.callList[i],
                           p.timeList[i] / (static_cast<double>(p.callList[i]) + std::numeric_limits<double>::epsilon()),
-                          p.timeList[i] / static_cast<double>(omp_get_max_threads() * comm->size()));
+                          p.timeList[i] / static_cast<double>(omp_get_max_threads() * (comm ? comm->size() : 1)),
+                          p.timeMinList[i], p.timeMaxList[i], p.timeMeanList[i], p.imbalance(i));
         if (length < 0)
           throw std::runtime_error("Error generating timer string");
         app_log() << std::string_view(tmpout.data(), length);
@@ -384,12 +493,13 @@ void TimerManager<TIMER>::print_stack(Communicate* comm)
       max_name_len           = std::max(name_len, max_name_len);
     }
 
-    std::array<char, 256> tmpout;
+    std::array<char, 512> tmpout;
     std::string timer_name;
     pad_string("Timer", timer_name, max_name_len);
 
-    int length = std::snprintf(tmpout.data(), tmpout.size(), "%s  %-9s  %-9s  %-10s  %-13s\n", timer_name.c_str(),
-                               "Inclusive_time", "Exclusive_time", "Calls", "Time_per_call");
+    int length = std::snprintf(tmpout.data(), tmpout.size(), "%s  %-9s  %-9s  %-10s  %-13s  %-9s  %-9s  %-9s  %-9s\n",
+                               timer_name.c_str(), "Inclusive_time", "Exclusive_time", "Calls", "Time_per_call",
+                               "Thread_min", "Thread_max", "Thread_mean", "Imbalance");
     if (length < 0)
       throw std::runtime_error("Error generating timer string");
     app_log() << std::string_view(tmpout.data(), length);
@@ -404,9 +514,10 @@ void TimerManager<TIMER>::print_stack(Communicate* comm)
       std::string padded_name_str;
       pad_string(indented_str, padded_name_str, max_name_len);
       length =
-          std::snprintf(tmpout.data(), tmpout.size(), "%s  %9.4f  %9.4f  %13ld  %16.9f\n", padded_name_str.c_str(),
-                        p.timeList[i], p.timeExclList[i], p.callList[i],
-                        p.timeList[i] / (static_cast<double>(p.callList[i]) + std::numeric_limits<double>::epsilon()));
+          std::snprintf(tmpout.data(), tmpout.size(), "%s  %9.4f  %9.4f  %13ld  %16.9f  %9.4f  %9.4f  %9.4f  %9.2f\n",
+                        padded_name_str.c_str(), p.timeList[i], p.timeExclList[i], p.callList[i],
+                        p.timeList[i] / (static_cast<double>(p.callList[i]) + std::numeric_limits<double>::epsilon()),
+                        p.timeMinList[i], p.timeMaxList[i], p.timeMeanList[i], p.imbalance(i));
       if (length < 0)
         throw std::runtime_error("Error generating timer string");
       app_log() << std::string_view(tmpout.data(), length);
@@ -468,6 +579,52 @@ void TimerManager<TIMER>::output_timing(Communicate* comm, Libxml2Document& doc,
 #endif
 }
 
+template<class TIMER>
+void TimerManager<TIMER>::enable_trace(std::size_t max_events, int sample_period, double min_duration)
+{
+  if (max_events == 0 || sample_period < 1)
+    throw std::runtime_error("TimerManager::enable_trace requires a positive number of events and sample period");
+  trace_buffers_ = std::vector<TraceBuffer>(get_num_thread_slots());
+  for (auto& buffer : trace_buffers_)
+    buffer.events.resize(max_events);
+  trace_sample_period_ = sample_period;
+  trace_min_duration_  = min_duration;
+  trace_epoch_         = TIMER::clock_type::now();
+  tracing_             = true;
+}
+
+template<class TIMER>
+void TimerManager<TIMER>::write_trace(Communicate* comm, std::ostream& os)
+{
+  const int rank        = comm ? comm->rank() : 0;
+  long num_overwritten = 0;
+
+  os << std::fixed << std::setprecision(3);
+  os << "{\"traceEvents\":[\n";
+  os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank << ",\"tid\":0,\"args\":{\"name\":\"rank " << rank
+     << "\"}}";
+  for (int slot = 0; slot < trace_buffers_.size(); slot++)
+  {
+    const TraceBuffer& buffer = trace_buffers_[slot];
+    if (buffer.num_recorded == 0)
+      continue;
+    os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << rank << ",\"tid\":" << slot
+       << ",\"args\":{\"name\":\"thread " << slot << "\"}}";
+
+    const long capacity = buffer.events.size();
+    const long first    = std::max(buffer.num_recorded - capacity, 0L);
+    num_overwritten += first;
+    for (long i = first; i < buffer.num_recorded; i++)
+    {
+      const TraceEvent& event = buffer.events[i % capacity];
+      os << ",\n{\"name\":" << json_string(timer_id_name[event.id]) << ",\"cat\":\"timer\",\"ph\":\"X\",\"pid\":"
+         << rank << ",\"tid\":" << slot << ",\"ts\":" << event.start << ",\"dur\":" << event.duration << "}";
+    }
+  }
+  os << "\n],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{\"sample_period\":" << trace_sample_period_
+     << ",\"min_duration\":" << trace_min_duration_ << ",\"overwritten_events\":" << num_overwritten << "}}\n";
+}
+
 template class TimerManager<NewTimer>;
 template class TimerManager<FakeTimer>;
 
@@ -23,6 +23,7 @@
 #include <mutex>
 #include <map>
 #include <memory>
+#include <ostream>
 #include <type_traits>
 #include "NewTimer.h"
 #include "config.h"
@@ -50,8 +51,39 @@ private:
   std::vector<std::unique_ptr<TIMER>> timer_storage_;
   /// mutex for TimerList
   std::mutex timer_list_lock_;
-  /// The stack of nested active timers
-  std::vector<TIMER*> CurrentTimerStack;
+  /// The stack of nested active timers of a thread slot, padded to avoid false sharing between threads
+  struct alignas(64) TimerStack
+  {
+    std::vector<TIMER*> timers;
+  };
+  /// The stacks of nested active timers, one per thread slot. Each slot is only touched by its owner thread.
+  std::vector<TimerStack> CurrentTimerStacks;
+  /// A timed interval recorded for the timeline, times in microseconds since trace_epoch_
+  struct TraceEvent
+  {
+    double start;
+    double duration;
+    timer_id_t id;
+  };
+  /// Ring buffer of the timeline events of a thread slot, only touched by its owner thread while recording
+  struct alignas(64) TraceBuffer
+  {
+    std::vector<TraceEvent> events;
+    /// events offered to this buffer, including those skipped by sampling
+    long num_offered = 0;
+    /// events stored, the oldest ones are overwritten once it exceeds the capacity
+    long num_recorded = 0;
+  };
+  /// timeline event buffers, one per thread slot
+  std::vector<TraceBuffer> trace_buffers_;
+  /// if true, timer stops are recorded in trace_buffers_
+  bool tracing_;
+  /// record one out of trace_sample_period_ events on each thread
+  int trace_sample_period_;
+  /// events shorter than this, in seconds, are not recorded
+  double trace_min_duration_;
+  /// time origin of the recorded events
+  typename TIMER::clock_type::time_point trace_epoch_;
   /// The threshold for active timers
   timer_levels timer_threshold;
   /// The current maximal timer id
@@ -73,25 +105,26 @@ public:
   __itt_domain* task_domain;
 #endif
 
-  TimerManager() : timer_threshold(timer_level_coarse), max_timer_id(1), max_timers_exceeded(false)
-  {
-#ifdef USE_VTUNE_TASKS
-    task_domain = __itt_domain_create("QMCPACK");
-#endif
-  }
+  TimerManager();
 
   /// Create a new timer object registred in this manager. This call is thread-safe.
   TIMER* createTimer(const std::string& myname, timer_levels mytimer = timer_level_fine);
 
-  void push_timer(TIMER* t);
+  /** number of thread slots timers keep separate measurements for.
+   * Fixed at construction to omp_get_max_threads(). Threads beyond it are not recorded.
+   */
+  int get_num_thread_slots() const { return CurrentTimerStacks.size(); }
+
+  void push_timer(TIMER* t, int slot = 0);
 
-  void pop_timer(TIMER* t);
+  void pop_timer(TIMER* t, int slot = 0);
 
-  TIMER* current_timer()
+  /// innermost active timer of a thread slot
+  TIMER* current_timer(int slot = 0)
   {
     TIMER* current = nullptr;
-    if (CurrentTimerStack.size() > 0)
-      current = CurrentTimerStack.back();
+    if (CurrentTimerStacks[slot].timers.size() > 0)
+      current = CurrentTimerStacks[slot].timers.back();
 
     return current;
   }
@@ -110,14 +143,28 @@ public:
   using callList_t = std::vector<long>;
   using names_t    = std::vector<std::string>;
 
-  struct FlatProfileData
+  /** Spread of a timer over the thread slots which called it.
+   * Time and calls in the profile lists are those of the master thread; these statistics
+   * cover every thread (crowd) of the rank and expose load imbalance between them.
+   */
+  struct ThreadStatsList
+  {
+    timeList_t timeMinList;
+    timeList_t timeMaxList;
+    timeList_t timeMeanList;
+
+    /// max over mean thread time, 1 for perfectly balanced threads
+    double imbalance(int i) const { return timeMeanList[i] > 0.0 ? timeMaxList[i] / timeMeanList[i] : 1.0; }
+  };
+
+  struct FlatProfileData : ThreadStatsList
   {
     nameList_t nameList;
     timeList_t timeList;
     callList_t callList;
   };
 
-  struct StackProfileData
+  struct StackProfileData : ThreadStatsList
   {
     names_t names;
     nameList_t nameList;
@@ -132,6 +179,34 @@ public:
 
   void output_timing(Communicate* comm, Libxml2Document& doc, xmlNodePtr root);
 
+  /** Start recording a timeline of timer start/stop events on every thread slot.
+   * @param max_events ring buffer capacity per thread slot. Once full, the oldest events are overwritten.
+   * @param sample_period record one out of every sample_period events of each thread
+   * @param min_duration events shorter than this, in seconds, are not recorded
+   */
+  void enable_trace(std::size_t max_events, int sample_period = 1, double min_duration = 0.0);
+
+  bool is_tracing() const { return tracing_; }
+
+  /// Record the interval of a stopped timer. Lock-free, only called by the owner thread of the slot.
+  void record_trace_event(int slot,
+                          timer_id_t id,
+                          const typename TIMER::clock_type::time_point& start_time,
+                          double elapsed)
+  {
+    TraceBuffer& buffer = trace_buffers_[slot];
+    if (buffer.num_offered++ % trace_sample_period_ != 0 || elapsed < trace_min_duration_)
+      return;
+    const std::chrono::duration<double, std::micro> start = start_time - trace_epoch_;
+    buffer.events[buffer.num_recorded++ % buffer.events.size()] = {start.count(), elapsed * 1.0e6, id};
+  }
+
+  /** Write the recorded events in the Chrome trace event format, readable by chrome://tracing and Perfetto.
+   * Each rank is a process and each thread slot a thread of it, so the files of all ranks can be merged.
+   * @param comm provides the rank of the events, may be nullptr
+   */
+  void write_trace(Communicate* comm, std::ostream& os);
+
   void get_stack_name_from_id(const StackKey& key, std::string& name);
 };
 
@@ -12,6 +12,7 @@
 
 #include "catch.hpp"
 
+#include <sstream>
 #include <string>
 #include <vector>
 #include "Utilities/TimerManager.h"
@@ -25,13 +26,26 @@ using FakeTimerManager = TimerManager<FakeTimer>;
 template<class CLOCK>
 void set_total_time(TimerType<CLOCK>* timer, double total_time_input)
 {
-  timer->total_time = total_time_input;
+  timer->thread_data[0].total_time = total_time_input;
 }
 
 template<class CLOCK>
 void set_num_calls(TimerType<CLOCK>* timer, long num_calls_input)
 {
-  timer->num_calls = num_calls_input;
+  timer->thread_data[0].num_calls = num_calls_input;
+}
+
+// Record a measurement of a thread slot with the timer as the outermost timer of that thread
+template<class CLOCK>
+void set_thread_total_time(TimerType<CLOCK>* timer, int slot, double total_time_input, long num_calls_input)
+{
+  auto& td = timer->thread_data[slot];
+  StackKey key;
+  key.add_id(timer->get_id());
+  td.total_time                = total_time_input;
+  td.num_calls                 = num_calls_input;
+  td.per_stack_total_time[key] = total_time_input;
+  td.per_stack_num_calls[key]  = num_calls_input;
 }
 
 // Convert duration input type to nanosecond duration
@@ -324,6 +338,92 @@ TEST_CASE("test_timer_nested_profile_collate", "[utilities]")
   doc.dump("tmp3.xml");
 }
 
+TEST_CASE("test_timer_thread_stats", "[utilities]")
+{
+  FakeTimerManager tm;
+  tm.set_timer_threshold(timer_level_fine);
+  FakeTimer* t1 = tm.createTimer("timer1");
+  FakeTimer* t2 = tm.createTimer("timer2");
+  REQUIRE(t1->get_num_thread_slots() == tm.get_num_thread_slots());
+
+  FakeChronoClock::fake_chrono_clock_increment = convert_to_ns(1.0s);
+  t1->start();
+  t2->start();
+  t2->stop();
+  t1->stop();
+
+  FakeTimerManager::FlatProfileData p;
+  tm.collate_flat_profile(NULL, p);
+  REQUIRE(p.timeMaxList.size() == 2);
+#ifdef ENABLE_TIMERS
+  // a single thread is perfectly balanced
+  const int i2 = p.nameList.at("timer2");
+  CHECK(p.timeMinList[i2] == Approx(1.0));
+  CHECK(p.timeMaxList[i2] == Approx(1.0));
+  CHECK(p.timeMeanList[i2] == Approx(1.0));
+  CHECK(p.imbalance(i2) == Approx(1.0));
+
+  if (tm.get_num_thread_slots() > 1)
+  {
+    // the second crowd spent three times as long in timer2
+    set_thread_total_time(t2, 1, 3.0, 2);
+    FakeTimerManager::FlatProfileData p2;
+    tm.collate_flat_profile(NULL, p2);
+    CHECK(p2.timeList[i2] == Approx(1.0));
+    CHECK(p2.callList[i2] == 1);
+    CHECK(p2.timeMinList[i2] == Approx(1.0));
+    CHECK(p2.timeMaxList[i2] == Approx(3.0));
+    CHECK(p2.timeMeanList[i2] == Approx(2.0));
+    CHECK(p2.imbalance(i2) == Approx(1.5));
+
+    // the stack of the second thread starts at timer2 and is grafted below timer1
+    FakeTimerManager::StackProfileData ps;
+    tm.collate_stack_profile(NULL, ps);
+    REQUIRE(ps.names.size() == 2);
+    REQUIRE(ps.names[1] == "timer1/timer2");
+    CHECK(ps.timeList[1] == Approx(1.0));
+    CHECK(ps.timeMaxList[1] == Approx(3.0));
+    CHECK(ps.imbalance(1) == Approx(1.5));
+  }
+#endif
+}
+
+TEST_CASE("test_timer_trace", "[utilities]")
+{
+  FakeTimerManager tm;
+  tm.set_timer_threshold(timer_level_fine);
+  FakeTimer* t1 = tm.createTimer("timer1");
+  FakeTimer* t2 = tm.createTimer("timer\"2");
+  REQUIRE(!tm.is_tracing());
+  // keep the last two events, recording every second one
+  tm.enable_trace(2, 2);
+  REQUIRE(tm.is_tracing());
+
+  FakeChronoClock::fake_chrono_clock_increment = convert_to_ns(1.0s);
+  t1->start();
+  for (int i = 0; i < 5; i++)
+  {
+    t2->start();
+    t2->stop();
+  }
+  t1->stop();
+
+  std::ostringstream trace;
+  tm.write_trace(NULL, trace);
+  const std::string json = trace.str();
+  CHECK(json.find("\"traceEvents\"") != std::string::npos);
+  CHECK(json.find("\"name\":\"rank 0\"") != std::string::npos);
+#ifdef ENABLE_TIMERS
+  // events 1, 3, 5 of timer2 are sampled, the first one is overwritten and timer1 is skipped by sampling
+  CHECK(json.find("\"timer\\\"2\",\"cat\":\"timer\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":6000000.000,\"dur\":"
+                  "1000000.000}") != std::string::npos);
+  CHECK(json.find("\"ts\":10000000.000") != std::string::npos);
+  CHECK(json.find("\"ts\":2000000.000") == std::string::npos);
+  CHECK(json.find("\"timer1\"") == std::string::npos);
+  CHECK(json.find("\"overwritten_events\":1}") != std::string::npos);
+#endif
+}
+
 #ifdef ENABLE_TIMERS
 TEST_CASE("test stack key")
 {